@@ -0,0 +1,85 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+#include "Benchmarks.h"
+
+namespace
+{
+	MauBen::Settings g_Settings{};
+
+	// Usage: MauEngBenchmarks [--max-entities <count>] [--json <dir>]
+	void ParseSettings(int argc, char* argv[])
+	{
+		uint32_t maxEntities{ 10'000'000 };
+
+		for (int i{ 1 }; i + 1 < argc; i += 2)
+		{
+			std::string_view const option{ argv[i] };
+			if (option == "--max-entities")
+			{
+				maxEntities = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+			}
+			else if (option == "--json")
+			{
+				g_Settings.jsonDirectory = argv[i + 1];
+				std::filesystem::create_directories(g_Settings.jsonDirectory);
+			}
+			else
+			{
+				std::cerr << "Unknown option " << option << '\n';
+			}
+		}
+
+		for (uint32_t count{ 1'000 }; count <= maxEntities; count *= 10)
+		{
+			g_Settings.entityCounts.emplace_back(count);
+		}
+	}
+}
+
+namespace MauBen
+{
+	Settings const& GetSettings() noexcept
+	{
+		return g_Settings;
+	}
+
+	void Export(ankerl::nanobench::Bench const& bench)
+	{
+		if (g_Settings.jsonDirectory.empty())
+		{
+			return;
+		}
+
+		// Titles contain spaces & commas, keep the file name portable
+		std::string fileName{ bench.title() };
+		std::ranges::replace_if(fileName, [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); }, '_');
+
+		std::ofstream file{ g_Settings.jsonDirectory / (fileName + ".json") };
+		ankerl::nanobench::render(ankerl::nanobench::templates::json(), bench, file);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	ParseSettings(argc, argv);
+
+	MauBen::RunSlotMapBenchmarks();
+	MauBen::RunLoggerBenchmarks();
+	MauBen::RunProfilerBenchmarks();
+	MauBen::RunEntityCreationBenchmarks();
+	MauBen::RunComponentBenchmarks();
+	MauBen::RunIterationBenchmarks();
+	MauBen::RunSortBenchmarks();
+	MauBen::RunSpatialIndexBenchmarks();
+	MauBen::RunSpatialHashGridBenchmarks();
+
+	return 0;
+}
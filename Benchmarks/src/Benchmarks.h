@@ -0,0 +1,40 @@
+#ifndef MAUBEN_BENCHMARKS_H
+#define MAUBEN_BENCHMARKS_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace ankerl::nanobench
+{
+	class Bench;
+}
+
+namespace MauBen
+{
+	// Set from the command line, see BenchMain.cpp
+	struct Settings final
+	{
+		// Entity counts the ECS benchmarks run for, 1k up to --max-entities
+		std::vector<uint32_t> entityCounts{};
+		// Results are also written as <dir>/<bench title>.json when --json <dir> is passed
+		std::filesystem::path jsonDirectory{};
+	};
+
+	[[nodiscard]] Settings const& GetSettings() noexcept;
+
+	// Call once every run of the bench is done
+	void Export(ankerl::nanobench::Bench const& bench);
+
+	void RunSlotMapBenchmarks();
+	void RunLoggerBenchmarks();
+	void RunProfilerBenchmarks();
+	void RunEntityCreationBenchmarks();
+	void RunComponentBenchmarks();
+	void RunIterationBenchmarks();
+	void RunSortBenchmarks();
+	void RunSpatialIndexBenchmarks();
+	void RunSpatialHashGridBenchmarks();
+}
+
+#endif
@@ -0,0 +1,139 @@
+#include <nanobench.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "Benchmarks.h"
+
+#include "Logger/Logger.h"
+
+namespace
+{
+	uint32_t constexpr CALL_COUNT{ 200'000 };
+
+	enum class LoggerKind : uint8_t
+	{
+		Sync,
+		Async,
+		Binary
+	};
+
+	struct LoggerSetup final
+	{
+		std::string_view name;
+		LoggerKind kind;
+		MauCor::LogOverflowPolicy overflowPolicy;
+	};
+
+	std::array constexpr SETUPS
+	{
+		LoggerSetup{ "file (sync)", LoggerKind::Sync, MauCor::LogOverflowPolicy::Drop },
+		LoggerSetup{ "file (async, drop)", LoggerKind::Async, MauCor::LogOverflowPolicy::Drop },
+		LoggerSetup{ "file (async, block)", LoggerKind::Async, MauCor::LogOverflowPolicy::Block },
+		LoggerSetup{ "file (async, count)", LoggerKind::Async, MauCor::LogOverflowPolicy::Count },
+		LoggerSetup{ "binary", LoggerKind::Binary, MauCor::LogOverflowPolicy::Count },
+	};
+
+	// The file logger rotates & writes a line per call, what the game thread paid for every log before
+	[[nodiscard]] std::filesystem::path LogFilePath()
+	{
+		return std::filesystem::temp_directory_path() / "MauEngBenchLog.txt";
+	}
+
+	[[nodiscard]] std::unique_ptr<MauCor::Logger> CreateLogger(LoggerSetup const& setup)
+	{
+		switch (setup.kind)
+		{
+		case LoggerKind::Async:
+			return MauCor::CreateAsyncLogger(MauCor::CreateFileLogger(LogFilePath()), { .overflowPolicy = setup.overflowPolicy });
+		case LoggerKind::Binary:
+			return MauCor::CreateBinaryLogger(LogFilePath());
+		default:
+			return MauCor::CreateFileLogger(LogFilePath());
+		}
+	}
+
+	// The same message for every logger, the binary logger gets it through ME_LOG_BINARY
+	void LogFrame(MauCor::Logger& logger, LoggerKind kind, uint32_t frame)
+	{
+		if (kind == LoggerKind::Binary)
+		{
+			ME_LOG_BINARY_TO(logger, MauCor::LogPriority::Info, MauCor::LogCategory::Engine, "Frame {} took {:.3f} ms, {} draws", frame, 16.6f, 1'024);
+		}
+		else
+		{
+			logger.Log(MauCor::LogPriority::Info, MauCor::LogCategory::Engine, "Frame {} took {:.3f} ms, {} draws", frame, 16.6f, 1'024);
+		}
+	}
+
+	// Time of every single call on the calling thread, the tail is what shows up as a frame spike
+	void MeasureLatency(LoggerSetup const& setup, MauCor::Logger& logger)
+	{
+		std::vector<std::chrono::nanoseconds> latencies(CALL_COUNT);
+
+		for (uint32_t i{ 0 }; i < CALL_COUNT; ++i)
+		{
+			auto const start{ std::chrono::steady_clock::now() };
+			LogFrame(logger, setup.kind, i);
+			latencies[i] = std::chrono::steady_clock::now() - start;
+		}
+
+		logger.Flush();
+
+		std::ranges::sort(latencies);
+		auto const percentile{ [&latencies](double p)
+			{
+				return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))].count();
+			} };
+
+		std::cout << fmt::format("{:<24} p50 {:>8} ns | p99.9 {:>10} ns | max {:>10} ns\n", 
+			setup.name, percentile(0.5), percentile(0.999), latencies.back().count());
+	}
+}
+
+namespace MauBen
+{
+	void RunLoggerBenchmarks()
+	{
+		std::cout << fmt::format("Caller latency of {} log calls in a row\n", CALL_COUNT);
+		for (auto const& setup : SETUPS)
+		{
+			auto const pLogger{ CreateLogger(setup) };
+			MeasureLatency(setup, *pLogger);
+		}
+
+		ankerl::nanobench::Bench bench{};
+		bench.title("Log one message")
+			.unit("message")
+			.relative(true);
+
+		uint32_t frame{ 0 };
+		for (auto const& setup : SETUPS)
+		{
+			auto const pLogger{ CreateLogger(setup) };
+			bench.run(std::string{ setup.name }, [&]
+				{
+					LogFrame(*pLogger, setup.kind, ++frame);
+				});
+		}
+
+		Export(bench);
+
+		// The binary log & the file logger's segments (MauEngBenchLog.0.txt, ...)
+		std::vector<std::filesystem::path> logFiles{};
+		for (auto const& entry : std::filesystem::directory_iterator{ LogFilePath().parent_path() })
+		{
+			if (entry.path().filename().string().starts_with(LogFilePath().stem().string()))
+			{
+				logFiles.emplace_back(entry.path());
+			}
+		}
+
+		for (auto const& path : logFiles)
+		{
+			std::filesystem::remove(path);
+		}
+	}
+}
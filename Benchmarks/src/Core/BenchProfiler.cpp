@@ -0,0 +1,71 @@
+#include <nanobench.h>
+#include <filesystem>
+#include <iostream>
+
+#include "Benchmarks.h"
+
+#include "CoreServiceLocator.h"
+#include "Profiling/InstrumentorTimer.h"
+#include "Profiling/Profiler.h"
+#include "Profiling/ProfilerFactory.h"
+
+namespace
+{
+	[[nodiscard]] std::filesystem::path ProfilePath()
+	{
+		return std::filesystem::temp_directory_path() / "MauEngBenchProfile";
+	}
+
+	// A scope that measures nothing, what is left is the cost of the profiler
+	void EmptyScope() noexcept
+	{
+		MauCor::InstrumentorTimer timer{ "Empty scope", false };
+	}
+
+	void NestedScopes() noexcept
+	{
+		MauCor::InstrumentorTimer outer{ "Outer scope", false };
+		EmptyScope();
+		EmptyScope();
+	}
+}
+
+namespace MauBen
+{
+	void RunProfilerBenchmarks()
+	{
+		ankerl::nanobench::Bench bench{};
+		// Bounded, every scope of the trace profiler is kept until the session ends
+		bench.title("Profile one scope")
+			.unit("scope")
+			.relative(true)
+			.epochs(20)
+			.epochIterations(10'000);
+
+		// Both write chrome trace JSON, the trace profiler only when the session ends
+		std::pair<char const*, std::unique_ptr<MauCor::Profiler>(*)()> constexpr PROFILERS[]
+		{
+			{ "google (JSON per scope)", &MauCor::CreateGoogleProfiler },
+			{ "trace (per thread ring)", &MauCor::CreateTraceProfiler },
+		};
+
+		for (auto const& [name, createProfiler] : PROFILERS)
+		{
+			MauCor::CoreServiceLocator::RegisterProfiler(createProfiler());
+			PROFILER.BeginSession(name, ProfilePath().string().c_str());
+
+			bench.run(name, [] { EmptyScope(); });
+
+			// Three scopes per call, the ring is drained while the session runs
+			bench.batch(3).run(std::string{ name } + ", nested", [] { NestedScopes(); });
+			bench.batch(1);
+
+			PROFILER.EndSession();
+		}
+
+		Export(bench);
+
+		MauCor::CoreServiceLocator::RegisterProfiler(nullptr);
+		std::filesystem::remove(ProfilePath().string() + ".json");
+	}
+}
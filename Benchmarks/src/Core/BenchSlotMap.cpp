@@ -0,0 +1,109 @@
+#include <nanobench.h>
+#include <random>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "Benchmarks.h"
+
+#include "Containers/SlotMap.h"
+
+namespace
+{
+	// Mirrors what VulkanMeshManager::QueueDraw reads & writes per instance, without the renderer
+	struct MeshData final
+	{
+		uint32_t meshID{};
+		uint32_t firstSubMesh{};
+		uint32_t subMeshCount{};
+		uint32_t flags{};
+	};
+
+	struct MeshInstanceData final
+	{
+		glm::mat4 transform{};
+		uint32_t subMeshID{};
+		uint32_t materialID{};
+		uint32_t flags{};
+	};
+
+	uint32_t constexpr MESH_COUNT{ 256 };
+
+	template<typename LookupFunc>
+	void Submit(std::vector<uint32_t> const& instanceMeshIDs, std::vector<MeshInstanceData>& instances, LookupFunc const& lookup)
+	{
+		instances.clear();
+
+		glm::mat4 const transform{ 1.f };
+		for (auto const meshID : instanceMeshIDs)
+		{
+			auto const& meshData{ lookup(meshID) };
+			for (uint32_t sub{ meshData.firstSubMesh }; sub < meshData.firstSubMesh + meshData.subMeshCount; ++sub)
+			{
+				instances.emplace_back(transform, sub, 0u, meshData.flags);
+			}
+		}
+	}
+}
+
+namespace MauBen
+{
+	void RunSlotMapBenchmarks()
+	{
+		// Before: mesh id -> index in an unordered_map, then the mesh data array
+		std::unordered_map<uint32_t, uint32_t> loadedMeshes{};
+		std::vector<MeshData> meshData{};
+
+		// After: the mesh id is a handle into the slot map
+		MauCor::SlotMap<MeshData, 16> meshes{};
+
+		for (uint32_t i{ 0 }; i < MESH_COUNT; ++i)
+		{
+			MeshData const data{ i, i, 1, 0 };
+
+			loadedMeshes[i] = static_cast<uint32_t>(meshData.size());
+			meshData.emplace_back(data);
+
+			static_cast<void>(meshes.Emplace(data));
+		}
+
+		for (uint32_t const count : GetSettings().entityCounts)
+		{
+			std::mt19937 rng{ count };
+			std::vector<uint32_t> instanceMeshIDs(count);
+			for (auto& meshID : instanceMeshIDs)
+			{
+				meshID = rng() % MESH_COUNT;
+			}
+
+			std::vector<MeshInstanceData> instances{};
+			instances.reserve(count);
+
+			ankerl::nanobench::Bench bench{};
+			bench.title(fmt::format("Submit {} mesh instances", count))
+				.unit("instance")
+				.batch(count)
+				.relative(true);
+
+			bench.run("unordered_map lookup", [&]
+				{
+					Submit(instanceMeshIDs, instances, [&](uint32_t meshID) -> MeshData const&
+						{
+							return meshData[loadedMeshes.find(meshID)->second];
+						});
+					ankerl::nanobench::doNotOptimizeAway(instances.data());
+				});
+
+			bench.run("SlotMap lookup", [&]
+				{
+					Submit(instanceMeshIDs, instances, [&](uint32_t meshID) -> MeshData const&
+						{
+							return meshes.Get(meshID);
+						});
+					ankerl::nanobench::doNotOptimizeAway(instances.data());
+				});
+
+			Export(bench);
+		}
+	}
+}
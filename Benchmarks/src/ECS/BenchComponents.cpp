@@ -0,0 +1,90 @@
+#include <nanobench.h>
+
+#include "Benchmarks.h"
+
+#include "ECSWorld.h"
+#include "Components/CTransform.h"
+
+namespace
+{
+	// Deleted in place (entt leaves a tombstone instead of swapping the last component in), the pools Compact is meant for
+	struct CVelocity final
+	{
+		static constexpr bool in_place_delete{ true };
+
+		glm::vec3 velocity{};
+	};
+}
+
+namespace MauBen
+{
+	void RunComponentBenchmarks()
+	{
+		using namespace MauEng;
+
+		for (uint32_t const count : GetSettings().entityCounts)
+		{
+			ECS::ECSWorld world{};
+			auto const ids{ world.CreateEntities(count, ECS::Prototype{ CTransform{} }) };
+
+			ankerl::nanobench::Bench bench{};
+			bench.title(fmt::format("Add & remove components, {} entities", count))
+				.unit("entity")
+				.batch(count)
+				.epochs(5)
+				.relative(true);
+
+			// Every run leaves the world like it found it
+			bench.run("AddComponent + RemoveComponent", [&]
+				{
+					for (auto const id : ids)
+					{
+						world.AddComponent<CVelocity>(id, glm::vec3{ 1.f, 0.f, 0.f });
+					}
+					for (auto const id : ids)
+					{
+						world.RemoveComponent<CVelocity>(id);
+					}
+					ankerl::nanobench::doNotOptimizeAway(world.ComponentCount<CVelocity>());
+				});
+
+			for (auto const id : ids)
+			{
+				world.AddComponent<CVelocity>(id);
+			}
+
+			// Removing leaves holes in the pool, compacting closes them so iteration does not skip over tombstones
+			auto const removeHalf{ [&]
+				{
+					for (std::size_t i{ 0 }; i < ids.size(); i += 2)
+					{
+						world.RemoveComponent<CVelocity>(ids[i]);
+					}
+				} };
+			auto const addHalf{ [&]
+				{
+					for (std::size_t i{ 0 }; i < ids.size(); i += 2)
+					{
+						world.AddComponent<CVelocity>(ids[i]);
+					}
+				} };
+
+			bench.run("Remove half + add half", [&]
+				{
+					removeHalf();
+					addHalf();
+					ankerl::nanobench::doNotOptimizeAway(world.ComponentCount<CVelocity>());
+				});
+
+			bench.run("Remove half + Compact + add half", [&]
+				{
+					removeHalf();
+					world.Compact<CVelocity>();
+					addHalf();
+					ankerl::nanobench::doNotOptimizeAway(world.ComponentCount<CVelocity>());
+				});
+
+			Export(bench);
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#include <nanobench.h>
+#include <execution>
+
+#include "Benchmarks.h"
+
+#include "Memory/PageArena.h"
+
+#include "ECSWorld.h"
+#include "Entity.h"
+#include "Components/CTransform.h"
+
+namespace
+{
+	// Stand in for CStaticMesh, the real one needs a renderer to look up the mesh
+	struct CMesh final
+	{
+		uint32_t meshID{};
+	};
+}
+
+namespace MauBen
+{
+	void RunEntityCreationBenchmarks()
+	{
+		using namespace MauEng;
+
+		for (uint32_t const count : GetSettings().entityCounts)
+		{
+			ankerl::nanobench::Bench bench{};
+			bench.title(fmt::format("Create {} entities", count))
+				.unit("entity")
+				.batch(count)
+				.epochs(5)
+				.relative(true);
+
+			bench.run("CreateEntity loop", [count]
+				{
+					ECS::ECSWorld world{};
+					for (uint32_t i{ 0 }; i < count; ++i)
+					{
+						Entity entity{ world.CreateEntity() };
+						auto& transform{ entity.AddComponent<CTransform>() };
+						transform.Translate({ static_cast<float>(i), 0.f, 0.f });
+						entity.AddComponent<CMesh>(1u);
+					}
+					ankerl::nanobench::doNotOptimizeAway(world.ComponentCount<CMesh>());
+				});
+
+			ECS::Prototype const prototype{ CTransform{}, CMesh{ 1 } };
+
+			bench.run("CreateEntities prototype", [count, &prototype]
+				{
+					ECS::ECSWorld world{};
+					auto const ids{ world.CreateEntities(count, prototype) };
+					ankerl::nanobench::doNotOptimizeAway(ids.data());
+				});
+
+			bench.run("CreateEntities prototype, page arena", [count, &prototype]
+				{
+					MauCor::PageArena arena{};
+					ECS::ECSWorld world{ &arena };
+					auto const ids{ world.CreateEntities(count, prototype) };
+					ankerl::nanobench::doNotOptimizeAway(ids.data());
+				});
+
+			bench.run("CreateEntities prototype + init", [count, &prototype]
+				{
+					ECS::ECSWorld world{};
+					auto const ids{ world.CreateEntities(count, prototype, [](uint32_t idx, CTransform& transform, CMesh&)
+						{
+							transform.Translate({ static_cast<float>(idx), 0.f, 0.f });
+						}) };
+					ankerl::nanobench::doNotOptimizeAway(ids.data());
+				});
+
+			bench.run("CreateEntities prototype + parallel init", [count, &prototype]
+				{
+					ECS::ECSWorld world{};
+					auto const ids{ world.CreateEntities(count, prototype, [](uint32_t idx, CTransform& transform, CMesh&)
+						{
+							transform.Translate({ static_cast<float>(idx), 0.f, 0.f });
+						}, std::execution::par_unseq) };
+					ankerl::nanobench::doNotOptimizeAway(ids.data());
+				});
+
+			// Destroying needs a filled world, compare with "CreateEntities prototype" for the cost of destroying
+			bench.run("CreateEntities prototype + DestroyEntity loop", [count, &prototype]
+				{
+					ECS::ECSWorld world{};
+					auto const ids{ world.CreateEntities(count, prototype) };
+					for (auto const id : ids)
+					{
+						world.DestroyEntity(id);
+					}
+					ankerl::nanobench::doNotOptimizeAway(world.ComponentCount<CMesh>());
+				});
+
+			Export(bench);
+		}
+	}
+}
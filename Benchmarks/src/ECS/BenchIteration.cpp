@@ -0,0 +1,93 @@
+#include <nanobench.h>
+#include <execution>
+
+#include "Benchmarks.h"
+
+#include "ECSWorld.h"
+#include "Components/CTransform.h"
+
+namespace
+{
+	struct CVelocity final
+	{
+		glm::vec3 velocity{};
+	};
+
+	float constexpr DELTA_TIME{ 1.f / 60.f };
+
+	void FillWorld(MauEng::ECS::ECSWorld& world, uint32_t count)
+	{
+		using namespace MauEng;
+
+		// As many static entities, the transform pool holds entities the views & groups don't visit
+		static_cast<void>(world.CreateEntities(count, ECS::Prototype{ CTransform{}, CVelocity{ glm::vec3{ 1.f, 0.f, 0.f } } }));
+		static_cast<void>(world.CreateEntities(count, ECS::Prototype{ CTransform{} }));
+	}
+
+	void Move(MauEng::CTransform& transform, CVelocity const& velocity) noexcept
+	{
+		transform.translation += velocity.velocity * DELTA_TIME;
+	}
+}
+
+namespace MauBen
+{
+	void RunIterationBenchmarks()
+	{
+		using namespace MauEng;
+
+		for (uint32_t const count : GetSettings().entityCounts)
+		{
+			// Owning the components reorders the pools, so the owning group gets a world of its own
+			ECS::ECSWorld world{};
+			FillWorld(world, count);
+
+			ECS::ECSWorld ownedWorld{};
+			FillWorld(ownedWorld, count);
+
+			auto const view{ world.View<CTransform, CVelocity>() };
+			auto const group{ world.Group<>(ECS::GetType<CTransform, CVelocity>{}) };
+			auto const ownedGroup{ ownedWorld.Group<CTransform, CVelocity>() };
+
+			ankerl::nanobench::Bench iterate{};
+			iterate.title(fmt::format("Iterate {} moving entities", count))
+				.unit("entity")
+				.batch(count)
+				.relative(true);
+
+			iterate.run("View", [&view] { view.Each(Move); });
+			iterate.run("Group", [&group] { group.Each(Move); });
+			iterate.run("Owned group", [&ownedGroup] { ownedGroup.Each(Move); });
+
+			iterate.run("View, unseq", [&view] { view.Each(Move, std::execution::unseq); });
+			iterate.run("View, par", [&view] { view.Each(Move, std::execution::par); });
+			iterate.run("View, par_unseq", [&view] { view.Each(Move, std::execution::par_unseq); });
+
+			iterate.run("Owned group, unseq", [&ownedGroup] { ownedGroup.Each(Move, std::execution::unseq); });
+			iterate.run("Owned group, par", [&ownedGroup] { ownedGroup.Each(Move, std::execution::par); });
+			iterate.run("Owned group, par_unseq", [&ownedGroup] { ownedGroup.Each(Move, std::execution::par_unseq); });
+
+			Export(iterate);
+
+			// What a frame does to every moving entity, translate & rebuild the matrix
+			auto const update{ [](CTransform& transform, CVelocity const& velocity)
+				{
+					transform.Translate(velocity.velocity * DELTA_TIME);
+					transform.UpdateMatrix();
+				} };
+
+			ankerl::nanobench::Bench transforms{};
+			transforms.title(fmt::format("Transform update, {} moving entities", count))
+				.unit("entity")
+				.batch(count)
+				.relative(true);
+
+			transforms.run("View", [&] { view.Each(update); });
+			transforms.run("View, par_unseq", [&] { view.Each(update, std::execution::par_unseq); });
+			transforms.run("Owned group", [&] { ownedGroup.Each(update); });
+			transforms.run("Owned group, par_unseq", [&] { ownedGroup.Each(update, std::execution::par_unseq); });
+
+			Export(transforms);
+		}
+	}
+}
@@ -0,0 +1,108 @@
+#include <nanobench.h>
+#include <random>
+
+#include "Benchmarks.h"
+
+#include "ECSWorld.h"
+
+namespace
+{
+	// Stand in for CStaticMesh, the real one needs a renderer to look up the mesh
+	struct CMesh final
+	{
+		uint32_t meshID{};
+	};
+
+	struct CDepth final
+	{
+		float depth{};
+	};
+}
+
+namespace MauBen
+{
+	void RunSortBenchmarks()
+	{
+		using namespace MauEng;
+
+		for (uint32_t const count : GetSettings().entityCounts)
+		{
+			std::mt19937 rng{ count };
+			std::vector<uint32_t> meshIDs(count);
+			std::vector<float> depths(count);
+			for (uint32_t i{ 0 }; i < count; ++i)
+			{
+				meshIDs[i] = rng() % 512;
+				depths[i] = std::uniform_real_distribution<float>{ 0.1f, 1'000.f }(rng);
+			}
+
+			ECS::ECSWorld world{};
+			static_cast<void>(world.CreateEntities(count, ECS::Prototype{ CMesh{}, CDepth{} }));
+
+			// Every run starts from other keys so the pool is unsorted again, this is part of the measured time
+			uint32_t offset{ 0 };
+			auto const shuffleKeys{ [&]
+				{
+					offset = (offset + 7'919) % count;
+
+					uint32_t idx{ offset };
+					world.View<CMesh, CDepth>().Each([&](CMesh& mesh, CDepth& depth)
+						{
+							mesh.meshID = meshIDs[idx];
+							depth.depth = depths[idx];
+							idx = (idx + 1 == count) ? 0 : idx + 1;
+						});
+				} };
+
+			ankerl::nanobench::Bench bench{};
+			bench.title(fmt::format("Sort {} components", count))
+				.unit("component")
+				.batch(count)
+				.epochs(5)
+				.relative(true);
+
+			bench.run("Shuffle keys only", [&]
+				{
+					shuffleKeys();
+				});
+
+			bench.run("Sort by mesh id, std_sort", [&]
+				{
+					shuffleKeys();
+					world.Sort<CMesh>([](CMesh const& lhs, CMesh const& rhs) { return lhs.meshID < rhs.meshID; });
+				});
+
+			bench.run("Sort by mesh id, ParallelSort", [&]
+				{
+					shuffleKeys();
+					world.Sort<CMesh>([](CMesh const& lhs, CMesh const& rhs) { return lhs.meshID < rhs.meshID; }, ECS::ParallelSort{});
+				});
+
+			bench.run("Sort by mesh id, RadixSort", [&]
+				{
+					shuffleKeys();
+					world.SortByKey<CMesh>([](CMesh const& mesh) { return mesh.meshID; });
+				});
+
+			bench.run("Sort back to front, std_sort", [&]
+				{
+					shuffleKeys();
+					world.Sort<CDepth>([](CDepth const& lhs, CDepth const& rhs) { return lhs.depth > rhs.depth; });
+				});
+
+			bench.run("Sort back to front, ParallelSort", [&]
+				{
+					shuffleKeys();
+					world.Sort<CDepth>([](CDepth const& lhs, CDepth const& rhs) { return lhs.depth > rhs.depth; }, ECS::ParallelSort{});
+				});
+
+			bench.run("Sort back to front, RadixSort", [&]
+				{
+					shuffleKeys();
+					world.SortByKey<CDepth>([](CDepth const& depth) { return ~ECS::OrderedKey(depth.depth); });
+				});
+
+			Export(bench);
+		}
+	}
+}
@@ -0,0 +1,111 @@
+#include <nanobench.h>
+#include <execution>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Benchmarks.h"
+
+#include "ECSWorld.h"
+#include "Components/CTransform.h"
+#include "Spatial/SpatialHashGrid.h"
+
+namespace
+{
+	// Spread over a 400m cube, small entities a few meters apart
+	float constexpr WORLD_HALF_SIZE{ 200.f };
+	float constexpr CELL_SIZE{ 4.f };
+
+	void FillWorld(MauEng::ECS::ECSWorld& world, uint32_t count)
+	{
+		using namespace MauEng;
+
+		ECS::Prototype const prototype{ CTransform{} };
+
+		static_cast<void>(world.CreateEntities(count, prototype, [](uint32_t idx, CTransform& transform)
+			{
+				std::minstd_rand gen{ idx };
+				std::uniform_real_distribution<float> dis{ -WORLD_HALF_SIZE, WORLD_HALF_SIZE };
+
+				transform.Translate({ dis(gen), dis(gen), dis(gen) });
+			}, std::execution::par_unseq));
+	}
+}
+
+namespace MauBen
+{
+	void RunSpatialHashGridBenchmarks()
+	{
+		using namespace MauEng;
+
+		for (uint32_t const count : { 100'000u, 1'000'000u })
+		{
+			ECS::ECSWorld world{};
+			FillWorld(world, count);
+
+			std::vector<glm::vec3> positions{};
+			std::vector<ECS::EntityID> entities{};
+			world.View<CTransform>().Each([&](ECS::EntityID id, CTransform const& transform)
+				{
+					positions.emplace_back(transform.translation);
+					entities.emplace_back(id);
+				});
+
+			SpatialHashGrid grid{ CELL_SIZE };
+
+			// The grid is meant to be rebuilt every frame, this has to stay within a few ms for 1M points
+			ankerl::nanobench::Bench rebuild{};
+			rebuild.title(fmt::format("Spatial hash grid rebuild, {} entities", count))
+				.unit("frame")
+				.minEpochIterations(10);
+
+			rebuild.run("Rebuild from points", [&]
+				{
+					grid.Rebuild(positions, entities);
+					ankerl::nanobench::doNotOptimizeAway(grid.EntityCount());
+				});
+
+			rebuild.run("Rebuild from the world", [&]
+				{
+					grid.Rebuild(world);
+					ankerl::nanobench::doNotOptimizeAway(grid.EntityCount());
+				});
+
+			std::minstd_rand gen{ 1 };
+			std::uniform_real_distribution<float> dis{ -WORLD_HALF_SIZE, WORLD_HALF_SIZE };
+			std::vector<ECS::EntityID> results{};
+
+			ankerl::nanobench::Bench query{};
+			query.title(fmt::format("Spatial hash grid queries, {} entities", count))
+				.unit("query");
+
+			query.run("Neighbors (27 cells)", [&]
+				{
+					results.clear();
+					grid.QueryNeighbors({ dis(gen), dis(gen), dis(gen) }, results);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			query.run("Radius (r = 10)", [&]
+				{
+					results.clear();
+					grid.QueryRadius({ dis(gen), dis(gen), dis(gen) }, 10.f, results);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			glm::mat4 const view{ glm::lookAt(glm::vec3{ 0.f }, glm::vec3{ 0.f, 0.f, -1.f }, glm::vec3{ 0.f, 1.f, 0.f }) };
+			glm::mat4 const proj{ glm::perspective(glm::radians(60.f), 16.f / 9.f, .1f, 300.f) };
+			auto const frustum{ MauCor::Frustum::FromMatrix(proj * view) };
+
+			query.run("Frustum", [&]
+				{
+					results.clear();
+					grid.QueryFrustum(frustum, 1.f, results);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			Export(rebuild);
+			Export(query);
+		}
+	}
+}
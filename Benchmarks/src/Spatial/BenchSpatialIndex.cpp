@@ -0,0 +1,154 @@
+#include <nanobench.h>
+#include <execution>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Benchmarks.h"
+
+#include "ECSWorld.h"
+#include "Components/CStaticMesh.h"
+#include "Components/CTransform.h"
+#include "Spatial/SpatialIndex.h"
+
+namespace
+{
+	// Spread over a 2km cube, roughly the density of the spider test scene
+	float constexpr WORLD_HALF_SIZE{ 1'000.f };
+
+	void FillWorld(MauEng::ECS::ECSWorld& world, uint32_t count)
+	{
+		using namespace MauEng;
+
+		ECS::Prototype const prototype{ CTransform{}, CStaticMesh{ 0u, MauCor::AABB{ glm::vec3{ -1.f }, glm::vec3{ 1.f } } } };
+
+		static_cast<void>(world.CreateEntities(count, prototype, [](uint32_t idx, CTransform& transform, CStaticMesh&)
+			{
+				std::minstd_rand gen{ idx };
+				std::uniform_real_distribution<float> dis{ -WORLD_HALF_SIZE, WORLD_HALF_SIZE };
+
+				transform.Translate({ dis(gen), dis(gen), dis(gen) });
+			}, std::execution::par_unseq));
+	}
+
+	[[nodiscard]] MauCor::Frustum CameraFrustum()
+	{
+		glm::mat4 const view{ glm::lookAt(glm::vec3{ 0.f }, glm::vec3{ 0.f, 0.f, -1.f }, glm::vec3{ 0.f, 1.f, 0.f }) };
+		glm::mat4 const proj{ glm::perspective(glm::radians(60.f), 16.f / 9.f, .1f, 300.f) };
+
+		return MauCor::Frustum::FromMatrix(proj * view);
+	}
+}
+
+namespace MauBen
+{
+	void RunSpatialIndexBenchmarks()
+	{
+		using namespace MauEng;
+
+		for (uint32_t const count : { 100'000u, 1'000'000u })
+		{
+			ECS::ECSWorld world{};
+			FillWorld(world, count);
+
+			ankerl::nanobench::Bench build{};
+			build.title(fmt::format("Spatial index build, {} entities", count))
+				.unit("entity")
+				.batch(count)
+				.epochs(5);
+
+			build.run("Initial update (bulk build)", [&world]
+				{
+					SpatialIndex index{};
+					index.Update(world);
+					ankerl::nanobench::doNotOptimizeAway(index.EntityCount());
+				});
+
+			SpatialIndex index{};
+			index.Update(world);
+
+			auto const frustum{ CameraFrustum() };
+			std::vector<ECS::EntityID> results{};
+
+			ankerl::nanobench::Bench query{};
+			query.title(fmt::format("Spatial queries, {} entities", count))
+				.unit("query")
+				.relative(true);
+
+			query.run("Frustum - scan all entities", [&]
+				{
+					results.clear();
+					world.View<CTransform, CStaticMesh>().Each([&](ECS::EntityID id, CTransform const& t, CStaticMesh const& m)
+						{
+							if (frustum.Overlaps(m.localBounds.Transformed(t.mat)))
+							{
+								results.emplace_back(id);
+							}
+						});
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			query.run("Frustum - spatial index", [&]
+				{
+					results.clear();
+					index.QueryFrustum(frustum, results);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			std::minstd_rand gen{ 1 };
+			std::uniform_real_distribution<float> dis{ -WORLD_HALF_SIZE, WORLD_HALF_SIZE };
+
+			query.run("Sphere (r = 25)", [&]
+				{
+					results.clear();
+					index.QuerySphere({ glm::vec3{ dis(gen), dis(gen), dis(gen) }, 25.f }, results);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			query.run("AABB (50 x 50 x 50)", [&]
+				{
+					results.clear();
+					glm::vec3 const center{ dis(gen), dis(gen), dis(gen) };
+					index.QueryAABB({ center - glm::vec3{ 25.f }, center + glm::vec3{ 25.f } }, results);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+
+			query.run("Ray cast (closest hit)", [&]
+				{
+					glm::vec3 const origin{ dis(gen), dis(gen), dis(gen) };
+					auto const hit{ index.RayCast({ origin, glm::normalize(glm::vec3{ dis(gen), dis(gen), dis(gen) } - origin) }, 2'000.f) };
+					ankerl::nanobench::doNotOptimizeAway(hit);
+				});
+
+			Export(build);
+			Export(query);
+
+			// Update cost when a part of the entities moves every frame
+			ankerl::nanobench::Bench update{};
+			update.title(fmt::format("Spatial index update, {} entities", count))
+				.unit("frame");
+
+			for (uint32_t const movedPercentage : { 1u, 10u })
+			{
+				uint32_t const moved{ count / 100 * movedPercentage };
+
+				update.run(fmt::format("{}% moved", movedPercentage), [&]
+					{
+						uint32_t idx{ 0 };
+						world.View<CTransform>().Each([&idx, moved](CTransform& transform)
+							{
+								if (idx++ < moved)
+								{
+									transform.Translate({ .5f, 0.f, 0.f });
+								}
+							});
+
+						index.Update(world);
+						ankerl::nanobench::doNotOptimizeAway(index.EntityCount());
+					});
+			}
+
+			Export(update);
+		}
+	}
+}
@@ -24,13 +24,20 @@ set(CMAKE_POSITION_INDEPENDENT_CODE ON)
 set_property(GLOBAL PROPERTY USE_FOLDERS ON)
 
 option(MAUENG_ENABLE_TESTS "Enable Tests" ON)
+option(MAUENG_ENABLE_BENCHMARKS "Enable Benchmarks" OFF)
+option(MAUENG_ENABLE_TOOLS "Enable Tools (e.g the binary log decoder)" ON)
 
 option(MAUENG_ENABLE_DEBUG_RENDERING "Enable debug rendering" ON)
 option(MAUENG_LOG_TO_FILE "Log to file" OFF)
 option(MAUENG_ENABLE_ASSERTS "Enable asserts" ON)
 
+# Logs below this priority are compiled out (Trace, Info, Debug, Warn, Error or Fatal), empty picks Warn for release & Trace for debug builds
+set(MAUENG_MIN_LOG_PRIORITY "" CACHE STRING "Minimum log priority that is compiled in")
+set_property(CACHE MAUENG_MIN_LOG_PRIORITY PROPERTY STRINGS "" Trace Info Debug Warn Error Fatal)
+
 option(MAUENG_ENABLE_PROFILER "Enable profiling" ON)
 option(MAUENG_USE_OPTICK "Use Optick instead of custom profiler" ON)
+option(MAUENG_ENABLE_MEMORY_TRACKING "Count heap allocations per memory tag (replaces the global operator new)" OFF)
 
 # set(MAUENG_ENABLE_DEBUG_RENDERING ${MAUENG_ENABLE_DEBUG_RENDERING} CACHE BOOL "Enable debug rendering")
 # set(MAUENG_LOG_TO_FILE ${MAUENG_LOG_TO_FILE} CACHE BOOL "Log to file")
@@ -45,8 +52,10 @@ message(STATUS "ENABLE TESTS: ${MAUENG_ENABLE_TESTS}")
 message(STATUS "Debug config: ")
 message(STATUS "MAUENG_ENABLE_DEBUG_RENDERING: ${MAUENG_ENABLE_DEBUG_RENDERING}")
 message(STATUS "MAUENG_LOG_TO_FILE: ${MAUENG_LOG_TO_FILE}")
-message(STATUS "MAUENG_ENABLE_ASSERTS: ${MAUENG_ENABLE_ASSERTS} \n")
+message(STATUS "MAUENG_ENABLE_ASSERTS: ${MAUENG_ENABLE_ASSERTS}")
+message(STATUS "MAUENG_MIN_LOG_PRIORITY: ${MAUENG_MIN_LOG_PRIORITY} \n")
 
 message(STATUS "Profiling config: ")
 message(STATUS "MAUENG_ENABLE_PROFILER: ${MAUENG_ENABLE_PROFILER}")
-message(STATUS "MAUENG_USE_OPTICK: ${MAUENG_USE_OPTICK} \n")
\ No newline at end of file
+message(STATUS "MAUENG_USE_OPTICK: ${MAUENG_USE_OPTICK}")
+message(STATUS "MAUENG_ENABLE_MEMORY_TRACKING: ${MAUENG_ENABLE_MEMORY_TRACKING} \n")
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Profiling/NullProfiler.h"
 #include "Profiling/OptickProfiler.h"
 #include "Profiling/GoogleProfiler.h"
+#include "Profiling/TraceProfiler.h"
 
 namespace MauCor
 {
@@ -14,7 +15,7 @@ namespace MauCor
 	#if USE_OPTICK
 		std::unique_ptr<Profiler> CoreServiceLocator::m_pProfiler{ std::make_unique<OptickProfiler>() };
 	#else
-		std::unique_ptr<Profiler> CoreServiceLocator::m_pProfiler{ std::make_unique<GoogleProfiler>() };
+		std::unique_ptr<Profiler> CoreServiceLocator::m_pProfiler{ MauEng::USE_TRACE_PROFILER ? std::unique_ptr<Profiler>{ std::make_unique<TraceProfiler>() } : std::make_unique<GoogleProfiler>() };
 	#endif
 #else
 	std::unique_ptr<Profiler> CoreServiceLocator::m_pProfiler{ std::make_unique<NullProfiler>() };
@@ -0,0 +1,135 @@
+#include "CorePCH.h"
+
+#include "IO/MappedFile.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace MauCor
+{
+	MappedFile::MappedFile(std::filesystem::path const& path)
+	{
+#ifdef _WIN32
+		HANDLE const file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+		if (INVALID_HANDLE_VALUE == file)
+		{
+			return;
+		}
+		m_FileHandle = file;
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(file, &size) || 0 == size.QuadPart)
+		{
+			Close();
+			return;
+		}
+
+		m_MappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_MappingHandle)
+		{
+			Close();
+			return;
+		}
+
+		m_pData = static_cast<std::byte const*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		m_Size = m_pData ? static_cast<std::size_t>(size.QuadPart) : 0;
+#else
+		m_FileDescriptor = open(path.c_str(), O_RDONLY);
+		if (m_FileDescriptor < 0)
+		{
+			return;
+		}
+
+		struct stat info{};
+		if (fstat(m_FileDescriptor, &info) != 0 || 0 == info.st_size)
+		{
+			Close();
+			return;
+		}
+
+		void* const pData{ mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0) };
+		if (MAP_FAILED == pData)
+		{
+			Close();
+			return;
+		}
+
+		madvise(pData, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+
+		m_pData = static_cast<std::byte const*>(pData);
+		m_Size = static_cast<std::size_t>(info.st_size);
+#endif
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	void MappedFile::Close() noexcept
+	{
+#ifdef _WIN32
+		if (m_pData)
+		{
+			UnmapViewOfFile(m_pData);
+		}
+		if (m_MappingHandle)
+		{
+			CloseHandle(m_MappingHandle);
+		}
+		if (m_FileHandle)
+		{
+			CloseHandle(m_FileHandle);
+		}
+
+		m_MappingHandle = nullptr;
+		m_FileHandle = nullptr;
+#else
+		if (m_pData)
+		{
+			munmap(const_cast<std::byte*>(m_pData), m_Size);
+		}
+		if (m_FileDescriptor >= 0)
+		{
+			close(m_FileDescriptor);
+		}
+
+		m_FileDescriptor = -1;
+#endif
+		m_pData = nullptr;
+		m_Size = 0;
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		Close();
+
+		m_pData = std::exchange(other.m_pData, nullptr);
+		m_Size = std::exchange(other.m_Size, 0);
+#ifdef _WIN32
+		m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+		m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#else
+		m_FileDescriptor = std::exchange(other.m_FileDescriptor, -1);
+#endif
+		return *this;
+	}
+}
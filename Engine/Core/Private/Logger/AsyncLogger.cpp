@@ -0,0 +1,146 @@
+#include "CorePCH.h"
+
+#include "AsyncLogger.h"
+
+#include "Memory/MemoryTracker.h"
+
+namespace MauCor
+{
+	AsyncLogger::AsyncLogger(std::unique_ptr<Logger>&& pSink, AsyncLoggerSettings const& settings) :
+		m_pSink{ std::move(pSink) },
+		m_OverflowPolicy{ settings.overflowPolicy },
+		m_Queue{ settings.capacity },
+		m_WriterThread{ [this](std::stop_token const& stopToken) { WriterLoop(stopToken); } }
+	{
+	}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		// Wakes the writer through the stop token, it writes the rest of the queue before returning
+		m_WriterThread.request_stop();
+		m_WriterThread.join();
+	}
+
+	void AsyncLogger::Flush()
+	{
+		uint64_t const target{ m_Queue.PushCount() };
+
+		WakeWriter();
+
+		uint64_t written{ m_WrittenCount.load(std::memory_order_acquire) };
+		while (written < target)
+		{
+			m_WrittenCount.wait(written, std::memory_order_acquire);
+			written = m_WrittenCount.load(std::memory_order_acquire);
+		}
+	}
+
+	void AsyncLogger::Write(LogPriority priority, LogCategory category, fmt::string_view format, fmt::format_args args)
+	{
+		auto const time{ std::chrono::system_clock::now() };
+
+		auto const writeRecord{ [&](LogRecord& record)
+			{
+				auto const result{ fmt::vformat_to_n(record.message.data(), record.message.size(), format, args) };
+
+				if (result.size > record.message.size())
+				{
+					std::ranges::copy(TRUNCATION_MARK, record.message.end() - TRUNCATION_MARK.size());
+				}
+
+				record.time = time;
+				record.size = static_cast<uint32_t>(std::min<size_t>(result.size, record.message.size()));
+				record.priority = priority;
+				record.category = category;
+			} };
+
+		if (!m_Queue.TryPush(writeRecord))
+		{
+			WakeWriter();
+
+			if (m_OverflowPolicy != LogOverflowPolicy::Block && priority != LogPriority::Fatal)
+			{
+				if (m_OverflowPolicy == LogOverflowPolicy::Count)
+				{
+					m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				return;
+			}
+
+			while (!m_Queue.TryPush(writeRecord))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if (priority == LogPriority::Fatal)
+		{
+			Flush();
+		}
+		else if (priority >= LogPriority::Error || m_Queue.Size() > m_Queue.Capacity() / 2)
+		{
+			WakeWriter();
+		}
+	}
+
+	void AsyncLogger::LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message)
+	{
+		m_pSink->LogInternal(priority, category, time, message);
+	}
+
+	void AsyncLogger::WakeWriter()
+	{
+		// Taking the lock makes sure the writer is either writing or already waiting, it can't miss the notify
+		{
+			std::scoped_lock lock{ m_WakeMutex };
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	void AsyncLogger::WriterLoop(std::stop_token const& stopToken)
+	{
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
+
+		while (!stopToken.stop_requested())
+		{
+			{
+				std::unique_lock lock{ m_WakeMutex };
+				m_WakeCondition.wait_for(lock, stopToken, WRITE_INTERVAL, [this] { return !m_Queue.Empty(); });
+			}
+
+			WriteQueued();
+		}
+
+		// Everything logged before the logger was destroyed
+		WriteQueued();
+	}
+
+	void AsyncLogger::WriteQueued()
+	{
+		bool wrote{ false };
+
+		while (m_Queue.TryPop([this](LogRecord const& record)
+			{
+				m_pSink->LogInternal(record.priority, record.category, record.time, { record.message.data(), record.size });
+			}))
+		{
+			wrote = true;
+		}
+
+		if (uint64_t const dropped{ m_DroppedCount.exchange(0, std::memory_order_relaxed) }; dropped > 0)
+		{
+			m_pSink->LogInternal(LogPriority::Warn, LogCategory::Core, std::chrono::system_clock::now(), 
+				fmt::format("{} log messages were dropped, the log queue was full", dropped));
+			wrote = true;
+		}
+
+		if (wrote)
+		{
+			m_pSink->Flush();
+
+			m_WrittenCount.store(m_Queue.PopCount(), std::memory_order_release);
+			m_WrittenCount.notify_all();
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#ifndef MAUCOR_ASYNCLOGGER_H
+#define MAUCOR_ASYNCLOGGER_H
+
+#include "Logger/Logger.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+#include "Containers/MPSCQueue.h"
+
+namespace MauCor
+{
+	/*
+	 * Formats the message into a fixed size record in a lock-free queue & returns, nothing is locked or allocated.
+	 * A writer thread hands the records to the sink in batches (timestamps, colours, file IO) & flushes it after every batch.
+	 * It wakes up every WRITE_INTERVAL, or right away for errors & when the queue is filling up.
+	 * Fatal messages are always queued & wait until they are written, the process is usually about to go down.
+	 */
+	class AsyncLogger final : public Logger
+	{
+	public:
+		AsyncLogger(std::unique_ptr<Logger>&& pSink, AsyncLoggerSettings const& settings);
+		// Writes whatever is still queued
+		virtual ~AsyncLogger() override;
+
+		// Waits until everything logged before the call is written & flushed by the sink
+		virtual void Flush() override;
+
+		AsyncLogger(AsyncLogger const&) = delete;
+		AsyncLogger(AsyncLogger&&) = delete;
+		AsyncLogger& operator=(AsyncLogger const&) = delete;
+		AsyncLogger& operator=(AsyncLogger&&) = delete;
+
+	private:
+		// Longer messages are cut off, the record fills a 512 byte queue slot
+		static uint32_t constexpr MAX_MESSAGE_SIZE{ 480 };
+		static constexpr std::string_view TRUNCATION_MARK{ "..." };
+		static constexpr std::chrono::milliseconds WRITE_INTERVAL{ 50 };
+
+		struct LogRecord final
+		{
+			std::chrono::system_clock::time_point time{};
+			uint32_t size{ 0 };
+			LogPriority priority{ LogPriority::Trace };
+			LogCategory category{ LogCategory::Core };
+			std::array<char, MAX_MESSAGE_SIZE> message{};
+		};
+
+		std::unique_ptr<Logger> m_pSink;
+		LogOverflowPolicy const m_OverflowPolicy;
+
+		MPSCQueue<LogRecord> m_Queue;
+		// Messages lost since the last batch (LogOverflowPolicy::Count)
+		std::atomic<uint64_t> m_DroppedCount{ 0 };
+		// Queue positions the sink has written & flushed, Flush waits on this
+		std::atomic<uint64_t> m_WrittenCount{ 0 };
+
+		std::mutex m_WakeMutex{};
+		std::condition_variable_any m_WakeCondition{};
+
+		// Last, it is started once everything it uses exists
+		std::jthread m_WriterThread;
+
+		virtual void Write(LogPriority priority, LogCategory category, fmt::string_view format, fmt::format_args args) override;
+		// Not used by Log, goes straight to the sink
+		virtual void LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message) override;
+
+		void WakeWriter();
+		void WriterLoop(std::stop_token const& stopToken);
+		// Hands everything in the queue to the sink, writer thread only
+		void WriteQueued();
+	};
+}
+
+#endif
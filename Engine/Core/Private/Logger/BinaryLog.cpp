@@ -0,0 +1,286 @@
+#include "CorePCH.h"
+
+#include "Logger/BinaryLog.h"
+
+#include <mutex>
+
+namespace MauCor
+{
+	namespace
+	{
+		struct SiteTable final
+		{
+			std::mutex mutex{};
+			std::vector<BinaryLogSite> sites{};
+		};
+
+		// Sites can register during static initialization, so the table is made on first use
+		[[nodiscard]] SiteTable& GetSiteTable()
+		{
+			static SiteTable table{};
+			return table;
+		}
+
+		template<typename Stored>
+		[[nodiscard]] bool ReadArg(std::span<std::byte const> bytes, size_t& offset, Stored& value) noexcept
+		{
+			if (offset + sizeof(Stored) > bytes.size())
+			{
+				return false;
+			}
+
+			std::memcpy(&value, bytes.data() + offset, sizeof(Stored));
+			offset += sizeof(Stored);
+			return true;
+		}
+
+		template<typename Stored>
+		[[nodiscard]] bool PushArg(fmt::dynamic_format_arg_store<fmt::format_context>& store, std::span<std::byte const> bytes, size_t& offset)
+		{
+			Stored value{};
+			if (!ReadArg(bytes, offset, value))
+			{
+				return false;
+			}
+
+			store.push_back(value);
+			return true;
+		}
+
+		template<typename T>
+		[[nodiscard]] bool Read(std::istream& stream, T& value)
+		{
+			stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+			return static_cast<bool>(stream);
+		}
+
+		// A cut off or corrupt file shouldn't make us allocate gigabytes
+		uint32_t constexpr MAX_RECORD_SIZE{ 1 << 20 };
+
+		[[nodiscard]] bool ReadString(std::istream& stream, std::string& string)
+		{
+			uint32_t size{};
+			if (!Read(stream, size) || size > MAX_RECORD_SIZE)
+			{
+				return false;
+			}
+
+			string.resize(size);
+			stream.read(string.data(), size);
+			return static_cast<bool>(stream);
+		}
+
+		[[nodiscard]] bool ReadBytes(std::istream& stream, std::vector<std::byte>& bytes)
+		{
+			uint32_t size{};
+			if (!Read(stream, size) || size > MAX_RECORD_SIZE)
+			{
+				return false;
+			}
+
+			bytes.resize(size);
+			stream.read(reinterpret_cast<char*>(bytes.data()), size);
+			return static_cast<bool>(stream);
+		}
+
+		[[nodiscard]] std::chrono::system_clock::time_point ToTimePoint(int64_t nanoseconds) noexcept
+		{
+			return std::chrono::system_clock::time_point{ std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{ nanoseconds }) };
+		}
+	}
+
+	uint32_t RegisterBinaryLogSite(BinaryLogSite const& site)
+	{
+		auto& table{ GetSiteTable() };
+		std::scoped_lock lock{ table.mutex };
+
+		uint32_t const id{ static_cast<uint32_t>(table.sites.size()) };
+		table.sites.emplace_back(site).id = id;
+
+		return id;
+	}
+
+	std::vector<BinaryLogSite> GetBinaryLogSites(uint32_t first)
+	{
+		auto& table{ GetSiteTable() };
+		std::scoped_lock lock{ table.mutex };
+
+		if (first >= table.sites.size())
+		{
+			return {};
+		}
+
+		return { table.sites.begin() + first, table.sites.end() };
+	}
+
+	bool DecodeBinaryArgs(fmt::dynamic_format_arg_store<fmt::format_context>& store, std::span<BinaryArgType const> argTypes, std::span<std::byte const> bytes)
+	{
+		size_t offset{ 0 };
+
+		for (auto const type : argTypes)
+		{
+			bool isValid{ false };
+
+			switch (type)
+			{
+			case BinaryArgType::Bool:
+			{
+				uint8_t value{};
+				isValid = ReadArg(bytes, offset, value);
+				store.push_back(value != 0);
+				break;
+			}
+			case BinaryArgType::Char: isValid = PushArg<char>(store, bytes, offset); break;
+			case BinaryArgType::Int32: isValid = PushArg<int32_t>(store, bytes, offset); break;
+			case BinaryArgType::UInt32: isValid = PushArg<uint32_t>(store, bytes, offset); break;
+			case BinaryArgType::Int64: isValid = PushArg<int64_t>(store, bytes, offset); break;
+			case BinaryArgType::UInt64: isValid = PushArg<uint64_t>(store, bytes, offset); break;
+			case BinaryArgType::Float: isValid = PushArg<float>(store, bytes, offset); break;
+			case BinaryArgType::Double: isValid = PushArg<double>(store, bytes, offset); break;
+			case BinaryArgType::String:
+			{
+				uint32_t size{};
+				isValid = ReadArg(bytes, offset, size) && offset + size <= bytes.size();
+				if (isValid)
+				{
+					// The store keeps a copy, the bytes don't have to outlive it
+					store.push_back(std::string{ reinterpret_cast<char const*>(bytes.data() + offset), size });
+					offset += size;
+				}
+				break;
+			}
+			case BinaryArgType::Pointer:
+			{
+				uint64_t value{};
+				isValid = ReadArg(bytes, offset, value);
+				store.push_back(reinterpret_cast<void const*>(static_cast<uintptr_t>(value)));
+				break;
+			}
+			}
+
+			if (!isValid)
+			{
+				return false;
+			}
+		}
+
+		return offset == bytes.size();
+	}
+
+	std::string FormatBinaryLog(std::string_view format, std::span<BinaryArgType const> argTypes, std::span<std::byte const> bytes)
+	{
+		fmt::dynamic_format_arg_store<fmt::format_context> store{};
+		if (!DecodeBinaryArgs(store, argTypes, bytes))
+		{
+			throw fmt::format_error{ "binary log arguments don't match the site" };
+		}
+
+		return fmt::vformat(format, store);
+	}
+
+	BinaryLogReader::BinaryLogReader(std::istream& stream) :
+		m_Stream{ stream }
+	{
+		std::array<char, 4> magic{};
+		uint32_t version{};
+
+		m_IsValid = Read(m_Stream, magic) && Read(m_Stream, version) && magic == BINARY_LOG_MAGIC && version == BINARY_LOG_VERSION;
+	}
+
+	bool BinaryLogReader::Next(DecodedLogRecord& record)
+	{
+		BinaryLogRecordKind kind{};
+
+		while (m_IsValid && Read(m_Stream, kind))
+		{
+			switch (kind)
+			{
+			case BinaryLogRecordKind::Site:
+			{
+				m_IsValid = ReadSite();
+				break;
+			}
+			case BinaryLogRecordKind::Event:
+			{
+				uint32_t siteID{};
+				int64_t time{};
+
+				m_IsValid = Read(m_Stream, siteID) && Read(m_Stream, time) && ReadBytes(m_Stream, m_Bytes) && siteID < m_Sites.size();
+				if (!m_IsValid)
+				{
+					break;
+				}
+
+				auto const& site{ m_Sites[siteID] };
+				record.time = ToTimePoint(time);
+				record.priority = site.priority;
+				record.category = site.category;
+				record.file = site.file;
+				record.line = site.line;
+
+				try
+				{
+					record.message = FormatBinaryLog(site.format, site.argTypes, m_Bytes);
+				}
+				catch (fmt::format_error const& error)
+				{
+					// Keep going, one bad record shouldn't hide the rest of the log
+					record.message = fmt::format("<failed to decode \"{}\": {}>", site.format, error.what());
+				}
+
+				return true;
+			}
+			case BinaryLogRecordKind::Text:
+			{
+				int64_t time{};
+
+				m_IsValid = Read(m_Stream, record.priority) && Read(m_Stream, record.category) && Read(m_Stream, time) && ReadString(m_Stream, record.message);
+				if (!m_IsValid)
+				{
+					break;
+				}
+
+				record.time = ToTimePoint(time);
+				record.file.clear();
+				record.line = 0;
+
+				return true;
+			}
+			default:
+				m_IsValid = false;
+				break;
+			}
+		}
+
+		return false;
+	}
+
+	bool BinaryLogReader::ReadSite()
+	{
+		uint32_t id{};
+		StoredSite site{};
+		uint8_t argCount{};
+
+		if (!Read(m_Stream, id) || !Read(m_Stream, site.priority) || !Read(m_Stream, site.category) || !Read(m_Stream, site.line) || !Read(m_Stream, argCount)
+			|| id > MAX_RECORD_SIZE)
+		{
+			return false;
+		}
+
+		site.argTypes.resize(argCount);
+		m_Stream.read(reinterpret_cast<char*>(site.argTypes.data()), argCount);
+
+		if (!m_Stream || !ReadString(m_Stream, site.format) || !ReadString(m_Stream, site.file))
+		{
+			return false;
+		}
+
+		if (id >= m_Sites.size())
+		{
+			m_Sites.resize(id + 1);
+		}
+		m_Sites[id] = std::move(site);
+
+		return true;
+	}
+}
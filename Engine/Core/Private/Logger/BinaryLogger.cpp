@@ -0,0 +1,330 @@
+#include "CorePCH.h"
+
+#include "BinaryLogger.h"
+
+#include "Memory/MemoryTracker.h"
+
+namespace MauCor
+{
+	namespace
+	{
+		std::atomic<uint32_t> g_NextBinaryLoggerID{ 0 };
+
+		template<typename T>
+		void Put(std::vector<std::byte>& bytes, T const& value)
+		{
+			auto const* pValue{ reinterpret_cast<std::byte const*>(&value) };
+			bytes.insert(bytes.end(), pValue, pValue + sizeof(T));
+		}
+
+		void PutBytes(std::vector<std::byte>& bytes, std::span<std::byte const> data)
+		{
+			bytes.insert(bytes.end(), data.begin(), data.end());
+		}
+
+		void PutString(std::vector<std::byte>& bytes, std::string_view string)
+		{
+			Put(bytes, static_cast<uint32_t>(string.size()));
+			PutBytes(bytes, std::as_bytes(std::span{ string }));
+		}
+
+		[[nodiscard]] int64_t ToNanoseconds(std::chrono::system_clock::time_point time) noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+		}
+	}
+
+	BinaryLogger::ThreadBuffer::ThreadBuffer(std::thread::id owner) :
+		m_Owner{ owner },
+		m_pBytes{ std::make_unique_for_overwrite<std::byte[]>(THREAD_BUFFER_SIZE) }
+	{
+	}
+
+	bool BinaryLogger::ThreadBuffer::TryWrite(RecordHeader const& header, std::span<std::byte const> payload) noexcept
+	{
+		uint64_t const size{ sizeof(RecordHeader) + payload.size() };
+		uint64_t const position{ m_WritePosition.load(std::memory_order_relaxed) };
+
+		if (position + size - m_CachedReadPosition > THREAD_BUFFER_SIZE)
+		{
+			m_CachedReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+			if (position + size - m_CachedReadPosition > THREAD_BUFFER_SIZE)
+			{
+				return false;
+			}
+		}
+
+		CopyIn(position, &header, sizeof(RecordHeader));
+		CopyIn(position + sizeof(RecordHeader), payload.data(), payload.size());
+
+		m_WritePosition.store(position + size, std::memory_order_release);
+		return true;
+	}
+
+	template<typename ReadFunc>
+	void BinaryLogger::ThreadBuffer::ReadAll(ReadFunc&& read)
+	{
+		uint64_t position{ m_ReadPosition.load(std::memory_order_relaxed) };
+		uint64_t const end{ m_WritePosition.load(std::memory_order_acquire) };
+
+		while (position < end)
+		{
+			RecordHeader header;
+			CopyOut(position, &header, sizeof(RecordHeader));
+			position += sizeof(RecordHeader);
+
+			size_t const offset{ position & (THREAD_BUFFER_SIZE - 1) };
+			size_t const first{ std::min<size_t>(header.size, THREAD_BUFFER_SIZE - offset) };
+			read(header, std::span<std::byte const>{ m_pBytes.get() + offset, first }, std::span<std::byte const>{ m_pBytes.get(), header.size - first });
+
+			position += header.size;
+		}
+
+		m_ReadPosition.store(position, std::memory_order_release);
+	}
+
+	void BinaryLogger::ThreadBuffer::CopyIn(uint64_t position, void const* pSrc, size_t size) noexcept
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		size_t const offset{ position & (THREAD_BUFFER_SIZE - 1) };
+		size_t const first{ std::min<size_t>(size, THREAD_BUFFER_SIZE - offset) };
+
+		std::memcpy(m_pBytes.get() + offset, pSrc, first);
+		if (first < size)
+		{
+			std::memcpy(m_pBytes.get(), static_cast<std::byte const*>(pSrc) + first, size - first);
+		}
+	}
+
+	void BinaryLogger::ThreadBuffer::CopyOut(uint64_t position, void* pDst, size_t size) const noexcept
+	{
+		size_t const offset{ position & (THREAD_BUFFER_SIZE - 1) };
+		size_t const first{ std::min<size_t>(size, THREAD_BUFFER_SIZE - offset) };
+
+		std::memcpy(pDst, m_pBytes.get() + offset, first);
+		if (first < size)
+		{
+			std::memcpy(static_cast<std::byte*>(pDst) + first, m_pBytes.get(), size - first);
+		}
+	}
+
+	BinaryLogger::BinaryLogger(std::filesystem::path&& path) :
+		m_ID{ g_NextBinaryLoggerID.fetch_add(1, std::memory_order_relaxed) },
+		m_File{ path, std::ios::out | std::ios::binary | std::ios::trunc }
+	{
+		if (m_File.is_open())
+		{
+			m_File.write(BINARY_LOG_MAGIC.data(), BINARY_LOG_MAGIC.size());
+			m_File.write(reinterpret_cast<char const*>(&BINARY_LOG_VERSION), sizeof(BINARY_LOG_VERSION));
+		}
+		else
+		{
+			std::cerr << "Error opening log file: " << path.string() << std::endl;
+		}
+
+		// After the header, the writer appends to the file
+		m_WriterThread = std::jthread{ [this](std::stop_token const& stopToken) { WriterLoop(stopToken); } };
+	}
+
+	BinaryLogger::~BinaryLogger()
+	{
+		m_WriterThread.request_stop();
+		m_WriterThread.join();
+	}
+
+	void BinaryLogger::Flush()
+	{
+		uint64_t const target{ m_FlushRequestCount.fetch_add(1) + 1 };
+
+		WakeWriter();
+
+		uint64_t flushed{ m_FlushedCount.load(std::memory_order_acquire) };
+		while (flushed < target)
+		{
+			m_FlushedCount.wait(flushed, std::memory_order_acquire);
+			flushed = m_FlushedCount.load(std::memory_order_acquire);
+		}
+	}
+
+	void BinaryLogger::Write(LogPriority priority, LogCategory category, fmt::string_view format, fmt::format_args args)
+	{
+		auto const time{ std::chrono::system_clock::now() };
+
+		fmt::memory_buffer message{};
+		fmt::vformat_to(std::back_inserter(message), format, args);
+
+		PushText(priority, category, time, { message.data(), message.size() });
+	}
+
+	void BinaryLogger::WriteBinary(BinaryLogSite const& site, std::span<std::byte const> args)
+	{
+		RecordHeader const header{ ToNanoseconds(std::chrono::system_clock::now()), site.id, static_cast<uint32_t>(args.size()), BinaryLogRecordKind::Event, site.priority, site.category };
+		Push(header, args);
+	}
+
+	void BinaryLogger::LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message)
+	{
+		PushText(priority, category, time, message);
+	}
+
+	BinaryLogger::ThreadBuffer& BinaryLogger::GetThreadBuffer()
+	{
+		// Usually there is one logger, remember the buffer this thread used last
+		thread_local struct
+		{
+			uint32_t loggerID{ UINT32_MAX };
+			ThreadBuffer* pBuffer{ nullptr };
+		} cache{};
+
+		if (cache.loggerID == m_ID)
+		{
+			return *cache.pBuffer;
+		}
+
+		std::scoped_lock lock{ m_BuffersMutex };
+
+		// A thread that logged here before (e.g to another logger in between) keeps its buffer, so its records stay in order
+		auto const owner{ std::this_thread::get_id() };
+		auto it{ std::ranges::find_if(m_ThreadBuffers, [owner](auto const& pBuffer) { return pBuffer->GetOwner() == owner; }) };
+		if (it == m_ThreadBuffers.end())
+		{
+			MemoryTagScope const memoryTag{ MemoryTag::Logger };
+			it = m_ThreadBuffers.emplace(m_ThreadBuffers.end(), std::make_unique<ThreadBuffer>(owner));
+		}
+
+		cache = { m_ID, it->get() };
+		return **it;
+	}
+
+	void BinaryLogger::Push(RecordHeader const& header, std::span<std::byte const> payload)
+	{
+		if (!GetThreadBuffer().TryWrite(header, payload))
+		{
+			m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+			WakeWriter();
+			return;
+		}
+
+		if (header.priority == LogPriority::Fatal)
+		{
+			// The process is usually about to go down
+			Flush();
+		}
+		else if (header.priority >= LogPriority::Error)
+		{
+			m_IsWakeRequested.store(true, std::memory_order_relaxed);
+			m_WakeCondition.notify_one();
+		}
+	}
+
+	void BinaryLogger::PushText(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message)
+	{
+		message = message.substr(0, MAX_TEXT_SIZE);
+
+		RecordHeader const header{ ToNanoseconds(time), 0, static_cast<uint32_t>(message.size()), BinaryLogRecordKind::Text, priority, category };
+		Push(header, std::as_bytes(std::span{ message }));
+	}
+
+	void BinaryLogger::WakeWriter()
+	{
+		m_IsWakeRequested.store(true, std::memory_order_relaxed);
+
+		// Taking the lock makes sure the writer is either writing or already waiting, it can't miss the notify
+		{
+			std::scoped_lock lock{ m_WakeMutex };
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	void BinaryLogger::WriterLoop(std::stop_token const& stopToken)
+	{
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
+
+		while (!stopToken.stop_requested())
+		{
+			{
+				std::unique_lock lock{ m_WakeMutex };
+				m_WakeCondition.wait_for(lock, stopToken, WRITE_INTERVAL, [this] { return m_IsWakeRequested.exchange(false, std::memory_order_relaxed); });
+			}
+
+			// Requests made before the pass are covered by it
+			uint64_t const flushRequestCount{ m_FlushRequestCount.load(std::memory_order_acquire) };
+
+			WriteBuffered();
+
+			m_FlushedCount.store(flushRequestCount, std::memory_order_release);
+			m_FlushedCount.notify_all();
+		}
+
+		// Everything logged before the logger was destroyed
+		WriteBuffered();
+	}
+
+	void BinaryLogger::WriteBuffered()
+	{
+		m_Records.clear();
+
+		{
+			std::scoped_lock lock{ m_BuffersMutex };
+			for (auto const& pBuffer : m_ThreadBuffers)
+			{
+				pBuffer->ReadAll([this](RecordHeader const& header, std::span<std::byte const> first, std::span<std::byte const> second)
+					{
+						Put(m_Records, header.kind);
+						if (header.kind == BinaryLogRecordKind::Event)
+						{
+							Put(m_Records, header.siteID);
+						}
+						else
+						{
+							Put(m_Records, header.priority);
+							Put(m_Records, header.category);
+						}
+						Put(m_Records, header.time);
+						Put(m_Records, header.size);
+						PutBytes(m_Records, first);
+						PutBytes(m_Records, second);
+					});
+			}
+		}
+
+		if (uint64_t const dropped{ m_DroppedCount.exchange(0, std::memory_order_relaxed) }; dropped > 0)
+		{
+			Put(m_Records, BinaryLogRecordKind::Text);
+			Put(m_Records, LogPriority::Warn);
+			Put(m_Records, LogCategory::Core);
+			Put(m_Records, ToNanoseconds(std::chrono::system_clock::now()));
+			PutString(m_Records, fmt::format("{} log messages were dropped, a thread's log buffer was full", dropped));
+		}
+
+		// A site is registered before its first record is written, so the sites of these records are in the table
+		m_Sites.clear();
+		auto const sites{ GetBinaryLogSites(m_WrittenSiteCount) };
+		for (auto const& site : sites)
+		{
+			Put(m_Sites, BinaryLogRecordKind::Site);
+			Put(m_Sites, site.id);
+			Put(m_Sites, site.priority);
+			Put(m_Sites, site.category);
+			Put(m_Sites, site.line);
+			Put(m_Sites, static_cast<uint8_t>(site.argTypes.size()));
+			PutBytes(m_Sites, std::as_bytes(site.argTypes));
+			PutString(m_Sites, site.format);
+			PutString(m_Sites, site.file);
+		}
+		m_WrittenSiteCount += static_cast<uint32_t>(sites.size());
+
+		if (m_Sites.empty() && m_Records.empty())
+		{
+			return;
+		}
+
+		m_File.write(reinterpret_cast<char const*>(m_Sites.data()), static_cast<std::streamsize>(m_Sites.size()));
+		m_File.write(reinterpret_cast<char const*>(m_Records.data()), static_cast<std::streamsize>(m_Records.size()));
+		m_File.flush();
+	}
+}
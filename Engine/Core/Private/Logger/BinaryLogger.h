@@ -0,0 +1,128 @@
+#ifndef MAUCOR_BINARYLOGGER_H
+#define MAUCOR_BINARYLOGGER_H
+
+#include "Logger/Logger.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace MauCor
+{
+	/*
+	 * Writes a binary log (layout in BinaryLog.h), decode it with MauEngLogDecoder.
+	 * Every logging thread gets its own ring buffer, a call copies the site id, a timestamp & the encoded arguments into it.
+	 * Text logs (ME_LOG) are formatted on the caller & stored as is. No lock is taken after a thread's first log.
+	 * A writer thread moves the records to the file every WRITE_INTERVAL, together with the sites it hasn't stored yet.
+	 * A full thread buffer drops the record, the writer logs how many were dropped.
+	 */
+	class BinaryLogger final : public Logger
+	{
+	public:
+		explicit BinaryLogger(std::filesystem::path&& path);
+		// Writes whatever is still buffered
+		virtual ~BinaryLogger() override;
+
+		// Waits until everything logged before the call is in the file
+		virtual void Flush() override;
+
+		BinaryLogger(BinaryLogger const&) = delete;
+		BinaryLogger(BinaryLogger&&) = delete;
+		BinaryLogger& operator=(BinaryLogger const&) = delete;
+		BinaryLogger& operator=(BinaryLogger&&) = delete;
+
+	private:
+		static uint32_t constexpr THREAD_BUFFER_SIZE{ 1 << 18 };
+		// Longer text messages are cut off
+		static uint32_t constexpr MAX_TEXT_SIZE{ 4'096 };
+		static constexpr std::chrono::milliseconds WRITE_INTERVAL{ 50 };
+
+		struct RecordHeader final
+		{
+			int64_t time;		// Nanoseconds since the epoch
+			uint32_t siteID;	// Events only
+			uint32_t size;		// Bytes after the header
+			BinaryLogRecordKind kind;
+			LogPriority priority;
+			LogCategory category;
+		};
+
+		// Byte ring with one producer (the owning thread) & one consumer (the writer thread)
+		class ThreadBuffer final
+		{
+		public:
+			explicit ThreadBuffer(std::thread::id owner);
+			~ThreadBuffer() = default;
+
+			[[nodiscard]] std::thread::id GetOwner() const noexcept { return m_Owner; }
+
+			// False when there is no room, owning thread only
+			[[nodiscard]] bool TryWrite(RecordHeader const& header, std::span<std::byte const> payload) noexcept;
+
+			// read(header, first, second) gets every record written so far, the payload is split in two when it wraps around
+			// Writer thread only
+			template<typename ReadFunc>
+			void ReadAll(ReadFunc&& read);
+
+			ThreadBuffer(ThreadBuffer const&) = delete;
+			ThreadBuffer(ThreadBuffer&&) = delete;
+			ThreadBuffer& operator=(ThreadBuffer const&) = delete;
+			ThreadBuffer& operator=(ThreadBuffer&&) = delete;
+
+		private:
+			std::thread::id const m_Owner;
+			std::unique_ptr<std::byte[]> m_pBytes;
+
+			alignas(64) std::atomic<uint64_t> m_WritePosition{ 0 };
+			// Producer's last look at m_ReadPosition, saves touching the consumer's cache line on every write
+			uint64_t m_CachedReadPosition{ 0 };
+			alignas(64) std::atomic<uint64_t> m_ReadPosition{ 0 };
+
+			void CopyIn(uint64_t position, void const* pSrc, size_t size) noexcept;
+			void CopyOut(uint64_t position, void* pDst, size_t size) const noexcept;
+		};
+
+		// Tells the thread local buffer cache apart from other binary loggers
+		uint32_t const m_ID;
+
+		std::ofstream m_File;
+
+		std::mutex m_BuffersMutex{};
+		// Kept until the logger is destroyed, also when their thread is gone
+		std::vector<std::unique_ptr<ThreadBuffer>> m_ThreadBuffers{};
+
+		std::atomic<uint64_t> m_DroppedCount{ 0 };
+		// Flush waits until the writer finished a pass that started after its request
+		std::atomic<uint64_t> m_FlushRequestCount{ 0 };
+		std::atomic<uint64_t> m_FlushedCount{ 0 };
+		std::atomic<bool> m_IsWakeRequested{ false };
+
+		// Writer thread only
+		uint32_t m_WrittenSiteCount{ 0 };
+		std::vector<std::byte> m_Records{};
+		std::vector<std::byte> m_Sites{};
+
+		std::mutex m_WakeMutex{};
+		std::condition_variable_any m_WakeCondition{};
+
+		// Last, started once the file header is written
+		std::jthread m_WriterThread{};
+
+		virtual void Write(LogPriority priority, LogCategory category, fmt::string_view format, fmt::format_args args) override;
+		virtual void WriteBinary(BinaryLogSite const& site, std::span<std::byte const> args) override;
+		virtual void LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message) override;
+
+		[[nodiscard]] ThreadBuffer& GetThreadBuffer();
+		void Push(RecordHeader const& header, std::span<std::byte const> payload);
+		void PushText(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message);
+
+		void WakeWriter();
+		void WriterLoop(std::stop_token const& stopToken);
+		// Moves every buffered record to the file, writer thread only
+		void WriteBuffered();
+	};
+}
+
+#endif
@@ -6,7 +6,12 @@
 
 namespace MauCor
 {
-	void ConsoleLogger::LogInternal(LogPriority priority, LogCategory category, std::string const& message)
+	void ConsoleLogger::Flush()
+	{
+		std::cout.flush();
+	}
+
+	void ConsoleLogger::LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point, std::string_view message)
 	{
 		std::cout << fmt::format("{}[{}] {}{}{} \n", MauEng::LOG_COLOR_CATEGORY, CategoryToString(category), PriorityToColour(priority), message, MauEng::LOG_COLOR_RESET);
 	}
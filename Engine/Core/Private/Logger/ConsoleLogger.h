@@ -11,12 +11,14 @@ namespace MauCor
 		ConsoleLogger() = default;
 		virtual ~ConsoleLogger() override = default;
 
+		virtual void Flush() override;
+
 		ConsoleLogger(ConsoleLogger const&) = delete;
 		ConsoleLogger(ConsoleLogger&&) = delete;
 		ConsoleLogger& operator=(ConsoleLogger const&) = delete;
 		ConsoleLogger& operator=(ConsoleLogger&&) = delete;
 	private:
-		virtual void LogInternal(LogPriority priority, LogCategory category, std::string const& message) override;
+		virtual void LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message) override;
 	};
 }
 
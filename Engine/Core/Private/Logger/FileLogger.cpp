@@ -2,61 +2,271 @@
 
 #include "FileLogger.h"
 
+#include <charconv>
+#include <utility>
+
+#include "Memory/MemoryTracker.h"
+
 namespace MauCor
 {
-	FileLogger::FileLogger(std::filesystem::path&& path) :
-		m_LogFilePath{ std::move(path) }
+	FileLogger::FileLogger(std::filesystem::path&& path, FileLoggerSettings const& settings) :
+		m_LogFilePath{ std::move(path) },
+		m_Settings{ settings },
+		m_pTimeZone{ std::chrono::current_zone() }
 	{
-		OpenLogFile();
+		ME_ASSERT(m_Settings.segmentSize > 0);
+		ME_ASSERT(m_Settings.generationCount > 0);
+
+		m_WriteBuffer.reserve(WRITE_BUFFER_SIZE + 1'024);
+
+		// Continue after the segments of earlier runs
+		std::error_code error{};
+		std::filesystem::path const directory{ m_LogFilePath.has_parent_path() ? m_LogFilePath.parent_path() : "." };
+
+		std::optional<uint32_t> newestIndex{};
+		for (auto const& entry : std::filesystem::directory_iterator{ directory, error })
+		{
+			if (auto const index{ SegmentIndex(entry.path()) }; index && (!newestIndex || *index > *newestIndex))
+			{
+				newestIndex = index;
+			}
+		}
+
+		uint32_t const firstIndex{ newestIndex ? *newestIndex + 1 : 0 };
+		RemoveOldSegments(firstIndex);
+
+		m_Segment = OpenSegment(firstIndex);
+		m_NextIndex = firstIndex + 1;
+
+		m_RotationThread = std::jthread{ [this](std::stop_token const& stopToken) { RotationLoop(stopToken); } };
 	}
 
 	FileLogger::~FileLogger()
 	{
-		if (m_LogFile.is_open())
+		m_RotationThread.request_stop();
+		m_RotationThread.join();
+
+		// Full segments the rotation thread didn't get to
+		for (auto& segment : m_FullSegments)
 		{
-			m_LogFile.close();
+			RetireSegment(segment);
+		}
+
+		std::error_code error{};
+		if (m_NextSegment)
+		{
+			m_NextSegment->file.close();
+			std::filesystem::remove(m_NextSegment->path, error);
+		}
+
+		if (m_Segment.file.is_open())
+		{
+			WriteBuffer();
+			m_Segment.file.close();
+			std::filesystem::resize_file(m_Segment.path, m_Segment.size, error);
+		}
+
+		if (!m_FullSegments.empty())
+		{
+			RemoveOldSegments(m_Segment.index);
 		}
 	}
 
-	void FileLogger::LogInternal(LogPriority priority, LogCategory category, std::string const& message)
+	void FileLogger::Flush()
 	{
-		if (m_LogFile.is_open())
+		// Same lock Write holds around LogInternal, the async logger's writer thread doesn't hold it & calls both itself
+		std::scoped_lock lock{ m_Mutex };
+		if (m_Segment.file.is_open())
 		{
-			auto const now{ std::chrono::system_clock::now() };
-			std::string const timestamp{ std::format("{:%Y-%m-%d %H:%M:%S}", std::chrono::zoned_time{ std::chrono::current_zone(), now }) };
+			WriteBuffer();
+			m_Segment.file.flush();
+		}
+	}
 
-			m_LogFile << fmt::format("[{}] [{}] [{}] {}\n", timestamp, PriorityToString(priority), CategoryToString(category), message);
+	void FileLogger::LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message)
+	{
+		if (m_Segment.file.is_open())
+		{
+			auto output{ std::back_inserter(m_WriteBuffer) };
+			output = std::format_to(output, "[{:%Y-%m-%d %H:%M:%S}] ", std::chrono::zoned_time{ m_pTimeZone, time });
+			fmt::format_to(output, "[{}] [{}] {}\n", PriorityToString(priority), CategoryToString(category), message);
 
-			if (m_LogFile.tellp() >= MAX_FILE_SIZE_BEFORE_ROTATE)
+			if (m_Segment.size + m_WriteBuffer.size() >= m_Settings.segmentSize)
 			{
 				RotateFile();
 			}
+			else if (m_WriteBuffer.size() >= WRITE_BUFFER_SIZE)
+			{
+				WriteBuffer();
+			}
 		}
 	}
 
-	void FileLogger::OpenLogFile()
+	void FileLogger::WriteBuffer()
+	{
+		m_Segment.file.write(m_WriteBuffer.data(), static_cast<std::streamsize>(m_WriteBuffer.size()));
+		m_Segment.size += m_WriteBuffer.size();
+		m_WriteBuffer.clear();
+	}
+
+	void FileLogger::RotateFile()
 	{
-		m_LogFile.open(m_LogFilePath, std::ios::out | std::ios::app);
-		if (!m_LogFile.is_open())
+		// Only the swaps are under the lock, the rotation thread never waits on a disk write
+		std::optional<Segment> nextSegment{};
 		{
-			std::cerr << "Error opening log file: " << m_LogFilePath.string() << std::endl;
+			std::scoped_lock lock{ m_RotationMutex };
+			nextSegment.swap(m_NextSegment);
+		}
+
+		if (!nextSegment)
+		{
+			if (m_WriteBuffer.size() >= WRITE_BUFFER_SIZE)
+			{
+				WriteBuffer();
+			}
+
+			return;
 		}
+
+		// The segment can end up a little over the segment size, a message is never split between two
+		WriteBuffer();
+
+		Segment fullSegment{ std::exchange(m_Segment, std::move(*nextSegment)) };
+		{
+			std::scoped_lock lock{ m_RotationMutex };
+			m_FullSegments.emplace_back(std::move(fullSegment));
+		}
+
+		m_RotationCondition.notify_one();
 	}
 
-	void FileLogger::RotateFile()
+	std::filesystem::path FileLogger::SegmentPath(uint32_t index) const
+	{
+		std::filesystem::path path{ m_LogFilePath };
+		path.replace_filename(fmt::format("{}.{}{}", m_LogFilePath.stem().string(), index, m_LogFilePath.extension().string()));
+		return path;
+	}
+
+	std::optional<uint32_t> FileLogger::SegmentIndex(std::filesystem::path const& path) const
+	{
+		std::string const fileName{ path.filename().string() };
+		std::string const prefix{ m_LogFilePath.stem().string() + "." };
+
+		if (!fileName.starts_with(prefix))
+		{
+			return std::nullopt;
+		}
+
+		uint32_t index{};
+		char const* pEnd{ fileName.data() + fileName.size() };
+		auto const [pRest, error] { std::from_chars(fileName.data() + prefix.size(), pEnd, index) };
+
+		// Compressed segments have their own extension after ours
+		if (error != std::errc{} || !std::string_view{ pRest, pEnd }.starts_with(m_LogFilePath.extension().string()))
+		{
+			return std::nullopt;
+		}
+
+		return index;
+	}
+
+	FileLogger::Segment FileLogger::OpenSegment(uint32_t index) const
 	{
-		if (m_LogFile.is_open())
+		Segment segment{ {}, SegmentPath(index), index, 0 };
+
+		segment.file.open(segment.path, std::ios::out | std::ios::trunc | std::ios::binary);
+		if (!segment.file.is_open())
+		{
+			std::cerr << "Error opening log file: " << segment.path.string() << std::endl;
+			return segment;
+		}
+
+		// Reserves the space up front, writing doesn't grow the file every time
+		std::error_code error{};
+		std::filesystem::resize_file(segment.path, m_Settings.segmentSize, error);
+
+		return segment;
+	}
+
+	void FileLogger::RetireSegment(Segment& segment) const
+	{
+		segment.file.close();
+
+		// Drops the part of the preallocated space that wasn't used
+		std::error_code error{};
+		std::filesystem::resize_file(segment.path, segment.size, error);
+
+		if (m_Settings.compressSegment && m_Settings.compressSegment(segment.path))
+		{
+			std::filesystem::remove(segment.path, error);
+		}
+	}
+
+	void FileLogger::RemoveOldSegments(uint32_t activeIndex) const
+	{
+		if (activeIndex < m_Settings.generationCount)
+		{
+			return;
+		}
+
+		uint32_t const oldestKept{ activeIndex - m_Settings.generationCount + 1 };
+
+		std::error_code error{};
+		std::filesystem::path const directory{ m_LogFilePath.has_parent_path() ? m_LogFilePath.parent_path() : "." };
+
+		std::vector<std::filesystem::path> oldSegments{};
+		for (auto const& entry : std::filesystem::directory_iterator{ directory, error })
 		{
-			m_LogFile.close();
+			if (auto const index{ SegmentIndex(entry.path()) }; index && *index < oldestKept)
+			{
+				oldSegments.emplace_back(entry.path());
+			}
 		}
 
-		std::filesystem::path const backupPath{ m_LogFilePath.string() + ".1" };
-		if (std::filesystem::exists(backupPath)) 
+		for (auto const& path : oldSegments)
 		{
-			std::filesystem::remove(backupPath);
+			std::filesystem::remove(path, error);
 		}
+	}
+
+	void FileLogger::RotationLoop(std::stop_token const& stopToken)
+	{
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
+
+		std::vector<Segment> fullSegments{};
+
+		while (!stopToken.stop_requested())
+		{
+			bool isNextSegmentNeeded{ false };
+
+			{
+				std::unique_lock lock{ m_RotationMutex };
+				m_RotationCondition.wait(lock, stopToken, [this] { return !m_NextSegment || !m_FullSegments.empty(); });
 
-		std::filesystem::rename(m_LogFilePath, backupPath);
-		OpenLogFile();
+				fullSegments.swap(m_FullSegments);
+				isNextSegmentNeeded = !m_NextSegment && !stopToken.stop_requested();
+			}
+
+			// First, the logging thread may fill another segment in the meantime
+			if (isNextSegmentNeeded)
+			{
+				Segment nextSegment{ OpenSegment(m_NextIndex++) };
+
+				std::scoped_lock lock{ m_RotationMutex };
+				m_NextSegment = std::move(nextSegment);
+			}
+
+			for (auto& segment : fullSegments)
+			{
+				RetireSegment(segment);
+			}
+
+			if (!fullSegments.empty())
+			{
+				// The segment being written is at least the one after the last full one
+				RemoveOldSegments(fullSegments.back().index + 1);
+				fullSegments.clear();
+			}
+		}
 	}
 }
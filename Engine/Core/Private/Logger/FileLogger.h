@@ -2,34 +2,87 @@
 #define MAUCOR_FILELOGGER_H
 
 #include "Logger/Logger.h"
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <optional>
+#include <thread>
 
 namespace MauCor
 {
+	/*
+	 * Writes the log as numbered segments (Log.txt -> Log.0.txt, Log.1.txt, ...), numbering continues after the files of earlier runs.
+	 * Messages are gathered in a write buffer, segments are preallocated to the segment size so writing doesn't keep growing the file.
+	 * A rotation thread opens the next segment ahead of time, a full one is swapped for it on the logging thread & handed back.
+	 * The rotation thread then trims it, compresses it (FileLoggerSettings::compressSegment) & removes the generations that are too old.
+	 * Files are never renamed while open. After a crash the segment being written ends in the zeroes of the preallocated space.
+	 */
 	class FileLogger final : public Logger
 	{
 	public:
-		explicit FileLogger(std::filesystem::path&& path);
+		FileLogger(std::filesystem::path&& path, FileLoggerSettings const& settings);
 		virtual ~FileLogger() override;
 
+		virtual void Flush() override;
+
 		FileLogger(FileLogger const&) = delete;
 		FileLogger(FileLogger&&) = delete;
 		FileLogger& operator=(FileLogger const&) = delete;
 		FileLogger& operator=(FileLogger&&) = delete;
 
 	private:
-		std::filesystem::path m_LogFilePath{ };
-		std::ofstream m_LogFile{ };
+		static uint32_t constexpr WRITE_BUFFER_SIZE{ 64 * 1'024 };
+
+		struct Segment final
+		{
+			std::ofstream file{};
+			std::filesystem::path path{};
+			uint32_t index{ 0 };
+			// Bytes written, the file itself is preallocated to the segment size
+			uint64_t size{ 0 };
+		};
+
+		std::filesystem::path const m_LogFilePath;
+		FileLoggerSettings const m_Settings;
+		// Looked up once, current_zone() searches the tz database
+		std::chrono::time_zone const* m_pTimeZone{ nullptr };
+
+		// Logging thread only (under m_Mutex, or the async logger's writer thread), Flush takes m_Mutex as well
+		Segment m_Segment{};
+		std::vector<char> m_WriteBuffer{};
+
+		// Shared with the rotation thread
+		std::mutex m_RotationMutex{};
+		std::condition_variable_any m_RotationCondition{};
+		std::optional<Segment> m_NextSegment{};
+		std::vector<Segment> m_FullSegments{};
 
-		const uint32_t MAX_FILE_SIZE_BEFORE_ROTATE{ 5'000 };
+		// Rotation thread only
+		uint32_t m_NextIndex{ 0 };
 
-		void LogInternal(LogPriority priority, LogCategory category, std::string const& message) override;
+		// Last, started once the first segment is open
+		std::jthread m_RotationThread{};
 
-		void OpenLogFile();
+		void LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message) override;
+
+		// Moves the write buffer to the segment
+		void WriteBuffer();
+		// Swaps to the next segment if the rotation thread has it ready, else keeps writing past the preallocated size
 		void RotateFile();
+
+		[[nodiscard]] std::filesystem::path SegmentPath(uint32_t index) const;
+		// Index of a segment of this log (also compressed ones), none for other files
+		[[nodiscard]] std::optional<uint32_t> SegmentIndex(std::filesystem::path const& path) const;
+
+		[[nodiscard]] Segment OpenSegment(uint32_t index) const;
+		// Closes, trims & compresses a full segment
+		void RetireSegment(Segment& segment) const;
+		// Keeps the segment being written & the generationCount - 1 segments before it, the preallocated next one isn't a generation
+		void RemoveOldSegments(uint32_t activeIndex) const;
+
+		void RotationLoop(std::stop_token const& stopToken);
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
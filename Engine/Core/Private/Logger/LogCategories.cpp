@@ -0,0 +1,39 @@
+#include "CorePCH.h"
+
+#include "Logger/LogCategories.h"
+
+#include <atomic>
+
+namespace MauCor
+{
+	namespace
+	{
+		// Lock-free, names can be registered while other threads log
+		std::array<std::atomic<char const*>, MAX_LOG_CATEGORIES> g_LogCategoryNames
+		{
+			"Core",
+			"Engine",
+			"Renderer",
+			"Game"
+		};
+	}
+
+	void RegisterLogCategory(LogCategory category, char const* name) noexcept
+	{
+		ME_ASSERT(static_cast<uint8_t>(category) < MAX_LOG_CATEGORIES);
+		ME_ASSERT(static_cast<uint8_t>(category) >= BUILT_IN_LOG_CATEGORY_COUNT);
+
+		g_LogCategoryNames[static_cast<uint8_t>(category)].store(name, std::memory_order_release);
+	}
+
+	char const* LogCategoryName(LogCategory category) noexcept
+	{
+		if (static_cast<uint8_t>(category) >= MAX_LOG_CATEGORIES)
+		{
+			return "Unknown";
+		}
+
+		char const* pName{ g_LogCategoryNames[static_cast<uint8_t>(category)].load(std::memory_order_acquire) };
+		return pName ? pName : "Unknown";
+	}
+}
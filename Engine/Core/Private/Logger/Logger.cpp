@@ -6,6 +6,31 @@ namespace MauCor
 {
 	void Logger::SetPriorityLevel(LogPriority priority) noexcept
 	{
-		m_LogPriority = priority;
+		m_LogPriority.store(priority, std::memory_order_relaxed);
+	}
+
+	void Logger::SetCategoryPriorityLevel(LogCategory category, LogPriority priority) noexcept
+	{
+		ME_ASSERT(static_cast<uint8_t>(category) < MAX_LOG_CATEGORIES);
+		m_CategoryPriorities[static_cast<uint8_t>(category) % MAX_LOG_CATEGORIES].store(priority, std::memory_order_relaxed);
+	}
+
+	void Logger::Write(LogPriority priority, LogCategory category, fmt::string_view format, fmt::format_args args)
+	{
+		// Short messages don't allocate, formatting happens before taking the lock
+		fmt::memory_buffer message{};
+		fmt::vformat_to(std::back_inserter(message), format, args);
+
+		std::scoped_lock lock{ m_Mutex };
+		LogInternal(priority, category, std::chrono::system_clock::now(), { message.data(), message.size() });
+	}
+
+	void Logger::WriteBinary(BinaryLogSite const& site, std::span<std::byte const> args)
+	{
+		fmt::dynamic_format_arg_store<fmt::format_context> store{};
+		if (DecodeBinaryArgs(store, site.argTypes, args))
+		{
+			Write(site.priority, site.category, site.format, store);
+		}
 	}
 }
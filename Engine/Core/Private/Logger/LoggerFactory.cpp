@@ -2,18 +2,36 @@
 
 #include "Logger/LoggerFactory.h"
 
+#include "AsyncLogger.h"
+#include "BinaryLogger.h"
 #include "ConsoleLogger.h"
 #include "FileLogger.h"
 
+#include "Memory/MemoryTracker.h"
+
 namespace MauCor
 {
 	std::unique_ptr<Logger> CreateConsoleLogger() noexcept
 	{
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
 		return std::make_unique<ConsoleLogger>();
 	}
 
-	std::unique_ptr<Logger> CreateFileLogger(std::filesystem::path&& filePath) noexcept
+	std::unique_ptr<Logger> CreateFileLogger(std::filesystem::path&& filePath, FileLoggerSettings const& settings) noexcept
+	{
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
+		return std::make_unique<FileLogger>(std::move(filePath), settings);
+	}
+
+	std::unique_ptr<Logger> CreateBinaryLogger(std::filesystem::path&& filePath) noexcept
+	{
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
+		return std::make_unique<BinaryLogger>(std::move(filePath));
+	}
+
+	std::unique_ptr<Logger> CreateAsyncLogger(std::unique_ptr<Logger>&& pSink, AsyncLoggerSettings const& settings) noexcept
 	{
-		return std::make_unique<FileLogger>(std::move(filePath));
+		MemoryTagScope const memoryTag{ MemoryTag::Logger };
+		return std::make_unique<AsyncLogger>(std::move(pSink), settings);
 	}
 }
\ No newline at end of file
@@ -19,7 +19,7 @@ namespace MauCor
 	protected:
 
 	private:
-		virtual void LogInternal(LogPriority priority, LogCategory category, std::string const& message) override {}
+		virtual void LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message) override {}
 	};
 }
 
@@ -0,0 +1,98 @@
+#include "CorePCH.h"
+
+#include "Memory/MemoryTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#if ENABLE_MEMORY_TRACKING
+
+// Every non aligned operator new & delete is replaced, the standard library (or a sanitizer) doesn't always forward them to the plain versions
+// Aligned allocations keep the default implementation & are not counted
+namespace
+{
+	// In front of every allocation, sized to keep the memory after it aligned like the default operator new
+	struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AllocationHeader final
+	{
+		std::size_t size;
+		MauCor::MemoryTag tag;
+	};
+}
+
+void* operator new(std::size_t size)
+{
+	auto* const pHeader{ static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size)) };
+	if (!pHeader)
+	{
+		throw std::bad_alloc{};
+	}
+
+	pHeader->size = size;
+	pHeader->tag = MauCor::GetThreadMemoryTag();
+	MauCor::TrackAllocation(pHeader->tag, size);
+
+	return pHeader + 1;
+}
+
+void operator delete(void* pData) noexcept
+{
+	if (!pData)
+	{
+		return;
+	}
+
+	// Freed under the tag it was allocated with, also from another thread
+	auto* const pHeader{ static_cast<AllocationHeader*>(pData) - 1 };
+	MauCor::TrackFree(pHeader->tag, pHeader->size);
+
+	std::free(pHeader);
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+	try
+	{
+		return operator new(size);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete[](void* pData) noexcept
+{
+	operator delete(pData);
+}
+
+void operator delete(void* pData, std::size_t) noexcept
+{
+	operator delete(pData);
+}
+
+void operator delete[](void* pData, std::size_t) noexcept
+{
+	operator delete(pData);
+}
+
+void operator delete(void* pData, std::nothrow_t const&) noexcept
+{
+	operator delete(pData);
+}
+
+void operator delete[](void* pData, std::nothrow_t const&) noexcept
+{
+	operator delete(pData);
+}
+
+#endif
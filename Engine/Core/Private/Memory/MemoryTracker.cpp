@@ -0,0 +1,183 @@
+#include "CorePCH.h"
+
+#include "Memory/MemoryTracker.h"
+
+#include <atomic>
+
+namespace MauCor
+{
+	namespace
+	{
+		uint32_t constexpr TAG_COUNT{ static_cast<uint32_t>(MemoryTag::Count) };
+
+		std::array<char const*, TAG_COUNT> constexpr TAG_NAMES
+		{
+			"Untagged",
+			"ECS",
+			"Renderer CPU",
+			"Renderer GPU",
+			"Assets",
+			"Logger"
+		};
+
+		struct MemoryCounters final
+		{
+			std::atomic<uint64_t> liveBytes{ 0 };
+			std::atomic<uint64_t> peakBytes{ 0 };
+			std::atomic<uint64_t> liveAllocations{ 0 };
+			std::atomic<uint64_t> peakAllocations{ 0 };
+			std::atomic<uint64_t> totalAllocations{ 0 };
+		};
+
+		// Constant initialised, operator new can count allocations made before main
+		constinit std::array<MemoryCounters, TAG_COUNT> g_TagCounters{};
+		constinit std::array<MemoryCounters, MAX_GPU_MEMORY_TYPES> g_GPUCounters{};
+
+		constinit thread_local MemoryTag g_ThreadTag{ MemoryTag::Untagged };
+
+		void RaisePeak(std::atomic<uint64_t>& peak, uint64_t value) noexcept
+		{
+			uint64_t current{ peak.load(std::memory_order_relaxed) };
+			while (current < value && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		void Add(MemoryCounters& counters, uint64_t size) noexcept
+		{
+			RaisePeak(counters.peakBytes, counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+			RaisePeak(counters.peakAllocations, counters.liveAllocations.fetch_add(1, std::memory_order_relaxed) + 1);
+			counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void Remove(MemoryCounters& counters, uint64_t size) noexcept
+		{
+			counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+			counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] MemoryStats Load(MemoryCounters const& counters) noexcept
+		{
+			return {
+				.liveBytes = counters.liveBytes.load(std::memory_order_relaxed),
+				.peakBytes = counters.peakBytes.load(std::memory_order_relaxed),
+				.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed),
+				.peakAllocations = counters.peakAllocations.load(std::memory_order_relaxed),
+				.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed)
+			};
+		}
+
+		[[nodiscard]] double ToMiB(uint64_t bytes) noexcept
+		{
+			return static_cast<double>(bytes) / (1024.0 * 1024.0);
+		}
+	}
+
+	void TrackAllocation(MemoryTag tag, std::size_t size) noexcept
+	{
+		Add(g_TagCounters[static_cast<uint32_t>(tag)], size);
+	}
+
+	void TrackFree(MemoryTag tag, std::size_t size) noexcept
+	{
+		Remove(g_TagCounters[static_cast<uint32_t>(tag)], size);
+	}
+
+	void TrackGPUAllocation(uint32_t memoryTypeIndex, uint64_t size) noexcept
+	{
+		ME_ASSERT(memoryTypeIndex < MAX_GPU_MEMORY_TYPES);
+
+		Add(g_TagCounters[static_cast<uint32_t>(MemoryTag::RendererGPU)], size);
+		Add(g_GPUCounters[memoryTypeIndex], size);
+	}
+
+	void TrackGPUFree(uint32_t memoryTypeIndex, uint64_t size) noexcept
+	{
+		ME_ASSERT(memoryTypeIndex < MAX_GPU_MEMORY_TYPES);
+
+		Remove(g_TagCounters[static_cast<uint32_t>(MemoryTag::RendererGPU)], size);
+		Remove(g_GPUCounters[memoryTypeIndex], size);
+	}
+
+	MemoryStats GetMemoryStats(MemoryTag tag) noexcept
+	{
+		return Load(g_TagCounters[static_cast<uint32_t>(tag)]);
+	}
+
+	MemoryStats GetGPUMemoryStats(uint32_t memoryTypeIndex) noexcept
+	{
+		ME_ASSERT(memoryTypeIndex < MAX_GPU_MEMORY_TYPES);
+		return Load(g_GPUCounters[memoryTypeIndex]);
+	}
+
+	char const* GetMemoryTagName(MemoryTag tag) noexcept
+	{
+		return TAG_NAMES[static_cast<uint32_t>(tag)];
+	}
+
+	void LogMemoryStats()
+	{
+		ME_LOG_INFO(LogCategory::Core, "Memory per tag{}", ENABLE_MEMORY_TRACKING ? "" : " (heap allocations are not tracked, enable MAUENG_ENABLE_MEMORY_TRACKING)");
+		ME_LOG_INFO(LogCategory::Core, "{:<20} {:>12} {:>12} {:>10} {:>10} {:>12}", "Tag", "live MiB", "peak MiB", "live", "peak", "total");
+
+		auto const logStats{ [](std::string_view name, MemoryStats const& stats)
+			{
+				ME_LOG_INFO(LogCategory::Core, "{:<20} {:>12.3f} {:>12.3f} {:>10} {:>10} {:>12}",
+					name, ToMiB(stats.liveBytes), ToMiB(stats.peakBytes), stats.liveAllocations, stats.peakAllocations, stats.totalAllocations);
+			} };
+
+		for (uint32_t tag{ 0 }; tag < TAG_COUNT; ++tag)
+		{
+			logStats(TAG_NAMES[tag], Load(g_TagCounters[tag]));
+		}
+
+		for (uint32_t type{ 0 }; type < MAX_GPU_MEMORY_TYPES; ++type)
+		{
+			if (auto const stats{ Load(g_GPUCounters[type]) }; stats.totalAllocations > 0)
+			{
+				logStats(fmt::format("  GPU type {}", type), stats);
+			}
+		}
+	}
+
+	MemoryTag GetThreadMemoryTag() noexcept
+	{
+		return g_ThreadTag;
+	}
+
+	MemoryTagScope::MemoryTagScope(MemoryTag tag) noexcept :
+		m_PreviousTag{ g_ThreadTag }
+	{
+		g_ThreadTag = tag;
+	}
+
+	MemoryTagScope::~MemoryTagScope()
+	{
+		g_ThreadTag = m_PreviousTag;
+	}
+
+	TrackedMemoryResource::TrackedMemoryResource(MemoryTag tag, std::pmr::memory_resource* pUpstream) noexcept :
+		m_Tag{ tag },
+		m_pUpstream{ pUpstream }
+	{
+		ME_ASSERT(pUpstream);
+	}
+
+	void* TrackedMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		void* const pData{ m_pUpstream->allocate(bytes, alignment) };
+		TrackAllocation(m_Tag, bytes);
+		return pData;
+	}
+
+	void TrackedMemoryResource::do_deallocate(void* pData, std::size_t bytes, std::size_t alignment)
+	{
+		TrackFree(m_Tag, bytes);
+		m_pUpstream->deallocate(pData, bytes, alignment);
+	}
+
+	bool TrackedMemoryResource::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+	{
+		return this == &other;
+	}
+}
@@ -0,0 +1,227 @@
+#include "CorePCH.h"
+
+#include "Memory/PageArena.h"
+
+#include <bit>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+#endif
+
+namespace MauCor
+{
+	PageArena::PageArena(std::size_t pageSize, bool useHugePages, MemoryTag tag) noexcept
+		: m_PageSize{ std::bit_ceil(std::max(pageSize, MIN_PAGE_SIZE)) }
+		, m_UseHugePages{ useHugePages }
+		, m_Tag{ tag }
+	{
+	}
+
+	PageArena::~PageArena()
+	{
+		for (auto const& page : m_Pages)
+		{
+			FreeToOS(page);
+		}
+
+		for (auto const& allocation : m_LargeAllocations)
+		{
+			FreeToOS(allocation);
+		}
+	}
+
+	ArenaStats PageArena::GetStats() const noexcept
+	{
+		std::scoped_lock const lock{ m_Mutex };
+		return m_Stats;
+	}
+
+	void* PageArena::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		ME_ASSERT(alignment <= MAX_ALIGNMENT);
+
+		std::scoped_lock const lock{ m_Mutex };
+		// The page lists grow with operator new
+		MemoryTagScope const tagScope{ m_Tag };
+
+		void* pBlock{ nullptr };
+		std::size_t usedSize{ 0 };
+
+		if (bytes > m_PageSize)
+		{
+			auto const allocation{ AllocateFromOS((bytes + m_PageSize - 1) / m_PageSize * m_PageSize) };
+			m_LargeAllocations.emplace_back(allocation);
+
+			++m_Stats.largeAllocationCount;
+			m_Stats.reservedBytes += allocation.size;
+
+			pBlock = allocation.pData;
+			usedSize = allocation.size;
+		}
+		else
+		{
+			usedSize = BlockSize(bytes, alignment);
+			pBlock = AllocateBlock(usedSize);
+		}
+
+		++m_Stats.allocationCount;
+		m_Stats.usedBytes += usedSize;
+		m_Stats.peakUsedBytes = std::max(m_Stats.peakUsedBytes, m_Stats.usedBytes);
+
+		return pBlock;
+	}
+
+	void PageArena::do_deallocate(void* pData, std::size_t bytes, std::size_t alignment)
+	{
+		if (!pData)
+		{
+			return;
+		}
+
+		std::scoped_lock const lock{ m_Mutex };
+
+		--m_Stats.allocationCount;
+
+		if (bytes > m_PageSize)
+		{
+			auto const it{ std::ranges::find(m_LargeAllocations, pData, &OSAllocation::pData) };
+			ME_ASSERT(it != m_LargeAllocations.end());
+
+			--m_Stats.largeAllocationCount;
+			m_Stats.reservedBytes -= it->size;
+			m_Stats.usedBytes -= it->size;
+
+			FreeToOS(*it);
+			*it = m_LargeAllocations.back();
+			m_LargeAllocations.pop_back();
+			return;
+		}
+
+		std::size_t const blockSize{ BlockSize(bytes, alignment) };
+		m_Stats.usedBytes -= blockSize;
+
+		auto& pFree{ m_FreeLists[SizeClass(blockSize)] };
+		pFree = ::new (pData) FreeBlock{ pFree };
+	}
+
+	void* PageArena::AllocateBlock(std::size_t blockSize)
+	{
+		if (auto& pFree{ m_FreeLists[SizeClass(blockSize)] }; pFree)
+		{
+			void* const pBlock{ pFree };
+			pFree = pFree->pNext;
+			return pBlock;
+		}
+
+		// Freed blocks are reused for any request of the same size, so align to what the largest request of this size could need
+		std::size_t const blockAlignment{ std::min(blockSize, MAX_ALIGNMENT) };
+		auto const aligned{ (reinterpret_cast<std::uintptr_t>(m_pCursor) + blockAlignment - 1) & ~(blockAlignment - 1) };
+
+		// The rest of the current page is too small, it stays unused
+		if (!m_pCursor || aligned + blockSize > reinterpret_cast<std::uintptr_t>(m_pPageEnd))
+		{
+			auto const page{ AllocateFromOS(m_PageSize) };
+			m_Pages.emplace_back(page);
+
+			++m_Stats.pageCount;
+			m_Stats.reservedBytes += page.size;
+			m_Stats.usesHugePages |= page.isHugePage;
+
+			m_pCursor = static_cast<std::byte*>(page.pData);
+			m_pPageEnd = m_pCursor + page.size;
+		}
+		else
+		{
+			m_pCursor = reinterpret_cast<std::byte*>(aligned);
+		}
+
+		void* const pBlock{ m_pCursor };
+		m_pCursor += blockSize;
+		return pBlock;
+	}
+
+	std::size_t PageArena::BlockSize(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		return std::bit_ceil(std::max({ bytes, alignment, MIN_BLOCK_SIZE }));
+	}
+
+	uint32_t PageArena::SizeClass(std::size_t blockSize) noexcept
+	{
+		return static_cast<uint32_t>(std::countr_zero(blockSize) - std::countr_zero(MIN_BLOCK_SIZE));
+	}
+
+	PageArena::OSAllocation PageArena::AllocateFromOS(std::size_t size) const
+	{
+#ifdef _WIN32
+		// Large pages need the lock pages in memory privilege, without it this fails & normal pages are used
+		if (m_UseHugePages)
+		{
+			SIZE_T const largePageSize{ GetLargePageMinimum() };
+			if (largePageSize > 0 && size % largePageSize == 0)
+			{
+				if (void* const pData{ VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE) })
+				{
+					TrackAllocation(m_Tag, size);
+					return { pData, size, true };
+				}
+			}
+		}
+
+		void* const pData{ VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE) };
+		if (!pData)
+		{
+			throw std::bad_alloc{};
+		}
+
+		TrackAllocation(m_Tag, size);
+		return { pData, size, false };
+#else
+		// Over allocate so the start can be aligned to the size, transparent huge pages need 2MB aligned ranges
+		std::size_t const alignment{ std::min(size, DEFAULT_PAGE_SIZE) };
+		std::size_t const mappedSize{ size + alignment };
+
+		void* const pMapped{ mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+		if (MAP_FAILED == pMapped)
+		{
+			throw std::bad_alloc{};
+		}
+
+		auto const mapped{ reinterpret_cast<std::uintptr_t>(pMapped) };
+		auto const aligned{ (mapped + alignment - 1) & ~(alignment - 1) };
+
+		if (aligned > mapped)
+		{
+			munmap(pMapped, aligned - mapped);
+		}
+		if (std::size_t const tail{ mapped + mappedSize - (aligned + size) }; tail > 0)
+		{
+			munmap(reinterpret_cast<void*>(aligned + size), tail);
+		}
+
+		void* const pData{ reinterpret_cast<void*>(aligned) };
+
+		bool isHugePage{ false };
+#ifdef MADV_HUGEPAGE
+		isHugePage = m_UseHugePages && size >= DEFAULT_PAGE_SIZE && 0 == madvise(pData, size, MADV_HUGEPAGE);
+#endif
+
+		TrackAllocation(m_Tag, size);
+		return { pData, size, isHugePage };
+#endif
+	}
+
+	void PageArena::FreeToOS(OSAllocation const& allocation) const noexcept
+	{
+		TrackFree(m_Tag, allocation.size);
+
+#ifdef _WIN32
+		VirtualFree(allocation.pData, 0, MEM_RELEASE);
+#else
+		munmap(allocation.pData, allocation.size);
+#endif
+	}
+}
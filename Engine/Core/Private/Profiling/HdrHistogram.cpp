@@ -0,0 +1,91 @@
+#include "Profiling/HdrHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace MauCor
+{
+	HdrHistogram::HdrHistogram(uint64_t maxValue) :
+		m_MaxValue{ maxValue },
+		m_Counts(BucketIndex(maxValue) + 1, 0)
+	{
+	}
+
+	void HdrHistogram::Record(uint64_t value) noexcept
+	{
+		value = std::min(value, m_MaxValue);
+
+		++m_Counts[BucketIndex(value)];
+		++m_Count;
+		m_Total += value;
+		m_Min = std::min(m_Min, value);
+		m_Max = std::max(m_Max, value);
+	}
+
+	void HdrHistogram::Reset() noexcept
+	{
+		std::ranges::fill(m_Counts, 0);
+		m_Count = 0;
+		m_Total = 0;
+		m_Min = UINT64_MAX;
+		m_Max = 0;
+	}
+
+	uint64_t HdrHistogram::ValueAtPercentile(double percentile) const noexcept
+	{
+		if (m_Count == 0)
+		{
+			return 0;
+		}
+
+		uint64_t const rank{ std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(m_Count))), 1, m_Count) };
+
+		uint64_t seen{ 0 };
+		for (uint32_t index{ 0 }; index < static_cast<uint32_t>(m_Counts.size()); ++index)
+		{
+			seen += m_Counts[index];
+			if (seen >= rank)
+			{
+				return std::min(BucketHighest(index), m_Max);
+			}
+		}
+
+		return m_Max;
+	}
+
+	uint32_t HdrHistogram::BucketIndex(uint64_t value) noexcept
+	{
+		if (value < SUB_BUCKET_COUNT)
+		{
+			return static_cast<uint32_t>(value);
+		}
+
+		// The top SUB_BUCKET_BITS bits of the value pick the bucket within its power of two
+		uint32_t const shift{ static_cast<uint32_t>(std::bit_width(value)) - SUB_BUCKET_BITS };
+		return SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT + static_cast<uint32_t>((value >> shift) - HALF_SUB_BUCKET_COUNT);
+	}
+
+	uint64_t HdrHistogram::BucketLowest(uint32_t index) noexcept
+	{
+		if (index < SUB_BUCKET_COUNT)
+		{
+			return index;
+		}
+
+		uint32_t const shift{ (index - SUB_BUCKET_COUNT) / HALF_SUB_BUCKET_COUNT + 1 };
+		uint64_t const top{ (index - SUB_BUCKET_COUNT) % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT };
+		return top << shift;
+	}
+
+	uint64_t HdrHistogram::BucketHighest(uint32_t index) noexcept
+	{
+		if (index < SUB_BUCKET_COUNT)
+		{
+			return index;
+		}
+
+		uint32_t const shift{ (index - SUB_BUCKET_COUNT) / HALF_SUB_BUCKET_COUNT + 1 };
+		return BucketLowest(index) + (uint64_t{ 1 } << shift) - 1;
+	}
+}
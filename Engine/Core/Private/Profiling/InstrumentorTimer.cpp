@@ -1,19 +1,21 @@
 #include "Profiling/InstrumentorTimer.h"
 
 #include "CoreServiceLocator.h"
+#include "Profiling/TraceClock.h"
 
 #include <iostream>
 
 namespace MauCor
 {
-	//thread_local uint32_t InstrumentorTimer::m_NestCount = 0;
+	thread_local uint32_t InstrumentorTimer::m_NestCount = 0;
 
 	InstrumentorTimer::InstrumentorTimer(char const* timerName, bool isFunction):
 		m_Name{ timerName },
+		m_Depth{ m_NestCount++ },
 		m_IsFunction{isFunction}
 	{
-		m_StartPoint = std::chrono::high_resolution_clock::now();
-		//++m_NestCount;
+		// Last, the profiler's own work isn't part of the scope
+		m_Start = ReadTraceClock();
 	}
 
 	InstrumentorTimer::~InstrumentorTimer()
@@ -26,13 +28,18 @@ namespace MauCor
 
 	void InstrumentorTimer::Stop() noexcept
 	{
-		auto const endPoint{ std::chrono::high_resolution_clock::now() };
-		auto const start{ std::chrono::time_point_cast<std::chrono::microseconds>(m_StartPoint).time_since_epoch().count() };
-		auto const end{ std::chrono::time_point_cast<std::chrono::microseconds>(endPoint).time_since_epoch().count() };
+		uint64_t const end{ ReadTraceClock() };
 
 		m_IsStopped = true;
+		--m_NestCount;
 
-		PROFILER.WriteProfile({ m_Name, start, end, std::this_thread::get_id() }, m_IsFunction);
-		//--m_NestCount;
+		TraceScope const scope{ m_Name, m_Start, end, m_Depth, m_IsFunction };
+
+		if constexpr (MauEng::USE_PROFILER_STATS)
+		{
+			PROFILER.AddToStats(scope);
+		}
+
+		PROFILER.WriteScope(scope);
 	}
 }
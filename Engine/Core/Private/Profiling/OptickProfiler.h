@@ -15,6 +15,8 @@ namespace MauCor
 
 		virtual void WriteProfile(ProfileResult const& result, bool isFunction) override;
 		virtual void WriteProfile(std::string const& name) override;
+		// Optick records its own events, the timers of the macros only feed the scope stats
+		virtual void WriteScope(TraceScope const& scope) override {}
 
 		virtual void EndSession() override;
 
@@ -1,11 +1,88 @@
 #include "Profiling/Profiler.h"
+#include "Profiling/ScopeNameTable.h"
+#include "Profiling/ScopeStatsCollector.h"
+#include "Profiling/TraceClock.h"
+#include "Memory/MemoryTracker.h"
 
 namespace MauCor
 {
+	Profiler::Profiler() :
+		m_pScopeNames{ std::make_unique<ScopeNameTable>() },
+		m_pStats{ std::make_unique<ScopeStatsCollector>(MauEng::PROFILER_STATS_FRAME_COUNT, *m_pScopeNames) }
+	{
+	}
+
+	Profiler::~Profiler() = default;
+
 	void Profiler::BeginSession(std::string const& name, char const* path, size_t reserveSize)
 	{
 		fileName = path;
 		BeginSessionInternal(name, reserveSize);
+		m_SessionCount.fetch_add(1, std::memory_order_release);
+	}
+
+	void Profiler::WriteScope(TraceScope const& scope)
+	{
+		double const ticksPerMicrosecond{ TraceClockFrequency() / 1'000'000.0 };
+
+		WriteProfile({ scope.name, static_cast<long long>(scope.start / ticksPerMicrosecond), static_cast<long long>(scope.end / ticksPerMicrosecond), std::this_thread::get_id() }, scope.isFunction);
+	}
+
+	void Profiler::WriteGPUScope(TraceScope const& scope)
+	{
+	}
+
+	void Profiler::WriteCounter(char const* name, uint64_t ticks, std::span<CounterValue const> values)
+	{
+	}
+
+	char const* Profiler::InternScopeName(std::string_view name)
+	{
+		return m_pScopeNames->Intern(name);
+	}
+
+	void Profiler::AddToStats(TraceScope const& scope) noexcept
+	{
+		m_pStats->Add(scope);
+	}
+
+	void Profiler::EndStatsFrame()
+	{
+		m_pStats->EndFrame();
+	}
+
+	void Profiler::ResetStats(uint32_t frameCount)
+	{
+		m_pStats->Reset(frameCount);
+	}
+
+	std::optional<ScopeStats> Profiler::GetStats(std::string_view name) const
+	{
+		return m_pStats->GetStats(name);
+	}
+
+	std::vector<std::pair<std::string, ScopeStats>> Profiler::GetAllStats() const
+	{
+		return m_pStats->GetAllStats();
+	}
+
+	void Profiler::LogStats() const
+	{
+		auto const stats{ m_pStats->GetAllStats() };
+
+		ME_LOG_INFO(LogCategory::Core, "Scope stats over the last {} frames (ms per frame)", MauEng::PROFILER_STATS_FRAME_COUNT);
+		ME_LOG_INFO(LogCategory::Core, "{:<40} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>7}", "Scope", "min", "avg", "p95", "p99", "max", "calls", "frames");
+
+		for (auto const& [name, scope] : stats)
+		{
+			ME_LOG_INFO(LogCategory::Core, "{:<40} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.1f} {:>7}",
+				name, scope.min, scope.average, scope.p95, scope.p99, scope.max, scope.callsPerFrame, scope.frameCount);
+		}
+
+		if (uint64_t const dropped{ m_pStats->GetDroppedCount() }; dropped > 0)
+		{
+			ME_LOG_WARN(LogCategory::Core, "{} scopes were left out of the stats, a thread ran too many different scopes", dropped);
+		}
 	}
 
 	void Profiler::Start(char const* path)
@@ -21,12 +98,74 @@ namespace MauCor
 
 			ME_LOG_INFO(MauCor::LogCategory::Core, "Beginning profile session {}", fileName);
 			BeginSessionInternal(fileName);
+			m_SessionCount.fetch_add(1, std::memory_order_release);
 			isProfiling = true;
 		}
 	}
 
+	bool Profiler::BeginFlightRecording(uint32_t frameCount)
+	{
+		m_IsFlightRecording = BeginFlightRecordingInternal(frameCount);
+		return m_IsFlightRecording;
+	}
+
+	bool Profiler::BeginFlightRecordingInternal(uint32_t frameCount)
+	{
+		return false;
+	}
+
+	void Profiler::DumpFlightRecording(char const* path, uint32_t framesAfter)
+	{
+		if (!m_IsFlightRecording)
+		{
+			Start(path);
+			return;
+		}
+
+		if (m_IsDumpPending)
+		{
+			return;
+		}
+
+		m_DumpPath = path;
+		m_DumpPath += std::to_string(numExecutedProfiles++);
+		m_DumpFramesLeft = framesAfter;
+		m_IsDumpPending = true;
+	}
+
+	void Profiler::EndFlightRecordingFrame(uint64_t ticks)
+	{
+	}
+
+	void Profiler::WriteFlightRecording(std::string const& path)
+	{
+	}
+
 	void Profiler::Update()
 	{
+		if constexpr (MauEng::USE_PROFILER_STATS)
+		{
+			EndStatsFrame();
+		}
+
+		if (isProfiling || m_IsFlightRecording)
+		{
+			WriteMemoryCounters();
+		}
+
+		if (m_IsFlightRecording)
+		{
+			EndFlightRecordingFrame(ReadTraceClock());
+
+			if (m_IsDumpPending && (m_DumpFramesLeft == 0 || --m_DumpFramesLeft == 0))
+			{
+				m_IsDumpPending = false;
+
+				ME_LOG_INFO(MauCor::LogCategory::Core, "Writing the flight recording {}", m_DumpPath);
+				WriteFlightRecording(m_DumpPath);
+			}
+		}
+
 		if (isProfiling)
 		{
 			++profiledFrames;
@@ -43,6 +182,44 @@ namespace MauCor
 		}
 	}
 
+	void Profiler::WriteMemoryCounters()
+	{
+		static auto const GPU_TYPE_NAMES{ []
+			{
+				std::array<std::string, MAX_GPU_MEMORY_TYPES> names{};
+				for (uint32_t type{ 0 }; type < MAX_GPU_MEMORY_TYPES; ++type)
+				{
+					names[type] = fmt::format("Type {}", type);
+				}
+				return names;
+			}() };
+
+		uint64_t const ticks{ ReadTraceClock() };
+
+		std::array<CounterValue, static_cast<uint32_t>(MemoryTag::Count)> tagValues{};
+		for (uint32_t tag{ 0 }; tag < tagValues.size(); ++tag)
+		{
+			tagValues[tag] = { GetMemoryTagName(static_cast<MemoryTag>(tag)), static_cast<double>(GetMemoryStats(static_cast<MemoryTag>(tag)).liveBytes) };
+		}
+		WriteCounter("Memory (bytes)", ticks, tagValues);
+
+		// Types that were never allocated from are left out, a type stays in once it was used
+		std::array<CounterValue, MAX_GPU_MEMORY_TYPES> typeValues{};
+		uint32_t typeCount{ 0 };
+		for (uint32_t type{ 0 }; type < MAX_GPU_MEMORY_TYPES; ++type)
+		{
+			if (auto const stats{ GetGPUMemoryStats(type) }; stats.totalAllocations > 0)
+			{
+				typeValues[typeCount++] = { GPU_TYPE_NAMES[type].c_str(), static_cast<double>(stats.liveBytes) };
+			}
+		}
+
+		if (typeCount > 0)
+		{
+			WriteCounter("GPU memory (bytes)", ticks, std::span{ typeValues.data(), typeCount });
+		}
+	}
+
 	void Profiler::FixFilePath(char const* filepath)
 	{
 		std::filesystem::path const dir{ std::filesystem::path(filepath).parent_path() };
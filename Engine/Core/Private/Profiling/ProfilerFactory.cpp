@@ -0,0 +1,17 @@
+#include "Profiling/ProfilerFactory.h"
+
+#include "Profiling/GoogleProfiler.h"
+#include "Profiling/TraceProfiler.h"
+
+namespace MauCor
+{
+	std::unique_ptr<Profiler> CreateGoogleProfiler() noexcept
+	{
+		return std::make_unique<GoogleProfiler>();
+	}
+
+	std::unique_ptr<Profiler> CreateTraceProfiler() noexcept
+	{
+		return std::make_unique<TraceProfiler>();
+	}
+}
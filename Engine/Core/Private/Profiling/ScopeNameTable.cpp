@@ -0,0 +1,28 @@
+#include "Profiling/ScopeNameTable.h"
+
+#include <mutex>
+
+namespace MauCor
+{
+	char const* ScopeNameTable::Intern(std::string_view name)
+	{
+		{
+			std::shared_lock lock{ m_Mutex };
+			if (auto const it{ m_Names.find(name) }; it != m_Names.end())
+			{
+				return it->c_str();
+			}
+		}
+
+		std::scoped_lock lock{ m_Mutex };
+		return m_Names.emplace(name).first->c_str();
+	}
+
+	char const* ScopeNameTable::Find(std::string_view name) const
+	{
+		std::shared_lock lock{ m_Mutex };
+
+		auto const it{ m_Names.find(name) };
+		return it != m_Names.end() ? it->c_str() : nullptr;
+	}
+}
@@ -0,0 +1,45 @@
+#ifndef MAUCOR_SCOPENAMETABLE_H
+#define MAUCOR_SCOPENAMETABLE_H
+
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace MauCor
+{
+	/*
+	 * Copies of the scope names that are not literals (e.g system names), one per distinct text.
+	 * The trace & the scope stats keep name pointers until long after the scope ended, an interned name lives as long as the table.
+	 * Entries are never removed, so the same text always gets the same pointer.
+	 */
+	class ScopeNameTable final
+	{
+	public:
+		ScopeNameTable() = default;
+		~ScopeNameTable() = default;
+
+		// Any thread, only the first call for a text takes the write lock
+		[[nodiscard]] char const* Intern(std::string_view name);
+		// The interned copy, nullptr if the text was never interned
+		[[nodiscard]] char const* Find(std::string_view name) const;
+
+		ScopeNameTable(ScopeNameTable const&) = delete;
+		ScopeNameTable(ScopeNameTable&&) = delete;
+		ScopeNameTable& operator=(ScopeNameTable const&) = delete;
+		ScopeNameTable& operator=(ScopeNameTable&&) = delete;
+
+	private:
+		struct StringHash final
+		{
+			using is_transparent = void;
+			[[nodiscard]] size_t operator()(std::string_view string) const noexcept { return std::hash<std::string_view>{}(string); }
+		};
+
+		mutable std::shared_mutex m_Mutex{};
+		// Node based, the strings don't move when others are added
+		std::unordered_set<std::string, StringHash, std::equal_to<>> m_Names{};
+	};
+}
+
+#endif
@@ -0,0 +1,248 @@
+#include "Profiling/ScopeStatsCollector.h"
+#include "Profiling/TraceClock.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MauCor
+{
+	namespace
+	{
+		std::atomic<uint32_t> g_NextScopeStatsCollectorID{ 0 };
+	}
+
+	ScopeStatsCollector::ScopeStatsCollector(uint32_t frameCount, ScopeNameTable& names) :
+		m_FrameCount{ std::max(frameCount, 1u) },
+		m_Names{ names },
+		m_ID{ g_NextScopeStatsCollectorID.fetch_add(1, std::memory_order_relaxed) }
+	{
+	}
+
+	void ScopeStatsCollector::Add(TraceScope const& scope) noexcept
+	{
+		auto& table{ GetThreadTable() };
+
+		// Names are usually literals, neighbouring ones differ in the low bits
+		uint32_t index{ static_cast<uint32_t>((reinterpret_cast<uintptr_t>(scope.name) * 0x9E3779B97F4A7C15ull) >> 32) };
+
+		for (uint32_t probe{ 0 }; probe < THREAD_TABLE_SIZE; ++probe, ++index)
+		{
+			auto& slot{ table.slots[index & (THREAD_TABLE_SIZE - 1)] };
+
+			// Only this thread writes names, its own writes don't need ordering
+			char const* const pName{ slot.name.load(std::memory_order_relaxed) };
+			if (pName == nullptr)
+			{
+				slot.name.store(scope.name, std::memory_order_release);
+			}
+			else if (pName != scope.name)
+			{
+				continue;
+			}
+
+			// EndFrame exchanges them, an add is never lost
+			slot.ticks.fetch_add(scope.end - scope.start, std::memory_order_relaxed);
+			slot.calls.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void ScopeStatsCollector::EndFrame()
+	{
+		std::scoped_lock historiesLock{ m_HistoriesMutex };
+
+		m_FrameSamples.clear();
+
+		{
+			std::scoped_lock tablesLock{ m_TablesMutex };
+			for (auto const& pTable : m_ThreadTables)
+			{
+				for (auto& slot : pTable->slots)
+				{
+					char const* const pName{ slot.name.load(std::memory_order_acquire) };
+					if (pName == nullptr)
+					{
+						continue;
+					}
+
+					uint32_t const calls{ slot.calls.exchange(0, std::memory_order_relaxed) };
+					uint64_t const ticks{ slot.ticks.exchange(0, std::memory_order_relaxed) };
+					if (calls == 0)
+					{
+						continue;
+					}
+
+					auto it{ m_HistoriesByPointer.find(pName) };
+					if (it == m_HistoriesByPointer.end())
+					{
+						// Node based, the history doesn't move when others are added
+						auto& history{ m_Histories.try_emplace(m_Names.Intern(pName)).first->second };
+						it = m_HistoriesByPointer.emplace(pName, &history).first;
+					}
+
+					// The same scope can run on several threads in a frame, or have several call sites
+					auto& sample{ m_FrameSamples[it->second] };
+					sample.ticks += ticks;
+					sample.calls += calls;
+				}
+			}
+		}
+
+		for (auto const& [pHistory, sample] : m_FrameSamples)
+		{
+			if (pHistory->samples.size() < m_FrameCount)
+			{
+				pHistory->samples.emplace_back(sample);
+			}
+			else
+			{
+				pHistory->samples[pHistory->next] = sample;
+			}
+			pHistory->next = (pHistory->next + 1) % m_FrameCount;
+			pHistory->lastFrame = m_FrameIndex;
+		}
+
+		// Scopes that didn't run in the window, e.g a removed system
+		if (m_FrameIndex >= m_FrameCount)
+		{
+			uint64_t const oldestKept{ m_FrameIndex - m_FrameCount + 1 };
+			std::erase_if(m_HistoriesByPointer, [oldestKept](auto const& entry) { return entry.second->lastFrame < oldestKept; });
+			std::erase_if(m_Histories, [oldestKept](auto const& entry) { return entry.second.lastFrame < oldestKept; });
+		}
+
+		++m_FrameIndex;
+	}
+
+	void ScopeStatsCollector::Reset(uint32_t frameCount)
+	{
+		std::scoped_lock historiesLock{ m_HistoriesMutex };
+
+		{
+			// Scopes that ended since the last frame belong to the old window, the names stay
+			std::scoped_lock tablesLock{ m_TablesMutex };
+			for (auto const& pTable : m_ThreadTables)
+			{
+				for (auto& slot : pTable->slots)
+				{
+					slot.calls.store(0, std::memory_order_relaxed);
+					slot.ticks.store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		m_HistoriesByPointer.clear();
+		m_Histories.clear();
+		m_FrameCount = std::max(frameCount, 1u);
+		m_FrameIndex = 0;
+	}
+
+	std::optional<ScopeStats> ScopeStatsCollector::GetStats(std::string_view name) const
+	{
+		char const* const pName{ m_Names.Find(name) };
+		if (pName == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		std::scoped_lock lock{ m_HistoriesMutex };
+
+		auto const it{ m_Histories.find(pName) };
+		if (it == m_Histories.end())
+		{
+			return std::nullopt;
+		}
+
+		return ToStats(it->second);
+	}
+
+	std::vector<std::pair<std::string, ScopeStats>> ScopeStatsCollector::GetAllStats() const
+	{
+		std::vector<std::pair<std::string, ScopeStats>> stats{};
+
+		{
+			std::scoped_lock lock{ m_HistoriesMutex };
+
+			stats.reserve(m_Histories.size());
+			for (auto const& [name, history] : m_Histories)
+			{
+				stats.emplace_back(name, ToStats(history));
+			}
+		}
+
+		std::ranges::sort(stats, std::greater{}, [](auto const& nameStats) { return nameStats.second.average; });
+		return stats;
+	}
+
+	ScopeStatsCollector::ThreadTable& ScopeStatsCollector::GetThreadTable()
+	{
+		// Usually there is one profiler, remember the table this thread used last
+		thread_local struct
+		{
+			uint32_t collectorID{ UINT32_MAX };
+			ThreadTable* pTable{ nullptr };
+		} cache{};
+
+		if (cache.collectorID == m_ID)
+		{
+			return *cache.pTable;
+		}
+
+		std::scoped_lock lock{ m_TablesMutex };
+
+		auto const owner{ std::this_thread::get_id() };
+		auto it{ std::ranges::find_if(m_ThreadTables, [owner](auto const& pTable) { return pTable->owner == owner; }) };
+		if (it == m_ThreadTables.end())
+		{
+			it = m_ThreadTables.emplace(m_ThreadTables.end(), std::make_unique<ThreadTable>(owner));
+		}
+
+		cache = { m_ID, it->get() };
+		return **it;
+	}
+
+	ScopeStats ScopeStatsCollector::ToStats(History const& history) const
+	{
+		ScopeStats stats{};
+		if (history.samples.empty())
+		{
+			return stats;
+		}
+
+		double const ticksPerMillisecond{ TraceClockFrequency() / 1'000.0 };
+
+		std::vector<double> times(history.samples.size());
+		uint64_t totalCalls{ 0 };
+		for (size_t i{ 0 }; i < history.samples.size(); ++i)
+		{
+			times[i] = static_cast<double>(history.samples[i].ticks) / ticksPerMillisecond;
+			totalCalls += history.samples[i].calls;
+		}
+
+		std::ranges::sort(times);
+
+		// Nearest rank
+		auto const percentile{ [&times](double p)
+			{
+				size_t const rank{ static_cast<size_t>(std::ceil(p * static_cast<double>(times.size()))) };
+				return times[std::clamp<size_t>(rank, 1, times.size()) - 1];
+			} };
+
+		double total{ 0.0 };
+		for (double const time : times)
+		{
+			total += time;
+		}
+
+		stats.min = times.front();
+		stats.average = total / static_cast<double>(times.size());
+		stats.p95 = percentile(0.95);
+		stats.p99 = percentile(0.99);
+		stats.max = times.back();
+		stats.callsPerFrame = static_cast<double>(totalCalls) / static_cast<double>(times.size());
+		stats.frameCount = static_cast<uint32_t>(times.size());
+
+		return stats;
+	}
+}
@@ -0,0 +1,115 @@
+#ifndef MAUCOR_SCOPESTATSCOLLECTOR_H
+#define MAUCOR_SCOPESTATSCOLLECTOR_H
+
+#include "Profiling/Profiler.h"
+#include "Profiling/ScopeNameTable.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MauCor
+{
+	/*
+	 * Rolling per scope statistics, always on unlike a capture.
+	 * Every thread adds the scopes it ends to its own fixed size table (name pointer -> ticks & calls this frame), only atomic adds.
+	 * EndFrame swaps the tables' counters out, sums them per name & appends the frame to the scope's history of the last frameCount frames.
+	 * Frames a scope didn't run in aren't part of its history, a scope that didn't run for frameCount frames is dropped.
+	 * Scope names are literals or interned in the profiler's name table (ME_PROFILE_SCOPE_DYNAMIC), a pointer never changes its text.
+	 * Histories are keyed by the interned copy, name pointers with the same text share one.
+	 */
+	class ScopeStatsCollector final
+	{
+	public:
+		// The names have to outlive the collector
+		ScopeStatsCollector(uint32_t frameCount, ScopeNameTable& names);
+		~ScopeStatsCollector() = default;
+
+		// Any thread
+		void Add(TraceScope const& scope) noexcept;
+
+		// Once per frame, by one thread
+		void EndFrame();
+		// Drops every history & keeps the last frameCount frames from now on, by the thread ending the frames
+		void Reset(uint32_t frameCount);
+
+		[[nodiscard]] std::optional<ScopeStats> GetStats(std::string_view name) const;
+		// Name & stats of every scope, most time per frame first
+		[[nodiscard]] std::vector<std::pair<std::string, ScopeStats>> GetAllStats() const;
+
+		// Scopes that didn't fit in their thread's table
+		[[nodiscard]] uint64_t GetDroppedCount() const noexcept { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+		ScopeStatsCollector(ScopeStatsCollector const&) = delete;
+		ScopeStatsCollector(ScopeStatsCollector&&) = delete;
+		ScopeStatsCollector& operator=(ScopeStatsCollector const&) = delete;
+		ScopeStatsCollector& operator=(ScopeStatsCollector&&) = delete;
+
+	private:
+		// Distinct scopes a single thread can run, a power of two
+		static uint32_t constexpr THREAD_TABLE_SIZE{ 512 };
+
+		struct ThreadTable final
+		{
+			struct Slot final
+			{
+				// Written once by the owning thread, published after the counters
+				std::atomic<char const*> name{ nullptr };
+				std::atomic<uint64_t> ticks{ 0 };
+				std::atomic<uint32_t> calls{ 0 };
+			};
+
+			explicit ThreadTable(std::thread::id owner) :
+				owner{ owner }
+			{
+			}
+
+			std::thread::id const owner;
+			std::array<Slot, THREAD_TABLE_SIZE> slots{};
+		};
+
+		struct FrameSample final
+		{
+			uint64_t ticks;
+			uint32_t calls;
+		};
+
+		// Ring of the last frameCount frames the scope ran in
+		struct History final
+		{
+			std::vector<FrameSample> samples{};
+			uint32_t next{ 0 };
+			uint64_t lastFrame{ 0 };
+		};
+
+		uint32_t m_FrameCount;
+		ScopeNameTable& m_Names;
+		// Tells the thread local table cache apart from other collectors
+		uint32_t const m_ID;
+
+		std::atomic<uint64_t> m_DroppedCount{ 0 };
+
+		std::mutex m_TablesMutex{};
+		// Kept until the collector is destroyed, also when their thread is gone
+		std::vector<std::unique_ptr<ThreadTable>> m_ThreadTables{};
+
+		// EndFrame & the queries
+		mutable std::mutex m_HistoriesMutex{};
+		uint64_t m_FrameIndex{ 0 };
+		// By interned name
+		std::unordered_map<char const*, History> m_Histories{};
+		// EndFrame only, skips interning the name of every scope every frame
+		std::unordered_map<char const*, History*> m_HistoriesByPointer{};
+		std::unordered_map<History*, FrameSample> m_FrameSamples{};
+
+		[[nodiscard]] ThreadTable& GetThreadTable();
+		[[nodiscard]] ScopeStats ToStats(History const& history) const;
+	};
+}
+
+#endif
@@ -0,0 +1,25 @@
+#include "Profiling/TraceClock.h"
+
+namespace MauCor
+{
+	double TraceClockFrequency() noexcept
+	{
+		static double const frequency{ []
+			{
+				auto const startTime{ std::chrono::steady_clock::now() };
+				uint64_t const startTicks{ ReadTraceClock() };
+
+				// Long enough that reading the clocks doesn't matter, short enough not to notice
+				auto endTime{ startTime };
+				while (endTime - startTime < std::chrono::milliseconds{ 5 })
+				{
+					endTime = std::chrono::steady_clock::now();
+				}
+
+				uint64_t const endTicks{ ReadTraceClock() };
+				return static_cast<double>(endTicks - startTicks) / std::chrono::duration<double>(endTime - startTime).count();
+			}() };
+
+		return frequency;
+	}
+}
@@ -0,0 +1,418 @@
+#include "Profiling/TraceProfiler.h"
+#include "Profiling/TraceClock.h"
+#include "AssertsInternal.h"
+
+#include <fstream>
+
+namespace MauCor
+{
+	namespace
+	{
+		std::atomic<uint32_t> g_NextTraceProfilerID{ 0 };
+
+		// Names are C++ identifiers or literals, only quotes & backslashes need escaping
+		void WriteJsonString(fmt::memory_buffer& json, char const* pString)
+		{
+			json.push_back('"');
+			for (; *pString; ++pString)
+			{
+				if (*pString == '"' || *pString == '\\')
+				{
+					json.push_back('\\');
+				}
+				json.push_back(*pString);
+			}
+			json.push_back('"');
+		}
+	}
+
+	TraceProfiler::TraceProfiler() :
+		m_ID{ g_NextTraceProfilerID.fetch_add(1, std::memory_order_relaxed) }
+	{
+		// No thread has the default id, GetThreadBuffer never hands it out
+		m_pGPUBuffer = m_ThreadBuffers.emplace_back(std::make_unique<ThreadBuffer>(std::thread::id{})).get();
+	}
+
+	TraceProfiler::~TraceProfiler()
+	{
+		// Not resumed by EndSession
+		m_FlightFrameCount = 0;
+
+		if (m_IsFlightSession)
+		{
+			m_IsFlightSession = false;
+			(void)StopRecording();
+		}
+
+		EndSession();
+	}
+
+	void TraceProfiler::BeginSessionInternal(std::string const& name, size_t reserveSize)
+	{
+		if (m_IsFlightSession)
+		{
+			// Dropped, the flight recorder starts again when the session ends
+			m_IsFlightSession = false;
+			(void)StopRecording();
+		}
+		else
+		{
+			EndSession();
+		}
+
+		StartRecording();
+	}
+
+	void TraceProfiler::WriteProfile(ProfileResult const& result, bool isFunction)
+	{
+		ME_LOG_ERROR(LogCategory::Core, "Incorrect profiler function for trace profiler used, use WriteScope.");
+		ME_CORE_CHECK(false);
+	}
+
+	void TraceProfiler::WriteProfile(std::string const& name)
+	{
+		ME_LOG_ERROR(LogCategory::Core, "Incorrect profiler function for trace profiler used.");
+		ME_CORE_CHECK(false);
+	}
+
+	void TraceProfiler::WriteScope(TraceScope const& scope)
+	{
+		if (!m_IsRecording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		if (!GetThreadBuffer().scopes.TryPush(scope))
+		{
+			m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void TraceProfiler::WriteGPUScope(TraceScope const& scope)
+	{
+		if (!m_IsRecording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		if (!m_pGPUBuffer->scopes.TryPush(scope))
+		{
+			m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void TraceProfiler::WriteCounter(char const* name, uint64_t ticks, std::span<CounterValue const> values)
+	{
+		if (!m_IsRecording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		std::scoped_lock lock{ m_CountersMutex };
+		m_SessionCounters.emplace_back(CounterSample{ name, ticks, { values.begin(), values.end() } });
+	}
+
+	void TraceProfiler::EndSession()
+	{
+		// The flight recorder is only written by WriteFlightRecording
+		if (m_IsFlightSession)
+		{
+			return;
+		}
+
+		auto const ticksPerMicrosecond{ StopRecording() };
+		if (!ticksPerMicrosecond)
+		{
+			return;
+		}
+
+		m_TraceStartTicks = m_SessionStartTicks;
+		WriteTrace(*ticksPerMicrosecond);
+		LogDroppedScopes();
+
+		if (m_FlightFrameCount > 0)
+		{
+			StartFlightSession();
+		}
+	}
+
+	bool TraceProfiler::BeginFlightRecordingInternal(uint32_t frameCount)
+	{
+		m_FlightFrameCount = std::max(frameCount, 1u);
+
+		// A running session hands over to the flight recorder when it ends
+		if (!m_IsRecording.load(std::memory_order_acquire))
+		{
+			StartFlightSession();
+		}
+
+		return true;
+	}
+
+	void TraceProfiler::EndFlightRecordingFrame(uint64_t ticks)
+	{
+		if (!m_IsFlightSession)
+		{
+			return;
+		}
+
+		m_FlightFrameEnds[m_NextFlightFrame] = ticks;
+		m_NextFlightFrame = (m_NextFlightFrame + 1) % static_cast<uint32_t>(m_FlightFrameEnds.size());
+
+		// The oldest end in the ring is the start of the oldest frame kept, 0 until the ring is full
+		m_FlightCutoffTicks.store(m_FlightFrameEnds[m_NextFlightFrame], std::memory_order_relaxed);
+	}
+
+	void TraceProfiler::WriteFlightRecording(std::string const& path)
+	{
+		if (!m_IsFlightSession)
+		{
+			ME_LOG_WARN(LogCategory::Core, "A session replaced the flight recording, {} isn't written", path);
+			return;
+		}
+
+		m_IsFlightSession = false;
+		auto const ticksPerMicrosecond{ StopRecording() };
+		if (!ticksPerMicrosecond)
+		{
+			return;
+		}
+
+		fileName = path;
+		m_TraceStartTicks = std::max(m_SessionStartTicks, m_FlightCutoffTicks.load(std::memory_order_relaxed));
+		WriteTrace(*ticksPerMicrosecond);
+		LogDroppedScopes();
+
+		StartFlightSession();
+	}
+
+	void TraceProfiler::StartRecording()
+	{
+		// Scopes that ended after the last session did, the session lists keep their memory
+		Drain(false);
+		{
+			std::scoped_lock lock{ m_CountersMutex };
+			m_SessionCounters.clear();
+		}
+
+		m_DroppedCount.store(0, std::memory_order_relaxed);
+		m_FlightCutoffTicks.store(0, std::memory_order_relaxed);
+		m_SessionStartTime = std::chrono::steady_clock::now();
+		m_SessionStartTicks = ReadTraceClock();
+
+		m_DrainThread = std::jthread{ [this](std::stop_token const& stopToken) { DrainLoop(stopToken); } };
+		m_IsRecording.store(true, std::memory_order_release);
+	}
+
+	std::optional<double> TraceProfiler::StopRecording()
+	{
+		if (!m_IsRecording.exchange(false, std::memory_order_acq_rel))
+		{
+			return std::nullopt;
+		}
+
+		uint64_t const endTicks{ ReadTraceClock() };
+		auto const endTime{ std::chrono::steady_clock::now() };
+
+		m_DrainThread.request_stop();
+		m_DrainThread.join();
+
+		// Whatever was pushed before recording stopped, later scopes are dropped by the next session
+		Drain(true);
+
+		double const seconds{ std::chrono::duration<double>(endTime - m_SessionStartTime).count() };
+		return seconds > 0.0 ? static_cast<double>(endTicks - m_SessionStartTicks) / seconds / 1'000'000.0 : TraceClockFrequency() / 1'000'000.0;
+	}
+
+	void TraceProfiler::StartFlightSession()
+	{
+		// One more end than frames, the oldest one is where the first frame kept starts
+		m_FlightFrameEnds.assign(m_FlightFrameCount + 1, 0);
+		m_NextFlightFrame = 0;
+
+		StartRecording();
+		m_IsFlightSession = true;
+	}
+
+	void TraceProfiler::LogDroppedScopes() const
+	{
+		if (uint64_t const dropped{ m_DroppedCount.load(std::memory_order_relaxed) }; dropped > 0)
+		{
+			ME_LOG_WARN(LogCategory::Core, "{} profiler scopes were dropped, a thread's trace buffer was full", dropped);
+		}
+	}
+
+	TraceProfiler::ThreadBuffer& TraceProfiler::GetThreadBuffer()
+	{
+		// Usually there is one profiler, remember the buffer this thread used last
+		thread_local struct
+		{
+			uint32_t profilerID{ UINT32_MAX };
+			ThreadBuffer* pBuffer{ nullptr };
+		} cache{};
+
+		if (cache.profilerID == m_ID)
+		{
+			return *cache.pBuffer;
+		}
+
+		std::scoped_lock lock{ m_BuffersMutex };
+
+		auto const owner{ std::this_thread::get_id() };
+		auto it{ std::ranges::find_if(m_ThreadBuffers, [owner](auto const& pBuffer) { return pBuffer->owner == owner; }) };
+		if (it == m_ThreadBuffers.end())
+		{
+			it = m_ThreadBuffers.emplace(m_ThreadBuffers.end(), std::make_unique<ThreadBuffer>(owner));
+		}
+
+		cache = { m_ID, it->get() };
+		return **it;
+	}
+
+	void TraceProfiler::DrainLoop(std::stop_token const& stopToken)
+	{
+		while (!stopToken.stop_requested())
+		{
+			{
+				std::unique_lock lock{ m_DrainMutex };
+				m_DrainCondition.wait_for(lock, stopToken, DRAIN_INTERVAL, [] { return false; });
+			}
+
+			Drain(true);
+		}
+	}
+
+	void TraceProfiler::Drain(bool keep)
+	{
+		// Threads can register while draining, only the list itself is locked
+		std::vector<ThreadBuffer*> buffers{};
+		{
+			std::scoped_lock lock{ m_BuffersMutex };
+			buffers.reserve(m_ThreadBuffers.size());
+			for (auto const& pBuffer : m_ThreadBuffers)
+			{
+				buffers.emplace_back(pBuffer.get());
+			}
+		}
+
+		uint64_t const cutoff{ m_FlightCutoffTicks.load(std::memory_order_relaxed) };
+
+		for (auto* pBuffer : buffers)
+		{
+			if (keep)
+			{
+				pBuffer->scopes.PopAll([pBuffer](TraceScope const& scope) { pBuffer->sessionScopes.emplace_back(scope); });
+
+				// Flight recorder, scopes are pushed when they end so the ones that ended before the oldest frame kept are in front
+				if (cutoff > 0)
+				{
+					auto const kept{ std::ranges::find_if(pBuffer->sessionScopes, [cutoff](TraceScope const& scope) { return scope.end >= cutoff; }) };
+					pBuffer->sessionScopes.erase(pBuffer->sessionScopes.begin(), kept);
+				}
+			}
+			else
+			{
+				pBuffer->scopes.PopAll([](TraceScope const&) {});
+				pBuffer->sessionScopes.clear();
+			}
+		}
+
+		if (keep && cutoff > 0)
+		{
+			std::scoped_lock lock{ m_CountersMutex };
+			auto const kept{ std::ranges::find_if(m_SessionCounters, [cutoff](CounterSample const& sample) { return sample.ticks >= cutoff; }) };
+			m_SessionCounters.erase(m_SessionCounters.begin(), kept);
+		}
+	}
+
+	void TraceProfiler::WriteTrace(double ticksPerMicrosecond)
+	{
+		fileName += ".json";
+		FixFilePath(fileName.c_str());
+
+		std::ofstream file{ fileName, std::ios::binary };
+		if (!file.is_open())
+		{
+			ME_LOG_ERROR(LogCategory::Core, "Failed to open the file: {}", fileName);
+			return;
+		}
+
+		fmt::memory_buffer json{};
+		fmt::format_to(std::back_inserter(json), R"({{"otherData":{{}},"traceEvents":[)");
+
+		bool isFirst{ true };
+		uint32_t threadIndex{ 0 };
+
+		std::scoped_lock lock{ m_BuffersMutex };
+		for (auto const& pBuffer : m_ThreadBuffers)
+		{
+			if (pBuffer.get() == m_pGPUBuffer && !pBuffer->sessionScopes.empty())
+			{
+				if (!isFirst)
+				{
+					json.push_back(',');
+				}
+				isFirst = false;
+
+				fmt::format_to(std::back_inserter(json), R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"GPU"}}}})", threadIndex);
+			}
+
+			for (auto const& scope : pBuffer->sessionScopes)
+			{
+				// Scopes that started before the trace are cut off at its start
+				double const start{ scope.start > m_TraceStartTicks ? static_cast<double>(scope.start - m_TraceStartTicks) / ticksPerMicrosecond : 0.0 };
+				double const end{ scope.end > m_TraceStartTicks ? static_cast<double>(scope.end - m_TraceStartTicks) / ticksPerMicrosecond : 0.0 };
+
+				if (!isFirst)
+				{
+					json.push_back(',');
+				}
+				isFirst = false;
+
+				fmt::format_to(std::back_inserter(json), R"({{"cat":"{}","name":)", scope.isFunction ? "function" : "scope");
+				WriteJsonString(json, scope.name);
+				fmt::format_to(std::back_inserter(json), R"(,"ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"depth":{}}}}})", threadIndex, start, end - start, scope.depth);
+
+				// Keeps the memory from growing over a long session
+				if (json.size() > 1 << 20)
+				{
+					file.write(json.data(), static_cast<std::streamsize>(json.size()));
+					json.clear();
+				}
+			}
+
+			pBuffer->sessionScopes.clear();
+			++threadIndex;
+		}
+
+		std::scoped_lock countersLock{ m_CountersMutex };
+		for (auto const& sample : m_SessionCounters)
+		{
+			double const timestamp{ sample.ticks > m_TraceStartTicks ? static_cast<double>(sample.ticks - m_TraceStartTicks) / ticksPerMicrosecond : 0.0 };
+
+			if (!isFirst)
+			{
+				json.push_back(',');
+			}
+			isFirst = false;
+
+			fmt::format_to(std::back_inserter(json), R"({{"name":)");
+			WriteJsonString(json, sample.name);
+			fmt::format_to(std::back_inserter(json), R"(,"ph":"C","pid":0,"ts":{:.3f},"args":{{)", timestamp);
+			for (uint32_t index{ 0 }; index < static_cast<uint32_t>(sample.values.size()); ++index)
+			{
+				if (index > 0)
+				{
+					json.push_back(',');
+				}
+				WriteJsonString(json, sample.values[index].name);
+				fmt::format_to(std::back_inserter(json), ":{:.0f}", sample.values[index].value);
+			}
+			fmt::format_to(std::back_inserter(json), "}}}}");
+		}
+		m_SessionCounters.clear();
+
+		fmt::format_to(std::back_inserter(json), "]}}");
+		file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	}
+}
@@ -0,0 +1,133 @@
+#ifndef MAUCOR_TRACEPROFILER_H
+#define MAUCOR_TRACEPROFILER_H
+
+#include "Profiling/Profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "Containers/SPSCQueue.h"
+
+namespace MauCor
+{
+	/*
+	 * Every profiling thread pushes its scopes as fixed size TraceScopes (name pointer, start & end ticks, depth) into its own lock-free ring.
+	 * No lock is taken & nothing is allocated or formatted after a thread's first scope.
+	 * While a session runs a drain thread moves the rings' contents into per thread lists every DRAIN_INTERVAL.
+	 * The Chrome trace JSON (chrome://tracing, Perfetto) is only written when the session ends.
+	 * A full ring drops the scope, the amount is logged at the end of the session.
+	 * GPU scopes get a ring of their own that is written as a separate "GPU" thread.
+	 * Counter samples (e.g memory per tag) are written once per frame, they are kept in a locked list.
+	 * As a flight recorder (BeginFlightRecording) it records while no session runs & the drain drops what ended before the last frames.
+	 * A session stops the flight recorder without writing it, it records again once the session ended.
+	 */
+	class TraceProfiler final : public Profiler
+	{
+	public:
+		TraceProfiler();
+		virtual ~TraceProfiler() override;
+
+		virtual void BeginSessionInternal(std::string const& name, size_t reserveSize = 100'000) override;
+
+		virtual void WriteProfile(ProfileResult const& result, bool isFunction) override;
+		virtual void WriteProfile(std::string const& name) override;
+		virtual void WriteScope(TraceScope const& scope) override;
+		virtual void WriteGPUScope(TraceScope const& scope) override;
+		virtual void WriteCounter(char const* name, uint64_t ticks, std::span<CounterValue const> values) override;
+
+		virtual void EndSession() override;
+
+		TraceProfiler(TraceProfiler const&) = delete;
+		TraceProfiler(TraceProfiler&&) = delete;
+		TraceProfiler& operator=(TraceProfiler const&) = delete;
+		TraceProfiler& operator=(TraceProfiler&&) = delete;
+
+	protected:
+		virtual bool BeginFlightRecordingInternal(uint32_t frameCount) override;
+		virtual void EndFlightRecordingFrame(uint64_t ticks) override;
+		virtual void WriteFlightRecording(std::string const& path) override;
+
+	private:
+		// 2 MiB per thread, more than a thread doing nothing but empty scopes fills in DRAIN_INTERVAL
+		static uint32_t constexpr THREAD_BUFFER_CAPACITY{ 1 << 16 };
+		static constexpr std::chrono::milliseconds DRAIN_INTERVAL{ 5 };
+
+		struct ThreadBuffer final
+		{
+			explicit ThreadBuffer(std::thread::id owner) :
+				owner{ owner },
+				scopes{ THREAD_BUFFER_CAPACITY }
+			{
+			}
+
+			std::thread::id const owner;
+			// The owning thread pushes, the drain thread (or the session owner while it isn't running) pops
+			SPSCQueue<TraceScope> scopes;
+			// Drained scopes of the current session, drain side only
+			std::vector<TraceScope> sessionScopes{};
+		};
+
+		struct CounterSample final
+		{
+			char const* name;
+			uint64_t ticks;
+			std::vector<CounterValue> values;
+		};
+
+		// Tells the thread local buffer cache apart from other trace profilers
+		uint32_t const m_ID;
+
+		std::atomic<bool> m_IsRecording{ false };
+		std::atomic<uint64_t> m_DroppedCount{ 0 };
+
+		std::mutex m_BuffersMutex{};
+		// Kept until the profiler is destroyed, also when their thread is gone
+		std::vector<std::unique_ptr<ThreadBuffer>> m_ThreadBuffers{};
+		// In m_ThreadBuffers, owned by no thread
+		ThreadBuffer* m_pGPUBuffer{ nullptr };
+
+		std::mutex m_CountersMutex{};
+		std::vector<CounterSample> m_SessionCounters{};
+
+		// Both clocks at the start of the session, the ticks are converted with the rate measured over the session
+		uint64_t m_SessionStartTicks{ 0 };
+		std::chrono::steady_clock::time_point m_SessionStartTime{};
+		// Time 0 of the written trace, the session's start or the oldest frame of a flight recording
+		uint64_t m_TraceStartTicks{ 0 };
+
+		// Frames the flight recorder keeps, 0 when it is off
+		uint32_t m_FlightFrameCount{ 0 };
+		// The current recording is the flight recorder's, not a session
+		bool m_IsFlightSession{ false };
+		// End ticks of the last m_FlightFrameCount + 1 frames, a ring
+		std::vector<uint64_t> m_FlightFrameEnds{};
+		uint32_t m_NextFlightFrame{ 0 };
+		// The drain drops what ended before it
+		std::atomic<uint64_t> m_FlightCutoffTicks{ 0 };
+
+		std::mutex m_DrainMutex{};
+		std::condition_variable_any m_DrainCondition{};
+		// Only runs during a session
+		std::jthread m_DrainThread{};
+
+		[[nodiscard]] ThreadBuffer& GetThreadBuffer();
+
+		void StartRecording();
+		// Ticks per microsecond over the recording, none if nothing was recording
+		[[nodiscard]] std::optional<double> StopRecording();
+		void StartFlightSession();
+		void LogDroppedScopes() const;
+
+		void DrainLoop(std::stop_token const& stopToken);
+		// Moves the rings' contents to the session lists, one thread at a time
+		void Drain(bool keep);
+		void WriteTrace(double ticksPerMicrosecond);
+	};
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef MAUENG_ENGINECONFIG_H
 #define MAUENG_ENGINECONFIG_H
 
+#include "Logger/LogCategories.h"
+
 namespace MauEng
 {
 	// Debug output colours
@@ -24,6 +26,9 @@ namespace MauEng
 #define ENABLE_PROFILER 0
 #define	USE_OPTICK_LIBRARY 0
 
+// Replace the global operator new & delete to count heap allocations per memory tag (MauCor::MemoryTagScope)
+#define ENABLE_MEMORY_TRACKING 0
+
 #ifdef MAUENG_LOG_TO_FILE
 	#undef ENABLE_FILE_LOGGING
 	#define ENABLE_FILE_LOGGING 1
@@ -44,6 +49,11 @@ namespace MauEng
 	#define ENABLE_PROFILER 1
 #endif
 
+#ifdef MAUENG_ENABLE_MEMORY_TRACKING
+	#undef ENABLE_MEMORY_TRACKING
+	#define ENABLE_MEMORY_TRACKING 1
+#endif
+
 #if ENABLE_PROFILER
 	uint32_t constexpr NUM_FRAMES_TO_PROFILE{ 5 };
 
@@ -62,6 +72,67 @@ namespace MauEng
 
 	bool constexpr LIMIT_FPS{ true };
 	bool constexpr LOG_FPS{ true };
+
+	// Time the phases of every frame & keep a histogram of the frame times, written to Profiling/FrameTimes.json/.csv on exit
+	bool constexpr USE_FRAME_TIMER{ true };
+	// Slower frames are logged as hitches, with the profiler enabled the frames around one are captured (Profiling/Hitch)
+	float constexpr HITCH_THRESHOLD_MS{ 50.f };
+	// The trace keeps recording the last frames while no session runs (a flight recorder), a hitch writes them plus the frames after it
+	uint32_t constexpr HITCH_CAPTURE_FRAMES_BEFORE{ 60 };
+	uint32_t constexpr HITCH_CAPTURE_FRAMES_AFTER{ 10 };
+	// Frames before another hitch is captured
+	uint32_t constexpr HITCH_CAPTURE_COOLDOWN_FRAMES{ 300 };
+
+	// ME_LOG & ME_LOG_BINARY calls below this priority are compiled out, their arguments are never evaluated
+	// Set with the MAUENG_MIN_LOG_PRIORITY CMake option (e.g Info), release builds keep warnings & up by default
+	// The order is Trace, Info, Debug, Warn, Error, Fatal: Debug is above Info, Warn is the lowest priority that drops debug logs
+#if defined(MAUENG_MIN_LOG_PRIORITY)
+	MauCor::LogPriority constexpr MIN_LOG_PRIORITY{ MauCor::LogPriority::MAUENG_MIN_LOG_PRIORITY };
+#elif defined(NDEBUG)
+	MauCor::LogPriority constexpr MIN_LOG_PRIORITY{ MauCor::LogPriority::Warn };
+#else
+	MauCor::LogPriority constexpr MIN_LOG_PRIORITY{ MauCor::LogPriority::Trace };
+#endif
+
+	// Compiled out minimum per category on top of MIN_LOG_PRIORITY, e.g return Warn for Renderer to silence it in every build
+	[[nodiscard]] constexpr MauCor::LogPriority MinCategoryLogPriority(MauCor::LogCategory category) noexcept
+	{
+		switch (category)
+		{
+		case MauCor::LogCategory::Core: return MauCor::LogPriority::Trace;
+		case MauCor::LogCategory::Engine: return MauCor::LogPriority::Trace;
+		case MauCor::LogCategory::Renderer: return MauCor::LogPriority::Trace;
+		case MauCor::LogCategory::Game: return MauCor::LogPriority::Trace;
+
+		default: return MauCor::LogPriority::Trace;
+		}
+	}
+
+	// Format log messages into a queue & let a writer thread do the console / file output
+	bool constexpr USE_ASYNC_LOGGING{ true };
+	// With file logging, write a binary log (Log.bin) instead of text, decode it with MauEngLogDecoder
+	bool constexpr USE_BINARY_FILE_LOGGING{ false };
+
+	// Keep rolling per scope stats (PROFILER.GetStats, F2 logs them) without a capture
+	bool constexpr USE_PROFILER_STATS{ ENABLE_PROFILER };
+	uint32_t constexpr PROFILER_STATS_FRAME_COUNT{ 600 };
+
+	// Without optick: record scopes into per thread rings & write the chrome trace when the session ends
+	// When off every scope is formatted into the shared JSON buffer right away (GoogleProfiler)
+	bool constexpr USE_TRACE_PROFILER{ true };
+	// Time the render passes on the GPU with timestamp queries, shown on a GPU track of the trace & in the scope stats
+	bool constexpr USE_GPU_PROFILER{ ENABLE_PROFILER };
+
+	// Record draws into a frame snapshot on the game thread & let a dedicated thread submit it to the GPU
+	bool constexpr USE_RENDER_THREAD{ true };
+
+	// Only queue the meshes whose bounds overlap the camera frustum (uses the scene's spatial index)
+	bool constexpr USE_FRUSTUM_CULLING{ true };
+
+	// Upload translation, rotation & scale per instance & let a compute shader build the model & normal matrices
+	// When off the model matrices are built on the CPU by CTransform::UpdateMatrix
+	// Off until the shader is validated against the CPU path on lavapipe (VALIDATE_GPU_TRANSFORMS)
+	bool constexpr USE_GPU_TRANSFORMS{ false };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef MAUCOR_MPSCQUEUE_H
+#define MAUCOR_MPSCQUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+
+namespace MauCor
+{
+	/*
+	 * Bounded lock-free queue for many producers & a single consumer (Vyukov's bounded queue).
+	 * Every slot has a sequence number that tells whose turn it is: producers claim a position with a CAS,
+	 * fill the slot in place & publish it by bumping the sequence, the consumer reads slots in position order.
+	 * Nothing is allocated after construction, a full queue makes TryPush fail instead of growing.
+	 */
+	template<typename ValueType>
+	class MPSCQueue final
+	{
+	public:
+		// Rounded up to a power of two
+		explicit MPSCQueue(uint32_t capacity) :
+			m_Capacity{ std::bit_ceil(capacity < 2 ? 2u : capacity) },
+			m_Mask{ m_Capacity - 1 },
+			m_pSlots{ std::make_unique<Slot[]>(m_Capacity) }
+		{
+			for (uint32_t i{ 0 }; i < m_Capacity; ++i)
+			{
+				m_pSlots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+		~MPSCQueue() = default;
+
+		MPSCQueue(MPSCQueue const&) = delete;
+		MPSCQueue(MPSCQueue&&) = delete;
+		MPSCQueue& operator=(MPSCQueue const&) = delete;
+		MPSCQueue& operator=(MPSCQueue&&) = delete;
+
+		// write(ValueType&) fills the claimed slot, it is not called when the queue is full
+		// Safe to call from any thread
+		template<typename WriteFunc>
+			requires std::invocable<WriteFunc, ValueType&>
+		[[nodiscard]] bool TryPush(WriteFunc&& write)
+		{
+			uint64_t position{ m_EnqueuePosition.load(std::memory_order_relaxed) };
+			Slot* pSlot{ nullptr };
+
+			for (;;)
+			{
+				pSlot = &m_pSlots[position & m_Mask];
+				uint64_t const sequence{ pSlot->sequence.load(std::memory_order_acquire) };
+
+				if (sequence == position)
+				{
+					// Slot is free, claim the position
+					if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (sequence < position)
+				{
+					// The consumer hasn't read this slot one lap ago yet
+					return false;
+				}
+				else
+				{
+					// Another producer claimed it first
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			write(pSlot->value);
+			pSlot->sequence.store(position + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		[[nodiscard]] bool TryPush(ValueType const& value)
+		{
+			return TryPush([&value](ValueType& slot) { slot = value; });
+		}
+
+		// read(ValueType&) is called with the oldest published value, the slot is reused once it returns
+		// Only one thread may pop
+		template<typename ReadFunc>
+			requires std::invocable<ReadFunc, ValueType&>
+		[[nodiscard]] bool TryPop(ReadFunc&& read)
+		{
+			uint64_t const position{ m_DequeuePosition.load(std::memory_order_relaxed) };
+			Slot& slot{ m_pSlots[position & m_Mask] };
+
+			// Empty, or the producer of the oldest position hasn't published it yet
+			if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+			{
+				return false;
+			}
+
+			read(slot.value);
+
+			// Free for the producer one lap later
+			slot.sequence.store(position + m_Capacity, std::memory_order_release);
+			m_DequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		// Approximate when other threads push or pop at the same time
+		[[nodiscard]] uint32_t Size() const noexcept
+		{
+			uint64_t const dequeued{ m_DequeuePosition.load(std::memory_order_relaxed) };
+			uint64_t const enqueued{ m_EnqueuePosition.load(std::memory_order_relaxed) };
+			return enqueued > dequeued ? static_cast<uint32_t>(enqueued - dequeued) : 0;
+		}
+		[[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+		[[nodiscard]] uint32_t Capacity() const noexcept { return m_Capacity; }
+
+		// Total amount of positions claimed by producers / read by the consumer
+		[[nodiscard]] uint64_t PushCount() const noexcept { return m_EnqueuePosition.load(std::memory_order_acquire); }
+		[[nodiscard]] uint64_t PopCount() const noexcept { return m_DequeuePosition.load(std::memory_order_acquire); }
+
+	private:
+		// Fixed instead of std::hardware_destructive_interference_size, which may differ between translation units
+		static uint32_t constexpr CACHE_LINE_SIZE{ 64 };
+
+		// Own cache line per slot, producers writing neighbouring slots don't share one
+		struct alignas(CACHE_LINE_SIZE) Slot final
+		{
+			std::atomic<uint64_t> sequence{ 0 };
+			ValueType value{};
+		};
+
+		uint32_t const m_Capacity;
+		uint32_t const m_Mask;
+		std::unique_ptr<Slot[]> m_pSlots;
+
+		// Separate cache lines, producers & the consumer don't contend on each other's position
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_EnqueuePosition{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_DequeuePosition{ 0 };
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef MAUCOR_SPSCQUEUE_H
+#define MAUCOR_SPSCQUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+
+namespace MauCor
+{
+	/*
+	 * Bounded lock-free ring for a single producer & a single consumer.
+	 * Each side owns its position & keeps a cached copy of the other one, so it only reads the other side's cache line when it looks full / empty.
+	 * Nothing is allocated after construction, a full ring makes TryPush fail instead of growing.
+	 */
+	template<typename ValueType>
+	class SPSCQueue final
+	{
+	public:
+		// Rounded up to a power of two
+		explicit SPSCQueue(uint32_t capacity) :
+			m_Capacity{ std::bit_ceil(capacity < 2 ? 2u : capacity) },
+			m_Mask{ m_Capacity - 1 },
+			m_pValues{ std::make_unique<ValueType[]>(m_Capacity) }
+		{
+		}
+		~SPSCQueue() = default;
+
+		SPSCQueue(SPSCQueue const&) = delete;
+		SPSCQueue(SPSCQueue&&) = delete;
+		SPSCQueue& operator=(SPSCQueue const&) = delete;
+		SPSCQueue& operator=(SPSCQueue&&) = delete;
+
+		// Producer thread only
+		[[nodiscard]] bool TryPush(ValueType const& value) noexcept
+		{
+			uint64_t const position{ m_WritePosition.load(std::memory_order_relaxed) };
+
+			if (position - m_CachedReadPosition >= m_Capacity)
+			{
+				m_CachedReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+				if (position - m_CachedReadPosition >= m_Capacity)
+				{
+					return false;
+				}
+			}
+
+			m_pValues[position & m_Mask] = value;
+			m_WritePosition.store(position + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		// read(ValueType&) is called for every value pushed so far, oldest first. Returns the amount read
+		// Consumer thread only
+		template<typename ReadFunc>
+			requires std::invocable<ReadFunc, ValueType&>
+		uint32_t PopAll(ReadFunc&& read)
+		{
+			uint64_t const first{ m_ReadPosition.load(std::memory_order_relaxed) };
+			uint64_t const last{ m_WritePosition.load(std::memory_order_acquire) };
+
+			for (uint64_t position{ first }; position < last; ++position)
+			{
+				read(m_pValues[position & m_Mask]);
+			}
+
+			// The slots are free for the producer once they are read
+			m_ReadPosition.store(last, std::memory_order_release);
+
+			return static_cast<uint32_t>(last - first);
+		}
+
+		// Approximate when the other side pushes or pops at the same time
+		[[nodiscard]] uint32_t Size() const noexcept
+		{
+			uint64_t const read{ m_ReadPosition.load(std::memory_order_relaxed) };
+			uint64_t const written{ m_WritePosition.load(std::memory_order_relaxed) };
+			return written > read ? static_cast<uint32_t>(written - read) : 0;
+		}
+		[[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+		[[nodiscard]] uint32_t Capacity() const noexcept { return m_Capacity; }
+
+	private:
+		// Fixed instead of std::hardware_destructive_interference_size, which may differ between translation units
+		static uint32_t constexpr CACHE_LINE_SIZE{ 64 };
+
+		uint32_t const m_Capacity;
+		uint32_t const m_Mask;
+		std::unique_ptr<ValueType[]> m_pValues;
+
+		// Producer side, with its last look at the consumer's position
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_WritePosition{ 0 };
+		uint64_t m_CachedReadPosition{ 0 };
+
+		// Consumer side
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_ReadPosition{ 0 };
+	};
+}
+
+#endif
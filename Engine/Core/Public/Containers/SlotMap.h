@@ -0,0 +1,153 @@
+#ifndef MAUCOR_SLOTMAP_H
+#define MAUCOR_SLOTMAP_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Asserts/Asserts.h"
+
+namespace MauCor
+{
+	/*
+	 * Generational handle into a SlotMap, packed in 32 bits so it can be stored wherever a plain id was.
+	 * The low bits are the slot index, the high bits the generation of the slot when the handle was made.
+	 * A slot gets a new generation when it is erased, handles to the old value are stale from then on.
+	 * The first value in a slot has generation 0, so its handle is the same as the slot index.
+	 */
+	template<uint32_t IndexBits>
+	struct GenerationalHandle final
+	{
+		static_assert(IndexBits > 0 && IndexBits < 32);
+
+		static uint32_t constexpr INDEX_MASK{ (1u << IndexBits) - 1 };
+		static uint32_t constexpr GENERATION_MASK{ ~INDEX_MASK >> IndexBits };
+		// The last index is never handed out, so the handle with all bits set is never valid
+		static uint32_t constexpr MAX_SLOTS{ INDEX_MASK };
+		static uint32_t constexpr INVALID{ UINT32_MAX };
+
+		[[nodiscard]] static constexpr uint32_t Make(uint32_t index, uint32_t generation) noexcept
+		{
+			return (index & INDEX_MASK) | ((generation & GENERATION_MASK) << IndexBits);
+		}
+		[[nodiscard]] static constexpr uint32_t Index(uint32_t handle) noexcept { return handle & INDEX_MASK; }
+		[[nodiscard]] static constexpr uint32_t Generation(uint32_t handle) noexcept { return handle >> IndexBits; }
+	};
+
+	/*
+	 * Values in a flat array addressed by generational handles, a lookup is an array index & a generation compare.
+	 * Erased slots are reused, values are not moved so the slot index is stable (e.g to index GPU arrays with).
+	 */
+	template<typename ValueType, uint32_t IndexBits = 20>
+	class SlotMap final
+	{
+	public:
+		using Handle = GenerationalHandle<IndexBits>;
+
+		SlotMap() = default;
+		~SlotMap() = default;
+
+		SlotMap(SlotMap const&) = default;
+		SlotMap(SlotMap&&) noexcept = default;
+		SlotMap& operator=(SlotMap const&) = default;
+		SlotMap& operator=(SlotMap&&) noexcept = default;
+
+		void Reserve(uint32_t count)
+		{
+			m_Values.reserve(count);
+			m_Generations.reserve(count);
+		}
+
+		template<typename... Args>
+		[[nodiscard]] uint32_t Emplace(Args&&... args)
+		{
+			if (!m_FreeSlots.empty())
+			{
+				uint32_t const index{ m_FreeSlots.back() };
+				m_FreeSlots.pop_back();
+
+				m_Values[index] = ValueType{ std::forward<Args>(args)... };
+				m_Generations[index] &= ~FREE_SLOT;
+				++m_Size;
+
+				return Handle::Make(index, m_Generations[index]);
+			}
+
+			ME_ASSERT(m_Values.size() < Handle::MAX_SLOTS);
+
+			uint32_t const index{ static_cast<uint32_t>(m_Values.size()) };
+			m_Values.emplace_back(std::forward<Args>(args)...);
+			m_Generations.emplace_back(0);
+			++m_Size;
+
+			return Handle::Make(index, 0);
+		}
+
+		// The slot is reused by a later Emplace, handles to it are stale from now on
+		void Erase(uint32_t handle) noexcept
+		{
+			ME_ASSERT(IsValid(handle));
+
+			uint32_t const index{ Handle::Index(handle) };
+			m_Values[index] = ValueType{};
+			m_Generations[index] = ((m_Generations[index] + 1) & Handle::GENERATION_MASK) | FREE_SLOT;
+			--m_Size;
+
+			m_FreeSlots.emplace_back(index);
+		}
+
+		[[nodiscard]] bool IsValid(uint32_t handle) const noexcept
+		{
+			uint32_t const index{ Handle::Index(handle) };
+			return index < m_Generations.size() && m_Generations[index] == Handle::Generation(handle);
+		}
+
+		[[nodiscard]] ValueType& Get(uint32_t handle) noexcept
+		{
+			ME_ASSERT(IsValid(handle));
+			return m_Values[Handle::Index(handle)];
+		}
+		[[nodiscard]] ValueType const& Get(uint32_t handle) const noexcept
+		{
+			ME_ASSERT(IsValid(handle));
+			return m_Values[Handle::Index(handle)];
+		}
+
+		[[nodiscard]] ValueType* TryGet(uint32_t handle) noexcept
+		{
+			return IsValid(handle) ? &m_Values[Handle::Index(handle)] : nullptr;
+		}
+		[[nodiscard]] ValueType const* TryGet(uint32_t handle) const noexcept
+		{
+			return IsValid(handle) ? &m_Values[Handle::Index(handle)] : nullptr;
+		}
+
+		// Amount of live values
+		[[nodiscard]] uint32_t Size() const noexcept { return m_Size; }
+		// Amount of slots, erased ones included
+		[[nodiscard]] uint32_t SlotCount() const noexcept { return static_cast<uint32_t>(m_Values.size()); }
+
+		// Values per slot index, erased slots hold a default value
+		[[nodiscard]] std::vector<ValueType> const& GetValues() const noexcept { return m_Values; }
+
+		void Clear() noexcept
+		{
+			m_Values.clear();
+			m_Generations.clear();
+			m_FreeSlots.clear();
+			m_Size = 0;
+		}
+
+	private:
+		// Set on the generation of erased slots, no handle has this bit in its generation
+		static uint32_t constexpr FREE_SLOT{ 1u << 31 };
+
+		std::vector<ValueType> m_Values{};
+		std::vector<uint32_t> m_Generations{};
+		std::vector<uint32_t> m_FreeSlots{};
+
+		uint32_t m_Size{ 0 };
+	};
+}
+
+#endif
@@ -21,5 +21,6 @@
 #include "Asserts/Asserts.h"
 
 #include "Math/Rotator.h"
+#include "Math/BoundingVolumes.h"
 
 #endif
@@ -30,8 +30,9 @@ namespace MauCor
 #pragma region EasyAccessHelpers
 #define LOGGER MauCor::CoreServiceLocator::GetLogger()
 
+	// Compiled out below MIN_LOG_PRIORITY, the arguments are only evaluated when the logger accepts the message
 	#define ME_LOG(priority, category, fmtStr, ...) \
-				LOGGER.Log(priority, category, fmtStr, __VA_ARGS__)
+				ME_LOG_TO(LOGGER, priority, category, fmtStr, __VA_ARGS__)
 
 	#define ME_LOG_TRACE(category, fmtStr, ...) ME_LOG(MauCor::LogPriority::Trace, category, fmtStr, __VA_ARGS__)
 	#define ME_LOG_INFO(category, fmtStr, ...) ME_LOG(MauCor::LogPriority::Info, category, fmtStr, __VA_ARGS__)
@@ -40,6 +41,10 @@ namespace MauCor
 	#define ME_LOG_ERROR(category, fmtStr, ...) ME_LOG(MauCor::LogPriority::Error, category, fmtStr, __VA_ARGS__)
 	#define ME_LOG_FATAL(category, fmtStr, ...) ME_LOG(MauCor::LogPriority::Fatal, category, fmtStr, __VA_ARGS__)
 
+	// Only the call site id & the arguments are stored, for logging in hot loops (see Logger/BinaryLog.h)
+	#define ME_LOG_BINARY(priority, category, fmtStr, ...) \
+				ME_LOG_BINARY_TO(LOGGER, priority, category, fmtStr, __VA_ARGS__)
+
 #define PROFILER MauCor::CoreServiceLocator::GetProfiler()
 	#define CONCAT(x, y) x ## y
 	#define C(x, y) CONCAT(x, y)
@@ -47,13 +52,18 @@ namespace MauCor
 	#define ME_PROFILE_BEGIN_SESSION(name, filepath, ...) PROFILER.BeginSession(name, filepath, __VA_ARGS__);
 	#define ME_PROFILE_END_SESSION() PROFILER.EndSession();
 #if USE_OPTICK
-	#define ME_PROFILE_FUNCTION() OPTICK_EVENT();
-	#define ME_PROFILE_SCOPE(name) OPTICK_EVENT(name);
+	// The timer only feeds the scope stats (USE_PROFILER_STATS), optick records the event itself
+	#define ME_PROFILE_FUNCTION() OPTICK_EVENT(); MauCor::InstrumentorTimer C(timer, __LINE__) { __FUNCTION__, true };
+	#define ME_PROFILE_SCOPE(name) OPTICK_EVENT(name); MauCor::InstrumentorTimer C(timer, __LINE__) { name, false };
+	// Scope with a name that is not a string literal (e.g a system name), optick caches the description of a regular event
+	// The timer gets the profiler's interned copy, the trace & the stats read the name after the string may be gone
+	#define ME_PROFILE_SCOPE_DYNAMIC(name) OPTICK_EVENT_DYNAMIC(name); MauCor::InstrumentorTimer C(timer, __LINE__) { PROFILER.InternScopeName(name), false };
 
 	#define ME_PROFILE_THREAD(name) OPTICK_THREAD(name)
 	#define ME_PROFILE_FRAME() OPTICK_FRAME("MainThread")
 #else
 	#define ME_PROFILE_SCOPE(name) MauCor::InstrumentorTimer C(timer, __LINE__) { name, false };
+	#define ME_PROFILE_SCOPE_DYNAMIC(name) MauCor::InstrumentorTimer C(timer, __LINE__) { PROFILER.InternScopeName(name), false };
 	#define ME_PROFILE_FUNCTION() MauCor::InstrumentorTimer C(timer, __LINE__) { __FUNCTION__, true };
 
 	#define ME_PROFILE_THREAD(name)
@@ -0,0 +1,42 @@
+#ifndef MAUCOR_MAPPEDFILE_H
+#define MAUCOR_MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace MauCor
+{
+	// Read only memory mapped file, the view stays valid for the lifetime of the object
+	class MappedFile final
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(std::filesystem::path const& path);
+		~MappedFile();
+
+		[[nodiscard]] bool IsOpen() const noexcept { return m_pData != nullptr; }
+		[[nodiscard]] std::span<std::byte const> Data() const noexcept { return { m_pData, m_Size }; }
+		[[nodiscard]] std::size_t Size() const noexcept { return m_Size; }
+
+		void Close() noexcept;
+
+		MappedFile(MappedFile const&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+	private:
+		std::byte const* m_pData{ nullptr };
+		std::size_t m_Size{ 0 };
+
+#ifdef _WIN32
+		void* m_FileHandle{ nullptr };
+		void* m_MappingHandle{ nullptr };
+#else
+		int m_FileDescriptor{ -1 };
+#endif
+	};
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef MAUCOR_BINARYLOG_H
+#define MAUCOR_BINARYLOG_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/args.h>
+
+#include "LogCategories.h"
+
+/*
+ * Binary logging: every ME_LOG_BINARY call site owns a static BinaryLogSite holding its format string, file, line & argument types.
+ * Everything about the site is known at compile time, it gets a numeric id the first time it runs.
+ * A call only stores the site id, a timestamp & the raw bytes of the arguments, the text is formatted when the log is decoded.
+ * Loggers without a binary format decode & format it right away, so the macro works with any logger.
+ */
+namespace MauCor
+{
+	// How an argument is stored, strings as a uint32 size followed by the characters
+	enum class BinaryArgType : uint8_t
+	{
+		Bool,
+		Char,
+		Int32,
+		UInt32,
+		Int64,
+		UInt64,
+		Float,
+		Double,
+		String,
+		Pointer
+	};
+
+	template<typename Type>
+	[[nodiscard]] consteval BinaryArgType ToBinaryArgType() noexcept
+	{
+		using T = std::decay_t<Type>;
+
+		if constexpr (std::is_same_v<T, bool>) return BinaryArgType::Bool;
+		else if constexpr (std::is_same_v<T, char>) return BinaryArgType::Char;
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) return sizeof(T) <= 4 ? BinaryArgType::Int32 : BinaryArgType::Int64;
+		else if constexpr (std::is_integral_v<T>) return sizeof(T) <= 4 ? BinaryArgType::UInt32 : BinaryArgType::UInt64;
+		else if constexpr (std::is_same_v<T, float>) return BinaryArgType::Float;
+		else if constexpr (std::is_same_v<T, double>) return BinaryArgType::Double;
+		else if constexpr (std::is_same_v<T, char*> || std::is_same_v<T, char const*> || std::is_convertible_v<T const&, std::string_view>) return BinaryArgType::String;
+		else if constexpr (std::is_pointer_v<T>) return BinaryArgType::Pointer;
+		else static_assert(sizeof(T) == 0, "Type can't be logged in binary, convert it to one of the BinaryArgTypes");
+	}
+
+	template<typename... Args>
+	inline constexpr std::array<BinaryArgType, sizeof...(Args)> BINARY_ARG_TYPES{ ToBinaryArgType<Args>()... };
+
+	// Encoded arguments of a single call, strings are cut off to fit
+	uint32_t constexpr MAX_BINARY_ARGS_SIZE{ 256 };
+
+	struct BinaryLogSite final
+	{
+		std::string_view format;
+		std::string_view file;
+		std::span<BinaryArgType const> argTypes;
+		uint32_t line;
+		LogPriority priority;
+		LogCategory category;
+		uint32_t id;
+	};
+
+	// Adds the site to the process wide site table, ids are handed out in order starting at 0
+	[[nodiscard]] uint32_t RegisterBinaryLogSite(BinaryLogSite const& site);
+	// Copies of the registered sites with id >= first, binary log writers store them next to the records
+	[[nodiscard]] std::vector<BinaryLogSite> GetBinaryLogSites(uint32_t first);
+
+	// The format string is checked against the argument types like fmt::format
+	template<typename... Args>
+	[[nodiscard]] BinaryLogSite MakeBinaryLogSite(LogPriority priority, LogCategory category, fmt::format_string<Args const&...> format, std::string_view file, uint32_t line)
+	{
+		fmt::string_view const formatView{ format };
+
+		BinaryLogSite site{ { formatView.data(), formatView.size() }, file, BINARY_ARG_TYPES<Args...>, line, priority, category, 0 };
+		site.id = RegisterBinaryLogSite(site);
+		return site;
+	}
+
+	namespace Detail
+	{
+		[[nodiscard]] constexpr uint32_t BinaryArgSize(BinaryArgType type) noexcept
+		{
+			switch (type)
+			{
+			case BinaryArgType::Bool:
+			case BinaryArgType::Char: return 1;
+			case BinaryArgType::Int32:
+			case BinaryArgType::UInt32:
+			case BinaryArgType::Float: return 4;
+			case BinaryArgType::String: return sizeof(uint32_t); // The size, the characters come after it
+			default: return 8;
+			}
+		}
+
+		template<typename T>
+		void EncodeBinaryArg(std::byte*& pDst, std::byte const* pEnd, T const& value) noexcept
+		{
+			BinaryArgType constexpr TYPE{ ToBinaryArgType<T>() };
+
+			auto const write{ [&pDst](auto const stored)
+				{
+					std::memcpy(pDst, &stored, sizeof(stored));
+					pDst += sizeof(stored);
+				} };
+
+			if constexpr (TYPE == BinaryArgType::String)
+			{
+				std::string_view string{};
+				if constexpr (std::is_pointer_v<T>)
+				{
+					string = value ? std::string_view{ value } : std::string_view{};
+				}
+				else
+				{
+					string = std::string_view{ value };
+				}
+
+				// Room for the size is reserved by MAX_BINARY_ARGS_SIZE, the characters get what is left
+				uint32_t const size{ static_cast<uint32_t>(std::min<size_t>(string.size(), pEnd - pDst - sizeof(uint32_t))) };
+				write(size);
+				std::memcpy(pDst, string.data(), size);
+				pDst += size;
+			}
+			else if constexpr (TYPE == BinaryArgType::Bool) write(static_cast<uint8_t>(value));
+			else if constexpr (TYPE == BinaryArgType::Char) write(value);
+			else if constexpr (TYPE == BinaryArgType::Int32) write(static_cast<int32_t>(value));
+			else if constexpr (TYPE == BinaryArgType::UInt32) write(static_cast<uint32_t>(value));
+			else if constexpr (TYPE == BinaryArgType::Int64) write(static_cast<int64_t>(value));
+			else if constexpr (TYPE == BinaryArgType::UInt64) write(static_cast<uint64_t>(value));
+			else if constexpr (TYPE == BinaryArgType::Pointer) write(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+			else write(value);
+		}
+	}
+
+	// Smallest encoded size of the arguments, i.e with empty strings
+	template<typename... Args>
+	[[nodiscard]] consteval uint32_t MinBinaryArgsSize() noexcept
+	{
+		return (0 + ... + Detail::BinaryArgSize(ToBinaryArgType<Args>()));
+	}
+
+	// Returns the amount of bytes written
+	template<typename... Args>
+	[[nodiscard]] uint32_t EncodeBinaryArgs(std::span<std::byte, MAX_BINARY_ARGS_SIZE> bytes, Args const&... args) noexcept
+	{
+		static_assert(MinBinaryArgsSize<Args...>() <= MAX_BINARY_ARGS_SIZE, "Too many arguments for a binary log");
+
+		// Strings only take what the arguments after them leave, so every argument fits
+		std::byte* pDst{ bytes.data() };
+		uint32_t remaining{ MinBinaryArgsSize<Args...>() };
+
+		auto const encode{ [&](auto const& arg)
+			{
+				remaining -= Detail::BinaryArgSize(ToBinaryArgType<decltype(arg)>());
+				Detail::EncodeBinaryArg(pDst, bytes.data() + bytes.size() - remaining, arg);
+			} };
+		(encode(args), ...);
+
+		return static_cast<uint32_t>(pDst - bytes.data());
+	}
+
+	// Adds the arguments to the store, false if the bytes don't match the types
+	[[nodiscard]] bool DecodeBinaryArgs(fmt::dynamic_format_arg_store<fmt::format_context>& store, std::span<BinaryArgType const> argTypes, std::span<std::byte const> bytes);
+	// Formatted message, throws fmt::format_error if the bytes don't match the types
+	[[nodiscard]] std::string FormatBinaryLog(std::string_view format, std::span<BinaryArgType const> argTypes, std::span<std::byte const> bytes);
+
+	/*
+	 * File layout, native endianness:
+	 *	header:	 "MEBL", uint32 version
+	 *	records: BinaryLogRecordKind, then
+	 *		Site:	uint32 id, uint8 priority, uint8 category, uint32 line, uint8 arg count, arg types, uint32 size & format, uint32 size & file
+	 *		Event:	uint32 site id, int64 time (ns since the epoch), uint32 size & encoded args
+	 *		Text:	uint8 priority, uint8 category, int64 time, uint32 size & message (already formatted)
+	 * A site is always stored before the first event that uses it.
+	 */
+	std::array<char, 4> constexpr BINARY_LOG_MAGIC{ 'M', 'E', 'B', 'L' };
+	uint32_t constexpr BINARY_LOG_VERSION{ 1 };
+
+	enum class BinaryLogRecordKind : uint8_t
+	{
+		Site,
+		Event,
+		Text
+	};
+
+	struct DecodedLogRecord final
+	{
+		std::chrono::system_clock::time_point time{};
+		LogPriority priority{ LogPriority::Trace };
+		LogCategory category{ LogCategory::Core };
+		std::string message{};
+		// Empty for text records
+		std::string file{};
+		uint32_t line{ 0 };
+	};
+
+	// Reads the records of a binary log back as text (see MauEngLogDecoder)
+	class BinaryLogReader final
+	{
+	public:
+		explicit BinaryLogReader(std::istream& stream);
+		~BinaryLogReader() = default;
+
+		// False when the stream doesn't start with a binary log header of this version
+		[[nodiscard]] bool IsValid() const noexcept { return m_IsValid; }
+
+		// False at the end of the log or on a malformed record (e.g a log cut off by a crash)
+		[[nodiscard]] bool Next(DecodedLogRecord& record);
+
+		BinaryLogReader(BinaryLogReader const&) = delete;
+		BinaryLogReader(BinaryLogReader&&) = delete;
+		BinaryLogReader& operator=(BinaryLogReader const&) = delete;
+		BinaryLogReader& operator=(BinaryLogReader&&) = delete;
+
+	private:
+		struct StoredSite final
+		{
+			std::string format;
+			std::string file;
+			std::vector<BinaryArgType> argTypes;
+			uint32_t line;
+			LogPriority priority;
+			LogCategory category;
+		};
+
+		std::istream& m_Stream;
+		// Indexed by site id
+		std::vector<StoredSite> m_Sites{};
+		std::vector<std::byte> m_Bytes{};
+		bool m_IsValid{ false };
+
+		[[nodiscard]] bool ReadSite();
+	};
+}
+
+// Like ME_LOG, but only the arguments are stored, the message is formatted when the log is decoded
+// Supports the BinaryArgType types, the format string is checked at compile time
+// Filtered like ME_LOG_TO, a compiled out log doesn't register its site
+#define ME_LOG_BINARY_TO(logger, priority, category, fmtStr, ...) \
+	do \
+	{ \
+		if constexpr (MauCor::IsLogCompiledIn(priority)) \
+		{ \
+			if (MauCor::IsLogCompiledIn(priority, category) && (logger).IsEnabled(priority, category)) \
+			{ \
+				[&]<typename... BinaryArgs>(BinaryArgs const&... binaryArgs) \
+				{ \
+					static MauCor::BinaryLogSite const binaryLogSite{ MauCor::MakeBinaryLogSite<BinaryArgs...>(priority, category, fmtStr, __FILE__, __LINE__) }; \
+					(logger).LogBinary(binaryLogSite, binaryArgs...); \
+				}(__VA_ARGS__); \
+			} \
+		} \
+	} while (false)
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef MAUCOR_LOGCATEGORIES_H
 #define MAUCOR_LOGCATEGORIES_H
 
+#include <cstdint>
+
 namespace MauCor
 {
 	enum class LogPriority : uint8_t
@@ -13,6 +15,7 @@ namespace MauCor
 		Fatal
 	};
 
+	// Built-in categories, games & tools add their own with MakeLogCategory & RegisterLogCategory
 	enum class LogCategory : uint8_t
 	{
 		Core,
@@ -20,6 +23,27 @@ namespace MauCor
 		Renderer,
 		Game
 	};
+
+	// A category indexes fixed size tables (names, priority levels), so the amount is limited
+	uint8_t constexpr MAX_LOG_CATEGORIES{ 64 };
+	uint8_t constexpr BUILT_IN_LOG_CATEGORY_COUNT{ static_cast<uint8_t>(LogCategory::Game) + 1 };
+
+	// The index-th user category, e.g: inline constexpr MauCor::LogCategory LOG_AUDIO{ MauCor::MakeLogCategory(0) };
+	// Constant, so logs of it can be filtered at compile time like the built-in ones
+	[[nodiscard]] consteval LogCategory MakeLogCategory(uint8_t index)
+	{
+		if (index >= MAX_LOG_CATEGORIES - BUILT_IN_LOG_CATEGORY_COUNT)
+		{
+			throw "Log category index out of range, see MAX_LOG_CATEGORIES";
+		}
+
+		return static_cast<LogCategory>(BUILT_IN_LOG_CATEGORY_COUNT + index);
+	}
+
+	// Name the loggers print for the category, it is not copied so it has to outlive the logging (e.g a string literal)
+	void RegisterLogCategory(LogCategory category, char const* name) noexcept;
+	// "Unknown" for categories without a name
+	[[nodiscard]] char const* LogCategoryName(LogCategory category) noexcept;
 }
 
-#endif
\ No newline at end of file
+#endif
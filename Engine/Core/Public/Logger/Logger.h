@@ -1,11 +1,15 @@
 #ifndef MAUCOR_LOGGER_H
 #define MAUCOR_LOGGER_H
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <fstream>
 #include <concepts>
 #include <mutex>
+#include <chrono>
+#include <string_view>
 
 #include <format>
 #include <fmt/format.h>
@@ -14,9 +18,22 @@
 
 #include "LoggerFactory.h"
 #include "LogCategories.h"
+#include "BinaryLog.h"
 
 namespace MauCor
 {
+	// False for logs that are compiled out (see MIN_LOG_PRIORITY)
+	[[nodiscard]] constexpr bool IsLogCompiledIn(LogPriority priority) noexcept
+	{
+		return priority >= MauEng::MIN_LOG_PRIORITY;
+	}
+
+	// Also checks the category's minimum (see MinCategoryLogPriority)
+	[[nodiscard]] constexpr bool IsLogCompiledIn(LogPriority priority, LogCategory category) noexcept
+	{
+		return IsLogCompiledIn(priority) && priority >= MauEng::MinCategoryLogPriority(category);
+	}
+
 	class Logger
 	{
 	public:
@@ -30,21 +47,43 @@ namespace MauCor
 		template<typename... Args>
 		void Log(LogPriority priority, LogCategory category, fmt::format_string<Args...> fmtStr, Args... args)
 		{
-			if (priority < m_LogPriority)
+			if (!IsEnabled(priority, category))
+			{
+				return;
+			}
+
+			// Type erased from here on, only Log itself is instantiated per call site
+			Write(priority, category, fmt::string_view{ fmtStr }, fmt::make_format_args(args...));
+		}
+
+		// Use ME_LOG_BINARY, the site is made once per call site
+		template<typename... Args>
+		void LogBinary(BinaryLogSite const& site, Args const&... args)
+		{
+			if (!IsEnabled(site.priority, site.category))
 			{
 				return;
 			}
 
-			std::scoped_lock lock{ m_Mutex };
-			LogInternal(priority, category, fmt::format(fmtStr, std::forward<Args>(args)...));
+			std::array<std::byte, MAX_BINARY_ARGS_SIZE> bytes;
+			uint32_t const size{ EncodeBinaryArgs(std::span{ bytes }, args...) };
+			WriteBinary(site, { bytes.data(), size });
 		}
 
+		// Runtime filters, a message has to pass the global & its category's level
+		// Safe to change while other threads log, the macros check them before evaluating the arguments
 		void SetPriorityLevel(LogPriority priority) noexcept;
+		void SetCategoryPriorityLevel(LogCategory category, LogPriority priority) noexcept;
 
-	protected:
-		Logger() = default;
+		[[nodiscard]] bool IsEnabled(LogPriority priority, LogCategory category) const noexcept
+		{
+			return priority >= m_LogPriority.load(std::memory_order_relaxed)
+				&& priority >= m_CategoryPriorities[static_cast<uint8_t>(category) % MAX_LOG_CATEGORIES].load(std::memory_order_relaxed);
+		}
+
+		// Makes sure everything logged so far reached its destination (e.g the log file)
+		virtual void Flush() {}
 
-		virtual void LogInternal(LogPriority priority, LogCategory category, std::string const& message) = 0;
 		static constexpr char const* PriorityToString(LogPriority priority) noexcept
 		{
 			switch (priority)
@@ -60,6 +99,27 @@ namespace MauCor
 			}
 		}
 
+		// Built-in & registered categories (see RegisterLogCategory)
+		static char const* CategoryToString(LogCategory category) noexcept
+		{
+			return LogCategoryName(category);
+		}
+
+	protected:
+		// The async logger hands its records to the sink's LogInternal & Flush from the writer thread
+		friend class AsyncLogger;
+
+		Logger() = default;
+
+		// Formats the message on the calling thread & writes it under the lock, overridden by loggers that defer the work
+		virtual void Write(LogPriority priority, LogCategory category, fmt::string_view format, fmt::format_args args);
+
+		// time is when the message was logged, not when it is written
+		virtual void LogInternal(LogPriority priority, LogCategory category, std::chrono::system_clock::time_point time, std::string_view message) = 0;
+
+		// Decodes the arguments & writes the message like Log, overridden by loggers that store the binary record
+		virtual void WriteBinary(BinaryLogSite const& site, std::span<std::byte const> args);
+
 		static constexpr char const* PriorityToColour(LogPriority priority) noexcept
 		{
 			switch (priority)
@@ -75,21 +135,12 @@ namespace MauCor
 			}
 		}
 
-		static constexpr char const* CategoryToString(LogCategory category) noexcept
-		{
-			switch (category)
-			{
-				case LogCategory::Core: return "Core";
-				case LogCategory::Engine: return "Engine";
-				case LogCategory::Renderer: return "Renderer";
-				case LogCategory::Game: return "Game";
+		// Held by Write around LogInternal, sinks that buffer take it in Flush too
+		mutable std::mutex m_Mutex{};
 
-				default: return "Unknown";
-			}
-		}
 	private:
-		LogPriority m_LogPriority{ LogPriority::Trace };
-		mutable std::mutex m_Mutex{};
+		std::atomic<LogPriority> m_LogPriority{ LogPriority::Trace };
+		std::array<std::atomic<LogPriority>, MAX_LOG_CATEGORIES> m_CategoryPriorities{};
 
 		// The std way of doing the logging, we're using fmt now but keeping this fnction in case we want to go back
 		template<typename... Args>
@@ -100,4 +151,18 @@ namespace MauCor
 	};
 }
 
+// ME_LOG with a specific logger, the priority has to be a constant
+// Compiled out logs & logs the logger filters at runtime don't evaluate their arguments
+#define ME_LOG_TO(logger, priority, category, fmtStr, ...) \
+	do \
+	{ \
+		if constexpr (MauCor::IsLogCompiledIn(priority)) \
+		{ \
+			if (MauCor::IsLogCompiledIn(priority, category) && (logger).IsEnabled(priority, category)) \
+			{ \
+				(logger).Log(priority, category, fmtStr, __VA_ARGS__); \
+			} \
+		} \
+	} while (false)
+
 #endif
\ No newline at end of file
@@ -1,14 +1,47 @@
 #ifndef MAUCOR_LOGGERFACTORY_H
 #define MAUCOR_LOGGERFACTORY_H
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 
 namespace MauCor
 {
 	class Logger;
 
+	// What the async logger does when its queue is full
+	enum class LogOverflowPolicy : uint8_t
+	{
+		Drop,	// The message is lost
+		Block,	// The caller waits until the writer thread made room
+		Count	// The message is lost, the writer logs how many were lost once there is room again
+	};
+
+	struct AsyncLoggerSettings final
+	{
+		// Amount of messages that can be queued before the overflow policy kicks in, rounded up to a power of two
+		uint32_t capacity{ 4'096 };
+		LogOverflowPolicy overflowPolicy{ LogOverflowPolicy::Count };
+	};
+
+	struct FileLoggerSettings final
+	{
+		// Every log file is preallocated to this size, the logger moves on to a new file once it is full
+		uint64_t segmentSize{ 4 * 1'024 * 1'024 };
+		// Files kept, the one being written included, older ones are removed. At least 1
+		uint32_t generationCount{ 5 };
+		// Called on the rotation thread for every full file, e.g to write a zstd compressed copy next to it
+		// Returning true removes the original
+		std::function<bool(std::filesystem::path const&)> compressSegment{};
+	};
+
 	[[nodiscard]] std::unique_ptr<Logger> CreateConsoleLogger() noexcept;
-	[[nodiscard]] std::unique_ptr<Logger> CreateFileLogger(std::filesystem::path&& filePath) noexcept; 
+	// Log.txt is written as Log.0.txt, Log.1.txt, ... (see FileLoggerSettings)
+	[[nodiscard]] std::unique_ptr<Logger> CreateFileLogger(std::filesystem::path&& filePath, FileLoggerSettings const& settings = {}) noexcept;
+	// Stores binary records instead of text (see Logger/BinaryLog.h), decode the file with MauEngLogDecoder
+	[[nodiscard]] std::unique_ptr<Logger> CreateBinaryLogger(std::filesystem::path&& filePath) noexcept;
+	// Logs on a background thread, the caller only formats into a queue. The sink does the writing.
+	[[nodiscard]] std::unique_ptr<Logger> CreateAsyncLogger(std::unique_ptr<Logger>&& pSink, AsyncLoggerSettings const& settings = {}) noexcept;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,184 @@
+#ifndef MAUCOR_BOUNDINGVOLUMES_H
+#define MAUCOR_BOUNDINGVOLUMES_H
+
+#include <array>
+#include <limits>
+
+#include "glm/glm.hpp"
+
+namespace MauCor
+{
+	struct AABB final
+	{
+		glm::vec3 min{ 0.f };
+		glm::vec3 max{ 0.f };
+
+		// Empty box, merging anything into it results in that thing
+		[[nodiscard]] static AABB Empty() noexcept
+		{
+			return { glm::vec3{ std::numeric_limits<float>::max() }, glm::vec3{ std::numeric_limits<float>::lowest() } };
+		}
+
+		[[nodiscard]] glm::vec3 Center() const noexcept { return (min + max) * .5f; }
+		[[nodiscard]] glm::vec3 Extents() const noexcept { return (max - min) * .5f; }
+
+		[[nodiscard]] float SurfaceArea() const noexcept
+		{
+			glm::vec3 const size{ max - min };
+			return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		void Merge(glm::vec3 const& point) noexcept
+		{
+			min = glm::min(min, point);
+			max = glm::max(max, point);
+		}
+
+		void Merge(AABB const& other) noexcept
+		{
+			min = glm::min(min, other.min);
+			max = glm::max(max, other.max);
+		}
+
+		[[nodiscard]] static AABB Merge(AABB const& lhs, AABB const& rhs) noexcept
+		{
+			return { glm::min(lhs.min, rhs.min), glm::max(lhs.max, rhs.max) };
+		}
+
+		[[nodiscard]] AABB Expanded(float margin) const noexcept
+		{
+			return { min - glm::vec3{ margin }, max + glm::vec3{ margin } };
+		}
+
+		[[nodiscard]] bool Contains(AABB const& other) const noexcept
+		{
+			return glm::all(glm::lessThanEqual(min, other.min)) && glm::all(glm::greaterThanEqual(max, other.max));
+		}
+
+		[[nodiscard]] bool Overlaps(AABB const& other) const noexcept
+		{
+			return glm::all(glm::lessThanEqual(min, other.max)) && glm::all(glm::greaterThanEqual(max, other.min));
+		}
+
+		// Bounds of this box after the transformation, transforms the extents instead of all 8 corners
+		[[nodiscard]] AABB Transformed(glm::mat4 const& mat) const noexcept
+		{
+			glm::vec3 const center{ mat * glm::vec4{ Center(), 1.f } };
+			glm::vec3 const extents{ Extents() };
+
+			glm::vec3 const worldExtents{
+				glm::abs(mat[0][0]) * extents.x + glm::abs(mat[1][0]) * extents.y + glm::abs(mat[2][0]) * extents.z,
+				glm::abs(mat[0][1]) * extents.x + glm::abs(mat[1][1]) * extents.y + glm::abs(mat[2][1]) * extents.z,
+				glm::abs(mat[0][2]) * extents.x + glm::abs(mat[1][2]) * extents.y + glm::abs(mat[2][2]) * extents.z };
+
+			return { center - worldExtents, center + worldExtents };
+		}
+	};
+
+	struct Sphere final
+	{
+		glm::vec3 center{ 0.f };
+		float radius{ 0.f };
+
+		[[nodiscard]] bool Overlaps(AABB const& box) const noexcept
+		{
+			glm::vec3 const closest{ glm::clamp(center, box.min, box.max) };
+			glm::vec3 const delta{ closest - center };
+			return glm::dot(delta, delta) <= radius * radius;
+		}
+	};
+
+	struct Ray final
+	{
+		glm::vec3 origin{ 0.f };
+		// Does not have to be normalized, hit distances are in units of the direction length
+		glm::vec3 direction{ 0.f, 0.f, -1.f };
+
+		// Slab test, returns the entry distance or a negative value on a miss
+		[[nodiscard]] float Intersect(AABB const& box, float maxDistance = std::numeric_limits<float>::max()) const noexcept
+		{
+			glm::vec3 const invDir{ 1.f / direction };
+			glm::vec3 const t0{ (box.min - origin) * invDir };
+			glm::vec3 const t1{ (box.max - origin) * invDir };
+
+			glm::vec3 const tMin{ glm::min(t0, t1) };
+			glm::vec3 const tMax{ glm::max(t0, t1) };
+
+			float const entry{ glm::max(glm::max(tMin.x, tMin.y), glm::max(tMin.z, 0.f)) };
+			float const exit{ glm::min(glm::min(tMax.x, tMax.y), glm::min(tMax.z, maxDistance)) };
+
+			return entry <= exit ? entry : -1.f;
+		}
+	};
+
+	// Plane as dot(normal, p) + distance = 0, the normal points to the inside
+	struct Plane final
+	{
+		glm::vec3 normal{ 0.f, 1.f, 0.f };
+		float distance{ 0.f };
+
+		[[nodiscard]] float SignedDistance(glm::vec3 const& point) const noexcept
+		{
+			return glm::dot(normal, point) + distance;
+		}
+	};
+
+	struct Frustum final
+	{
+		// Left, right, bottom, top, near, far
+		std::array<Plane, 6> planes{};
+
+		// Extracts the planes from a (projection * view) matrix
+		[[nodiscard]] static Frustum FromMatrix(glm::mat4 const& viewProj) noexcept
+		{
+			glm::vec4 const row0{ viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0] };
+			glm::vec4 const row1{ viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1] };
+			glm::vec4 const row2{ viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2] };
+			glm::vec4 const row3{ viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3] };
+
+			std::array<glm::vec4, 6> const rawPlanes{ row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2 };
+
+			Frustum frustum{};
+			for (std::size_t idx{ 0 }; idx < rawPlanes.size(); ++idx)
+			{
+				auto const& raw{ rawPlanes[idx] };
+				float const invLength{ 1.f / glm::length(glm::vec3{ raw }) };
+
+				frustum.planes[idx] = { glm::vec3{ raw } * invLength, raw.w * invLength };
+			}
+
+			return frustum;
+		}
+
+		// Conservative, boxes near the corners of the frustum can be reported as visible
+		[[nodiscard]] bool Overlaps(AABB const& box) const noexcept
+		{
+			for (auto const& plane : planes)
+			{
+				// Corner of the box that lies furthest along the plane normal
+				glm::vec3 const positive{ glm::mix(box.min, box.max, glm::greaterThanEqual(plane.normal, glm::vec3{ 0.f })) };
+				if (plane.SignedDistance(positive) < 0.f)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		[[nodiscard]] bool Overlaps(Sphere const& sphere) const noexcept
+		{
+			for (auto const& plane : planes)
+			{
+				if (plane.SignedDistance(sphere.center) < -sphere.radius)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef MAUCOR_NORMALMATRIX_H
+#define MAUCOR_NORMALMATRIX_H
+
+#include "glm/geometric.hpp"
+#include "glm/mat3x3.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace MauCor
+{
+	// transpose(inverse(mat3(modelMatrix))) for model matrices without shear
+	// All model matrices are translate * rotate * scale (CTransform, CInstanceBatch), the columns of rotate * scale are orthogonal.
+	// The inverse transpose is then rotate * inverse(scale): every column divided by its squared length, no general inverse needed
+	[[nodiscard]] inline glm::mat3 NormalMatrix(glm::mat4 const& modelMatrix) noexcept
+	{
+		glm::mat3 normalMatrix{ 0.f };
+		for (glm::length_t col{ 0 }; col < 3; ++col)
+		{
+			glm::vec3 const axis{ modelMatrix[col] };
+			normalMatrix[col] = axis / glm::dot(axis, axis);
+		}
+
+		return normalMatrix;
+	}
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef MAUCOR_MEMORYTRACKER_H
+#define MAUCOR_MEMORYTRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace MauCor
+{
+	// Subsystem an allocation is counted under
+	enum class MemoryTag : uint8_t
+	{
+		Untagged,
+		ECS,
+		RendererCPU,
+		// Device memory, also counted per memory type
+		RendererGPU,
+		Assets,
+		Logger,
+
+		Count
+	};
+
+	// VK_MAX_MEMORY_TYPES
+	uint32_t constexpr MAX_GPU_MEMORY_TYPES{ 32 };
+
+	struct MemoryStats final
+	{
+		uint64_t liveBytes{ 0 };
+		uint64_t peakBytes{ 0 };
+		uint64_t liveAllocations{ 0 };
+		uint64_t peakAllocations{ 0 };
+		// Every allocation since the start
+		uint64_t totalAllocations{ 0 };
+	};
+
+	/*
+	 * Counters per memory tag, updated with atomics so any thread can allocate & free.
+	 * Heap allocations are counted under the tag of the allocating thread (MemoryTagScope) when ENABLE_MEMORY_TRACKING replaces the global operator new,
+	 * memory resources can be wrapped in a TrackedMemoryResource & Vulkan allocations are counted per memory type with TrackGPUAllocation in every build.
+	 */
+	void TrackAllocation(MemoryTag tag, std::size_t size) noexcept;
+	void TrackFree(MemoryTag tag, std::size_t size) noexcept;
+
+	// Also counted under MemoryTag::RendererGPU
+	void TrackGPUAllocation(uint32_t memoryTypeIndex, uint64_t size) noexcept;
+	void TrackGPUFree(uint32_t memoryTypeIndex, uint64_t size) noexcept;
+
+	[[nodiscard]] MemoryStats GetMemoryStats(MemoryTag tag) noexcept;
+	[[nodiscard]] MemoryStats GetGPUMemoryStats(uint32_t memoryTypeIndex) noexcept;
+	[[nodiscard]] char const* GetMemoryTagName(MemoryTag tag) noexcept;
+
+	// Logs the stats of every tag & GPU memory type that was used
+	void LogMemoryStats();
+
+	// Tag the calling thread's heap allocations are counted under
+	[[nodiscard]] MemoryTag GetThreadMemoryTag() noexcept;
+
+	// Counts the calling thread's heap allocations under the tag until the scope ends
+	class MemoryTagScope final
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) noexcept;
+		~MemoryTagScope();
+
+		MemoryTagScope(MemoryTagScope const&) = delete;
+		MemoryTagScope(MemoryTagScope&&) = delete;
+		MemoryTagScope& operator=(MemoryTagScope const&) = delete;
+		MemoryTagScope& operator=(MemoryTagScope&&) = delete;
+
+	private:
+		MemoryTag const m_PreviousTag;
+	};
+
+	// Counts what is allocated from the upstream resource under the tag, e.g the ECS component pools
+	class TrackedMemoryResource final : public std::pmr::memory_resource
+	{
+	public:
+		TrackedMemoryResource(MemoryTag tag, std::pmr::memory_resource* pUpstream) noexcept;
+		~TrackedMemoryResource() override = default;
+
+		[[nodiscard]] MemoryTag GetTag() const noexcept { return m_Tag; }
+
+		TrackedMemoryResource(TrackedMemoryResource const&) = delete;
+		TrackedMemoryResource(TrackedMemoryResource&&) = delete;
+		TrackedMemoryResource& operator=(TrackedMemoryResource const&) = delete;
+		TrackedMemoryResource& operator=(TrackedMemoryResource&&) = delete;
+
+	private:
+		MemoryTag const m_Tag;
+		std::pmr::memory_resource* const m_pUpstream;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pData, std::size_t bytes, std::size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+	};
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef MAUCOR_PAGEARENA_H
+#define MAUCOR_PAGEARENA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+#include "Memory/MemoryTracker.h"
+
+namespace MauCor
+{
+	struct ArenaStats final
+	{
+		// Memory taken from the OS
+		std::size_t reservedBytes{ 0 };
+		// Memory handed out, rounded up to the block size
+		std::size_t usedBytes{ 0 };
+		std::size_t peakUsedBytes{ 0 };
+		std::size_t allocationCount{ 0 };
+
+		uint32_t pageCount{ 0 };
+		uint32_t largeAllocationCount{ 0 };
+		// At least one page is backed by huge pages
+		bool usesHugePages{ false };
+	};
+
+	/*
+	 * Memory resource that takes memory from the OS in large pages, huge pages are used when the OS allows it.
+	 * Blocks up to the page size are rounded up to a power of 2 & carved from the pages, freed blocks are reused per size.
+	 * Larger blocks get their own OS allocation that is released again on deallocate.
+	 * Pages are only returned to the OS when the arena is destroyed, allocating is thread safe.
+	 * The memory taken from the OS is counted under the tag, its bookkeeping under the same tag when operator new is tracked.
+	 */
+	class PageArena final : public std::pmr::memory_resource
+	{
+	public:
+		static std::size_t constexpr DEFAULT_PAGE_SIZE{ 2 * 1024 * 1024 };
+
+		explicit PageArena(std::size_t pageSize = DEFAULT_PAGE_SIZE, bool useHugePages = true, MemoryTag tag = MemoryTag::Untagged) noexcept;
+		~PageArena() override;
+
+		[[nodiscard]] ArenaStats GetStats() const noexcept;
+		[[nodiscard]] std::size_t GetPageSize() const noexcept { return m_PageSize; }
+
+		PageArena(PageArena const&) = delete;
+		PageArena(PageArena&&) = delete;
+		PageArena& operator=(PageArena const&) = delete;
+		PageArena& operator=(PageArena&&) = delete;
+
+	private:
+		static std::size_t constexpr MIN_BLOCK_SIZE{ 64 };
+		static std::size_t constexpr MIN_PAGE_SIZE{ 64 * 1024 };
+		// OS allocations are at least aligned to this
+		static std::size_t constexpr MAX_ALIGNMENT{ 4'096 };
+		static uint32_t constexpr SIZE_CLASS_COUNT{ 32 };
+
+		struct FreeBlock final
+		{
+			FreeBlock* pNext{ nullptr };
+		};
+
+		struct OSAllocation final
+		{
+			void* pData{ nullptr };
+			std::size_t size{ 0 };
+			bool isHugePage{ false };
+		};
+
+		std::size_t const m_PageSize;
+		bool const m_UseHugePages;
+		MemoryTag const m_Tag;
+
+		mutable std::mutex m_Mutex{};
+
+		// Free blocks of every power of 2 size, starting at MIN_BLOCK_SIZE
+		std::array<FreeBlock*, SIZE_CLASS_COUNT> m_FreeLists{};
+		std::vector<OSAllocation> m_Pages{};
+		std::vector<OSAllocation> m_LargeAllocations{};
+
+		// Unused part of the last page
+		std::byte* m_pCursor{ nullptr };
+		std::byte* m_pPageEnd{ nullptr };
+
+		ArenaStats m_Stats{};
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pData, std::size_t bytes, std::size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+
+		// Takes a block from the free list or the current page, the lock must be held
+		[[nodiscard]] void* AllocateBlock(std::size_t blockSize);
+
+		[[nodiscard]] static std::size_t BlockSize(std::size_t bytes, std::size_t alignment) noexcept;
+		[[nodiscard]] static uint32_t SizeClass(std::size_t blockSize) noexcept;
+
+		[[nodiscard]] OSAllocation AllocateFromOS(std::size_t size) const;
+		void FreeToOS(OSAllocation const& allocation) const noexcept;
+	};
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef MAUCOR_HDRHISTOGRAM_H
+#define MAUCOR_HDRHISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace MauCor
+{
+	/*
+	 * High dynamic range histogram (log-linear buckets) for latencies such as frame times.
+	 * Values below SUB_BUCKET_COUNT get a bucket each, above that every power of two is split into SUB_BUCKET_COUNT / 2 buckets,
+	 * so a bucket is never wider than 1 / 128th of its values. Recording is an index calculation & an increment, nothing is allocated.
+	 */
+	class HdrHistogram final
+	{
+	public:
+		// Larger values are recorded as maxValue
+		explicit HdrHistogram(uint64_t maxValue);
+		~HdrHistogram() = default;
+
+		void Record(uint64_t value) noexcept;
+		void Reset() noexcept;
+
+		[[nodiscard]] uint64_t Count() const noexcept { return m_Count; }
+		// 0 when nothing was recorded
+		[[nodiscard]] uint64_t Min() const noexcept { return m_Count > 0 ? m_Min : 0; }
+		[[nodiscard]] uint64_t Max() const noexcept { return m_Max; }
+		[[nodiscard]] double Mean() const noexcept { return m_Count > 0 ? static_cast<double>(m_Total) / static_cast<double>(m_Count) : 0.0; }
+
+		// Nearest rank, percentile in [0, 1]: the highest value of the bucket holding the rank, never above Max
+		[[nodiscard]] uint64_t ValueAtPercentile(double percentile) const noexcept;
+
+		// visit(lowest, highest, count) for every bucket that has values, lowest first
+		template<typename VisitFunc>
+		void ForEachBucket(VisitFunc&& visit) const
+		{
+			for (uint32_t index{ 0 }; index < static_cast<uint32_t>(m_Counts.size()); ++index)
+			{
+				if (m_Counts[index] > 0)
+				{
+					visit(BucketLowest(index), BucketHighest(index), m_Counts[index]);
+				}
+			}
+		}
+
+		HdrHistogram(HdrHistogram const&) = default;
+		HdrHistogram(HdrHistogram&&) = default;
+		HdrHistogram& operator=(HdrHistogram const&) = default;
+		HdrHistogram& operator=(HdrHistogram&&) = default;
+
+	private:
+		static uint32_t constexpr SUB_BUCKET_BITS{ 8 };
+		static uint32_t constexpr SUB_BUCKET_COUNT{ 1 << SUB_BUCKET_BITS };
+		static uint32_t constexpr HALF_SUB_BUCKET_COUNT{ SUB_BUCKET_COUNT / 2 };
+
+		uint64_t m_MaxValue;
+		std::vector<uint64_t> m_Counts;
+
+		uint64_t m_Count{ 0 };
+		uint64_t m_Total{ 0 };
+		uint64_t m_Min{ UINT64_MAX };
+		uint64_t m_Max{ 0 };
+
+		[[nodiscard]] static uint32_t BucketIndex(uint64_t value) noexcept;
+		[[nodiscard]] static uint64_t BucketLowest(uint32_t index) noexcept;
+		[[nodiscard]] static uint64_t BucketHighest(uint32_t index) noexcept;
+	};
+}
+
+#endif
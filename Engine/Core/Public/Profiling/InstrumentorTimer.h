@@ -1,7 +1,7 @@
 #ifndef MAUCOR_TIMER_H
 #define MAUCOR_TIMER_H
 
-#include <chrono>
+#include <cstdint>
 
 namespace MauCor
 {
@@ -20,9 +20,12 @@ namespace MauCor
 	private:
 		char const* m_Name{ "NO NAME" };
 
-		//static thread_local uint32_t m_NestCount;
+		// Scopes the thread is in
+		static thread_local uint32_t m_NestCount;
 
-		std::chrono::time_point<std::chrono::high_resolution_clock> m_StartPoint{ };
+		// Trace clock ticks (see TraceClock.h)
+		uint64_t m_Start{ 0 };
+		uint32_t m_Depth{ 0 };
 		bool m_IsStopped{ false };
 
 		bool m_IsFunction{};
@@ -30,4 +33,4 @@ namespace MauCor
 }
 
 
-#endif
\ No newline at end of file
+#endif
@@ -1,8 +1,15 @@
 #ifndef MAUCOR_PROFILER_H
 #define MAUCOR_PROFILER_H
 
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace MauCor
 {
@@ -14,20 +21,87 @@ namespace MauCor
 		std::thread::id threadID;
 	};
 
+	// A scope measured by InstrumentorTimer (ME_PROFILE_SCOPE / ME_PROFILE_FUNCTION), start & end are trace clock ticks
+	struct TraceScope final
+	{
+		// Not copied, it has to outlive the session (literals, __FUNCTION__ or Profiler::InternScopeName)
+		char const* name;
+		uint64_t start;
+		uint64_t end;
+		// Amount of scopes the thread was in when this one started
+		uint32_t depth;
+		bool isFunction;
+	};
+
+	// Time spent in a scope per frame (every call that frame summed) in milliseconds, over the frames of the stats window it ran in
+	struct ScopeStats final
+	{
+		double min{ 0.0 };
+		double average{ 0.0 };
+		double p95{ 0.0 };
+		double p99{ 0.0 };
+		double max{ 0.0 };
+		double callsPerFrame{ 0.0 };
+		uint32_t frameCount{ 0 };
+	};
+
+	// A series of a counter track, e.g the live bytes of a memory tag. The name has to outlive the session like scope names
+	struct CounterValue final
+	{
+		char const* name;
+		double value;
+	};
+
+	class ScopeNameTable;
+	class ScopeStatsCollector;
+
 	class Profiler
 	{
 	public:
-		virtual ~Profiler() = default;
+		virtual ~Profiler();
 
 		void BeginSession(std::string const& name, char const* filepath, size_t reserveSize = 100'000);
 
 		virtual void WriteProfile(ProfileResult const& result, bool isFunction) = 0;
 		virtual void WriteProfile(std::string const& name) = 0;
+		// Converts to a ProfileResult in microseconds by default, overridden by profilers that keep the raw scope
+		virtual void WriteScope(TraceScope const& scope);
+		// A scope timed on the GPU, converted to trace clock ticks (see VulkanGPUProfiler). Ignored unless the profiler has a GPU track
+		// Written by one thread at a time
+		virtual void WriteGPUScope(TraceScope const& scope);
+		// Values of the series of a counter track at the given trace clock ticks. Ignored unless the profiler has counter tracks
+		virtual void WriteCounter(char const* name, uint64_t ticks, std::span<CounterValue const> values);
+
+		// A copy of the name that lives as long as the profiler, the same pointer for the same text (ME_PROFILE_SCOPE_DYNAMIC). Any thread
+		[[nodiscard]] char const* InternScopeName(std::string_view name);
+
+		// Rolling stats of every scope over the last PROFILER_STATS_FRAME_COUNT frames, independent of sessions (USE_PROFILER_STATS)
+		// Any thread, InstrumentorTimer adds its scope
+		void AddToStats(TraceScope const& scope) noexcept;
+		// Called by Update
+		void EndStatsFrame();
+		// Clears the stats, from now on they cover the last frameCount frames, e.g exactly the measured frames of a benchmark. Between frames
+		void ResetStats(uint32_t frameCount);
+		// By scope name, e.g GetStats("QUEUE DRAWS"). None for scopes that didn't run in the window
+		[[nodiscard]] std::optional<ScopeStats> GetStats(std::string_view name) const;
+		// Name & stats of every scope, most time per frame first
+		[[nodiscard]] std::vector<std::pair<std::string, ScopeStats>> GetAllStats() const;
+		// Logs every scope's stats, most time per frame first
+		void LogStats() const;
 
 		virtual void EndSession() = 0;
 
 		void Start(char const* path);
 		void Update();
+		[[nodiscard]] bool IsProfiling() const noexcept { return isProfiling; }
+
+		// Keeps the trace of the last frameCount frames while no session runs (a flight recorder), false if the profiler can't
+		bool BeginFlightRecording(uint32_t frameCount);
+		// Writes the flight recorder's frames once framesAfter more frames ran, e.g on a hitch. Without a flight recorder it starts a capture (Start)
+		void DumpFlightRecording(char const* path, uint32_t framesAfter);
+		[[nodiscard]] bool IsFlightRecordingDumpPending() const noexcept { return m_IsDumpPending; }
+		// Sessions begun so far (BeginSession & Start), e.g to recalibrate another clock when one starts. Any thread
+		[[nodiscard]] uint32_t GetSessionCount() const noexcept { return m_SessionCount.load(std::memory_order_acquire); }
 
 		static void FixFilePath(char const* filepath);
 
@@ -36,15 +110,35 @@ namespace MauCor
 		Profiler& operator=(Profiler const&) = delete;
 		Profiler& operator=(Profiler&&) = delete;
 	protected:
-		Profiler() = default;
+		Profiler();
+
+		// False if the profiler has no flight recorder
+		virtual bool BeginFlightRecordingInternal(uint32_t frameCount);
+		// Called by Update at the end of every frame while flight recording
+		virtual void EndFlightRecordingFrame(uint64_t ticks);
+		// Writes the frames the flight recorder kept to path (without extension) & keeps recording
+		virtual void WriteFlightRecording(std::string const& path);
 
 	private:
 		virtual void BeginSessionInternal(std::string const& name, size_t reserveSize = 100'000) = 0;
 
+		// Live bytes per memory tag & per used GPU memory type, once per profiled frame
+		void WriteMemoryCounters();
+
 		uint32_t profiledFrames{ 0 };
 		bool isProfiling{ false };
 
 		uint32_t numExecutedProfiles{ 0 };
+		std::atomic<uint32_t> m_SessionCount{ 0 };
+
+		bool m_IsFlightRecording{ false };
+		bool m_IsDumpPending{ false };
+		uint32_t m_DumpFramesLeft{ 0 };
+		std::string m_DumpPath{};
+
+		// Before the stats, destroyed after everything that could hold one of its names
+		std::unique_ptr<ScopeNameTable> m_pScopeNames;
+		std::unique_ptr<ScopeStatsCollector> m_pStats;
 
 	protected:
 		std::string fileName;
@@ -0,0 +1,16 @@
+#ifndef MAUCOR_PROFILERFACTORY_H
+#define MAUCOR_PROFILERFACTORY_H
+
+#include <memory>
+
+namespace MauCor
+{
+	class Profiler;
+
+	// Formats every scope into a shared JSON buffer as it ends
+	[[nodiscard]] std::unique_ptr<Profiler> CreateGoogleProfiler() noexcept;
+	// Records scopes into per thread rings, the JSON is written when the session ends
+	[[nodiscard]] std::unique_ptr<Profiler> CreateTraceProfiler() noexcept;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef MAUCOR_TRACECLOCK_H
+#define MAUCOR_TRACECLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#elif defined(__x86_64__)
+	#include <x86intrin.h>
+#endif
+
+namespace MauCor
+{
+	// Timestamp of a profiling scope, the CPU's time stamp counter where there is one (a handful of ns to read), steady_clock otherwise
+	// Only differences between ticks mean something, see TraceClockFrequency
+	[[nodiscard]] inline uint64_t ReadTraceClock() noexcept
+	{
+	#if defined(_M_X64) || defined(__x86_64__)
+		return __rdtsc();
+	#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	#endif
+	}
+
+	// Ticks per second, measured against steady_clock the first time it is called (takes a few ms)
+	[[nodiscard]] double TraceClockFrequency() noexcept;
+}
+
+#endif
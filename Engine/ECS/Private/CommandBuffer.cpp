@@ -0,0 +1,169 @@
+#include "CommandBuffer.h"
+
+#include <atomic>
+
+#include "CoreServiceLocator.h"
+
+namespace MauEng::ECS
+{
+	namespace
+	{
+		std::atomic<uint64_t> g_NextCommandBufferID{ 1 };
+
+		// Last recorder used by this thread, avoids taking the lock for every recorded command
+		struct CachedRecorder final
+		{
+			uint64_t bufferID{ 0 };
+			void* pRecorder{ nullptr };
+		};
+		thread_local CachedRecorder t_CachedRecorder{};
+	}
+
+	CommandBuffer::CommandBuffer() :
+		m_ID{ g_NextCommandBufferID.fetch_add(1, std::memory_order_relaxed) }
+	{
+	}
+
+	PendingEntity CommandBuffer::CreateEntity()
+	{
+		auto& recorder{ GetRecorder() };
+		recorder.isEmpty = false;
+
+		return PendingEntity{ recorder.index, recorder.pendingCount++ };
+	}
+
+	void CommandBuffer::DestroyEntity(CommandTarget const& target)
+	{
+		auto& recorder{ GetRecorder() };
+		recorder.destroyTargets.emplace_back(target);
+		recorder.isEmpty = false;
+	}
+
+	void CommandBuffer::Playback(ECSImpl& impl)
+	{
+		if (IsEmpty())
+		{
+			return;
+		}
+
+		ME_PROFILE_FUNCTION()
+
+		std::scoped_lock lock{ m_RecorderMutex };
+
+		// Create all pending entities in a single batch
+		std::vector<uint32_t> recorderOffsets(m_Recorders.size(), 0);
+		uint32_t numPending{ 0 };
+		for (size_t idx{ 0 }; idx < m_Recorders.size(); ++idx)
+		{
+			recorderOffsets[idx] = numPending;
+			numPending += m_Recorders[idx]->pendingCount;
+		}
+
+		std::vector<entt::entity> createdEntities(numPending);
+		impl.CreateEntities(createdEntities.begin(), createdEntities.end());
+
+		PendingEntityResolver const resolve{ recorderOffsets, createdEntities };
+
+		// Gather the commands per component type over all recorders so every type is inserted / erased once
+		struct TypeCommands final
+		{
+			uint32_t recorderIdx;
+			uint32_t firstSequence;
+			std::vector<ComponentCommandsBase*> pools;
+		};
+
+		std::vector<TypeCommands> types{};
+		std::unordered_map<ComponentTypeID, size_t> typeIndices{};
+		for (auto const& pRecorder : m_Recorders)
+		{
+			for (auto const& [typeID, pPool] : pRecorder->componentCommands)
+			{
+				if (pPool->IsEmpty())
+				{
+					continue;
+				}
+
+				auto const [it, isNew]{ typeIndices.try_emplace(typeID, types.size()) };
+				if (isNew)
+				{
+					types.push_back({ pRecorder->index, pPool->firstSequence, {} });
+				}
+
+				types[it->second].pools.emplace_back(pPool.get());
+			}
+		}
+
+		// In the order the types were first recorded, so the construct & destroy signals don't depend on the hash map's layout
+		std::ranges::sort(types, {}, [](TypeCommands const& type) { return std::pair{ type.recorderIdx, type.firstSequence }; });
+
+		for (auto const& type : types)
+		{
+			type.pools.front()->Playback(impl, type.pools, resolve);
+		}
+
+		// Destroy last, commands for destroyed entities are still valid up until here
+		std::vector<entt::entity> destroyed{};
+		for (auto const& pRecorder : m_Recorders)
+		{
+			for (auto const& target : pRecorder->destroyTargets)
+			{
+				destroyed.emplace_back(resolve(target));
+			}
+		}
+
+		if (!destroyed.empty())
+		{
+			std::ranges::sort(destroyed);
+			auto const duplicates{ std::ranges::unique(destroyed) };
+			destroyed.erase(duplicates.begin(), duplicates.end());
+			std::erase_if(destroyed, [&impl](entt::entity entity) { return !impl.registry.valid(entity); });
+
+			impl.DestroyEntities(destroyed.begin(), destroyed.end());
+		}
+
+		for (auto const& pRecorder : m_Recorders)
+		{
+			pRecorder->Clear();
+		}
+	}
+
+	bool CommandBuffer::IsEmpty() const noexcept
+	{
+		return std::ranges::all_of(m_Recorders, [](auto const& pRecorder) { return pRecorder->isEmpty; });
+	}
+
+	CommandBuffer::Recorder& CommandBuffer::GetRecorder()
+	{
+		if (t_CachedRecorder.bufferID == m_ID)
+		{
+			return *static_cast<Recorder*>(t_CachedRecorder.pRecorder);
+		}
+
+		std::scoped_lock lock{ m_RecorderMutex };
+
+		auto& pRecorder{ m_ThreadRecorders[std::this_thread::get_id()] };
+		if (!pRecorder)
+		{
+			auto& pNew{ m_Recorders.emplace_back(std::make_unique<Recorder>()) };
+			pNew->index = static_cast<uint32_t>(m_Recorders.size() - 1);
+			pRecorder = pNew.get();
+		}
+
+		t_CachedRecorder = { m_ID, pRecorder };
+		return *pRecorder;
+	}
+
+	void CommandBuffer::Recorder::Clear() noexcept
+	{
+		pendingCount = 0;
+		commandCount = 0;
+		isEmpty = true;
+		destroyTargets.clear();
+
+		// Keep the pools, the same component types are usually recorded every frame
+		for (auto const& [typeID, pPool] : componentCommands)
+		{
+			pPool->Clear();
+		}
+	}
+}
@@ -7,9 +7,10 @@
 
 namespace MauEng::ECS
 {
-	ECSWorld::ECSWorld() :
-		m_pImpl{ std::make_unique<ECSImpl>() }
+	ECSWorld::ECSWorld(std::pmr::memory_resource* pResource) :
+		m_pImpl{ std::make_unique<ECSImpl>(pResource) }
 	{
+		ME_ASSERT(pResource);
 	}
 
 	ECSWorld::~ECSWorld()
@@ -43,5 +44,19 @@ namespace MauEng::ECS
 	{
 		return m_pImpl->IsValid(id);
 	}
+
+	void ECSWorld::RunSystems()&
+	{
+		m_Systems.Run(*this);
+	}
+
+	void ECSWorld::FlushCommands()&
+	{
+		m_CommandBuffer.Playback(*m_pImpl);
+	}
+
+	void ECSWorld::ClearSystems()& noexcept
+	{
+		m_Systems.Clear();
+	}
 }
-	
\ No newline at end of file
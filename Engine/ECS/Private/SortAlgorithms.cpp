@@ -0,0 +1,124 @@
+#include "SortAlgorithms.h"
+
+#include <array>
+#include <ranges>
+#include <utility>
+
+#include "CoreServiceLocator.h"
+
+namespace MauEng::ECS::Internal
+{
+	namespace
+	{
+		uint32_t constexpr DIGIT_BITS{ 8 };
+		uint32_t constexpr DIGIT_COUNT{ 1 << DIGIT_BITS };
+		uint32_t constexpr DIGIT_MASK{ DIGIT_COUNT - 1 };
+
+		// Every chunk is counted & scattered by one task
+		std::size_t constexpr CHUNK_SIZE{ 65'536 };
+
+		using DigitOffsets = std::array<uint32_t, DIGIT_COUNT>;
+
+		template<typename KeyType>
+		void RadixSortPairs(std::span<KeyType> keys, std::span<entt::entity> values)
+		{
+			ME_PROFILE_FUNCTION()
+			ME_ASSERT(keys.size() == values.size());
+
+			std::size_t const count{ keys.size() };
+			if (count < 2)
+			{
+				return;
+			}
+
+			// Digits that are the same in every key don't change the order
+			auto const [orKeys, andKeys] { std::transform_reduce(std::execution::par_unseq, keys.begin(), keys.end(), std::pair<KeyType, KeyType>{ 0, ~KeyType{ 0 } },
+				[](auto const& lhs, auto const& rhs) { return std::pair<KeyType, KeyType>{ lhs.first | rhs.first, lhs.second & rhs.second }; },
+				[](KeyType key) { return std::pair<KeyType, KeyType>{ key, key }; }) };
+			KeyType const varyingBits{ static_cast<KeyType>(orKeys ^ andKeys) };
+
+			std::vector<KeyType> keyScratch(count);
+			std::vector<entt::entity> valueScratch(count);
+
+			std::span<KeyType> srcKeys{ keys };
+			std::span<entt::entity> srcValues{ values };
+			std::span<KeyType> dstKeys{ keyScratch };
+			std::span<entt::entity> dstValues{ valueScratch };
+
+			std::vector<DigitOffsets> chunkOffsets((count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+			// Iterates the chunk indices, a parallel policy may hand the lambda copies of the offsets
+			auto const chunks{ std::views::iota(std::size_t{ 0 }, chunkOffsets.size()) };
+
+			auto const chunkRange{ [count](std::size_t chunk)
+				{
+					std::size_t const begin{ chunk * CHUNK_SIZE };
+					return std::pair{ begin, std::min(count, begin + CHUNK_SIZE) };
+				} };
+
+			for (uint32_t shift{ 0 }; shift < sizeof(KeyType) * 8; shift += DIGIT_BITS)
+			{
+				if (0 == ((varyingBits >> shift) & DIGIT_MASK))
+				{
+					continue;
+				}
+
+				std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](std::size_t chunk)
+					{
+						auto& offsets{ chunkOffsets[chunk] };
+						offsets.fill(0);
+
+						auto const [begin, end] { chunkRange(chunk) };
+						for (std::size_t idx{ begin }; idx < end; ++idx)
+						{
+							++offsets[(srcKeys[idx] >> shift) & DIGIT_MASK];
+						}
+					});
+
+				// Within a digit the chunks follow each other, keeps the sort stable
+				uint32_t offset{ 0 };
+				for (uint32_t digit{ 0 }; digit < DIGIT_COUNT; ++digit)
+				{
+					for (auto& offsets : chunkOffsets)
+					{
+						uint32_t const digitCount{ offsets[digit] };
+						offsets[digit] = offset;
+						offset += digitCount;
+					}
+				}
+
+				std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](std::size_t chunk)
+					{
+						auto& offsets{ chunkOffsets[chunk] };
+						auto const [begin, end] { chunkRange(chunk) };
+						for (std::size_t idx{ begin }; idx < end; ++idx)
+						{
+							uint32_t const slot{ offsets[(srcKeys[idx] >> shift) & DIGIT_MASK]++ };
+							dstKeys[slot] = srcKeys[idx];
+							dstValues[slot] = srcValues[idx];
+						}
+					});
+
+				std::swap(srcKeys, dstKeys);
+				std::swap(srcValues, dstValues);
+			}
+
+			// Odd amount of passes, the result is in the scratch buffers
+			if (srcKeys.data() != keys.data())
+			{
+				std::copy(std::execution::par_unseq, srcKeys.begin(), srcKeys.end(), keys.begin());
+				std::copy(std::execution::par_unseq, srcValues.begin(), srcValues.end(), values.begin());
+			}
+		}
+	}
+
+	void RadixSortPairs(std::span<uint32_t> keys, std::span<entt::entity> values)
+	{
+		RadixSortPairs<uint32_t>(keys, values);
+	}
+
+	void RadixSortPairs(std::span<uint64_t> keys, std::span<entt::entity> values)
+	{
+		RadixSortPairs<uint64_t>(keys, values);
+	}
+}
@@ -0,0 +1,107 @@
+#include "SystemScheduler.h"
+
+#include <algorithm>
+#include <execution>
+
+#include "CoreServiceLocator.h"
+#include "ECSWorld.h"
+
+namespace MauEng::ECS
+{
+	void SystemScheduler::AddSystem(SystemEntry&& system)
+	{
+		m_Systems.emplace_back(std::move(system));
+		m_IsDirty = true;
+	}
+
+	void SystemScheduler::Clear() noexcept
+	{
+		m_Systems.clear();
+		m_Stages.clear();
+		m_IsDirty = false;
+	}
+
+	void SystemScheduler::Run(ECSWorld& world)
+	{
+		ME_PROFILE_FUNCTION()
+
+		for (auto const& stage : GetStages())
+		{
+			if (stage.size() == 1)
+			{
+				Execute(m_Systems[stage.front()], world);
+			}
+			else
+			{
+				std::for_each(std::execution::par, stage.begin(), stage.end(), [&](uint32_t systemIdx)
+					{
+						Execute(m_Systems[systemIdx], world);
+					});
+			}
+
+			// Sync point, structural changes recorded by this stage are visible to the next one
+			world.FlushCommands();
+		}
+	}
+
+	std::vector<std::vector<uint32_t>> const& SystemScheduler::GetStages() noexcept
+	{
+		if (m_IsDirty)
+		{
+			BuildStages();
+		}
+
+		return m_Stages;
+	}
+
+	bool SystemScheduler::IsConflicting(SystemEntry const& lhs, SystemEntry const& rhs) noexcept
+	{
+		auto const writesAny{ [](std::vector<ComponentTypeID> const& writes, SystemEntry const& other)
+			{
+				return std::ranges::any_of(writes, [&other](ComponentTypeID id)
+					{
+						return std::ranges::find(other.reads, id) != other.reads.end()
+							|| std::ranges::find(other.writes, id) != other.writes.end();
+					});
+			} };
+
+		return writesAny(lhs.writes, rhs) || writesAny(rhs.writes, lhs);
+	}
+
+	void SystemScheduler::BuildStages()
+	{
+		m_Stages.clear();
+
+		// Each system is placed in the first stage after the last stage that holds a conflicting system
+		// This keeps the registration order between conflicting systems while packing the others together
+		std::vector<uint32_t> systemStage(m_Systems.size(), 0);
+
+		for (uint32_t systemIdx{ 0 }; systemIdx < m_Systems.size(); ++systemIdx)
+		{
+			uint32_t stageIdx{ 0 };
+			for (uint32_t otherIdx{ 0 }; otherIdx < systemIdx; ++otherIdx)
+			{
+				if (IsConflicting(m_Systems[systemIdx], m_Systems[otherIdx]))
+				{
+					stageIdx = std::max(stageIdx, systemStage[otherIdx] + 1);
+				}
+			}
+
+			systemStage[systemIdx] = stageIdx;
+			if (stageIdx >= m_Stages.size())
+			{
+				m_Stages.resize(stageIdx + 1);
+			}
+
+			m_Stages[stageIdx].emplace_back(systemIdx);
+		}
+
+		m_IsDirty = false;
+	}
+
+	void SystemScheduler::Execute(SystemEntry const& system, ECSWorld& world)
+	{
+		ME_PROFILE_SCOPE_DYNAMIC(system.name.c_str())
+		system.func(world);
+	}
+}
@@ -0,0 +1,599 @@
+#include "WorldSerializer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "CoreServiceLocator.h"
+#include "Asserts/Asserts.h"
+#include "ECSWorld.h"
+#include "IO/MappedFile.h"
+
+namespace MauEng::ECS
+{
+	namespace
+	{
+		static_assert(sizeof(entt::entity) == sizeof(uint32_t), "Snapshots store entities as 32 bit ids");
+
+		uint32_t constexpr SNAPSHOT_MAGIC{ 0x5350414D }; // "MAPS"
+		uint32_t constexpr SNAPSHOT_FORMAT_VERSION{ 1 };
+		// Component data is aligned to a cache line in the file so it can be used in place from the mapped memory
+		std::size_t constexpr DATA_ALIGNMENT{ 64 };
+
+		struct SnapshotHeader final
+		{
+			uint32_t magic{ SNAPSHOT_MAGIC };
+			uint32_t formatVersion{ SNAPSHOT_FORMAT_VERSION };
+			uint32_t isDelta{ 0 };
+			uint32_t numTypes{ 0 };
+			// Full snapshot: all saved entities, delta: entities created since the base snapshot
+			uint32_t numEntities{ 0 };
+			// Delta only: entities destroyed since the base snapshot
+			uint32_t numDestroyed{ 0 };
+		};
+
+		// Followed by the entities, padding up to DATA_ALIGNMENT, the component data & the removed entities (delta only)
+		struct TypeBlockHeader final
+		{
+			uint32_t nameHash{};
+			uint32_t version{};
+			uint32_t elementSize{};
+			uint32_t alignment{};
+			uint32_t numComponents{};
+			uint32_t numRemoved{};
+		};
+
+		// Component block as it is laid out in a mapped file
+		struct TypeBlock final
+		{
+			TypeBlockHeader header{};
+			std::span<entt::entity const> entities{};
+			std::byte const* pData{ nullptr };
+			std::span<entt::entity const> removed{};
+		};
+
+		struct ParsedSnapshot final
+		{
+			SnapshotHeader header{};
+			std::span<entt::entity const> entities{};
+			std::span<entt::entity const> destroyed{};
+			std::vector<TypeBlock> blocks{};
+		};
+
+		class SnapshotWriter final
+		{
+		public:
+			explicit SnapshotWriter(std::filesystem::path const& path)
+				: m_Stream{ path, std::ios::binary | std::ios::trunc } {}
+
+			[[nodiscard]] bool IsValid() const noexcept { return m_Stream.good(); }
+
+			void Write(void const* pData, std::size_t size)
+			{
+				m_Stream.write(static_cast<char const*>(pData), static_cast<std::streamsize>(size));
+				m_Offset += size;
+			}
+
+			template<typename T>
+				requires std::is_trivially_copyable_v<T>
+			void WriteValue(T const& value)
+			{
+				Write(&value, sizeof(T));
+			}
+
+			void WriteEntities(std::span<entt::entity const> entities)
+			{
+				Write(entities.data(), entities.size_bytes());
+			}
+
+			void Pad(std::size_t alignment)
+			{
+				std::byte constexpr ZEROS[DATA_ALIGNMENT]{};
+				auto const padding{ (alignment - m_Offset % alignment) % alignment };
+				Write(ZEROS, padding);
+			}
+
+		private:
+			std::ofstream m_Stream;
+			std::size_t m_Offset{ 0 };
+		};
+
+		class SnapshotReader final
+		{
+		public:
+			explicit SnapshotReader(std::span<std::byte const> data) noexcept
+				: m_Data{ data } {}
+
+			template<typename T>
+			[[nodiscard]] bool Read(T& value) noexcept
+			{
+				if (m_Offset + sizeof(T) > m_Data.size())
+				{
+					return false;
+				}
+
+				std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+				m_Offset += sizeof(T);
+				return true;
+			}
+
+			// Returns a view into the mapped memory, the data is not copied
+			[[nodiscard]] std::byte const* Take(std::size_t size) noexcept
+			{
+				if (m_Offset + size > m_Data.size())
+				{
+					return nullptr;
+				}
+
+				auto const* pData{ m_Data.data() + m_Offset };
+				m_Offset += size;
+				return pData;
+			}
+
+			[[nodiscard]] bool TakeEntities(uint32_t count, std::span<entt::entity const>& entities) noexcept
+			{
+				auto const* pData{ Take(count * sizeof(entt::entity)) };
+				if (!pData)
+				{
+					return false;
+				}
+
+				entities = { reinterpret_cast<entt::entity const*>(pData), count };
+				return true;
+			}
+
+			void Skip(std::size_t alignment) noexcept
+			{
+				m_Offset += (alignment - m_Offset % alignment) % alignment;
+			}
+
+		private:
+			std::span<std::byte const> m_Data;
+			std::size_t m_Offset{ 0 };
+		};
+
+		[[nodiscard]] bool Parse(std::span<std::byte const> data, ParsedSnapshot& snapshot) noexcept
+		{
+			SnapshotReader reader{ data };
+
+			auto& header{ snapshot.header };
+			if (!reader.Read(header) || SNAPSHOT_MAGIC != header.magic || SNAPSHOT_FORMAT_VERSION != header.formatVersion)
+			{
+				return false;
+			}
+
+			if (!reader.TakeEntities(header.numEntities, snapshot.entities) || !reader.TakeEntities(header.numDestroyed, snapshot.destroyed))
+			{
+				return false;
+			}
+
+			snapshot.blocks.resize(header.numTypes);
+			for (auto& block : snapshot.blocks)
+			{
+				if (!reader.Read(block.header) || !reader.TakeEntities(block.header.numComponents, block.entities))
+				{
+					return false;
+				}
+
+				reader.Skip(DATA_ALIGNMENT);
+				block.pData = reader.Take(static_cast<std::size_t>(block.header.numComponents) * block.header.elementSize);
+				if (!block.pData && block.header.numComponents > 0)
+				{
+					return false;
+				}
+
+				reader.Skip(alignof(entt::entity));
+				if (!reader.TakeEntities(block.header.numRemoved, block.removed))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void WriteBlock(SnapshotWriter& writer, TypeBlockHeader const& header, std::span<entt::entity const> entities, std::byte const* pData, std::span<entt::entity const> removed)
+		{
+			writer.WriteValue(header);
+			writer.WriteEntities(entities);
+			writer.Pad(DATA_ALIGNMENT);
+			writer.Write(pData, static_cast<std::size_t>(header.numComponents) * header.elementSize);
+			writer.Pad(alignof(entt::entity));
+			writer.WriteEntities(removed);
+		}
+
+		[[nodiscard]] TypeBlockHeader MakeBlockHeader(SerializableComponentType const& type, std::size_t numComponents, std::size_t numRemoved) noexcept
+		{
+			return { type.nameHash, type.version, type.size, type.alignment, static_cast<uint32_t>(numComponents), static_cast<uint32_t>(numRemoved) };
+		}
+
+		// Registered type of every block, null for unknown or outdated blocks which are skipped
+		[[nodiscard]] std::vector<SerializableComponentType const*> ResolveTypes(std::vector<SerializableComponentType> const& registered, ParsedSnapshot const& snapshot, std::filesystem::path const& path)
+		{
+			std::vector<SerializableComponentType const*> types(snapshot.blocks.size(), nullptr);
+			for (std::size_t blockIdx{ 0 }; blockIdx < snapshot.blocks.size(); ++blockIdx)
+			{
+				auto const& header{ snapshot.blocks[blockIdx].header };
+				auto const type{ std::ranges::find(registered, header.nameHash, &SerializableComponentType::nameHash) };
+				if (type == registered.end() || type->version != header.version || type->size != header.elementSize)
+				{
+					ME_LOG_WARN(MauCor::LogCategory::Engine, "Skipping unknown or outdated component block {} in {}", header.nameHash, path.string());
+					continue;
+				}
+
+				types[blockIdx] = &*type;
+			}
+
+			return types;
+		}
+
+		// An entity of any version uses the index
+		[[nodiscard]] bool IsIndexInUse(ECSImpl const& impl, entt::entity entity) noexcept
+		{
+			using Traits = entt::entt_traits<entt::entity>;
+			return impl.registry.valid(Traits::construct(Traits::to_entity(entity), impl.registry.current(entity)));
+		}
+
+		// A block holds an entity at most once, a duplicate would insert or replace its component twice
+		[[nodiscard]] bool HasDuplicates(std::span<entt::entity const> entities)
+		{
+			std::vector<entt::entity> sorted(entities.begin(), entities.end());
+			std::ranges::sort(sorted);
+			return std::ranges::adjacent_find(sorted) != sorted.end();
+		}
+
+		// The entities can be recreated with their saved ids: sorted without duplicates & their index is free (or freed by the destroyed entities)
+		[[nodiscard]] bool CanCreateEntities(ECSImpl const& impl, std::span<entt::entity const> entities, std::unordered_set<entt::entity> const& destroyed = {})
+		{
+			using Traits = entt::entt_traits<entt::entity>;
+
+			std::unordered_set<uint32_t> freedIndices{};
+			for (auto const entity : destroyed)
+			{
+				freedIndices.emplace(static_cast<uint32_t>(Traits::to_entity(entity)));
+			}
+
+			for (std::size_t idx{ 0 }; idx < entities.size(); ++idx)
+			{
+				if (idx > 0 && entities[idx - 1] >= entities[idx])
+				{
+					return false;
+				}
+
+				if (IsIndexInUse(impl, entities[idx]) && !freedIndices.contains(static_cast<uint32_t>(Traits::to_entity(entities[idx]))))
+				{
+					ME_LOG_ERROR(MauCor::LogCategory::Engine, "Snapshot entity {} can not be recreated, its index is in use", static_cast<uint32_t>(entities[idx]));
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Recreates the entities with the same ids they were saved with, validated with CanCreateEntities
+		void CreateEntities(ECSImpl& impl, std::span<entt::entity const> entities)
+		{
+			for (auto const entity : entities)
+			{
+				[[maybe_unused]] auto const created{ impl.registry.create(entity) };
+				ME_ASSERT(created == entity);
+			}
+		}
+	}
+
+	void WorldSerializer::RegisterComponent(SerializableComponentType&& type)
+	{
+		ME_ASSERT(!FindType(type.nameHash), "Component names have to be unique");
+		m_Types.emplace_back(std::move(type));
+	}
+
+	SerializableComponentType const* WorldSerializer::FindType(uint32_t nameHash) const noexcept
+	{
+		auto const it{ std::ranges::find(m_Types, nameHash, &SerializableComponentType::nameHash) };
+		return it != m_Types.end() ? &*it : nullptr;
+	}
+
+	bool WorldSerializer::Save(ECSWorld& world, std::filesystem::path const& path) const
+	{
+		ME_PROFILE_FUNCTION()
+
+		auto& impl{ *world.m_pImpl };
+
+		std::vector<std::vector<entt::entity>> typeEntities(m_Types.size());
+		std::vector<std::vector<std::byte>> typeData(m_Types.size());
+		std::vector<entt::entity> entities{};
+
+		for (std::size_t typeIdx{ 0 }; typeIdx < m_Types.size(); ++typeIdx)
+		{
+			m_Types[typeIdx].gather(impl, typeEntities[typeIdx], typeData[typeIdx]);
+			entities.insert(entities.end(), typeEntities[typeIdx].begin(), typeEntities[typeIdx].end());
+		}
+
+		// Sorted so the entities are recreated in the same order, which keeps the free list of the registry small
+		std::ranges::sort(entities);
+		auto const duplicates{ std::ranges::unique(entities) };
+		entities.erase(duplicates.begin(), duplicates.end());
+
+		SnapshotWriter writer{ path };
+		if (!writer.IsValid())
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "Failed to open {} for writing", path.string());
+			return false;
+		}
+
+		SnapshotHeader header{};
+		header.numTypes = static_cast<uint32_t>(m_Types.size());
+		header.numEntities = static_cast<uint32_t>(entities.size());
+
+		writer.WriteValue(header);
+		writer.WriteEntities(entities);
+
+		for (std::size_t typeIdx{ 0 }; typeIdx < m_Types.size(); ++typeIdx)
+		{
+			WriteBlock(writer, MakeBlockHeader(m_Types[typeIdx], typeEntities[typeIdx].size(), 0), typeEntities[typeIdx], typeData[typeIdx].data(), {});
+		}
+
+		return writer.IsValid();
+	}
+
+	bool WorldSerializer::Load(ECSWorld& world, std::filesystem::path const& path) const
+	{
+		ME_PROFILE_FUNCTION()
+
+		MauCor::MappedFile const file{ path };
+		ParsedSnapshot snapshot{};
+		if (!file.IsOpen() || !Parse(file.Data(), snapshot) || snapshot.header.isDelta)
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} is not a valid snapshot", path.string());
+			return false;
+		}
+
+		auto& impl{ *world.m_pImpl };
+
+		// Everything that can fail is checked before the world is touched
+		if (!CanCreateEntities(impl, snapshot.entities))
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} does not fit the world, is it empty?", path.string());
+			return false;
+		}
+
+		auto const types{ ResolveTypes(m_Types, snapshot, path) };
+		for (std::size_t blockIdx{ 0 }; blockIdx < snapshot.blocks.size(); ++blockIdx)
+		{
+			bool const hasUnsavedEntity{ types[blockIdx] && std::ranges::any_of(snapshot.blocks[blockIdx].entities, [&snapshot](entt::entity entity)
+				{
+					return !std::ranges::binary_search(snapshot.entities, entity);
+				}) };
+
+			if (hasUnsavedEntity)
+			{
+				ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} has components of entities it does not hold", path.string());
+				return false;
+			}
+
+			if (types[blockIdx] && HasDuplicates(snapshot.blocks[blockIdx].entities))
+			{
+				ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} lists an entity twice in a component block", path.string());
+				return false;
+			}
+		}
+
+		CreateEntities(impl, snapshot.entities);
+
+		for (std::size_t blockIdx{ 0 }; blockIdx < snapshot.blocks.size(); ++blockIdx)
+		{
+			if (auto const* pType{ types[blockIdx] })
+			{
+				// Bulk insert straight from the mapped file
+				auto const& block{ snapshot.blocks[blockIdx] };
+				pType->insert(impl, block.entities.data(), block.entities.data() + block.entities.size(), block.pData);
+			}
+		}
+
+		return true;
+	}
+
+	bool WorldSerializer::SaveDelta(ECSWorld& world, std::filesystem::path const& basePath, std::filesystem::path const& deltaPath) const
+	{
+		ME_PROFILE_FUNCTION()
+
+		MauCor::MappedFile const baseFile{ basePath };
+		ParsedSnapshot base{};
+		if (!baseFile.IsOpen() || !Parse(baseFile.Data(), base) || base.header.isDelta)
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} is not a valid base snapshot", basePath.string());
+			return false;
+		}
+
+		auto& impl{ *world.m_pImpl };
+
+		std::vector<std::vector<entt::entity>> changedEntities(m_Types.size());
+		std::vector<std::vector<std::byte>> changedData(m_Types.size());
+		std::vector<std::vector<entt::entity>> removedEntities(m_Types.size());
+		std::unordered_set<entt::entity> currentEntities{};
+
+		std::vector<entt::entity> entities{};
+		std::vector<std::byte> data{};
+
+		for (std::size_t typeIdx{ 0 }; typeIdx < m_Types.size(); ++typeIdx)
+		{
+			auto const& type{ m_Types[typeIdx] };
+
+			entities.clear();
+			data.clear();
+			type.gather(impl, entities, data);
+			currentEntities.insert(entities.begin(), entities.end());
+
+			// Components of this type in the base snapshot, blocks of another version are treated as missing
+			std::unordered_map<entt::entity, std::byte const*> baseComponents{};
+			auto const baseBlock{ std::ranges::find_if(base.blocks, [&type](TypeBlock const& block)
+				{
+					return block.header.nameHash == type.nameHash && block.header.version == type.version && block.header.elementSize == type.size;
+				}) };
+
+			if (baseBlock != base.blocks.end())
+			{
+				baseComponents.reserve(baseBlock->entities.size());
+				for (std::size_t idx{ 0 }; idx < baseBlock->entities.size(); ++idx)
+				{
+					baseComponents.emplace(baseBlock->entities[idx], baseBlock->pData + idx * type.size);
+				}
+
+				// Removed from entities that are still alive, destroyed entities lose their components anyway
+				for (auto const entity : baseBlock->entities)
+				{
+					if (impl.registry.valid(entity) && !type.has(impl, entity))
+					{
+						removedEntities[typeIdx].emplace_back(entity);
+					}
+				}
+			}
+
+			for (std::size_t idx{ 0 }; idx < entities.size(); ++idx)
+			{
+				auto const* pCurrent{ data.data() + idx * type.size };
+
+				auto const it{ baseComponents.find(entities[idx]) };
+				if (it != baseComponents.end() && type.equals(it->second, pCurrent))
+				{
+					continue;
+				}
+
+				changedEntities[typeIdx].emplace_back(entities[idx]);
+				changedData[typeIdx].insert(changedData[typeIdx].end(), pCurrent, pCurrent + type.size);
+			}
+		}
+
+		std::unordered_set<entt::entity> const baseEntities{ base.entities.begin(), base.entities.end() };
+
+		std::vector<entt::entity> created{};
+		std::ranges::copy_if(currentEntities, std::back_inserter(created), [&baseEntities](entt::entity entity) { return !baseEntities.contains(entity); });
+		std::ranges::sort(created);
+
+		std::vector<entt::entity> destroyed{};
+		std::ranges::copy_if(base.entities, std::back_inserter(destroyed), [&currentEntities](entt::entity entity) { return !currentEntities.contains(entity); });
+
+		SnapshotWriter writer{ deltaPath };
+		if (!writer.IsValid())
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "Failed to open {} for writing", deltaPath.string());
+			return false;
+		}
+
+		SnapshotHeader header{};
+		header.isDelta = 1;
+		header.numTypes = static_cast<uint32_t>(m_Types.size());
+		header.numEntities = static_cast<uint32_t>(created.size());
+		header.numDestroyed = static_cast<uint32_t>(destroyed.size());
+
+		writer.WriteValue(header);
+		writer.WriteEntities(created);
+		writer.WriteEntities(destroyed);
+
+		for (std::size_t typeIdx{ 0 }; typeIdx < m_Types.size(); ++typeIdx)
+		{
+			WriteBlock(writer, MakeBlockHeader(m_Types[typeIdx], changedEntities[typeIdx].size(), removedEntities[typeIdx].size()),
+				changedEntities[typeIdx], changedData[typeIdx].data(), removedEntities[typeIdx]);
+		}
+
+		return writer.IsValid();
+	}
+
+	bool WorldSerializer::LoadDelta(ECSWorld& world, std::filesystem::path const& deltaPath) const
+	{
+		ME_PROFILE_FUNCTION()
+
+		MauCor::MappedFile const file{ deltaPath };
+		ParsedSnapshot delta{};
+		if (!file.IsOpen() || !Parse(file.Data(), delta) || !delta.header.isDelta)
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} is not a valid delta snapshot", deltaPath.string());
+			return false;
+		}
+
+		auto& impl{ *world.m_pImpl };
+
+		// Everything that can fail is checked before the world is touched
+		std::unordered_set<entt::entity> destroyed{};
+		std::ranges::copy_if(delta.destroyed, std::inserter(destroyed, destroyed.end()), [&impl](entt::entity entity) { return impl.registry.valid(entity); });
+
+		if (!CanCreateEntities(impl, delta.entities, destroyed))
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} does not fit the world, was it loaded from the base snapshot?", deltaPath.string());
+			return false;
+		}
+
+		// Alive once the destroyed & created entities are applied
+		auto const isAliveAfterDelta{ [&](entt::entity entity)
+			{
+				return (impl.registry.valid(entity) && !destroyed.contains(entity)) || std::ranges::binary_search(delta.entities, entity);
+			} };
+
+		auto const types{ ResolveTypes(m_Types, delta, deltaPath) };
+		for (std::size_t blockIdx{ 0 }; blockIdx < delta.blocks.size(); ++blockIdx)
+		{
+			auto const& block{ delta.blocks[blockIdx] };
+			if (types[blockIdx] && !(std::ranges::all_of(block.entities, isAliveAfterDelta) && std::ranges::all_of(block.removed, isAliveAfterDelta)))
+			{
+				ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} changes components of entities that do not exist", deltaPath.string());
+				return false;
+			}
+
+			if (types[blockIdx] && (HasDuplicates(block.entities) || HasDuplicates(block.removed)))
+			{
+				ME_LOG_ERROR(MauCor::LogCategory::Engine, "{} lists an entity twice in a component block", deltaPath.string());
+				return false;
+			}
+		}
+
+		for (auto const entity : destroyed)
+		{
+			impl.registry.destroy(entity);
+		}
+
+		CreateEntities(impl, delta.entities);
+
+		std::vector<entt::entity> inserted{};
+		std::vector<std::byte> insertedData{};
+
+		for (std::size_t blockIdx{ 0 }; blockIdx < delta.blocks.size(); ++blockIdx)
+		{
+			auto const* pType{ types[blockIdx] };
+			if (!pType)
+			{
+				continue;
+			}
+
+			auto const& block{ delta.blocks[blockIdx] };
+			pType->erase(impl, block.removed.data(), block.removed.data() + block.removed.size());
+
+			// Changed components are replaced in place, added ones are gathered for a single bulk insert
+			inserted.clear();
+			insertedData.clear();
+
+			for (std::size_t idx{ 0 }; idx < block.entities.size(); ++idx)
+			{
+				auto const* pData{ block.pData + idx * pType->size };
+				if (pType->has(impl, block.entities[idx]))
+				{
+					pType->replace(impl, block.entities[idx], pData);
+				}
+				else
+				{
+					inserted.emplace_back(block.entities[idx]);
+					insertedData.insert(insertedData.end(), pData, pData + pType->size);
+				}
+			}
+
+			if (!inserted.empty())
+			{
+				pType->insert(impl, inserted.data(), inserted.data() + inserted.size(), insertedData.data());
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,297 @@
+#ifndef MAUENG_COMMANDBUFFER_H
+#define MAUENG_COMMANDBUFFER_H
+
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "EntityID.h"
+#include "EnttImpl.h"
+#include "System.h"
+
+namespace MauEng::ECS
+{
+	// Entity that will be created when the command buffer is played back
+	struct PendingEntity final
+	{
+		uint32_t recorderIdx{};
+		uint32_t index{};
+	};
+
+	// A command either targets an existing entity or one that is created by the same command buffer
+	using CommandTarget = std::variant<EntityID, PendingEntity>;
+
+	// Maps pending entities to the entities created during playback
+	class PendingEntityResolver final
+	{
+	public:
+		PendingEntityResolver(std::span<uint32_t const> recorderOffsets, std::span<entt::entity const> createdEntities) noexcept
+			: m_RecorderOffsets{ recorderOffsets }, m_CreatedEntities{ createdEntities } {}
+
+		[[nodiscard]] entt::entity operator()(CommandTarget const& target) const noexcept
+		{
+			if (auto const* pID{ std::get_if<EntityID>(&target) })
+			{
+				return static_cast<entt::entity>(*pID);
+			}
+
+			auto const& pending{ std::get<PendingEntity>(target) };
+			return m_CreatedEntities[m_RecorderOffsets[pending.recorderIdx] + pending.index];
+		}
+
+	private:
+		std::span<uint32_t const> m_RecorderOffsets;
+		std::span<entt::entity const> m_CreatedEntities;
+	};
+
+	class ComponentCommandsBase
+	{
+	public:
+		ComponentCommandsBase() = default;
+		virtual ~ComponentCommandsBase() = default;
+
+		// Plays back the commands of all recorders for this component type, pools all hold the same component type
+		virtual void Playback(ECSImpl& impl, std::span<ComponentCommandsBase* const> pools, PendingEntityResolver const& resolve) = 0;
+		virtual void Clear() noexcept = 0;
+		[[nodiscard]] virtual bool IsEmpty() const noexcept = 0;
+
+		// Position of the first command in its recorder, types are played back in the order they were first recorded
+		uint32_t firstSequence{ 0 };
+
+		ComponentCommandsBase(ComponentCommandsBase const&) = delete;
+		ComponentCommandsBase(ComponentCommandsBase&&) = delete;
+		ComponentCommandsBase& operator=(ComponentCommandsBase const&) = delete;
+		ComponentCommandsBase& operator=(ComponentCommandsBase&&) = delete;
+	};
+
+	template<typename ComponentType>
+	class ComponentCommands final : public ComponentCommandsBase
+	{
+	public:
+		// Component index of a remove command
+		static uint32_t constexpr REMOVE{ UINT32_MAX };
+
+		ComponentCommands() = default;
+		virtual ~ComponentCommands() override = default;
+
+		// Adds & removes in record order, an add has the index of its component
+		std::vector<CommandTarget> targets{};
+		std::vector<uint32_t> componentIndices{};
+		std::vector<ComponentType> components{};
+
+		void Add(CommandTarget const& target, ComponentType&& component, uint32_t sequence)
+		{
+			Record(target, static_cast<uint32_t>(components.size()), sequence);
+			components.emplace_back(std::move(component));
+		}
+
+		void Remove(CommandTarget const& target, uint32_t sequence)
+		{
+			Record(target, REMOVE, sequence);
+		}
+
+		virtual void Playback(ECSImpl& impl, std::span<ComponentCommandsBase* const> pools, PendingEntityResolver const& resolve) override
+		{
+			// Only the last command per entity matters, the result is the same as playing them back one by one in record order
+			struct LastCommand final
+			{
+				entt::entity entity;
+				ComponentCommands* pPool;
+				uint32_t componentIdx;
+			};
+
+			std::vector<LastCommand> lastCommands{};
+			std::unordered_map<entt::entity, size_t> commandIndices{};
+
+			for (auto* pBase : pools)
+			{
+				auto& pool{ *static_cast<ComponentCommands*>(pBase) };
+				for (size_t idx{ 0 }; idx < pool.targets.size(); ++idx)
+				{
+					LastCommand const command{ resolve(pool.targets[idx]), &pool, pool.componentIndices[idx] };
+
+					if (auto const [it, isNew]{ commandIndices.try_emplace(command.entity, lastCommands.size()) }; isNew)
+					{
+						lastCommands.emplace_back(command);
+					}
+					else
+					{
+						lastCommands[it->second] = command;
+					}
+				}
+			}
+
+			std::vector<entt::entity> entities{};
+
+			for (auto const& command : lastCommands)
+			{
+				if (REMOVE == command.componentIdx && impl.registry.valid(command.entity) && impl.registry.all_of<ComponentType>(command.entity))
+				{
+					entities.emplace_back(command.entity);
+				}
+			}
+
+			if (!entities.empty())
+			{
+				impl.Erase<ComponentType>(entities.begin(), entities.end());
+			}
+
+			entities.clear();
+			std::vector<ComponentType> added{};
+
+			for (auto const& command : lastCommands)
+			{
+				if (REMOVE == command.componentIdx || !impl.registry.valid(command.entity))
+				{
+					continue;
+				}
+
+				auto& component{ command.pPool->components[command.componentIdx] };
+
+				// Rare path, entity already has the component so it can not be part of the batch
+				if (impl.registry.all_of<ComponentType>(command.entity))
+				{
+					if constexpr (!std::is_empty_v<ComponentType>)
+					{
+						impl.registry.replace<ComponentType>(command.entity, std::move(component));
+					}
+					continue;
+				}
+
+				entities.emplace_back(command.entity);
+				added.emplace_back(std::move(component));
+			}
+
+			if (!entities.empty())
+			{
+				if constexpr (std::is_empty_v<ComponentType>)
+				{
+					impl.Insert(entities.begin(), entities.end(), ComponentType{});
+				}
+				else
+				{
+					impl.Insert<ComponentType>(entities.begin(), entities.end(), added.begin());
+				}
+			}
+		}
+
+		virtual void Clear() noexcept override
+		{
+			targets.clear();
+			componentIndices.clear();
+			components.clear();
+		}
+
+		[[nodiscard]] virtual bool IsEmpty() const noexcept override { return targets.empty(); }
+
+	private:
+		void Record(CommandTarget const& target, uint32_t componentIdx, uint32_t sequence)
+		{
+			if (targets.empty())
+			{
+				firstSequence = sequence;
+			}
+
+			targets.emplace_back(target);
+			componentIndices.emplace_back(componentIdx);
+		}
+	};
+
+	/*
+	 * Records structural changes (create / destroy entities, add / remove components) from parallel code.
+	 * Each thread records into its own recorder, so recording never locks after the first command of a thread.
+	 * The commands are played back in one batched pass on a sync point (e.g between system stages).
+	 */
+	class CommandBuffer final
+	{
+	public:
+		CommandBuffer();
+		~CommandBuffer() = default;
+
+		// Create an entity on playback, the returned handle can be used to add components to it
+		[[nodiscard]] PendingEntity CreateEntity();
+
+		// Destroy an entity on playback
+		void DestroyEntity(CommandTarget const& target);
+
+		/**
+		 * @brief Add a component on playback, replaces the component if the entity already has it by then.
+		 * @tparam ComponentType Type of component to add.
+		 * @param target existing or pending entity to add the component to.
+		 * @param component component to add.
+		 * @note Adds & removes of the same component type on one entity play back in record order, the last one decides.
+		*/
+		template<typename ComponentType>
+		void AddComponent(CommandTarget const& target, ComponentType component = {})
+		{
+			auto& recorder{ GetRecorder() };
+			recorder.GetPool<ComponentType>().Add(target, std::move(component), recorder.commandCount++);
+			recorder.isEmpty = false;
+		}
+
+		/**
+		 * @brief Remove a component on playback, does nothing if the entity does not have the component.
+		 * @tparam ComponentType Type of component to remove.
+		 * @param target existing or pending entity to remove the component from.
+		*/
+		template<typename ComponentType>
+		void RemoveComponent(CommandTarget const& target)
+		{
+			auto& recorder{ GetRecorder() };
+			recorder.GetPool<ComponentType>().Remove(target, recorder.commandCount++);
+			recorder.isEmpty = false;
+		}
+
+		// Play back all recorded commands & clear them, must be called while no thread is recording
+		void Playback(ECSImpl& impl);
+
+		[[nodiscard]] bool IsEmpty() const noexcept;
+
+		CommandBuffer(CommandBuffer const&) = delete;
+		CommandBuffer(CommandBuffer&&) = delete;
+		CommandBuffer& operator=(CommandBuffer const&) = delete;
+		CommandBuffer& operator=(CommandBuffer&&) = delete;
+
+	private:
+		struct Recorder final
+		{
+			uint32_t index{};
+			uint32_t pendingCount{ 0 };
+			// Component commands recorded so far, orders the component types
+			uint32_t commandCount{ 0 };
+			bool isEmpty{ true };
+
+			std::vector<CommandTarget> destroyTargets{};
+			std::unordered_map<ComponentTypeID, std::unique_ptr<ComponentCommandsBase>> componentCommands{};
+
+			template<typename ComponentType>
+			[[nodiscard]] ComponentCommands<ComponentType>& GetPool()
+			{
+				auto& pPool{ componentCommands[GetComponentTypeID<ComponentType>()] };
+				if (!pPool)
+				{
+					pPool = std::make_unique<ComponentCommands<ComponentType>>();
+				}
+
+				return *static_cast<ComponentCommands<ComponentType>*>(pPool.get());
+			}
+
+			void Clear() noexcept;
+		};
+
+		// Unique per buffer, used to validate the thread local recorder cache
+		uint64_t m_ID;
+
+		std::vector<std::unique_ptr<Recorder>> m_Recorders{};
+		std::unordered_map<std::thread::id, Recorder*> m_ThreadRecorders{};
+		std::mutex m_RecorderMutex{};
+
+		[[nodiscard]] Recorder& GetRecorder();
+	};
+}
+
+#endif
@@ -3,7 +3,9 @@
 
 #include "EntityID.h"
 #include <memory>
+#include <memory_resource>
 #include <concepts>
+#include <ranges>
 
 #include "CoreServiceLocator.h"
 #include "Asserts/Asserts.h"
@@ -12,6 +14,10 @@
 
 #include "View.h"
 #include "Group.h"
+#include "SystemScheduler.h"
+#include "CommandBuffer.h"
+#include "Prototype.h"
+#include "ReactiveQuery.h"
 
 namespace MauEng
 {
@@ -23,7 +29,8 @@ namespace MauEng::ECS
 	class ECSWorld final
 	{
 	public:
-		ECSWorld();
+		// Every component pool allocates from the memory resource, it has to outlive the world
+		explicit ECSWorld(std::pmr::memory_resource* pResource = std::pmr::get_default_resource());
 		~ECSWorld();
 
 		ECSWorld(ECSWorld const&) = delete;
@@ -43,10 +50,106 @@ namespace MauEng::ECS
 			return m_pImpl->IsOwned<ComponentTypes...>();
 		}
 
+#pragma region Memory
+		/**
+		 * @brief Reserve room in the pool of a component type, avoids reallocating the pool while it fills up.
+		 * @tparam ComponentType Type of the pool.
+		 * @param count amount of components the pool should hold without growing.
+		*/
+		template<typename ComponentType>
+		void Reserve(std::size_t count)&
+		{
+			m_pImpl->Reserve<ComponentType>(count);
+		}
+
+		// Reserve room for count entities without growing the entity pool
+		void ReserveEntities(std::size_t count)&
+		{
+			m_pImpl->ReserveEntities(count);
+		}
+
+		/**
+		 * @brief Memory used by the pool of a component type.
+		 * @tparam ComponentType Type of the pool.
+		 * @return size, capacity & bytes of the pool, empty when the pool doesn't exist yet.
+		*/
+		template<typename ComponentType>
+		[[nodiscard]] PoolStats GetPoolStats() const& noexcept
+		{
+			return m_pImpl->GetPoolStats<ComponentType>();
+		}
+
+		// Stats of every pool, the component bytes are not known here (see GetPoolStats<ComponentType>)
+		[[nodiscard]] std::vector<PoolStats> GetAllPoolStats() const&
+		{
+			return m_pImpl->GetAllPoolStats();
+		}
+#pragma endregion
+
 #pragma region Entities
 		// Create an entity and add it to the ECS
 		[[nodiscard]] Entity CreateEntity() & noexcept;
 
+		/**
+		 * @brief Create an entity for every element in the range.
+		 * @tparam Iterator iterator type, the range holds EntityIDs.
+		 * @param begin start of the range to fill.
+		 * @param end end of the range to fill.
+		*/
+		template<typename Iterator>
+			requires std::same_as<std::iter_value_t<Iterator>, EntityID>
+		void CreateEntities(Iterator begin, Iterator end) &
+		{
+			m_pImpl->CreateEntities(begin, end);
+		}
+
+		/**
+		 * @brief Create entities that all start with a copy of the prototype's components.
+		 * @tparam ComponentTypes Component types in the prototype.
+		 * @param count amount of entities to create.
+		 * @param prototype components every entity starts with.
+		 * @return ids of the created entities.
+		*/
+		template<typename... ComponentTypes>
+		std::vector<EntityID> CreateEntities(uint32_t count, Prototype<ComponentTypes...> const& prototype) &
+		{
+			ME_PROFILE_FUNCTION()
+
+			return ToEntityIDs(CreateFromPrototype(count, prototype));
+		}
+
+		/**
+		 * @brief Create entities that all start with a copy of the prototype's components & initialise each of them.
+		 * @tparam ComponentTypes Component types in the prototype.
+		 * @tparam InitFunc Function type, invoked as init(index, ComponentTypes&...).
+		 * @tparam ExecPolicy Policy to run the init function with.
+		 * @param count amount of entities to create.
+		 * @param prototype components every entity starts with.
+		 * @param init function to initialise the components of each entity.
+		 * @param policy Policy to multithread the init function with.
+		 * @return ids of the created entities.
+		 * @note init may only modify the components it is given, use the command buffer for structural changes.
+		*/
+		template<typename... ComponentTypes, typename InitFunc, typename ExecPolicy = std::execution::sequenced_policy>
+			requires std::is_invocable_v<InitFunc, uint32_t, ComponentTypes&...>
+					&& std::is_execution_policy_v<std::remove_cvref_t<ExecPolicy>>
+		std::vector<EntityID> CreateEntities(uint32_t count, Prototype<ComponentTypes...> const& prototype, InitFunc&& init, ExecPolicy policy = ExecPolicy{}) &
+		{
+			ME_PROFILE_FUNCTION()
+
+			auto const entities{ CreateFromPrototype(count, prototype) };
+
+			// Pools are not modified here, getting components from multiple threads is safe
+			// Iterates the indices, a parallel policy may hand the lambda copies of the entities
+			auto const indices{ std::views::iota(0u, static_cast<uint32_t>(entities.size())) };
+			std::for_each(policy, indices.begin(), indices.end(), [&](uint32_t index)
+				{
+					init(index, m_pImpl->registry.get<ComponentTypes>(entities[index])...);
+				});
+
+			return ToEntityIDs(entities);
+		}
+
 		// Destroy an Entity & remove it from the ECS
 		void DestroyEntity(Entity entity) & noexcept;
 		// Destroy an Entity & remove it from the ECS
@@ -57,6 +160,12 @@ namespace MauEng::ECS
 		// Checks if the entity is valid
 		[[nodiscard]] bool IsValid(EntityID id) const& noexcept;
 
+		// Index part of the id (without the version), dense & reused once the entity is destroyed
+		[[nodiscard]] static constexpr uint32_t GetEntityIndex(EntityID id) noexcept
+		{
+			return static_cast<uint32_t>(entt::to_entity(static_cast<InternalEntityType>(id)));
+		}
+
 		/**
 		 * @brief Remove all components in the registry of a given type.
 		 * @tparam ComponentType Component type to clear.
@@ -140,6 +249,22 @@ namespace MauEng::ECS
 			m_pImpl->Insert(begin, end, component);
 		}
 
+		/**
+		 * @brief Add a component to every entity in the range, each entity gets its own component.
+		 * @tparam ComponentType Type of component to insert.
+		 * @tparam It iterator type.
+		 * @tparam ComponentIt component iterator type.
+		 * @param begin start of the range to add component to.
+		 * @param end end of the range to add component to.
+		 * @param from start of the components, must hold as many components as there are entities in the range.
+		*/
+		template<typename ComponentType, typename It, typename ComponentIt>
+			requires std::input_iterator<ComponentIt>
+		void Insert(It begin, It end, ComponentIt from)
+		{
+			m_pImpl->Insert<ComponentType>(begin, end, from);
+		}
+
 #pragma endregion
 
 #pragma region Components
@@ -313,17 +438,38 @@ namespace MauEng::ECS
 			ME_ASSERT(IsValid(id));
 			return m_pImpl->GetOrEmplaceComponent<ComponentType>(id, std::forward<Args>(args)...);
 		}
+
+		/**
+		 * @brief Modify a component in place & notify the reactive queries that observe updates of it.
+		 * @tparam ComponentType Type of component to modify.
+		 * @tparam Funcs Types of the functions (usually automatically deduced).
+		 * @param id entity of the component.
+		 * @param funcs called in order as func(component&).
+		 * @return The component by reference.
+		 * @warning Observing queries are notified on the calling thread, don't patch an observed type from parallel code.
+		*/
+		template<typename ComponentType, typename... Funcs>
+			requires (std::invocable<Funcs, ComponentType&> && ...)
+		ComponentType& Patch(EntityID id, Funcs&&... funcs) & noexcept
+		{
+			ME_ASSERT(IsValid(id));
+			ME_ASSERT(HasComponent<ComponentType>(id));
+
+			return m_pImpl->Patch<ComponentType>(id, std::forward<Funcs>(funcs)...);
+		}
 		
 		/**
 		 * @brief Sort a specific component type in the ECS.
 		 * @tparam ComponentType Type of component to sort.
 		 * @tparam Compare Type of comparison object.
+		 * @tparam SortAlgo Type of callable sorting object (e.g ParallelSort).
 		 * @param compare comparison object.
+		 * @param algo sorting algorithm object.
 		*/
-		template<typename ComponentType, typename Compare>
+		template<typename ComponentType, typename Compare, typename SortAlgo = entt::std_sort>
 			requires std::invocable<Compare, ComponentType const&, ComponentType const&>
 				  || std::invocable<Compare, EntityID, EntityID>
-		void Sort(Compare&& compare) & noexcept
+		void Sort(Compare&& compare, SortAlgo algo = SortAlgo{}) & noexcept
 		{
 			if (IsOwned<ComponentType>())
 			{
@@ -334,12 +480,31 @@ namespace MauEng::ECS
 
 			if constexpr (std::invocable<Compare, EntityID, EntityID>)
 			{
-				m_pImpl->Sort<ComponentType>([&](InternalEntityType lhs, InternalEntityType rhs) { return compare(static_cast<EntityID>(lhs), static_cast<EntityID>(rhs)); });
+				m_pImpl->Sort<ComponentType>([&](InternalEntityType lhs, InternalEntityType rhs) { return compare(static_cast<EntityID>(lhs), static_cast<EntityID>(rhs)); }, algo);
 			}
 			else if constexpr (std::invocable<Compare, ComponentType const&, ComponentType const&>)
 			{
-				m_pImpl->Sort<ComponentType>(std::forward<Compare>(compare));
+				m_pImpl->Sort<ComponentType>(std::forward<Compare>(compare), algo);
+			}
+		}
+
+		/**
+		 * @brief Sort a specific component type ascending on a key with a parallel radix sort, faster than a compare based sort for big pools.
+		 * @tparam ComponentType Type of component to sort.
+		 * @tparam KeyFunc Type of key function.
+		 * @param key returns the uint32_t or uint64_t key of a component, called from multiple threads (use OrderedKey for floats).
+		*/
+		template<typename ComponentType, typename KeyFunc>
+			requires RadixKeyType<std::invoke_result_t<KeyFunc const&, ComponentType const&>>
+		void SortByKey(KeyFunc const& key) & noexcept
+		{
+			if (IsOwned<ComponentType>())
+			{
+				ME_LOG(MauCor::LogPriority::Error, MauCor::LogCategory::Engine, "Can not sort, trying to sort owned components (use group sort)");
+				return;
 			}
+
+			m_pImpl->SortByKey<ComponentType>(key);
 		}
 
 		// @brief Sort 2 component types to be more cache efficient in the registry (e.g Transform, Mesh, Transform, Mesh and so on).
@@ -358,6 +523,24 @@ namespace MauEng::ECS
 
 #pragma endregion
 
+#pragma region ReactiveQueries
+		/**
+		 * @brief Create a query that collects the entities of which the component was added, removed and/or updated.
+		 * @tparam ComponentType Type of component to observe.
+		 * @param events changes to collect, e.g ComponentEvent::Added | ComponentEvent::Removed.
+		 * @return The query, it collects until it is destroyed.
+		 * @note Updates are only noticed through ReplaceComponent, AddOrReplaceComponent & Patch (WorldSerializer::LoadDelta patches).
+		 * @warning The world has to outlive the query. Create queries outside of systems, creating one modifies the registry.
+		*/
+		template<typename ComponentType>
+		[[nodiscard]] ReactiveQuery Observe(ComponentEvent events = ComponentEvent::Added) &
+		{
+			ReactiveQuery query{};
+			query.Connect<ComponentType>(m_pImpl->registry, events);
+			return query;
+		}
+#pragma endregion
+
 #pragma region ViewsAndGroups
 #pragma region Views
 		/**
@@ -423,8 +606,105 @@ namespace MauEng::ECS
 #pragma endregion
 #pragma endregion
 
+#pragma region Systems
+		/**
+		 * @brief Register a system, its component access is declared with Read<> & Write<> (e.g AddSystem<Read<CTransform>, Write<CVelocity>>).
+		 * @tparam Accesses Read<> / Write<> declarations of every component the system touches.
+		 * @tparam Func Function type, invocable with the ECSWorld or with the accessed components (in declaration order, Read<> ones as const&).
+		 * @tparam ExecPolicy Policy used to iterate the entities of a per entity system.
+		 * @param name Name of the system, used for profiling.
+		 * @param func System to run each tick.
+		 * @param policy Policy to multithread the entity loop with.
+		 * @note Systems without conflicting access run in parallel, a system may not create or destroy entities or components (use the command buffer).
+		*/
+		template<SystemAccessType... Accesses, typename Func, typename ExecPolicy = std::execution::sequenced_policy>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecPolicy>>
+		void AddSystem(char const* name, Func&& func, ExecPolicy policy = ExecPolicy{}) &
+		{
+			using Access = SystemAccess<Accesses...>;
+
+			// Create the pools up front, views created from parallel systems may then never modify the registry
+			[this]<typename... ComponentTypes>(TypeList<ComponentTypes...>)
+			{
+				m_pImpl->AssureStorage<ComponentTypes...>();
+			}(typename Access::Components{});
+
+			SystemEntry system{ .name = name, .reads = Access::Reads(), .writes = Access::Writes() };
+
+			if constexpr (std::is_invocable_v<Func, ECSWorld&>)
+			{
+				system.func = std::forward<Func>(func);
+			}
+			else
+			{
+				static_assert(!std::is_same_v<typename Access::Components, TypeList<>>, "A per entity system has to access at least one component");
+
+				system.func = [f = std::forward<Func>(func), policy](ECSWorld& world) mutable
+					{
+						[&]<typename... ComponentTypes>(TypeList<ComponentTypes...>)
+						{
+							world.View<ComponentTypes...>().Each(f, policy);
+						}(typename Access::Parameters{});
+					};
+			}
+
+			m_Systems.AddSystem(std::move(system));
+		}
+
+		// @brief Register a system without a name, see AddSystem(name, func, policy).
+		template<SystemAccessType... Accesses, typename Func, typename ExecPolicy = std::execution::sequenced_policy>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecPolicy>>
+		void AddSystem(Func&& func, ExecPolicy policy = ExecPolicy{}) &
+		{
+			AddSystem<Accesses...>("Unnamed System", std::forward<Func>(func), policy);
+		}
+
+		// Run all registered systems, called once per tick by the scene
+		void RunSystems() &;
+
+		// Buffer to record structural changes into from systems & other parallel code
+		[[nodiscard]] CommandBuffer& GetCommandBuffer() & noexcept { return m_CommandBuffer; }
+		// Play back the recorded structural changes, happens automatically after every system stage
+		void FlushCommands() &;
+		// Remove all registered systems
+		void ClearSystems() & noexcept;
+
+		[[nodiscard]] std::size_t SystemCount() const& noexcept { return m_Systems.SystemCount(); }
+#pragma endregion
+
 	private:
+		// Reads & writes the raw component pools
+		friend class WorldSerializer;
+
+		template<typename... ComponentTypes>
+		[[nodiscard]] std::vector<InternalEntityType> CreateFromPrototype(uint32_t count, Prototype<ComponentTypes...> const& prototype)
+		{
+			std::vector<InternalEntityType> entities(count);
+			m_pImpl->CreateEntities(entities.begin(), entities.end());
+
+			// Grow every pool once up front, inserting would otherwise reallocate the pools several times
+			(m_pImpl->ReserveAdditional<ComponentTypes>(count), ...);
+
+			// One insert per component type instead of an emplace per entity
+			std::apply([&](ComponentTypes const&... comps)
+				{
+					(m_pImpl->Insert(entities.begin(), entities.end(), comps), ...);
+				}, prototype.components);
+
+			return entities;
+		}
+
+		[[nodiscard]] static std::vector<EntityID> ToEntityIDs(std::vector<InternalEntityType> const& entities)
+		{
+			std::vector<EntityID> ids(entities.size());
+			std::ranges::transform(entities, ids.begin(), [](InternalEntityType entity) { return static_cast<EntityID>(entity); });
+
+			return ids;
+		}
+
 		std::unique_ptr<ECSImpl> m_pImpl;
+		SystemScheduler m_Systems{};
+		CommandBuffer m_CommandBuffer{};
 	};
 
 }
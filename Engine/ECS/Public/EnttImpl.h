@@ -4,12 +4,31 @@
 //TODO fix include
 #include "../../ECS/Libs/Entt/single_include/entt/entt.hpp"
 #include "EntityID.h"
+#include "PoolStats.h"
+#include "SortAlgorithms.h"
+
+#include <memory_resource>
 
 namespace MauEng::ECS
 {
+	// Every pool of the registry allocates through the memory resource the world was created with
+	template<typename Type>
+	using PoolAllocator = std::pmr::polymorphic_allocator<Type>;
+
+	using Registry = entt::basic_registry<entt::entity, PoolAllocator<entt::entity>>;
+
+	template<typename ComponentType>
+	using StorageType = entt::storage_for_t<ComponentType, entt::entity, PoolAllocator<std::remove_const_t<ComponentType>>>;
+
+	// Type erased base of every pool, holds the packed & sparse entity arrays
+	using SparseSetType = entt::basic_sparse_set<entt::entity, PoolAllocator<entt::entity>>;
+
 	struct ECSImpl final
 	{
-		entt::registry registry{};
+		explicit ECSImpl(std::pmr::memory_resource* pResource)
+			: registry{ PoolAllocator<entt::entity>{ pResource } } {}
+
+		Registry registry;
 
 #pragma region Registry
 		template<typename... ComponentTypes>
@@ -36,12 +55,92 @@ namespace MauEng::ECS
 			registry.insert<ComponentType>(first, last, component);
 		}
 
+		template<typename ComponentType, typename EntityIt, typename ComponentIt>
+			requires std::input_iterator<ComponentIt>
+		void Insert(EntityIt first, EntityIt last, ComponentIt from)
+		{
+			registry.insert<ComponentType>(first, last, from);
+		}
+
 		template<typename... ComponentTypes>
 		[[nodiscard]] bool IsOwned() const noexcept
 		{
 			return registry.owned<ComponentTypes...>();
 		}	
 
+		// Make sure the pools exist, creating a pool modifies the registry so this must not happen from parallel code
+		template<typename... ComponentTypes>
+		void AssureStorage() noexcept
+		{
+			(static_cast<void>(registry.storage<ComponentTypes>()), ...);
+		}
+
+		template<typename ComponentType>
+		void Reserve(std::size_t count)
+		{
+			registry.storage<ComponentType>().reserve(count);
+		}
+
+		void ReserveEntities(std::size_t count)
+		{
+			registry.storage<entt::entity>().reserve(count);
+		}
+
+		// Room for count more components, grows by at least half the capacity so repeated batches don't reallocate every time
+		template<typename ComponentType>
+		void ReserveAdditional(std::size_t count)
+		{
+			auto& storage{ registry.storage<ComponentType>() };
+
+			// Component pages & the packed entity array can have a different capacity
+			std::size_t const capacity{ std::min(storage.capacity(), static_cast<SparseSetType const&>(storage).capacity()) };
+			std::size_t const required{ storage.size() + count };
+			if (required > capacity)
+			{
+				storage.reserve(std::max(required, capacity + capacity / 2));
+			}
+		}
+
+		template<typename ComponentType>
+		[[nodiscard]] PoolStats GetPoolStats() const noexcept
+		{
+			auto const* pPool{ registry.storage(entt::type_hash<ComponentType>::value()) };
+			if (!pPool)
+			{
+				return PoolStats{ .name = entt::type_id<ComponentType>().name() };
+			}
+
+			PoolStats stats{ MakePoolStats(*pPool) };
+
+			// Empty types have no component storage
+			if constexpr (!std::is_empty_v<ComponentType>)
+			{
+				auto const& storage{ static_cast<StorageType<ComponentType> const&>(*pPool) };
+				stats.componentBytes = storage.capacity() * sizeof(ComponentType);
+			}
+
+			return stats;
+		}
+
+		[[nodiscard]] std::vector<PoolStats> GetAllPoolStats() const
+		{
+			std::vector<PoolStats> stats{};
+			for (auto [id, pool] : registry.storage())
+			{
+				stats.emplace_back(MakePoolStats(pool));
+			}
+			return stats;
+		}
+
+		[[nodiscard]] static PoolStats MakePoolStats(SparseSetType const& pool) noexcept
+		{
+			return PoolStats{
+				.name = pool.type().name(),
+				.size = pool.size(),
+				.capacity = pool.capacity(),
+				.entityBytes = (pool.capacity() + pool.extent()) * sizeof(entt::entity) };
+		}
+
 #pragma endregion
 		
 #pragma region Entities
@@ -50,11 +149,33 @@ namespace MauEng::ECS
 			return static_cast<EntityID>(registry.create());
 		}
 
+		// Fills the range with newly created entities
+		template<typename Iterator>
+		void CreateEntities(Iterator first, Iterator last)
+		{
+			if constexpr (std::is_same_v<std::iter_value_t<Iterator>, entt::entity>)
+			{
+				registry.create(first, last);
+			}
+			else
+			{
+				std::vector<entt::entity> entities(static_cast<std::size_t>(std::distance(first, last)));
+				registry.create(entities.begin(), entities.end());
+				std::ranges::transform(entities, first, [](entt::entity entity) { return static_cast<EntityID>(entity); });
+			}
+		}
+
 		void DestroyEntity(EntityID id) noexcept
 		{
 			registry.destroy(static_cast<entt::entity>(id));
 		}
 
+		template<typename Iterator>
+		void DestroyEntities(Iterator first, Iterator last) noexcept
+		{
+			registry.destroy(first, last);
+		}
+
 		[[nodiscard]] bool IsValid(EntityID id) const noexcept
 		{
 			return registry.valid(static_cast<entt::entity>(id));
@@ -159,15 +280,30 @@ namespace MauEng::ECS
 			return registry.get_or_emplace<ComponentType>(static_cast<entt::entity>(id), std::forward<Args>(args)...);
 		}
 
+		template<typename ComponentType, typename... Funcs>
+		ComponentType& Patch(EntityID id, Funcs&&... funcs) noexcept
+		{
+			return registry.patch<ComponentType>(static_cast<entt::entity>(id), std::forward<Funcs>(funcs)...);
+		}
+
 		template<typename ComponentType1, typename ComponentType2>
 		void Sort() noexcept
 		{
 			registry.sort<ComponentType1, ComponentType2>();
 		}
-		template<typename ComponentType, typename Comparator>
-		void Sort(Comparator comp) noexcept
+		template<typename ComponentType, typename Comparator, typename SortAlgo = entt::std_sort, typename... Args>
+		void Sort(Comparator comp, SortAlgo algo = SortAlgo{}, Args&&... args) noexcept
+		{
+			registry.sort<ComponentType>(std::move(comp), std::move(algo), std::forward<Args>(args)...);
+		}
+
+		// Sorts the pool on the key of its components, see RadixSort
+		template<typename ComponentType, typename KeyFunc>
+		void SortByKey(KeyFunc const& key) noexcept
 		{
-			registry.sort<ComponentType>(comp);
+			auto const& storage{ registry.storage<ComponentType>() };
+			registry.sort<ComponentType>([](ComponentType const&, ComponentType const&) { return false; }, RadixSort{},
+				[&storage, &key](entt::entity entity) { return key(storage.get(entity)); });
 		}
 #pragma endregion
 
@@ -9,6 +9,7 @@
 #include "Asserts/Asserts.h"
 #include "EnttImpl.h"
 #include "View.h"
+#include "SortAlgorithms.h"
 
 #include <algorithm>
 
@@ -176,6 +177,25 @@ namespace MauEng::ECS
 				);
 		}
 
+		/**
+		 * @brief Sorts the group ascending on a key of one of its components with a parallel radix sort.
+		 * @tparam ComponentType Component type the key is taken from.
+		 * @tparam KeyFunc Type of key function.
+		 * @param key returns the uint32_t or uint64_t key of a component, called from multiple threads (use OrderedKey for floats).
+		 * @warning group must own the component you sort
+		*/
+		template<typename ComponentType, typename KeyFunc>
+			requires RadixKeyType<std::invoke_result_t<KeyFunc const&, ComponentType const&>>
+		void SortByKey(KeyFunc const& key) noexcept
+		{
+			m_Group.template sort<ComponentType>
+				(
+					[](ComponentType const&, ComponentType const&) { return false; },
+					RadixSort{},
+					[this, &key](InternalEntityType entity) { return key(m_Group.template get<ComponentType>(entity)); }
+				);
+		}
+
 		/**
 		  * @brief Get component(s) from an entity in the group
 		  * @tparam ComponentTs Function type (usually automatically deduced)
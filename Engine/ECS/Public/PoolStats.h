@@ -0,0 +1,28 @@
+#ifndef MAUENG_POOLSTATS_H
+#define MAUENG_POOLSTATS_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace MauEng::ECS
+{
+	// Memory used by the pool of one component type
+	struct PoolStats final
+	{
+		std::string_view name{};
+
+		// Components in the pool
+		std::size_t size{ 0 };
+		// Components that fit before the entity array has to grow
+		std::size_t capacity{ 0 };
+
+		// Packed & sparse entity arrays
+		std::size_t entityBytes{ 0 };
+		// Component storage, only known when the stats are requested for a specific type
+		std::size_t componentBytes{ 0 };
+
+		[[nodiscard]] std::size_t TotalBytes() const noexcept { return entityBytes + componentBytes; }
+	};
+}
+
+#endif
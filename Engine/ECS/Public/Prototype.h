@@ -0,0 +1,38 @@
+#ifndef MAUENG_PROTOTYPE_H
+#define MAUENG_PROTOTYPE_H
+
+#include <tuple>
+#include <type_traits>
+
+namespace MauEng::ECS
+{
+	/**
+	 * @brief Set of components every entity created from it starts with (e.g Prototype{ CTransform{}, CStaticMesh{ "Spider.obj" } }).
+	 * @tparam ComponentTypes Component types in the prototype, each type can only be in there once.
+	 * @note Components are copied into the entities, expensive construction (e.g mesh lookups) only happens once.
+	 */
+	template<typename... ComponentTypes>
+	struct Prototype final
+	{
+		std::tuple<ComponentTypes...> components;
+
+		explicit Prototype(ComponentTypes... comps)
+			: components{ std::move(comps)... } {}
+
+		template<typename ComponentType>
+		bool static constexpr CONTAINS{ (std::is_same_v<ComponentType, ComponentTypes> || ...) };
+
+		// Copy of this prototype with an extra component at the front
+		template<typename ComponentType>
+			requires (!CONTAINS<ComponentType>)
+		[[nodiscard]] Prototype<ComponentType, ComponentTypes...> Prepend(ComponentType component) const
+		{
+			return std::apply([&](ComponentTypes const&... comps)
+				{
+					return Prototype<ComponentType, ComponentTypes...>{ std::move(component), comps... };
+				}, components);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef MAUENG_REACTIVEQUERY_H
+#define MAUENG_REACTIVEQUERY_H
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <vector>
+
+#include "EntityID.h"
+#include "EnttImpl.h"
+
+namespace MauEng::ECS
+{
+	// Changes to a component a reactive query collects, can be combined with |
+	enum class ComponentEvent : uint8_t
+	{
+		Added = 1 << 0,
+		Removed = 1 << 1,
+		// Only ReplaceComponent, AddOrReplaceComponent & Patch notify, writing through a reference does not
+		Updated = 1 << 2
+	};
+
+	[[nodiscard]] constexpr ComponentEvent operator|(ComponentEvent lhs, ComponentEvent rhs) noexcept
+	{
+		return static_cast<ComponentEvent>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs));
+	}
+
+	[[nodiscard]] constexpr bool HasEvent(ComponentEvent events, ComponentEvent event) noexcept
+	{
+		return 0 != (static_cast<uint8_t>(events) & static_cast<uint8_t>(event));
+	}
+
+	/*
+	 * Collects the entities of which a component changed, see ECSWorld::Observe.
+	 * The owner handles the entities once per tick & clears the query, so only entities that changed since then are visited instead of rescanning the pool.
+	 * Every entity is in the query once, no matter how often it changed.
+	 * Removed entities can be destroyed by the time the query is handled, check ECSWorld::IsValid if it matters.
+	 * The query stops listening when it is destroyed, the world has to outlive it.
+	 */
+	class ReactiveQuery final
+	{
+	public:
+		ReactiveQuery() = default;
+		~ReactiveQuery() = default;
+
+		ReactiveQuery(ReactiveQuery const&) = delete;
+		ReactiveQuery(ReactiveQuery&&) noexcept = default;
+		ReactiveQuery& operator=(ReactiveQuery const&) = delete;
+		ReactiveQuery& operator=(ReactiveQuery&&) noexcept = default;
+
+		// Calls func(EntityID) for every changed entity, in the order they first changed
+		template<typename Func>
+			requires std::invocable<Func, EntityID>
+		void Each(Func&& func) const
+		{
+			if (!m_pState)
+			{
+				return;
+			}
+
+			for (auto const id : m_pState->entities)
+			{
+				func(id);
+			}
+		}
+
+		// Each followed by Clear
+		template<typename Func>
+			requires std::invocable<Func, EntityID>
+		void Consume(Func&& func)
+		{
+			Each(std::forward<Func>(func));
+			Clear();
+		}
+
+		void Clear() noexcept
+		{
+			if (!m_pState)
+			{
+				return;
+			}
+
+			for (auto const id : m_pState->entities)
+			{
+				m_pState->slots[ToIndex(id)] = NULL_ENTITY_ID;
+			}
+			m_pState->entities.clear();
+		}
+
+		// Only the exact entity, a recycled index with another version is a different entity
+		[[nodiscard]] bool Contains(EntityID id) const noexcept
+		{
+			if (!m_pState)
+			{
+				return false;
+			}
+
+			auto const index{ ToIndex(id) };
+			if (index >= m_pState->slots.size() || NULL_ENTITY_ID == m_pState->slots[index])
+			{
+				return false;
+			}
+
+			EntityID const slotID{ m_pState->slots[index] };
+			if (ToVersion(slotID) == ToVersion(id))
+			{
+				return true;
+			}
+
+			// The slot holds the newest version of the index, an older one that changed before it was destroyed is still in the list
+			return std::ranges::find(m_pState->entities, id) != m_pState->entities.end();
+		}
+
+		[[nodiscard]] std::size_t Size() const noexcept { return m_pState ? m_pState->entities.size() : 0; }
+		[[nodiscard]] bool Empty() const noexcept { return 0 == Size(); }
+
+		// If the query listens to a world
+		[[nodiscard]] explicit operator bool() const noexcept { return nullptr != m_pState; }
+
+	private:
+		friend class ECSWorld;
+
+		// Signals keep a pointer to the state, it lives on the heap so the query can be moved
+		struct State final
+		{
+			std::vector<EntityID> entities{};
+			// Per entity index, the newest id of it that is in entities or NULL_ENTITY_ID
+			std::vector<EntityID> slots{};
+
+			std::vector<entt::scoped_connection> connections{};
+
+			void OnChange(Registry&, entt::entity entity)
+			{
+				auto const id{ static_cast<EntityID>(entity) };
+				auto const index{ ToIndex(id) };
+
+				if (index >= slots.size())
+				{
+					slots.resize(std::max<std::size_t>(index + 1, slots.size() * 2), NULL_ENTITY_ID);
+				}
+
+				// A recycled index with a new version is a different entity & is added as well
+				if (slots[index] != id)
+				{
+					slots[index] = id;
+					entities.emplace_back(id);
+				}
+			}
+		};
+
+		std::unique_ptr<State> m_pState{};
+
+		template<typename ComponentType>
+		void Connect(Registry& registry, ComponentEvent events)
+		{
+			m_pState = std::make_unique<State>();
+
+			if (HasEvent(events, ComponentEvent::Added))
+			{
+				m_pState->connections.emplace_back(registry.on_construct<ComponentType>().template connect<&State::OnChange>(*m_pState));
+			}
+			if (HasEvent(events, ComponentEvent::Removed))
+			{
+				m_pState->connections.emplace_back(registry.on_destroy<ComponentType>().template connect<&State::OnChange>(*m_pState));
+			}
+			if (HasEvent(events, ComponentEvent::Updated))
+			{
+				m_pState->connections.emplace_back(registry.on_update<ComponentType>().template connect<&State::OnChange>(*m_pState));
+			}
+		}
+
+		[[nodiscard]] static uint32_t ToIndex(EntityID id) noexcept
+		{
+			return static_cast<uint32_t>(entt::to_entity(static_cast<entt::entity>(id)));
+		}
+
+		[[nodiscard]] static uint32_t ToVersion(EntityID id) noexcept
+		{
+			return static_cast<uint32_t>(entt::to_version(static_cast<entt::entity>(id)));
+		}
+	};
+}
+
+#endif
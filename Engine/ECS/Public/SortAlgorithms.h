@@ -0,0 +1,77 @@
+#ifndef MAUENG_SORTALGORITHMS_H
+#define MAUENG_SORTALGORITHMS_H
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <execution>
+#include <span>
+#include <vector>
+
+// Not EnttImpl.h, it includes this header for RadixSort
+#include <entt/entt.hpp>
+
+namespace MauEng::ECS
+{
+	// Keys the radix sort can work with, see OrderedKey to sort on floats
+	template<typename T>
+	concept RadixKeyType = std::same_as<T, uint32_t> || std::same_as<T, uint64_t>;
+
+	namespace Internal
+	{
+		// Stable sort of the values on their key, both spans are reordered
+		void RadixSortPairs(std::span<uint32_t> keys, std::span<entt::entity> values);
+		void RadixSortPairs(std::span<uint64_t> keys, std::span<entt::entity> values);
+	}
+
+	/**
+	 * @brief Maps a float to a key with the same order, negative values included.
+	 * @param value float to map.
+	 * @return key that sorts like the float, use ~OrderedKey(value) to sort descending (e.g back to front).
+	 */
+	[[nodiscard]] constexpr uint32_t OrderedKey(float value) noexcept
+	{
+		uint32_t const bits{ std::bit_cast<uint32_t>(value) };
+		// Flip all bits of negative values, only the sign bit of positive values
+		return bits ^ ((0u - (bits >> 31)) | 0x8000'0000u);
+	}
+
+	/**
+	 * @brief Sorting object for the SortAlgo parameter of the ECS sorts, sorts with std::sort on all cores.
+	 * @note The comparison is called from multiple threads, it may only read.
+	 */
+	struct ParallelSort final
+	{
+		template<typename It, typename Compare>
+		void operator()(It first, It last, Compare compare) const
+		{
+			std::sort(std::execution::par, first, last, std::move(compare));
+		}
+	};
+
+	/**
+	 * @brief Sorting object for the SortAlgo parameter of the ECS sorts, parallel LSD radix sort on a 32 or 64 bit key.
+	 * The comparison is ignored, the order comes from the key function that is passed as extra argument (see ECSWorld::SortByKey).
+	 * Keys are extracted once per entity, digits every key has in common are skipped.
+	 */
+	struct RadixSort final
+	{
+		template<typename It, typename Compare, typename KeyFunc>
+			requires RadixKeyType<std::invoke_result_t<KeyFunc const&, entt::entity>>
+		void operator()(It first, It last, Compare const&, KeyFunc const& keyOf) const
+		{
+			using KeyType = std::invoke_result_t<KeyFunc const&, entt::entity>;
+
+			std::vector<entt::entity> entities(first, last);
+			std::vector<KeyType> keys(entities.size());
+
+			std::transform(std::execution::par, entities.begin(), entities.end(), keys.begin(), keyOf);
+
+			Internal::RadixSortPairs(keys, entities);
+			std::copy(entities.begin(), entities.end(), first);
+		}
+	};
+}
+
+#endif
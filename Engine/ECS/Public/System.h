@@ -0,0 +1,103 @@
+#ifndef MAUENG_SYSTEM_H
+#define MAUENG_SYSTEM_H
+
+#include <vector>
+#include <type_traits>
+
+#include "EnttImpl.h"
+
+namespace MauEng::ECS
+{
+	using ComponentTypeID = entt::id_type;
+
+	template<typename ComponentType>
+	[[nodiscard]] ComponentTypeID GetComponentTypeID() noexcept
+	{
+		return entt::type_hash<std::remove_cvref_t<ComponentType>>::value();
+	}
+
+	template<typename... Types>
+	struct TypeList final {};
+
+	/**
+	 * @brief Declare read only access to components for a system.
+	 * @tparam ComponentTypes Component types the system only reads.
+	 */
+	template<typename... ComponentTypes>
+	struct Read final
+	{
+		using Types = TypeList<ComponentTypes...>;
+		// As a per entity system gets them
+		using ParameterTypes = TypeList<ComponentTypes const...>;
+		bool static constexpr IS_WRITE{ false };
+	};
+
+	/**
+	 * @brief Declare read & write access to components for a system.
+	 * @tparam ComponentTypes Component types the system modifies.
+	 */
+	template<typename... ComponentTypes>
+	struct Write final
+	{
+		using Types = TypeList<ComponentTypes...>;
+		// As a per entity system gets them
+		using ParameterTypes = TypeList<ComponentTypes...>;
+		bool static constexpr IS_WRITE{ true };
+	};
+
+	namespace Internal
+	{
+		template<typename T>
+		struct IsAccess : std::false_type {};
+		template<typename... Ts>
+		struct IsAccess<Read<Ts...>> : std::true_type {};
+		template<typename... Ts>
+		struct IsAccess<Write<Ts...>> : std::true_type {};
+
+		template<typename... Lists>
+		struct Concat;
+		template<>
+		struct Concat<> { using Type = TypeList<>; };
+		template<typename... Ts>
+		struct Concat<TypeList<Ts...>> { using Type = TypeList<Ts...>; };
+		template<typename... Ts, typename... Us, typename... Rest>
+		struct Concat<TypeList<Ts...>, TypeList<Us...>, Rest...> { using Type = typename Concat<TypeList<Ts..., Us...>, Rest...>::Type; };
+	}
+
+	template<typename T>
+	concept SystemAccessType = Internal::IsAccess<T>::value;
+
+	/**
+	 * @brief Compile time component access of a system, built from Read<> & Write<> declarations.
+	 * @tparam Accesses Read<> / Write<> declarations.
+	 */
+	template<SystemAccessType... Accesses>
+	struct SystemAccess final
+	{
+		// All accessed components, in declaration order
+		using Components = typename Internal::Concat<typename Accesses::Types...>::Type;
+		// Same order, Read<> components are const so a per entity system can't write what it declared read only
+		using Parameters = typename Internal::Concat<typename Accesses::ParameterTypes...>::Type;
+
+		[[nodiscard]] static std::vector<ComponentTypeID> Reads() noexcept { return Collect<false>(); }
+		[[nodiscard]] static std::vector<ComponentTypeID> Writes() noexcept { return Collect<true>(); }
+
+	private:
+		template<bool IS_WRITE>
+		[[nodiscard]] static std::vector<ComponentTypeID> Collect() noexcept
+		{
+			std::vector<ComponentTypeID> ids{};
+			([&]<typename... Ts>(TypeList<Ts...>)
+			{
+				if constexpr (Accesses::IS_WRITE == IS_WRITE)
+				{
+					(ids.emplace_back(GetComponentTypeID<Ts>()), ...);
+				}
+			}(typename Accesses::Types{}), ...);
+
+			return ids;
+		}
+	};
+}
+
+#endif
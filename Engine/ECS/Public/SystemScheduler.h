@@ -0,0 +1,62 @@
+#ifndef MAUENG_SYSTEMSCHEDULER_H
+#define MAUENG_SYSTEMSCHEDULER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "System.h"
+
+namespace MauEng::ECS
+{
+	class ECSWorld;
+
+	// A registered system, its access sets decide which other systems it may run in parallel with
+	struct SystemEntry final
+	{
+		std::string name{};
+		std::vector<ComponentTypeID> reads{};
+		std::vector<ComponentTypeID> writes{};
+		std::function<void(ECSWorld&)> func{};
+	};
+
+	/*
+	 * Keeps the registered systems & runs them in stages.
+	 * Systems in the same stage have no conflicting component access and run in parallel,
+	 * conflicting systems always run in registration order.
+	 */
+	class SystemScheduler final
+	{
+	public:
+		SystemScheduler() = default;
+		~SystemScheduler() = default;
+
+		void AddSystem(SystemEntry&& system);
+		void Clear() noexcept;
+
+		// Run all systems, stage by stage
+		void Run(ECSWorld& world);
+
+		[[nodiscard]] std::size_t SystemCount() const noexcept { return m_Systems.size(); }
+		// Indices of the systems per stage, in the order they will be executed
+		[[nodiscard]] std::vector<std::vector<uint32_t>> const& GetStages() noexcept;
+
+		// Two systems conflict if either of them writes a component the other one accesses
+		[[nodiscard]] static bool IsConflicting(SystemEntry const& lhs, SystemEntry const& rhs) noexcept;
+
+		SystemScheduler(SystemScheduler const&) = delete;
+		SystemScheduler(SystemScheduler&&) = delete;
+		SystemScheduler& operator=(SystemScheduler const&) = delete;
+		SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+	private:
+		std::vector<SystemEntry> m_Systems{};
+		std::vector<std::vector<uint32_t>> m_Stages{};
+		bool m_IsDirty{ false };
+
+		void BuildStages();
+		static void Execute(SystemEntry const& system, ECSWorld& world);
+	};
+}
+
+#endif
@@ -21,7 +21,7 @@ namespace MauEng::ECS
 	class ViewWrapper
 	{
 	public:
-		using ViewType = entt::view<entt::get_t<ComponentTypes...>>;
+		using ViewType = entt::basic_view<entt::get_t<StorageType<ComponentTypes>...>, entt::exclude_t<>>;
 
 
 		explicit ViewWrapper(ViewType const& view)
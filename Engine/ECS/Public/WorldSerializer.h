@@ -0,0 +1,143 @@
+#ifndef MAUENG_WORLDSERIALIZER_H
+#define MAUENG_WORLDSERIALIZER_H
+
+#include <concepts>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "EnttImpl.h"
+
+namespace MauEng::ECS
+{
+	class ECSWorld;
+
+	// Type erased access to a serializable component type
+	struct SerializableComponentType final
+	{
+		std::string name{};
+		// Hash of the name, stable between builds so it is used to identify the type in a snapshot
+		uint32_t nameHash{};
+		// Bump when the layout of the component changes, blocks with a different version are skipped on load
+		uint32_t version{};
+		uint32_t size{};
+		uint32_t alignment{};
+
+		// Appends all entities with the component & their raw component data
+		void (*gather)(ECSImpl& impl, std::vector<entt::entity>& entities, std::vector<std::byte>& data) {};
+		// Adds the components to entities that do not have it yet
+		void (*insert)(ECSImpl& impl, entt::entity const* first, entt::entity const* last, std::byte const* data) {};
+		// Patches the component, so queries observing updates see it
+		void (*replace)(ECSImpl& impl, entt::entity entity, std::byte const* data) {};
+		void (*erase)(ECSImpl& impl, entt::entity const* first, entt::entity const* last) {};
+		[[nodiscard]] bool (*has)(ECSImpl& impl, entt::entity entity) {};
+		// operator== when the component has one, the raw bytes (padding included) otherwise
+		[[nodiscard]] bool (*equals)(std::byte const* lhs, std::byte const* rhs) {};
+	};
+
+	/*
+	 * Binary snapshots of an ECSWorld.
+	 * Every registered component type is written as one dense block (entities followed by the raw components),
+	 * loading maps the file & bulk inserts the blocks straight from the mapped memory.
+	 * Delta snapshots only store what changed compared to a full snapshot (quick save).
+	 */
+	class WorldSerializer final
+	{
+	public:
+		WorldSerializer() = default;
+		~WorldSerializer() = default;
+
+		/**
+		 * @brief Register a component type to be serialized.
+		 * @tparam ComponentType Type of component, must be trivially copyable as it is stored as raw bytes.
+		 * Give components with padding an operator==, delta saves otherwise compare the padding bytes too.
+		 * @param name Unique name of the component, used to identify the type in a snapshot.
+		 * @param version Version of the component layout.
+		 */
+		template<typename ComponentType>
+			requires std::is_trivially_copyable_v<ComponentType> && (!std::is_empty_v<ComponentType>)
+		void RegisterComponent(char const* name, uint32_t version = 1)
+		{
+			SerializableComponentType type{};
+			type.name = name;
+			type.nameHash = entt::hashed_string::value(name);
+			type.version = version;
+			type.size = sizeof(ComponentType);
+			type.alignment = alignof(ComponentType);
+
+			type.gather = [](ECSImpl& impl, std::vector<entt::entity>& entities, std::vector<std::byte>& data)
+				{
+					auto const& storage{ impl.registry.storage<ComponentType>() };
+
+					entities.reserve(entities.size() + storage.size());
+					data.reserve(data.size() + storage.size() * sizeof(ComponentType));
+
+					for (auto const entity : storage)
+					{
+						entities.emplace_back(entity);
+
+						auto const* pBytes{ reinterpret_cast<std::byte const*>(&storage.get(entity)) };
+						data.insert(data.end(), pBytes, pBytes + sizeof(ComponentType));
+					}
+				};
+			type.insert = [](ECSImpl& impl, entt::entity const* first, entt::entity const* last, std::byte const* data)
+				{
+					impl.ReserveAdditional<ComponentType>(static_cast<std::size_t>(last - first));
+					impl.Insert<ComponentType>(first, last, reinterpret_cast<ComponentType const*>(data));
+				};
+			type.replace = [](ECSImpl& impl, entt::entity entity, std::byte const* data)
+				{
+					impl.registry.patch<ComponentType>(entity, [data](ComponentType& component) { std::memcpy(&component, data, sizeof(ComponentType)); });
+				};
+			type.erase = [](ECSImpl& impl, entt::entity const* first, entt::entity const* last)
+				{
+					impl.registry.erase<ComponentType>(first, last);
+				};
+			type.has = [](ECSImpl& impl, entt::entity entity)
+				{
+					return impl.registry.all_of<ComponentType>(entity);
+				};
+			type.equals = [](std::byte const* lhs, std::byte const* rhs)
+				{
+					if constexpr (std::equality_comparable<ComponentType>)
+					{
+						return *reinterpret_cast<ComponentType const*>(lhs) == *reinterpret_cast<ComponentType const*>(rhs);
+					}
+					else
+					{
+						return 0 == std::memcmp(lhs, rhs, sizeof(ComponentType));
+					}
+				};
+
+			RegisterComponent(std::move(type));
+		}
+
+		// Write all registered components of the world to a file
+		bool Save(ECSWorld& world, std::filesystem::path const& path) const;
+		// Load a full snapshot into a world without any of the snapshot's entities, entity ids are kept.
+		// The snapshot is validated before the world is touched, a failed load leaves the world as it was
+		bool Load(ECSWorld& world, std::filesystem::path const& path) const;
+
+		// Write everything that changed compared to the full snapshot at basePath
+		bool SaveDelta(ECSWorld& world, std::filesystem::path const& basePath, std::filesystem::path const& deltaPath) const;
+		// Apply a delta snapshot, the world must be in the state of the base snapshot the delta was made from.
+		// Like Load the world is left as it was when the delta does not fit it, changed components are patched (ComponentEvent::Updated)
+		bool LoadDelta(ECSWorld& world, std::filesystem::path const& deltaPath) const;
+
+		[[nodiscard]] std::vector<SerializableComponentType> const& GetRegisteredTypes() const noexcept { return m_Types; }
+
+		WorldSerializer(WorldSerializer const&) = delete;
+		WorldSerializer(WorldSerializer&&) = delete;
+		WorldSerializer& operator=(WorldSerializer const&) = delete;
+		WorldSerializer& operator=(WorldSerializer&&) = delete;
+
+	private:
+		std::vector<SerializableComponentType> m_Types{};
+
+		void RegisterComponent(SerializableComponentType&& type);
+		[[nodiscard]] SerializableComponentType const* FindType(uint32_t nameHash) const noexcept;
+	};
+}
+
+#endif
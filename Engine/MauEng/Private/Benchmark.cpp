@@ -0,0 +1,43 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+
+namespace MauEng
+{
+	CameraPath::CameraPath(std::vector<CameraPathKey> keys) :
+		m_Keys{ std::move(keys) }
+	{
+		std::ranges::stable_sort(m_Keys, {}, &CameraPathKey::timeSec);
+	}
+
+	CameraPathKey CameraPath::Sample(float timeSec) const noexcept
+	{
+		if (m_Keys.empty())
+		{
+			return {};
+		}
+
+		if (timeSec <= m_Keys.front().timeSec)
+		{
+			return m_Keys.front();
+		}
+
+		if (timeSec >= m_Keys.back().timeSec)
+		{
+			return m_Keys.back();
+		}
+
+		// First key after the time, there is always one before it
+		auto const next{ std::ranges::upper_bound(m_Keys, timeSec, {}, &CameraPathKey::timeSec) };
+		auto const& from{ *(next - 1) };
+		auto const& to{ *next };
+
+		float const alpha{ (timeSec - from.timeSec) / (to.timeSec - from.timeSec) };
+
+		return {
+			.timeSec = timeSec,
+			.position = glm::mix(from.position, to.position, alpha),
+			.target = glm::mix(from.target, to.target, alpha)
+		};
+	}
+}
@@ -0,0 +1,124 @@
+#include "Components/CInstanceBatch.h"
+
+#include <algorithm>
+#include <execution>
+#include <ranges>
+
+#include "InternalServiceLocator.h"
+
+namespace MauEng
+{
+	CInstanceBatch::CInstanceBatch(char const* path)
+	{
+		meshID = RENDERER.LoadOrGetMeshID(path);
+		localBounds = RENDERER.GetMeshBounds(meshID);
+	}
+
+	CInstanceBatch::CInstanceBatch(uint32_t id) :
+		meshID{ id },
+		localBounds{ RENDERER.GetMeshBounds(id) }
+	{
+	}
+
+	void CInstanceBatch::Reserve(uint32_t count)
+	{
+		positions.reserve(count);
+		rotations.reserve(count);
+		scales.reserve(count);
+	}
+
+	uint32_t CInstanceBatch::AddInstance(glm::vec3 const& position, glm::quat const& rotation, float scale)
+	{
+		positions.emplace_back(position);
+		rotations.emplace_back(rotation);
+		scales.emplace_back(scale);
+		isDirty = true;
+
+		return Count() - 1;
+	}
+
+	void CInstanceBatch::SetInstance(uint32_t index, glm::vec3 const& position, glm::quat const& rotation, float scale) noexcept
+	{
+		ME_ASSERT(index < Count());
+
+		positions[index] = position;
+		rotations[index] = rotation;
+		scales[index] = scale;
+		isDirty = true;
+	}
+
+	void CInstanceBatch::RemoveInstance(uint32_t index) noexcept
+	{
+		ME_ASSERT(index < Count());
+
+		positions[index] = positions.back();
+		rotations[index] = rotations.back();
+		scales[index] = scales.back();
+
+		positions.pop_back();
+		rotations.pop_back();
+		scales.pop_back();
+		isDirty = true;
+	}
+
+	void CInstanceBatch::Clear() noexcept
+	{
+		positions.clear();
+		rotations.clear();
+		scales.clear();
+		isDirty = true;
+	}
+
+	std::size_t CInstanceBatch::MemoryBytes() const noexcept
+	{
+		return positions.capacity() * sizeof(glm::vec3) + rotations.capacity() * sizeof(glm::quat) + scales.capacity() * sizeof(float);
+	}
+
+	MauCor::AABB CInstanceBatch::ComputeBounds() const noexcept
+	{
+		ME_PROFILE_FUNCTION()
+		ME_ASSERT(positions.size() == rotations.size() && positions.size() == scales.size());
+
+		if (positions.empty())
+		{
+			return MauCor::AABB{};
+		}
+
+		// Bounds of the instance origins, grown by the largest scaled mesh afterwards
+		auto const [origins, maxScale] { std::transform_reduce(std::execution::par_unseq, positions.begin(), positions.end(), scales.begin(),
+			std::pair{ MauCor::AABB::Empty(), 0.f },
+			[](auto const& lhs, auto const& rhs) { return std::pair{ MauCor::AABB::Merge(lhs.first, rhs.first), std::max(lhs.second, rhs.second) }; },
+			[](glm::vec3 const& position, float scale) { return std::pair{ MauCor::AABB{ position, position }, scale }; }) };
+
+		// Farthest corner of the mesh bounds from the instance origin
+		float const meshRadius{ glm::length(glm::max(glm::abs(localBounds.min), glm::abs(localBounds.max))) };
+		return origins.Expanded(meshRadius * maxScale);
+	}
+
+	MauCor::AABB const& CInstanceBatch::GetBounds() noexcept
+	{
+		if (isDirty)
+		{
+			bounds = ComputeBounds();
+			isDirty = false;
+		}
+
+		return bounds;
+	}
+
+	void CInstanceBatch::BuildMatrices(std::span<glm::mat4> matrices) const noexcept
+	{
+		ME_PROFILE_FUNCTION()
+		ME_ASSERT(matrices.size() == positions.size());
+		ME_ASSERT(positions.size() == rotations.size() && positions.size() == scales.size());
+
+		auto const instances{ std::views::iota(std::size_t{ 0 }, matrices.size()) };
+		std::for_each(std::execution::par_unseq, instances.begin(), instances.end(), [&](std::size_t idx)
+			{
+				// Same order as CTransform: translate * rotate * scale
+				glm::mat4& matrix{ matrices[idx] };
+				matrix = glm::toMat4(rotations[idx]) * scales[idx];
+				matrix[3] = glm::vec4{ positions[idx], 1.f };
+			});
+	}
+}
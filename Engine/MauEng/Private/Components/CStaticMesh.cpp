@@ -7,5 +7,12 @@ namespace MauEng
 	CStaticMesh::CStaticMesh(char const* path)
 	{
 		meshID = RENDERER.LoadOrGetMeshID(path);
+		localBounds = RENDERER.GetMeshBounds(meshID);
+	}
+
+	CStaticMesh::CStaticMesh(uint32_t id) :
+		meshID{ id },
+		localBounds{ RENDERER.GetMeshBounds(id) }
+	{
 	}
 }
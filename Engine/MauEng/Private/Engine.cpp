@@ -21,40 +21,74 @@
 
 #include "Input/KeyInfo.h"
 
+#include "FrameTimer.h"
+#include "Memory/MemoryTracker.h"
+
 namespace MauEng
 {
-	Engine::Engine():
-		m_Window{ std::make_unique<SDLWindow>() }
+	Engine::Engine(EngineMode mode):
+		m_Mode{ mode },
+		m_Window{ mode == EngineMode::Windowed ? std::make_unique<SDLWindow>() : nullptr }
 	{
 		// Initialize all core dependences & singletons
 
-		if constexpr (ENABLE_FILE_LOGGING)
+		auto const registerLogger{ [](std::unique_ptr<MauCor::Logger>&& pLogger)
+			{
+				if constexpr (USE_ASYNC_LOGGING)
+				{
+					pLogger = MauCor::CreateAsyncLogger(std::move(pLogger));
+				}
+
+				MauCor::CoreServiceLocator::RegisterLogger(std::move(pLogger));
+			} };
+
+		if constexpr (ENABLE_FILE_LOGGING && USE_BINARY_FILE_LOGGING)
 		{
-			MauCor::CoreServiceLocator::RegisterLogger(MauCor::CreateFileLogger("Log.txt"));
+			// Has its own writer thread already
+			MauCor::CoreServiceLocator::RegisterLogger(MauCor::CreateBinaryLogger("Log.bin"));
+			MauCor::CoreServiceLocator::GetLogger().SetPriorityLevel(MauCor::LogPriority::Warn);
+		}
+		else if constexpr (ENABLE_FILE_LOGGING)
+		{
+			registerLogger(MauCor::CreateFileLogger("Log.txt"));
 			MauCor::CoreServiceLocator::GetLogger().SetPriorityLevel(MauCor::LogPriority::Warn);
 		}
 		else
 		{
-			MauCor::CoreServiceLocator::RegisterLogger(MauCor::CreateConsoleLogger());
+			registerLogger(MauCor::CreateConsoleLogger());
 		}
 
-		if constexpr (ENABLE_DEBUG_RENDERING)
+		if (m_Mode == EngineMode::Headless)
+		{
+			// The debug renderer stays the null one
+			InternalServiceLocator::RegisterRenderer(MauRen::CreateNullRenderer());
+		}
+		else
 		{
-			ServiceLocator::RegisterDebugRenderer(MauRen::CreateDebugRenderer(false));
+			if constexpr (ENABLE_DEBUG_RENDERING)
+			{
+				ServiceLocator::RegisterDebugRenderer(MauRen::CreateDebugRenderer(false));
+			}
+
+			InternalServiceLocator::RegisterRenderer(MauRen::CreateVulkanRenderer(m_Window->window, DEBUG_RENDERER));
 		}
 
-		InternalServiceLocator::RegisterRenderer(MauRen::CreateVulkanRenderer(m_Window->window, DEBUG_RENDERER));
 		InternalServiceLocator::GetRenderer().Init();
 
-		m_Window->Initialize();
+		if (m_Window)
+		{
+			m_Window->Initialize();
 
-		SDL_GL_SetSwapInterval(0);
+			SDL_GL_SetSwapInterval(0);
+		}
 
 		auto& inputManager{ InputManager::GetInstance() };
 
 		if constexpr(ENABLE_PROFILER)
 		{
 			inputManager.BindAction("PROFILE", KeyInfo{ SDLK_F1, KeyInfo::ActionType::Down });
+			inputManager.BindAction("PROFILE_STATS", KeyInfo{ SDLK_F2, KeyInfo::ActionType::Down });
+			inputManager.BindAction("MEMORY_STATS", KeyInfo{ SDLK_F3, KeyInfo::ActionType::Down });
 		}
 	}
 
@@ -62,10 +96,19 @@ namespace MauEng
 	{
 		// Cleanup all core dependences & singletons
 		InternalServiceLocator::GetRenderer().Destroy();
+
+		// The logger outlives the engine, make sure the shutdown logs are out
+		LOGGER.Flush();
 	}
 
 	void Engine::Run(std::function<void()> const& load)
 	{
+		if (m_Mode == EngineMode::Headless)
+		{
+			ME_LOG_ERROR(MauCor::LogCategory::Engine, "A headless engine can only run benchmarks, use RunBenchmark");
+			return;
+		}
+
 		ME_PROFILE_BEGIN_SESSION("Startup", "Profiling/Startup/Startup")
 		// First load everything the user wants us to load using their "load function"
 		load();
@@ -89,6 +132,16 @@ namespace MauEng
 		auto& sceneManager{ SceneManager::GetInstance() };
 		auto& inputManager{ InputManager::GetInstance() };
 
+		FrameTimer frameTimer{};
+		// Hitches often come in bursts, only the first one of a burst is captured
+		uint64_t nextHitchCaptureFrame{ 0 };
+
+		if constexpr (ENABLE_PROFILER and USE_FRAME_TIMER)
+		{
+			// A hitch is only known once its frame ended, the trace has to be recording already
+			PROFILER.BeginFlightRecording(HITCH_CAPTURE_FRAMES_BEFORE + HITCH_CAPTURE_FRAMES_AFTER);
+		}
+
 		bool doContinue{ true };
 
 		while (doContinue)
@@ -100,6 +153,16 @@ namespace MauEng
 					PROFILER.Start("Profiling/Run/Run");
 				}
 
+				if (inputManager.IsActionExecuted("PROFILE_STATS"))
+				{
+					PROFILER.LogStats();
+				}
+
+				if (inputManager.IsActionExecuted("MEMORY_STATS"))
+				{
+					MauCor::LogMemoryStats();
+				}
+
 				ME_PROFILE_FRAME()
 			}
 
@@ -111,7 +174,7 @@ namespace MauEng
 			{
 				if (IsMinimised)
 				{
-					LOGGER.Log(MauCor::LogPriority::Info, MauCor::LogCategory::Engine, "Window is minimized");
+					ME_LOG_BINARY(MauCor::LogPriority::Info, MauCor::LogCategory::Engine, "Window is minimized");
 
 					elapsedTime = 0.f;
 					frameCount = 0;
@@ -124,14 +187,24 @@ namespace MauEng
 				if (elapsedTime >= 1.0f)
 				{
 					float const fps{ static_cast<float>(frameCount) / elapsedTime };
-					LOGGER.Log(MauCor::LogPriority::Info, MauCor::LogCategory::Engine, "FPS: {}", fps);
+					ME_LOG_BINARY(MauCor::LogPriority::Info, MauCor::LogCategory::Engine, "FPS: {}", fps);
 					elapsedTime -= 1.0f;
 					frameCount = 0;
 				}
 			}
 
+			if constexpr (USE_FRAME_TIMER)
+			{
+				frameTimer.EndPhase(FramePhase::Other);
+			}
+
 			doContinue = inputManager.ProcessInput();
 
+			if constexpr (USE_FRAME_TIMER)
+			{
+				frameTimer.EndPhase(FramePhase::Input);
+			}
+
 			while (time.IsLag())
 			{
 				if (not IsMinimised)
@@ -142,10 +215,26 @@ namespace MauEng
 				time.ProcessLag();
 			}
 
+			if constexpr (USE_FRAME_TIMER)
+			{
+				frameTimer.EndPhase(FramePhase::FixedUpdate);
+			}
+
 			if (not IsMinimised)
 			{
 				sceneManager.Tick();
+
+				if constexpr (USE_FRAME_TIMER)
+				{
+					frameTimer.EndPhase(FramePhase::Tick);
+				}
+
 				sceneManager.Render();
+
+				if constexpr (USE_FRAME_TIMER)
+				{
+					frameTimer.EndPhase(FramePhase::Render);
+				}
 			}
 
 			if constexpr (LIMIT_FPS)
@@ -154,7 +243,145 @@ namespace MauEng
 				std::this_thread::sleep_for(time.SleepTime());
 			}
 
+			if constexpr (USE_FRAME_TIMER)
+			{
+				frameTimer.EndPhase(FramePhase::Sleep);
+				frameTimer.SetGPUWait(RENDERER.GetGPUWaitTicks());
+			}
+
 			PROFILER.Update();
+
+			if constexpr (USE_FRAME_TIMER)
+			{
+				bool const isHitch{ frameTimer.EndFrame() };
+
+				if constexpr (ENABLE_PROFILER)
+				{
+					// Writes the frames before the hitch, the hitch & a few after it
+					if (isHitch and not PROFILER.IsProfiling() and frameTimer.GetFrameCount() >= nextHitchCaptureFrame)
+					{
+						PROFILER.DumpFlightRecording("Profiling/Hitch/Hitch", HITCH_CAPTURE_FRAMES_AFTER);
+						nextHitchCaptureFrame = frameTimer.GetFrameCount() + HITCH_CAPTURE_COOLDOWN_FRAMES;
+					}
+				}
+			}
+		}
+
+		if constexpr (USE_FRAME_TIMER)
+		{
+			frameTimer.WriteReport("Profiling/FrameTimes");
+			ME_LOG_INFO(MauCor::LogCategory::Engine, "{} frames, {} hitches, frame times written to Profiling/FrameTimes.json & .csv", frameTimer.GetFrameCount(), frameTimer.GetHitchCount());
+		}
+	}
+
+	void Engine::RunBenchmark(std::function<void()> const& load, BenchmarkSettings const& settings)
+	{
+		load();
+
+		BenchmarkLoop(settings);
+	}
+
+	void Engine::BenchmarkLoop(BenchmarkSettings const& settings)
+	{
+		ME_LOG_INFO(MauCor::LogCategory::Engine, "Benchmark: {} warmup & {} measured frames of {:.2f} ms{}", settings.warmupFrames, settings.frameCount,
+			settings.timeStepSec * 1'000.f, m_Mode == EngineMode::Headless ? ", headless" : "");
+
+		{
+			// Not part of the report
+			FrameTimer warmupTimer{};
+			for (uint32_t frame{ 0 }; frame < settings.warmupFrames; ++frame)
+			{
+				if (not BenchmarkFrame(warmupTimer, settings, 0.f))
+				{
+					return;
+				}
+			}
+		}
+
+		// The scope stats cover exactly the measured frames, with Vulkan they include the GPU passes
+		PROFILER.ResetStats(settings.frameCount);
+
+		bool const captureTrace{ ENABLE_PROFILER and settings.captureTrace };
+		if (captureTrace)
+		{
+			// A session, a capture (Start) would only keep the first NUM_FRAMES_TO_PROFILE frames
+			PROFILER.BeginSession("Benchmark", (settings.outputPath.string() + "Trace").c_str());
+		}
+
+		FrameTimer frameTimer{};
+		for (uint32_t frame{ 0 }; frame < settings.frameCount; ++frame)
+		{
+			if (not BenchmarkFrame(frameTimer, settings, static_cast<float>(frame) * settings.timeStepSec))
+			{
+				ME_LOG_WARN(MauCor::LogCategory::Engine, "Benchmark stopped after {} of {} frames", frame, settings.frameCount);
+				break;
+			}
+		}
+
+		if (captureTrace)
+		{
+			PROFILER.EndSession();
+		}
+
+		auto const scopes{ PROFILER.GetAllStats() };
+		frameTimer.WriteReport(settings.outputPath, scopes);
+
+		ME_LOG_INFO(MauCor::LogCategory::Engine, "Benchmark done: {} frames, {} hitches, written to {}.json & .csv", frameTimer.GetFrameCount(), frameTimer.GetHitchCount(), settings.outputPath.string());
+	}
+
+	bool Engine::BenchmarkFrame(FrameTimer& frameTimer, BenchmarkSettings const& settings, float pathTimeSec)
+	{
+		ME_PROFILE_FRAME()
+
+		auto& time{ Time::GetInstance() };
+		auto& sceneManager{ SceneManager::GetInstance() };
+
+		// Same step every frame, no sleeping
+		time.Step(settings.timeStepSec);
+
+		frameTimer.EndPhase(FramePhase::Other);
+
+		bool doContinue{ true };
+		if (m_Window)
+		{
+			// Keeps the window responsive, closing it stops the benchmark
+			doContinue = InputManager::GetInstance().ProcessInput();
 		}
+
+		frameTimer.EndPhase(FramePhase::Input);
+
+		while (time.IsLag())
+		{
+			sceneManager.FixedUpdate();
+			time.ProcessLag();
+		}
+
+		frameTimer.EndPhase(FramePhase::FixedUpdate);
+
+		sceneManager.Tick();
+
+		// After the tick, the path overrides whatever the scene did with the camera
+		if (not settings.cameraPath.IsEmpty())
+		{
+			auto const key{ settings.cameraPath.Sample(pathTimeSec) };
+
+			auto& camera{ sceneManager.GetActiveCamera() };
+			camera.SetPosition(key.position);
+			camera.Focus(key.target);
+		}
+
+		frameTimer.EndPhase(FramePhase::Tick);
+
+		sceneManager.Render();
+
+		frameTimer.EndPhase(FramePhase::Render);
+		frameTimer.SetGPUWait(RENDERER.GetGPUWaitTicks());
+		frameTimer.SetInstanceCount(RENDERER.GetInstanceCount());
+
+		PROFILER.Update();
+
+		frameTimer.EndFrame();
+
+		return doContinue;
 	}
 }
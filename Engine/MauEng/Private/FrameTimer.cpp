@@ -0,0 +1,200 @@
+#include "FrameTimer.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "Profiling/TraceClock.h"
+
+namespace MauEng
+{
+	namespace
+	{
+		// Frames & phases above a minute are recorded as a minute
+		uint64_t constexpr MAX_RECORDED_NANOSECONDS{ 60'000'000'000 };
+
+		std::array<char const*, static_cast<size_t>(FramePhase::Count)> constexpr PHASE_NAMES
+		{
+			"input",
+			"fixed_update",
+			"tick",
+			"render",
+			"sleep",
+			"other",
+			"gpu_wait"
+		};
+
+		void WritePercentiles(fmt::memory_buffer& json, MauCor::HdrHistogram const& histogram)
+		{
+			auto const toMs{ [](double nanoseconds) { return nanoseconds / 1'000'000.0; } };
+			auto const percentileMs{ [&](double percentile) { return toMs(static_cast<double>(histogram.ValueAtPercentile(percentile))); } };
+
+			fmt::format_to(std::back_inserter(json), R"({{"min":{:.3f},"mean":{:.3f},"p50":{:.3f},"p90":{:.3f},"p95":{:.3f},"p99":{:.3f},"p999":{:.3f},"max":{:.3f}}})",
+				toMs(static_cast<double>(histogram.Min())), toMs(histogram.Mean()), percentileMs(0.5), percentileMs(0.9), percentileMs(0.95), percentileMs(0.99), percentileMs(0.999),
+				toMs(static_cast<double>(histogram.Max())));
+		}
+
+		void WriteFile(std::filesystem::path const& path, fmt::memory_buffer const& contents)
+		{
+			MauCor::Profiler::FixFilePath(path.string().c_str());
+
+			std::ofstream file{ path, std::ios::binary };
+			if (!file.is_open())
+			{
+				ME_LOG_ERROR(MauCor::LogCategory::Engine, "Failed to open the file: {}", path.string());
+				return;
+			}
+
+			file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+		}
+	}
+
+	FrameTimer::FrameTimer() :
+		m_NanosecondsPerTick{ 1'000'000'000.0 / MauCor::TraceClockFrequency() },
+		m_HitchThresholdTicks{ static_cast<uint64_t>(static_cast<double>(HITCH_THRESHOLD_MS) * 1'000'000.0 / m_NanosecondsPerTick) },
+		m_History(FRAME_HISTORY_SIZE),
+		m_FrameStart{ MauCor::ReadTraceClock() },
+		m_LastMark{ m_FrameStart },
+		m_FrameTimes{ MAX_RECORDED_NANOSECONDS },
+		m_PhaseTimes(PHASE_COUNT, MauCor::HdrHistogram{ MAX_RECORDED_NANOSECONDS })
+	{
+	}
+
+	void FrameTimer::EndPhase(FramePhase phase) noexcept
+	{
+		uint64_t const now{ MauCor::ReadTraceClock() };
+		m_Current.phaseTicks[static_cast<uint32_t>(phase)] += now - m_LastMark;
+		m_LastMark = now;
+	}
+
+	void FrameTimer::SetGPUWait(uint64_t ticks) noexcept
+	{
+		m_Current.phaseTicks[static_cast<uint32_t>(FramePhase::GPUWait)] = ticks;
+	}
+
+	void FrameTimer::SetInstanceCount(uint32_t count) noexcept
+	{
+		m_Current.instanceCount = count;
+	}
+
+	bool FrameTimer::EndFrame() noexcept
+	{
+		uint64_t const now{ MauCor::ReadTraceClock() };
+
+		m_Current.frame = m_FrameCount;
+		m_Current.totalTicks = now - m_FrameStart;
+		m_Current.phaseTicks[static_cast<uint32_t>(FramePhase::Other)] += now - m_LastMark;
+
+		m_FrameTimes.Record(static_cast<uint64_t>(static_cast<double>(m_Current.totalTicks) * m_NanosecondsPerTick));
+		for (uint32_t phase{ 0 }; phase < PHASE_COUNT; ++phase)
+		{
+			m_PhaseTimes[phase].Record(static_cast<uint64_t>(static_cast<double>(m_Current.phaseTicks[phase]) * m_NanosecondsPerTick));
+		}
+
+		m_TotalInstanceCount += m_Current.instanceCount;
+		m_MaxInstanceCount = std::max(m_MaxInstanceCount, m_Current.instanceCount);
+
+		bool const isHitch{ m_Current.totalTicks > m_HitchThresholdTicks };
+		if (isHitch)
+		{
+			++m_HitchCount;
+
+			auto const& phases{ m_Current.phaseTicks };
+			ME_LOG_WARN(MauCor::LogCategory::Engine, "Hitch: frame {} took {:.2f} ms (input {:.2f}, fixed update {:.2f}, tick {:.2f}, render {:.2f}, sleep {:.2f}, other {:.2f}, GPU wait {:.2f})",
+				m_FrameCount, ToMilliseconds(m_Current.totalTicks),
+				ToMilliseconds(phases[0]), ToMilliseconds(phases[1]), ToMilliseconds(phases[2]), ToMilliseconds(phases[3]), ToMilliseconds(phases[4]), ToMilliseconds(phases[5]), ToMilliseconds(phases[6]));
+		}
+
+		m_History[m_FrameCount % FRAME_HISTORY_SIZE] = m_Current;
+		m_Current = {};
+
+		++m_FrameCount;
+		m_FrameStart = now;
+		m_LastMark = now;
+
+		return isHitch;
+	}
+
+	void FrameTimer::WriteReport(std::filesystem::path const& basePath, std::span<std::pair<std::string, MauCor::ScopeStats> const> scopes) const
+	{
+		if (m_FrameCount == 0)
+		{
+			return;
+		}
+
+		WriteJson(std::filesystem::path{ basePath }.replace_extension(".json"), scopes);
+		WriteCsv(std::filesystem::path{ basePath }.replace_extension(".csv"));
+	}
+
+	void FrameTimer::WriteJson(std::filesystem::path const& path, std::span<std::pair<std::string, MauCor::ScopeStats> const> scopes) const
+	{
+		fmt::memory_buffer json{};
+
+#ifdef NDEBUG
+		char const* const build{ "Release" };
+#else
+		char const* const build{ "Debug" };
+#endif
+
+		fmt::format_to(std::back_inserter(json), R"({{"build":"{}","frames":{},"hitches":{},"hitchThresholdMs":{:.3f},"frameTime":)", build, m_FrameCount, m_HitchCount, HITCH_THRESHOLD_MS);
+		WritePercentiles(json, m_FrameTimes);
+
+		fmt::format_to(std::back_inserter(json), R"(,"instances":{{"mean":{:.1f},"max":{}}})",
+			static_cast<double>(m_TotalInstanceCount) / static_cast<double>(m_FrameCount), m_MaxInstanceCount);
+
+		fmt::format_to(std::back_inserter(json), R"(,"phases":{{)");
+		for (uint32_t phase{ 0 }; phase < PHASE_COUNT; ++phase)
+		{
+			fmt::format_to(std::back_inserter(json), R"({}"{}":)", phase > 0 ? "," : "", PHASE_NAMES[phase]);
+			WritePercentiles(json, m_PhaseTimes[phase]);
+		}
+
+		// In ms over the profiler's stats window
+		fmt::format_to(std::back_inserter(json), R"(}},"scopes":{{)");
+		for (size_t scope{ 0 }; scope < scopes.size(); ++scope)
+		{
+			auto const& [name, stats] { scopes[scope] };
+			fmt::format_to(std::back_inserter(json), R"({}"{}":{{"min":{:.3f},"mean":{:.3f},"p95":{:.3f},"p99":{:.3f},"max":{:.3f},"callsPerFrame":{:.2f},"frames":{}}})",
+				scope > 0 ? "," : "", name, stats.min, stats.average, stats.p95, stats.p99, stats.max, stats.callsPerFrame, stats.frameCount);
+		}
+
+		// Frame time buckets in ms: [lowest, highest, count]
+		fmt::format_to(std::back_inserter(json), R"(}},"histogram":[)");
+		bool isFirst{ true };
+		m_FrameTimes.ForEachBucket([&json, &isFirst](uint64_t lowest, uint64_t highest, uint64_t count)
+			{
+				fmt::format_to(std::back_inserter(json), "{}[{:.4f},{:.4f},{}]", isFirst ? "" : ",", static_cast<double>(lowest) / 1'000'000.0, static_cast<double>(highest) / 1'000'000.0, count);
+				isFirst = false;
+			});
+		fmt::format_to(std::back_inserter(json), "]}}");
+
+		WriteFile(path, json);
+	}
+
+	void FrameTimer::WriteCsv(std::filesystem::path const& path) const
+	{
+		fmt::memory_buffer csv{};
+
+		fmt::format_to(std::back_inserter(csv), "frame,total_ms");
+		for (char const* const name : PHASE_NAMES)
+		{
+			fmt::format_to(std::back_inserter(csv), ",{}_ms", name);
+		}
+		fmt::format_to(std::back_inserter(csv), ",instances\n");
+
+		// Oldest frame of the ring first
+		uint64_t const first{ m_FrameCount > FRAME_HISTORY_SIZE ? m_FrameCount - FRAME_HISTORY_SIZE : 0 };
+		for (uint64_t frame{ first }; frame < m_FrameCount; ++frame)
+		{
+			auto const& record{ m_History[frame % FRAME_HISTORY_SIZE] };
+
+			fmt::format_to(std::back_inserter(csv), "{},{:.4f}", record.frame, ToMilliseconds(record.totalTicks));
+			for (uint64_t const ticks : record.phaseTicks)
+			{
+				fmt::format_to(std::back_inserter(csv), ",{:.4f}", ToMilliseconds(ticks));
+			}
+			fmt::format_to(std::back_inserter(csv), ",{}\n", record.instanceCount);
+		}
+
+		WriteFile(path, csv);
+	}
+}
@@ -0,0 +1,102 @@
+#ifndef MAUENG_FRAMETIMER_H
+#define MAUENG_FRAMETIMER_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Profiling/HdrHistogram.h"
+#include "Profiling/Profiler.h"
+
+namespace MauEng
+{
+	// Parts of a game loop frame, in the order they run
+	enum class FramePhase : uint8_t
+	{
+		Input,
+		FixedUpdate,
+		Tick,
+		Render,
+		Sleep,
+		// Whatever the loop did outside of the other phases (time, profiler, ...)
+		Other,
+		// The render thread's wait for the fence of the last frame it drew, it overlaps the other phases
+		GPUWait,
+
+		Count
+	};
+
+	/*
+	 * Per frame breakdown of the game loop (USE_FRAME_TIMER).
+	 * Every phase is timed with the trace clock, the last FRAME_HISTORY_SIZE frames are kept in a ring,
+	 * every frame & phase time also goes into a histogram that covers the whole run.
+	 * WriteReport dumps the percentiles as JSON & the frame ring as CSV, e.g to compare p99 frame times between builds.
+	 */
+	class FrameTimer final
+	{
+	public:
+		FrameTimer();
+		~FrameTimer() = default;
+
+		// The time since the last phase (or frame) ended is added to the phase
+		void EndPhase(FramePhase phase) noexcept;
+		void SetGPUWait(uint64_t ticks) noexcept;
+		// Instances the renderer drew this frame
+		void SetInstanceCount(uint32_t count) noexcept;
+
+		// Returns true when the frame took longer than HITCH_THRESHOLD_MS
+		bool EndFrame() noexcept;
+
+		// Writes <basePath>.json & <basePath>.csv, the scope stats (e.g the profiler's GPU passes) are added to the JSON
+		void WriteReport(std::filesystem::path const& basePath, std::span<std::pair<std::string, MauCor::ScopeStats> const> scopes = {}) const;
+
+		[[nodiscard]] uint64_t GetFrameCount() const noexcept { return m_FrameCount; }
+		[[nodiscard]] uint64_t GetHitchCount() const noexcept { return m_HitchCount; }
+
+		FrameTimer(FrameTimer const&) = delete;
+		FrameTimer(FrameTimer&&) = delete;
+		FrameTimer& operator=(FrameTimer const&) = delete;
+		FrameTimer& operator=(FrameTimer&&) = delete;
+
+	private:
+		static uint32_t constexpr FRAME_HISTORY_SIZE{ 4'096 };
+		static uint32_t constexpr PHASE_COUNT{ static_cast<uint32_t>(FramePhase::Count) };
+
+		struct FrameRecord final
+		{
+			uint64_t frame{ 0 };
+			uint64_t totalTicks{ 0 };
+			std::array<uint64_t, PHASE_COUNT> phaseTicks{};
+			uint32_t instanceCount{ 0 };
+		};
+
+		double const m_NanosecondsPerTick;
+		uint64_t const m_HitchThresholdTicks;
+
+		std::vector<FrameRecord> m_History;
+		FrameRecord m_Current{};
+
+		uint64_t m_FrameStart;
+		uint64_t m_LastMark;
+		uint64_t m_FrameCount{ 0 };
+		uint64_t m_HitchCount{ 0 };
+
+		uint64_t m_TotalInstanceCount{ 0 };
+		uint32_t m_MaxInstanceCount{ 0 };
+
+		// Nanoseconds, the whole frame & every phase
+		MauCor::HdrHistogram m_FrameTimes;
+		std::vector<MauCor::HdrHistogram> m_PhaseTimes;
+
+		[[nodiscard]] double ToMilliseconds(uint64_t ticks) const noexcept { return static_cast<double>(ticks) * m_NanosecondsPerTick / 1'000'000.0; }
+
+		void WriteJson(std::filesystem::path const& path, std::span<std::pair<std::string, MauCor::ScopeStats> const> scopes) const;
+		void WriteCsv(std::filesystem::path const& path) const;
+	};
+}
+
+#endif
@@ -8,7 +8,13 @@ namespace MauEng
 	{
 		ME_PROFILE_FUNCTION()
 		{
-			//GetECSWorld(). ;
+			{
+				// Also updates the matrices of the moved meshes
+				ME_PROFILE_SCOPE("UPDATE SPATIAL INDEX")
+				m_SpatialIndex.Update(m_ECSWorld);
+			}
+			// With GPU transforms the renderer does not need the matrices, only the spatial index updates the ones it uses
+			if constexpr (!USE_GPU_TRANSFORMS)
 			{
 				auto const view = GetECSWorld().View<CTransform>();
 				ME_PROFILE_SCOPE("UPDATE MATRICES")
@@ -18,11 +24,41 @@ namespace MauEng
 			}
 			{
 				ME_PROFILE_SCOPE("QUEUE DRAWS")
-				auto group{ GetECSWorld().Group<CStaticMesh, CTransform>() };
-				group.Each([](CStaticMesh const& m, CTransform const& t)
+				auto const& camera{ m_CameraManager.GetActiveCamera() };
+				auto const frustum{ MauCor::Frustum::FromMatrix(camera.GetProjectionMatrix() * camera.GetViewMatrix()) };
+
+				if constexpr (USE_FRUSTUM_CULLING)
+				{
+					m_VisibleEntities.clear();
+					m_SpatialIndex.QueryFrustum(frustum, m_VisibleEntities);
+
+					for (auto const id : m_VisibleEntities)
+					{
+						RENDERER.QueueDraw(m_ECSWorld.GetComponent<CTransform>(id), m_ECSWorld.GetComponent<CStaticMesh>(id));
+					}
+				}
+				else
+				{
+					auto group{ GetECSWorld().Group<CStaticMesh, CTransform>() };
+					group.Each([](CStaticMesh const& m, CTransform const& t)
+								{
+									RENDERER.QueueDraw(t, m);
+								});
+				}
+
+				// Batches are culled as a whole, not per instance
+				GetECSWorld().View<CInstanceBatch>().Each([&frustum](CInstanceBatch& batch)
+					{
+						if constexpr (USE_FRUSTUM_CULLING)
+						{
+							if (!frustum.Overlaps(batch.GetBounds()))
 							{
-								RENDERER.QueueDraw(t.mat, m);
-							});
+								return;
+							}
+						}
+
+						RENDERER.QueueDraw(batch);
+					});
 			}
 		}
 	}
@@ -40,6 +40,11 @@ namespace MauEng
 		m_Scene->GetCameraManager().GetActiveCamera().SetAspectRatio(aspectRatio);
 	}
 
+	Camera& SceneManager::GetActiveCamera() noexcept
+	{
+		return m_Scene->GetCameraManager().GetActiveCamera();
+	}
+
 	SceneManager::~SceneManager()
 	{
 		m_Scene->OnUnload();
@@ -0,0 +1,889 @@
+#include "Spatial/DynamicAABBTree.h"
+
+#include <algorithm>
+#include <array>
+#include <execution>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define MAUENG_SPATIAL_SSE 1
+#else
+	#define MAUENG_SPATIAL_SSE 0
+#endif
+
+namespace MauEng
+{
+	namespace
+	{
+		// Ranges smaller than this are built on the calling thread
+		uint32_t constexpr PARALLEL_BUILD_THRESHOLD{ 4'096 };
+		// Levels of the build that fork into parallel tasks
+		uint32_t constexpr PARALLEL_BUILD_DEPTH{ 6 };
+
+		enum class Containment : uint8_t
+		{
+			Outside,
+			Intersecting,
+			Inside
+		};
+
+#if MAUENG_SPATIAL_SSE
+		[[nodiscard]] __m128 LoadVec3(glm::vec3 const& v) noexcept
+		{
+			return _mm_setr_ps(v.x, v.y, v.z, 0.f);
+		}
+
+		[[nodiscard]] float HorizontalMax3(__m128 v) noexcept
+		{
+			__m128 const yyyy{ _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)) };
+			__m128 const zzzz{ _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)) };
+			return _mm_cvtss_f32(_mm_max_ss(_mm_max_ss(v, yyyy), zzzz));
+		}
+
+		[[nodiscard]] float HorizontalMin3(__m128 v) noexcept
+		{
+			__m128 const yyyy{ _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)) };
+			__m128 const zzzz{ _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)) };
+			return _mm_cvtss_f32(_mm_min_ss(_mm_min_ss(v, yyyy), zzzz));
+		}
+
+		class BoxTester final
+		{
+		public:
+			explicit BoxTester(MauCor::AABB const& box) noexcept
+				: m_Min{ LoadVec3(box.min) }, m_Max{ LoadVec3(box.max) } {}
+
+			[[nodiscard]] bool Overlaps(MauCor::AABB const& box) const noexcept
+			{
+				__m128 const overlap{ _mm_and_ps(_mm_cmple_ps(LoadVec3(box.min), m_Max), _mm_cmpge_ps(LoadVec3(box.max), m_Min)) };
+				return 0xF == _mm_movemask_ps(overlap);
+			}
+
+		private:
+			__m128 m_Min;
+			__m128 m_Max;
+		};
+
+		class RayTester final
+		{
+		public:
+			explicit RayTester(MauCor::Ray const& ray) noexcept
+				: m_Origin{ LoadVec3(ray.origin) }, m_InvDirection{ LoadVec3(1.f / ray.direction) } {}
+
+			// Entry distance or a negative value on a miss
+			[[nodiscard]] float Intersect(MauCor::AABB const& box, float maxDistance) const noexcept
+			{
+				__m128 const t0{ _mm_mul_ps(_mm_sub_ps(LoadVec3(box.min), m_Origin), m_InvDirection) };
+				__m128 const t1{ _mm_mul_ps(_mm_sub_ps(LoadVec3(box.max), m_Origin), m_InvDirection) };
+
+				float const entry{ std::max(HorizontalMax3(_mm_min_ps(t0, t1)), 0.f) };
+				float const exit{ std::min(HorizontalMin3(_mm_max_ps(t0, t1)), maxDistance) };
+
+				return entry <= exit ? entry : -1.f;
+			}
+
+		private:
+			__m128 m_Origin;
+			__m128 m_InvDirection;
+		};
+
+		// Planes stored as structure of arrays, 4 planes are tested per instruction (the last 2 planes are duplicated)
+		class FrustumTester final
+		{
+		public:
+			explicit FrustumTester(MauCor::Frustum const& frustum) noexcept
+			{
+				for (uint32_t group{ 0 }; group < 2; ++group)
+				{
+					auto const& p0{ frustum.planes[group * 4 + 0] };
+					auto const& p1{ frustum.planes[group * 4 + 1] };
+					auto const& p2{ frustum.planes[std::min(group * 4 + 2, 4u)] };
+					auto const& p3{ frustum.planes[std::min(group * 4 + 3, 5u)] };
+
+					m_NormalX[group] = _mm_setr_ps(p0.normal.x, p1.normal.x, p2.normal.x, p3.normal.x);
+					m_NormalY[group] = _mm_setr_ps(p0.normal.y, p1.normal.y, p2.normal.y, p3.normal.y);
+					m_NormalZ[group] = _mm_setr_ps(p0.normal.z, p1.normal.z, p2.normal.z, p3.normal.z);
+					m_Distance[group] = _mm_setr_ps(p0.distance, p1.distance, p2.distance, p3.distance);
+
+					__m128 const signMask{ _mm_set1_ps(-0.f) };
+					m_AbsNormalX[group] = _mm_andnot_ps(signMask, m_NormalX[group]);
+					m_AbsNormalY[group] = _mm_andnot_ps(signMask, m_NormalY[group]);
+					m_AbsNormalZ[group] = _mm_andnot_ps(signMask, m_NormalZ[group]);
+				}
+			}
+
+			[[nodiscard]] Containment Test(MauCor::AABB const& box) const noexcept
+			{
+				glm::vec3 const center{ box.Center() };
+				glm::vec3 const extents{ box.Extents() };
+
+				__m128 const cx{ _mm_set1_ps(center.x) };
+				__m128 const cy{ _mm_set1_ps(center.y) };
+				__m128 const cz{ _mm_set1_ps(center.z) };
+				__m128 const ex{ _mm_set1_ps(extents.x) };
+				__m128 const ey{ _mm_set1_ps(extents.y) };
+				__m128 const ez{ _mm_set1_ps(extents.z) };
+
+				int insideMask{ 0 };
+				for (uint32_t group{ 0 }; group < 2; ++group)
+				{
+					__m128 const distance{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(m_NormalX[group], cx), _mm_mul_ps(m_NormalY[group], cy)),
+						_mm_add_ps(_mm_mul_ps(m_NormalZ[group], cz), m_Distance[group])) };
+					__m128 const radius{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(m_AbsNormalX[group], ex), _mm_mul_ps(m_AbsNormalY[group], ey)),
+						_mm_mul_ps(m_AbsNormalZ[group], ez)) };
+
+					// Box is fully behind one of the planes
+					if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps())))
+					{
+						return Containment::Outside;
+					}
+
+					insideMask |= _mm_movemask_ps(_mm_cmpge_ps(distance, radius)) << (group * 4);
+				}
+
+				return 0xFF == insideMask ? Containment::Inside : Containment::Intersecting;
+			}
+
+		private:
+			__m128 m_NormalX[2];
+			__m128 m_NormalY[2];
+			__m128 m_NormalZ[2];
+			__m128 m_Distance[2];
+			__m128 m_AbsNormalX[2];
+			__m128 m_AbsNormalY[2];
+			__m128 m_AbsNormalZ[2];
+		};
+#else
+		class BoxTester final
+		{
+		public:
+			explicit BoxTester(MauCor::AABB const& box) noexcept
+				: m_Box{ box } {}
+
+			[[nodiscard]] bool Overlaps(MauCor::AABB const& box) const noexcept { return m_Box.Overlaps(box); }
+
+		private:
+			MauCor::AABB m_Box;
+		};
+
+		class RayTester final
+		{
+		public:
+			explicit RayTester(MauCor::Ray const& ray) noexcept
+				: m_Ray{ ray } {}
+
+			[[nodiscard]] float Intersect(MauCor::AABB const& box, float maxDistance) const noexcept { return m_Ray.Intersect(box, maxDistance); }
+
+		private:
+			MauCor::Ray m_Ray;
+		};
+
+		class FrustumTester final
+		{
+		public:
+			explicit FrustumTester(MauCor::Frustum const& frustum) noexcept
+				: m_Frustum{ frustum } {}
+
+			[[nodiscard]] Containment Test(MauCor::AABB const& box) const noexcept
+			{
+				glm::vec3 const center{ box.Center() };
+				glm::vec3 const extents{ box.Extents() };
+
+				bool isInside{ true };
+				for (auto const& plane : m_Frustum.planes)
+				{
+					float const distance{ plane.SignedDistance(center) };
+					float const radius{ glm::dot(glm::abs(plane.normal), extents) };
+
+					if (distance + radius < 0.f)
+					{
+						return Containment::Outside;
+					}
+
+					isInside &= distance >= radius;
+				}
+
+				return isInside ? Containment::Inside : Containment::Intersecting;
+			}
+
+		private:
+			MauCor::Frustum m_Frustum;
+		};
+#endif
+	}
+
+	uint32_t DynamicAABBTree::CreateProxy(MauCor::AABB const& bounds, uint32_t userData)
+	{
+		uint32_t const proxyID{ AllocateNode() };
+
+		auto& node{ m_Nodes[proxyID] };
+		node.bounds = bounds.Expanded(m_Margin);
+		node.userData = userData;
+		node.height = 0;
+
+		InsertLeaf(proxyID);
+		++m_ProxyCount;
+
+		return proxyID;
+	}
+
+	void DynamicAABBTree::DestroyProxy(uint32_t proxyID) noexcept
+	{
+		ME_ASSERT(proxyID < m_Nodes.size() && m_Nodes[proxyID].IsLeaf() && m_Nodes[proxyID].height == 0);
+
+		RemoveLeaf(proxyID);
+		FreeNode(proxyID);
+		--m_ProxyCount;
+	}
+
+	bool DynamicAABBTree::MoveProxy(uint32_t proxyID, MauCor::AABB const& bounds) noexcept
+	{
+		ME_ASSERT(proxyID < m_Nodes.size() && m_Nodes[proxyID].IsLeaf());
+
+		if (m_Nodes[proxyID].bounds.Contains(bounds))
+		{
+			return false;
+		}
+
+		RemoveLeaf(proxyID);
+		m_Nodes[proxyID].bounds = bounds.Expanded(m_Margin);
+		InsertLeaf(proxyID);
+
+		return true;
+	}
+
+	void DynamicAABBTree::Build(std::span<ProxyInput const> proxies, std::span<uint32_t> proxyIDs)
+	{
+		ME_PROFILE_FUNCTION()
+		ME_ASSERT(proxyIDs.size() >= proxies.size());
+
+		Clear();
+		if (proxies.empty())
+		{
+			return;
+		}
+
+		auto const count{ static_cast<uint32_t>(proxies.size()) };
+
+		// A binary tree over n leaves has exactly 2n - 1 nodes, no free list needed
+		m_Nodes.resize(2 * static_cast<std::size_t>(count) - 1);
+
+		std::vector<glm::vec3> centroids(count);
+		std::transform(std::execution::par_unseq, proxies.begin(), proxies.end(), centroids.begin(), [](ProxyInput const& proxy)
+			{
+				return proxy.bounds.Center();
+			});
+
+		std::vector<uint32_t> order(count);
+		std::iota(order.begin(), order.end(), 0u);
+
+		m_Root = BuildRange(proxies, centroids, order, 0, count, PARALLEL_BUILD_DEPTH);
+		m_Nodes[m_Root].parent = NULL_NODE;
+		m_ProxyCount = count;
+
+		// The leaf for sorted position i is always node 2i
+		for (uint32_t idx{ 0 }; idx < count; ++idx)
+		{
+			proxyIDs[order[idx]] = 2 * idx;
+		}
+	}
+
+	void DynamicAABBTree::Clear() noexcept
+	{
+		m_Nodes.clear();
+		m_Root = NULL_NODE;
+		m_FreeList = NULL_NODE;
+		m_ProxyCount = 0;
+	}
+
+	void DynamicAABBTree::QueryAABB(MauCor::AABB const& bounds, std::vector<uint32_t>& results) const
+	{
+		if (NULL_NODE == m_Root)
+		{
+			return;
+		}
+
+		BoxTester const tester{ bounds };
+
+		std::vector<uint32_t> stack{ m_Root };
+		while (!stack.empty())
+		{
+			auto const& node{ m_Nodes[stack.back()] };
+			stack.pop_back();
+
+			if (!tester.Overlaps(node.bounds))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				results.emplace_back(node.userData);
+			}
+			else
+			{
+				stack.emplace_back(node.child1);
+				stack.emplace_back(node.child2);
+			}
+		}
+	}
+
+	void DynamicAABBTree::QuerySphere(MauCor::Sphere const& sphere, std::vector<uint32_t>& results) const
+	{
+		if (NULL_NODE == m_Root)
+		{
+			return;
+		}
+
+		// The box around the sphere rejects most nodes with the cheaper test
+		BoxTester const tester{ { sphere.center - glm::vec3{ sphere.radius }, sphere.center + glm::vec3{ sphere.radius } } };
+
+		std::vector<uint32_t> stack{ m_Root };
+		while (!stack.empty())
+		{
+			auto const& node{ m_Nodes[stack.back()] };
+			stack.pop_back();
+
+			if (!tester.Overlaps(node.bounds) || !sphere.Overlaps(node.bounds))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				results.emplace_back(node.userData);
+			}
+			else
+			{
+				stack.emplace_back(node.child1);
+				stack.emplace_back(node.child2);
+			}
+		}
+	}
+
+	void DynamicAABBTree::QueryFrustum(MauCor::Frustum const& frustum, std::vector<uint32_t>& results) const
+	{
+		if (NULL_NODE == m_Root)
+		{
+			return;
+		}
+
+		FrustumTester const tester{ frustum };
+
+		std::vector<uint32_t> stack{ m_Root };
+		std::vector<uint32_t> subtreeStack{};
+
+		while (!stack.empty())
+		{
+			uint32_t const nodeID{ stack.back() };
+			stack.pop_back();
+
+			auto const& node{ m_Nodes[nodeID] };
+			switch (tester.Test(node.bounds))
+			{
+			case Containment::Outside:
+				break;
+
+			case Containment::Inside:
+				// Everything below is visible, no more plane tests needed
+				AddLeaves(nodeID, results, subtreeStack);
+				break;
+
+			case Containment::Intersecting:
+				if (node.IsLeaf())
+				{
+					results.emplace_back(node.userData);
+				}
+				else
+				{
+					stack.emplace_back(node.child1);
+					stack.emplace_back(node.child2);
+				}
+				break;
+			}
+		}
+	}
+
+	std::optional<RayHit> DynamicAABBTree::RayCast(MauCor::Ray const& ray, float maxDistance) const
+	{
+		if (NULL_NODE == m_Root)
+		{
+			return std::nullopt;
+		}
+
+		RayTester const tester{ ray };
+		std::optional<RayHit> closest{};
+
+		std::vector<uint32_t> stack{ m_Root };
+		while (!stack.empty())
+		{
+			auto const& node{ m_Nodes[stack.back()] };
+			stack.pop_back();
+
+			// Clipping the ray to the closest hit so far skips everything behind it
+			float const distance{ tester.Intersect(node.bounds, maxDistance) };
+			if (distance < 0.f)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				closest = RayHit{ node.userData, distance };
+				maxDistance = distance;
+				continue;
+			}
+
+			// Visit the closer child first
+			float const distance1{ tester.Intersect(m_Nodes[node.child1].bounds, maxDistance) };
+			float const distance2{ tester.Intersect(m_Nodes[node.child2].bounds, maxDistance) };
+
+			bool const isChild1Closer{ distance1 >= 0.f && (distance2 < 0.f || distance1 <= distance2) };
+			uint32_t const nearChild{ isChild1Closer ? node.child1 : node.child2 };
+			uint32_t const farChild{ isChild1Closer ? node.child2 : node.child1 };
+
+			if ((isChild1Closer ? distance2 : distance1) >= 0.f)
+			{
+				stack.emplace_back(farChild);
+			}
+			if ((isChild1Closer ? distance1 : distance2) >= 0.f)
+			{
+				stack.emplace_back(nearChild);
+			}
+		}
+
+		return closest;
+	}
+
+	void DynamicAABBTree::RayCastAll(MauCor::Ray const& ray, float maxDistance, std::vector<RayHit>& hits) const
+	{
+		if (NULL_NODE == m_Root)
+		{
+			return;
+		}
+
+		RayTester const tester{ ray };
+
+		std::vector<uint32_t> stack{ m_Root };
+		while (!stack.empty())
+		{
+			auto const& node{ m_Nodes[stack.back()] };
+			stack.pop_back();
+
+			float const distance{ tester.Intersect(node.bounds, maxDistance) };
+			if (distance < 0.f)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				hits.emplace_back(RayHit{ node.userData, distance });
+			}
+			else
+			{
+				stack.emplace_back(node.child1);
+				stack.emplace_back(node.child2);
+			}
+		}
+	}
+
+	bool DynamicAABBTree::Validate() const noexcept
+	{
+		if (NULL_NODE == m_Root)
+		{
+			return 0 == m_ProxyCount;
+		}
+
+		if (m_Nodes[m_Root].parent != NULL_NODE)
+		{
+			return false;
+		}
+
+		uint32_t leafCount{ 0 };
+
+		std::vector<uint32_t> stack{ m_Root };
+		while (!stack.empty())
+		{
+			uint32_t const nodeID{ stack.back() };
+			stack.pop_back();
+
+			auto const& node{ m_Nodes[nodeID] };
+			if (node.IsLeaf())
+			{
+				if (node.height != 0 || node.child2 != NULL_NODE)
+				{
+					return false;
+				}
+
+				++leafCount;
+				continue;
+			}
+
+			auto const& child1{ m_Nodes[node.child1] };
+			auto const& child2{ m_Nodes[node.child2] };
+
+			if (child1.parent != nodeID || child2.parent != nodeID
+				|| node.height != 1 + std::max(child1.height, child2.height)
+				|| !node.bounds.Contains(child1.bounds) || !node.bounds.Contains(child2.bounds))
+			{
+				return false;
+			}
+
+			stack.emplace_back(node.child1);
+			stack.emplace_back(node.child2);
+		}
+
+		return leafCount == m_ProxyCount;
+	}
+
+	uint32_t DynamicAABBTree::AllocateNode()
+	{
+		if (NULL_NODE == m_FreeList)
+		{
+			m_Nodes.emplace_back();
+			return static_cast<uint32_t>(m_Nodes.size() - 1);
+		}
+
+		uint32_t const nodeID{ m_FreeList };
+
+		auto& node{ m_Nodes[nodeID] };
+		m_FreeList = node.parent;
+		node = Node{};
+
+		return nodeID;
+	}
+
+	void DynamicAABBTree::FreeNode(uint32_t nodeID) noexcept
+	{
+		auto& node{ m_Nodes[nodeID] };
+		node.parent = m_FreeList;
+		node.child1 = NULL_NODE;
+		node.child2 = NULL_NODE;
+		node.height = -1;
+
+		m_FreeList = nodeID;
+	}
+
+	void DynamicAABBTree::InsertLeaf(uint32_t leaf)
+	{
+		if (NULL_NODE == m_Root)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		MauCor::AABB const leafBounds{ m_Nodes[leaf].bounds };
+
+		// Find the sibling with the lowest surface area cost
+		uint32_t sibling{ m_Root };
+		while (!m_Nodes[sibling].IsLeaf())
+		{
+			auto const& node{ m_Nodes[sibling] };
+
+			float const area{ node.bounds.SurfaceArea() };
+			float const combinedArea{ MauCor::AABB::Merge(node.bounds, leafBounds).SurfaceArea() };
+
+			// Cost of pairing the leaf with this node & the minimum cost pushed down to the children
+			float const cost{ 2.f * combinedArea };
+			float const inheritanceCost{ 2.f * (combinedArea - area) };
+
+			auto const childCost{ [&](uint32_t childID)
+				{
+					auto const& child{ m_Nodes[childID] };
+					float const mergedArea{ MauCor::AABB::Merge(child.bounds, leafBounds).SurfaceArea() };
+
+					return (child.IsLeaf() ? mergedArea : mergedArea - child.bounds.SurfaceArea()) + inheritanceCost;
+				} };
+
+			float const cost1{ childCost(node.child1) };
+			float const cost2{ childCost(node.child2) };
+
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+
+			sibling = cost1 < cost2 ? node.child1 : node.child2;
+		}
+
+		// Allocating can grow the node vector, so no references are held across it
+		uint32_t const oldParent{ m_Nodes[sibling].parent };
+		uint32_t const newParent{ AllocateNode() };
+
+		auto& parentNode{ m_Nodes[newParent] };
+		parentNode.parent = oldParent;
+		parentNode.bounds = MauCor::AABB::Merge(leafBounds, m_Nodes[sibling].bounds);
+		parentNode.height = m_Nodes[sibling].height + 1;
+		parentNode.child1 = sibling;
+		parentNode.child2 = leaf;
+
+		if (NULL_NODE == oldParent)
+		{
+			m_Root = newParent;
+		}
+		else if (m_Nodes[oldParent].child1 == sibling)
+		{
+			m_Nodes[oldParent].child1 = newParent;
+		}
+		else
+		{
+			m_Nodes[oldParent].child2 = newParent;
+		}
+
+		m_Nodes[sibling].parent = newParent;
+		m_Nodes[leaf].parent = newParent;
+
+		// From the new parent itself, pairing the leaf with a high sibling can already unbalance it
+		Refit(newParent);
+	}
+
+	void DynamicAABBTree::RemoveLeaf(uint32_t leaf) noexcept
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NULL_NODE;
+			return;
+		}
+
+		uint32_t const parent{ m_Nodes[leaf].parent };
+		uint32_t const grandParent{ m_Nodes[parent].parent };
+		uint32_t const sibling{ m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1 };
+
+		FreeNode(parent);
+
+		if (NULL_NODE == grandParent)
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].parent = NULL_NODE;
+			return;
+		}
+
+		if (m_Nodes[grandParent].child1 == parent)
+		{
+			m_Nodes[grandParent].child1 = sibling;
+		}
+		else
+		{
+			m_Nodes[grandParent].child2 = sibling;
+		}
+
+		m_Nodes[sibling].parent = grandParent;
+
+		Refit(grandParent);
+	}
+
+	void DynamicAABBTree::Refit(uint32_t nodeID) noexcept
+	{
+		while (NULL_NODE != nodeID)
+		{
+			nodeID = Balance(nodeID);
+
+			auto& node{ m_Nodes[nodeID] };
+			auto const& child1{ m_Nodes[node.child1] };
+			auto const& child2{ m_Nodes[node.child2] };
+
+			node.height = 1 + std::max(child1.height, child2.height);
+			node.bounds = MauCor::AABB::Merge(child1.bounds, child2.bounds);
+
+			nodeID = node.parent;
+		}
+	}
+
+	uint32_t DynamicAABBTree::Balance(uint32_t nodeID) noexcept
+	{
+		// Rotates the higher child up when the heights of the children differ by more than 1
+		auto& a{ m_Nodes[nodeID] };
+		if (a.IsLeaf() || a.height < 2)
+		{
+			return nodeID;
+		}
+
+		uint32_t const idB{ a.child1 };
+		uint32_t const idC{ a.child2 };
+		auto& b{ m_Nodes[idB] };
+		auto& c{ m_Nodes[idC] };
+
+		int32_t const balance{ c.height - b.height };
+
+		auto const replaceInParent{ [this](uint32_t parentID, uint32_t oldChild, uint32_t newChild)
+			{
+				if (NULL_NODE == parentID)
+				{
+					m_Root = newChild;
+				}
+				else if (m_Nodes[parentID].child1 == oldChild)
+				{
+					m_Nodes[parentID].child1 = newChild;
+				}
+				else
+				{
+					m_Nodes[parentID].child2 = newChild;
+				}
+			} };
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			uint32_t const idF{ c.child1 };
+			uint32_t const idG{ c.child2 };
+			auto& f{ m_Nodes[idF] };
+			auto& g{ m_Nodes[idG] };
+
+			c.child1 = nodeID;
+			c.parent = a.parent;
+			a.parent = idC;
+			replaceInParent(c.parent, nodeID, idC);
+
+			if (f.height > g.height)
+			{
+				c.child2 = idF;
+				a.child2 = idG;
+				g.parent = nodeID;
+				a.bounds = MauCor::AABB::Merge(b.bounds, g.bounds);
+				c.bounds = MauCor::AABB::Merge(a.bounds, f.bounds);
+
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.child2 = idG;
+				a.child2 = idF;
+				f.parent = nodeID;
+				a.bounds = MauCor::AABB::Merge(b.bounds, f.bounds);
+				c.bounds = MauCor::AABB::Merge(a.bounds, g.bounds);
+
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return idC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			uint32_t const idD{ b.child1 };
+			uint32_t const idE{ b.child2 };
+			auto& d{ m_Nodes[idD] };
+			auto& e{ m_Nodes[idE] };
+
+			b.child1 = nodeID;
+			b.parent = a.parent;
+			a.parent = idB;
+			replaceInParent(b.parent, nodeID, idB);
+
+			if (d.height > e.height)
+			{
+				b.child2 = idD;
+				a.child1 = idE;
+				e.parent = nodeID;
+				a.bounds = MauCor::AABB::Merge(c.bounds, e.bounds);
+				b.bounds = MauCor::AABB::Merge(a.bounds, d.bounds);
+
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.child2 = idE;
+				a.child1 = idD;
+				d.parent = nodeID;
+				a.bounds = MauCor::AABB::Merge(c.bounds, d.bounds);
+				b.bounds = MauCor::AABB::Merge(a.bounds, e.bounds);
+
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return idB;
+		}
+
+		return nodeID;
+	}
+
+	uint32_t DynamicAABBTree::BuildRange(std::span<ProxyInput const> proxies, std::span<glm::vec3 const> centroids, std::span<uint32_t> order,
+		uint32_t begin, uint32_t end, uint32_t parallelDepth)
+	{
+		// Range [begin, end) owns nodes [2 * begin, 2 * end - 1), subtrees never touch each others nodes
+		if (end - begin == 1)
+		{
+			uint32_t const leaf{ 2 * begin };
+
+			auto& node{ m_Nodes[leaf] };
+			node.bounds = proxies[order[begin]].bounds.Expanded(m_Margin);
+			node.userData = proxies[order[begin]].userData;
+			node.height = 0;
+
+			return leaf;
+		}
+
+		// Median split along the longest axis of the centroids
+		MauCor::AABB centroidBounds{ MauCor::AABB::Empty() };
+		for (uint32_t idx{ begin }; idx < end; ++idx)
+		{
+			centroidBounds.Merge(centroids[order[idx]]);
+		}
+
+		glm::vec3 const size{ centroidBounds.max - centroidBounds.min };
+		int const axis{ size.x > size.y && size.x > size.z ? 0 : (size.y > size.z ? 1 : 2) };
+
+		uint32_t const middle{ begin + (end - begin) / 2 };
+		std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&centroids, axis](uint32_t lhs, uint32_t rhs)
+			{
+				return centroids[lhs][axis] < centroids[rhs][axis];
+			});
+
+		std::array<uint32_t, 2> children{};
+		std::array<std::pair<uint32_t, uint32_t>, 2> const ranges{ std::pair{ begin, middle }, std::pair{ middle, end } };
+
+		if (parallelDepth > 0 && end - begin >= PARALLEL_BUILD_THRESHOLD)
+		{
+			std::transform(std::execution::par, ranges.begin(), ranges.end(), children.begin(), [&](auto const& range)
+				{
+					return BuildRange(proxies, centroids, order, range.first, range.second, parallelDepth - 1);
+				});
+		}
+		else
+		{
+			children[0] = BuildRange(proxies, centroids, order, begin, middle, 0);
+			children[1] = BuildRange(proxies, centroids, order, middle, end, 0);
+		}
+
+		uint32_t const nodeID{ 2 * middle - 1 };
+
+		auto& node{ m_Nodes[nodeID] };
+		node.child1 = children[0];
+		node.child2 = children[1];
+		node.bounds = MauCor::AABB::Merge(m_Nodes[children[0]].bounds, m_Nodes[children[1]].bounds);
+		node.height = 1 + std::max(m_Nodes[children[0]].height, m_Nodes[children[1]].height);
+
+		m_Nodes[children[0]].parent = nodeID;
+		m_Nodes[children[1]].parent = nodeID;
+
+		return nodeID;
+	}
+
+	void DynamicAABBTree::AddLeaves(uint32_t nodeID, std::vector<uint32_t>& results, std::vector<uint32_t>& stack) const
+	{
+		stack.emplace_back(nodeID);
+		while (!stack.empty())
+		{
+			auto const& node{ m_Nodes[stack.back()] };
+			stack.pop_back();
+
+			if (node.IsLeaf())
+			{
+				results.emplace_back(node.userData);
+			}
+			else
+			{
+				stack.emplace_back(node.child1);
+				stack.emplace_back(node.child2);
+			}
+		}
+	}
+}
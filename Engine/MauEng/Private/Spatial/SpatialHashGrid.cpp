@@ -0,0 +1,224 @@
+#include "Spatial/SpatialHashGrid.h"
+
+#include <bit>
+#include <execution>
+#include <ranges>
+
+#include "../../ECS/Public/ECSWorld.h"
+
+#include "Components/CTransform.h"
+
+namespace MauEng
+{
+	void SpatialHashGrid::Rebuild(ECS::ECSWorld& world)
+	{
+		ME_PROFILE_FUNCTION()
+
+		m_GatheredPositions.clear();
+		m_GatheredEntities.clear();
+
+		{
+			ME_PROFILE_SCOPE("GATHER")
+
+			world.View<CTransform>().Each([this](ECS::EntityID id, CTransform const& transform)
+				{
+					m_GatheredPositions.emplace_back(transform.translation);
+					m_GatheredEntities.emplace_back(id);
+				});
+		}
+
+		Rebuild(m_GatheredPositions, m_GatheredEntities);
+	}
+
+	void SpatialHashGrid::Rebuild(std::span<glm::vec3 const> positions, std::span<ECS::EntityID const> entities)
+	{
+		ME_PROFILE_FUNCTION()
+		ME_ASSERT(positions.size() == entities.size());
+
+		uint32_t const count{ static_cast<uint32_t>(positions.size()) };
+
+		// Around 1 point per bucket, keeps the chance of unrelated cells sharing a bucket low
+		uint32_t const bucketCount{ std::max(MIN_BUCKET_COUNT, std::bit_ceil(count)) };
+		uint32_t const partitionShift{ static_cast<uint32_t>(std::countr_zero(bucketCount)) - PARTITION_BITS };
+
+		m_BucketStart.resize(bucketCount + 1);
+		m_PointBuckets.resize(count);
+		m_Partitioned.resize(count);
+		m_Positions.resize(count);
+		m_Entities.resize(count);
+
+		m_Chunks.resize((count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+		for (uint32_t chunkIdx{ 0 }; chunkIdx < m_Chunks.size(); ++chunkIdx)
+		{
+			m_Chunks[chunkIdx].begin = chunkIdx * CHUNK_SIZE;
+			m_Chunks[chunkIdx].end = std::min(count, (chunkIdx + 1) * CHUNK_SIZE);
+		}
+
+		{
+			ME_PROFILE_SCOPE("HASH")
+
+			std::transform(std::execution::par_unseq, positions.begin(), positions.end(), m_PointBuckets.begin(), [this](glm::vec3 const& position)
+				{
+					return HashCell(CellOf(position));
+				});
+
+			std::for_each(std::execution::par, m_Chunks.begin(), m_Chunks.end(), [this, partitionShift](Chunk& chunk)
+				{
+					chunk.offsets.fill(0);
+					for (uint32_t pointIdx{ chunk.begin }; pointIdx < chunk.end; ++pointIdx)
+					{
+						++chunk.offsets[m_PointBuckets[pointIdx] >> partitionShift];
+					}
+				});
+		}
+
+		{
+			ME_PROFILE_SCOPE("PARTITION")
+
+			// Partitions are laid out in order, within a partition the points of every chunk follow each other
+			m_PartitionStart.resize(PARTITION_COUNT + 1);
+
+			uint32_t offset{ 0 };
+			for (uint32_t partition{ 0 }; partition < PARTITION_COUNT; ++partition)
+			{
+				m_PartitionStart[partition] = offset;
+				for (auto& chunk : m_Chunks)
+				{
+					uint32_t const chunkCount{ chunk.offsets[partition] };
+					chunk.offsets[partition] = offset;
+					offset += chunkCount;
+				}
+			}
+			m_PartitionStart[PARTITION_COUNT] = offset;
+
+			std::for_each(std::execution::par, m_Chunks.begin(), m_Chunks.end(), [this, positions, entities, partitionShift](Chunk& chunk)
+				{
+					for (uint32_t pointIdx{ chunk.begin }; pointIdx < chunk.end; ++pointIdx)
+					{
+						uint32_t const bucket{ m_PointBuckets[pointIdx] };
+						m_Partitioned[chunk.offsets[bucket >> partitionShift]++] = PartitionedPoint{ positions[pointIdx], entities[pointIdx], bucket };
+					}
+				});
+		}
+
+		{
+			ME_PROFILE_SCOPE("SORT PARTITIONS")
+
+			// Every partition owns a contiguous range of buckets & points, a counting sort per partition stays in cache.
+			// Iterates the partition indices, a parallel policy may hand the lambda copies of the starts
+			auto const partitions{ std::views::iota(0u, static_cast<uint32_t>(m_PartitionStart.size() - 1)) };
+			std::for_each(std::execution::par, partitions.begin(), partitions.end(), [this, partitionShift](uint32_t partition)
+				{
+					uint32_t const partitionStart{ m_PartitionStart[partition] };
+					uint32_t const partitionEnd{ m_PartitionStart[partition + 1] };
+
+					uint32_t* const pBucketStart{ m_BucketStart.data() + (partition << partitionShift) };
+					uint32_t const partitionBucketCount{ 1u << partitionShift };
+
+					std::fill_n(pBucketStart, partitionBucketCount, 0);
+					for (uint32_t idx{ partitionStart }; idx < partitionEnd; ++idx)
+					{
+						++pBucketStart[m_Partitioned[idx].bucket & (partitionBucketCount - 1)];
+					}
+
+					// Bucket starts are used as write cursors & shifted back afterwards
+					uint32_t offset{ partitionStart };
+					for (uint32_t bucket{ 0 }; bucket < partitionBucketCount; ++bucket)
+					{
+						uint32_t const bucketSize{ pBucketStart[bucket] };
+						pBucketStart[bucket] = offset;
+						offset += bucketSize;
+					}
+
+					for (uint32_t idx{ partitionStart }; idx < partitionEnd; ++idx)
+					{
+						auto const& point{ m_Partitioned[idx] };
+						uint32_t const slot{ pBucketStart[point.bucket & (partitionBucketCount - 1)]++ };
+
+						m_Positions[slot] = point.position;
+						m_Entities[slot] = point.entity;
+					}
+
+					for (uint32_t bucket{ partitionBucketCount - 1 }; bucket > 0; --bucket)
+					{
+						pBucketStart[bucket] = pBucketStart[bucket - 1];
+					}
+					pBucketStart[0] = partitionStart;
+				});
+
+			m_BucketStart[bucketCount] = count;
+		}
+	}
+
+	void SpatialHashGrid::Clear() noexcept
+	{
+		m_BucketStart.clear();
+		m_Positions.clear();
+		m_Entities.clear();
+	}
+
+	void SpatialHashGrid::QueryRange(MauCor::AABB const& range, std::vector<ECS::EntityID>& results) const
+	{
+		ForEachInRange(range, [&results](ECS::EntityID entity, glm::vec3 const&)
+			{
+				results.emplace_back(entity);
+			});
+	}
+
+	void SpatialHashGrid::QueryRadius(glm::vec3 const& center, float radius, std::vector<ECS::EntityID>& results) const
+	{
+		ForEachInRadius(center, radius, [&results](ECS::EntityID entity, glm::vec3 const&)
+			{
+				results.emplace_back(entity);
+			});
+	}
+
+	void SpatialHashGrid::QueryNeighbors(glm::vec3 const& position, std::vector<ECS::EntityID>& results) const
+	{
+		if (m_Entities.empty())
+		{
+			return;
+		}
+
+		glm::ivec3 const cell{ CellOf(position) };
+		glm::vec3 const rangeMin{ glm::vec3{ cell - glm::ivec3{ 1 } } * m_CellSize };
+
+		// Compare cells instead of positions, points on the far boundary belong to the next cell
+		ForEachCandidateBucket({ rangeMin, rangeMin + glm::vec3{ 3.f * m_CellSize } }, [&](uint32_t bucket)
+			{
+				for (uint32_t idx{ m_BucketStart[bucket] }; idx < m_BucketStart[bucket + 1]; ++idx)
+				{
+					glm::ivec3 const offset{ CellOf(m_Positions[idx]) - cell };
+					if (glm::all(glm::lessThanEqual(glm::abs(offset), glm::ivec3{ 1 })))
+					{
+						results.emplace_back(m_Entities[idx]);
+					}
+				}
+			});
+	}
+
+	void SpatialHashGrid::QueryFrustum(MauCor::Frustum const& frustum, float pointRadius, std::vector<ECS::EntityID>& results) const
+	{
+		ME_PROFILE_FUNCTION()
+
+		if (m_Positions.empty())
+		{
+			return;
+		}
+
+		// Points are packed after the rebuild, a parallel pass over them is cheaper than walking the cells inside the frustum
+		std::vector<uint8_t> visible(m_Positions.size());
+		std::transform(std::execution::par_unseq, m_Positions.begin(), m_Positions.end(), visible.begin(), [&frustum, pointRadius](glm::vec3 const& position)
+			{
+				return static_cast<uint8_t>(frustum.Overlaps(MauCor::Sphere{ position, pointRadius }));
+			});
+
+		for (std::size_t idx{ 0 }; idx < visible.size(); ++idx)
+		{
+			if (visible[idx])
+			{
+				results.emplace_back(m_Entities[idx]);
+			}
+		}
+	}
+}
@@ -0,0 +1,145 @@
+#include "Spatial/SpatialIndex.h"
+
+#include <execution>
+
+#include "../../ECS/Public/ECSWorld.h"
+
+#include "Components/CStaticMesh.h"
+#include "Components/CTransform.h"
+
+namespace MauEng
+{
+	void SpatialIndex::Update(ECS::ECSWorld& world)
+	{
+		ME_PROFILE_FUNCTION()
+
+		++m_UpdateCount;
+		m_Pending.clear();
+
+		uint32_t seenCount{ 0 };
+
+		{
+			ME_PROFILE_SCOPE("FIND CHANGES")
+
+			world.View<CTransform, CStaticMesh>().Each([this, &seenCount](ECS::EntityID id, CTransform& transform, CStaticMesh const& mesh)
+				{
+					uint32_t const slot{ ECS::ECSWorld::GetEntityIndex(id) };
+					if (slot >= m_Tracked.size())
+					{
+						m_Tracked.resize(slot + 1);
+					}
+
+					auto& tracked{ m_Tracked[slot] };
+
+					// Slot was reused by a new entity, the destroyed one is still in the tree
+					if (tracked.id != id && INVALID_PROXY_ID != tracked.proxyID)
+					{
+						m_Tree.DestroyProxy(tracked.proxyID);
+						tracked.proxyID = INVALID_PROXY_ID;
+						--m_TrackedCount;
+					}
+
+					tracked.id = id;
+					tracked.lastSeenUpdate = m_UpdateCount;
+
+					bool const isNew{ INVALID_PROXY_ID == tracked.proxyID };
+					if (!isNew)
+					{
+						++seenCount;
+					}
+
+					if (isNew || transform.isDirty)
+					{
+						m_Pending.emplace_back(PendingEntity{ id, &transform, &mesh, {}, isNew });
+					}
+				});
+		}
+
+		// Fewer tracked entities were seen than there are in the tree, some were destroyed or lost a component
+		if (seenCount < m_TrackedCount)
+		{
+			RemoveUnseen();
+		}
+
+		ApplyPending();
+	}
+
+	void SpatialIndex::Clear() noexcept
+	{
+		m_Tree.Clear();
+		m_Tracked.clear();
+		m_Pending.clear();
+		m_TrackedCount = 0;
+	}
+
+	void SpatialIndex::ApplyPending()
+	{
+		if (m_Pending.empty())
+		{
+			return;
+		}
+
+		{
+			ME_PROFILE_SCOPE("WORLD BOUNDS")
+
+			std::for_each(std::execution::par_unseq, m_Pending.begin(), m_Pending.end(), [](PendingEntity& pending)
+				{
+					pending.pTransform->UpdateMatrix();
+					pending.bounds = pending.pMesh->localBounds.Transformed(pending.pTransform->mat);
+				});
+		}
+
+		ME_PROFILE_SCOPE("UPDATE TREE")
+
+		// Everything is new (e.g after loading a scene), a bulk build gives a better tree & is a lot faster than inserting one by one
+		if (0 == m_TrackedCount && m_Pending.size() >= BULK_BUILD_THRESHOLD)
+		{
+			std::vector<ProxyInput> proxies(m_Pending.size());
+			std::transform(std::execution::par_unseq, m_Pending.begin(), m_Pending.end(), proxies.begin(), [](PendingEntity const& pending)
+				{
+					return ProxyInput{ pending.bounds, pending.id };
+				});
+
+			std::vector<uint32_t> proxyIDs(proxies.size());
+			m_Tree.Build(proxies, proxyIDs);
+
+			for (std::size_t idx{ 0 }; idx < m_Pending.size(); ++idx)
+			{
+				m_Tracked[ECS::ECSWorld::GetEntityIndex(m_Pending[idx].id)].proxyID = proxyIDs[idx];
+			}
+
+			m_TrackedCount = static_cast<uint32_t>(m_Pending.size());
+			return;
+		}
+
+		for (auto const& pending : m_Pending)
+		{
+			auto& tracked{ m_Tracked[ECS::ECSWorld::GetEntityIndex(pending.id)] };
+			if (pending.isNew)
+			{
+				tracked.proxyID = m_Tree.CreateProxy(pending.bounds, pending.id);
+				++m_TrackedCount;
+			}
+			else
+			{
+				m_Tree.MoveProxy(tracked.proxyID, pending.bounds);
+			}
+		}
+	}
+
+	void SpatialIndex::RemoveUnseen() noexcept
+	{
+		ME_PROFILE_FUNCTION()
+
+		for (auto& tracked : m_Tracked)
+		{
+			if (INVALID_PROXY_ID != tracked.proxyID && tracked.lastSeenUpdate != m_UpdateCount)
+			{
+				m_Tree.DestroyProxy(tracked.proxyID);
+				tracked.proxyID = INVALID_PROXY_ID;
+				tracked.id = ECS::NULL_ENTITY_ID;
+				--m_TrackedCount;
+			}
+		}
+	}
+}
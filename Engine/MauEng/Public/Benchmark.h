@@ -0,0 +1,62 @@
+#ifndef MAUENG_BENCHMARK_H
+#define MAUENG_BENCHMARK_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace MauEng
+{
+	struct CameraPathKey final
+	{
+		float timeSec{ 0.f };
+		glm::vec3 position{};
+		// Point the camera looks at
+		glm::vec3 target{ 0.f, 0.f, 1.f };
+	};
+
+	// Scripted camera flythrough, the position & target are interpolated linearly between the keys
+	class CameraPath final
+	{
+	public:
+		CameraPath() = default;
+		explicit CameraPath(std::vector<CameraPathKey> keys);
+		~CameraPath() = default;
+
+		// Clamped to the first & last key
+		[[nodiscard]] CameraPathKey Sample(float timeSec) const noexcept;
+
+		[[nodiscard]] bool IsEmpty() const noexcept { return m_Keys.empty(); }
+		[[nodiscard]] float GetDuration() const noexcept { return m_Keys.empty() ? 0.f : m_Keys.back().timeSec; }
+
+		CameraPath(CameraPath const&) = default;
+		CameraPath(CameraPath&&) = default;
+		CameraPath& operator=(CameraPath const&) = default;
+		CameraPath& operator=(CameraPath&&) = default;
+
+	private:
+		// Sorted by time
+		std::vector<CameraPathKey> m_Keys{};
+	};
+
+	// Engine::RunBenchmark, every frame advances the game time by the same step so runs can be compared
+	struct BenchmarkSettings final
+	{
+		// Not measured, lets the caches, pools & GPU clocks settle
+		uint32_t warmupFrames{ 60 };
+		uint32_t frameCount{ 1'000 };
+		float timeStepSec{ 1.f / 60.f };
+
+		// Drives the active camera when not empty, the time starts at 0 after the warmup
+		CameraPath cameraPath{};
+
+		// Records a trace of the measured frames (ENABLE_PROFILER)
+		bool captureTrace{ false };
+		// <outputPath>.json & .csv, the trace goes next to it
+		std::filesystem::path outputPath{ "Profiling/Benchmark/Benchmark" };
+	};
+}
+
+#endif
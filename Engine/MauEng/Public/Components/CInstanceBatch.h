@@ -0,0 +1,59 @@
+#ifndef MAUENG_CINSTANCEBATCH_H
+#define MAUENG_CINSTANCEBATCH_H
+
+#include <span>
+#include <vector>
+
+#include "RendererIdentifiers.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/Rotator.h"
+
+namespace MauEng
+{
+	/*
+	 * Many render only instances of one mesh owned by a single entity (crowds, foliage, particles).
+	 * Instances are not entities, they only have a world space position, rotation & uniform scale, stored as arrays (SoA).
+	 * The transform of the owning entity is not applied. The renderer gets the matrices of a batch as one block.
+	 */
+	struct CInstanceBatch final
+	{
+		uint32_t meshID{ MauRen::INVALID_MESH_ID };
+		// Local space bounds of the mesh
+		MauCor::AABB localBounds{};
+
+		// One entry per instance in each array, modify them directly & set isDirty afterwards
+		std::vector<glm::vec3> positions{};
+		std::vector<glm::quat> rotations{};
+		std::vector<float> scales{};
+
+		// World space bounds of all instances, rebuilt by GetBounds when dirty
+		MauCor::AABB bounds{};
+		bool isDirty{ true };
+
+		CInstanceBatch(char const* path);
+		explicit CInstanceBatch(uint32_t id);
+		CInstanceBatch(uint32_t id, MauCor::AABB const& bounds) noexcept : meshID{ id }, localBounds{ bounds } {}
+
+		void Reserve(uint32_t count);
+
+		// Returns the index of the instance
+		uint32_t AddInstance(glm::vec3 const& position, glm::quat const& rotation = glm::quat{ 1.f, 0.f, 0.f, 0.f }, float scale = 1.f);
+		void SetInstance(uint32_t index, glm::vec3 const& position, glm::quat const& rotation, float scale) noexcept;
+		// Moves the last instance into the freed slot, only its index changes
+		void RemoveInstance(uint32_t index) noexcept;
+		void Clear() noexcept;
+
+		[[nodiscard]] uint32_t Count() const noexcept { return static_cast<uint32_t>(positions.size()); }
+		// Memory used by the instance arrays
+		[[nodiscard]] std::size_t MemoryBytes() const noexcept;
+
+		// World space bounds of all instances, uses the bounding sphere of the mesh so rotations are covered
+		[[nodiscard]] MauCor::AABB ComputeBounds() const noexcept;
+		// Cached ComputeBounds, only recomputed after the instances changed
+		[[nodiscard]] MauCor::AABB const& GetBounds() noexcept;
+		// Writes the model matrix of every instance, in parallel
+		void BuildMatrices(std::span<glm::mat4> matrices) const noexcept;
+	};
+}
+
+#endif
@@ -2,13 +2,19 @@
 #define MAUENG_CSTATICMESH_H
 
 #include "RendererIdentifiers.h"
+#include "Math/BoundingVolumes.h"
 
 namespace MauEng
 {
 	struct CStaticMesh final
 	{
 		uint32_t meshID{ MauRen::INVALID_MESH_ID };
+		// Local space bounds of the mesh, used by the spatial index
+		MauCor::AABB localBounds{};
+
 		CStaticMesh(char const* path);
+		explicit CStaticMesh(uint32_t id);
+		CStaticMesh(uint32_t id, MauCor::AABB const& bounds) noexcept : meshID{ id }, localBounds{ bounds } {}
 	};
 }
 
@@ -6,18 +6,31 @@
 #include <functional>
 #include <memory>
 
+#include "Benchmark.h"
+
 namespace MauEng
 {
 	struct GLFWWindow;
 	struct SDLWindow;
 
+	enum class EngineMode : uint8_t
+	{
+		Windowed,
+		// No window, input or GPU, draws go to the null renderer. Only runs benchmarks, e.g on a build machine without a display
+		Headless
+	};
+
+	class FrameTimer;
+
 	class Engine final
 	{
 	public:
-		explicit Engine();
+		explicit Engine(EngineMode mode = EngineMode::Windowed);
 		~Engine();
 
 		void Run(std::function<void()> const& load);
+		// Runs the loaded scene for a fixed number of frames & writes the frame times, see BenchmarkSettings
+		void RunBenchmark(std::function<void()> const& load, BenchmarkSettings const& settings);
 
 		Engine(Engine const&) = delete;
 		Engine(Engine&&) = delete;
@@ -25,9 +38,14 @@ namespace MauEng
 		Engine& operator=(Engine&&) = delete;
 
 	private:
+		EngineMode const m_Mode;
+		// Null when headless
 		std::unique_ptr<SDLWindow> m_Window;
 
 		void GameLoop();
+		void BenchmarkLoop(BenchmarkSettings const& settings);
+		// Returns false when the window was closed
+		bool BenchmarkFrame(FrameTimer& frameTimer, BenchmarkSettings const& settings, float pathTimeSec);
 	};
 }
 
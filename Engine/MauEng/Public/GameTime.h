@@ -55,6 +55,13 @@ namespace MauEng
 			m_LastTime = std::chrono::high_resolution_clock::now();
 		}
 
+		// Advance by a fixed step instead of the real time, every run gets the same ticks (benchmarks)
+		inline void constexpr Step(float elapsedSec) noexcept
+		{
+			m_ElapsedSec = elapsedSec;
+			m_MsLag += elapsedSec * 1000.f;
+		}
+
 		// How long should we sleep to achieve our Ms per frame target
 		[[nodiscard]] inline auto SleepTime() const noexcept
 		{
@@ -8,6 +8,7 @@
 #include "CorePCH.h"
 
 #include "Components/CStaticMesh.h"
+#include "Components/CInstanceBatch.h"
 #include "Components/CTransform.h"
 
 #endif
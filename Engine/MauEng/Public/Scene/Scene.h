@@ -8,7 +8,10 @@
 #include "../../ECS/Public/ECSWorld.h"
 #include "../../ECS/Public/Entity.h"
 
+#include "Memory/PageArena.h"
+
 #include "Components/CTransform.h"
+#include "Spatial/SpatialIndex.h"
 
 namespace MauEng
 {
@@ -26,6 +29,7 @@ namespace MauEng
 		virtual void Tick()
 		{
 			m_CameraManager.Tick();
+			m_ECSWorld.RunSystems();
 		}
 
 		// Called to render the scene
@@ -38,10 +42,56 @@ namespace MauEng
 		[[nodiscard]] Entity CreateEntity();
 		void DestroyEntity(Entity entity);
 
+		/**
+		 * @brief Create entities from a prototype, a default CTransform is added in front if the prototype has none.
+		 * @param count amount of entities to create.
+		 * @param prototype components every entity starts with.
+		 * @return ids of the created entities.
+		*/
+		template<typename... ComponentTypes>
+		std::vector<ECS::EntityID> CreateEntities(uint32_t count, ECS::Prototype<ComponentTypes...> const& prototype)
+		{
+			if constexpr (ECS::Prototype<ComponentTypes...>::template CONTAINS<CTransform>)
+			{
+				return m_ECSWorld.CreateEntities(count, prototype);
+			}
+			else
+			{
+				return m_ECSWorld.CreateEntities(count, prototype.Prepend(CTransform{}));
+			}
+		}
+
+		/**
+		 * @brief Create entities from a prototype & initialise them, a default CTransform is added in front if the prototype has none.
+		 * @param count amount of entities to create.
+		 * @param prototype components every entity starts with.
+		 * @param init invoked as init(index, components&...), in the order of the (extended) prototype.
+		 * @param policy Policy to multithread the init function with.
+		 * @return ids of the created entities.
+		*/
+		template<typename... ComponentTypes, typename InitFunc, typename ExecPolicy = std::execution::sequenced_policy>
+		std::vector<ECS::EntityID> CreateEntities(uint32_t count, ECS::Prototype<ComponentTypes...> const& prototype, InitFunc&& init, ExecPolicy policy = ExecPolicy{})
+		{
+			if constexpr (ECS::Prototype<ComponentTypes...>::template CONTAINS<CTransform>)
+			{
+				return m_ECSWorld.CreateEntities(count, prototype, std::forward<InitFunc>(init), policy);
+			}
+			else
+			{
+				return m_ECSWorld.CreateEntities(count, prototype.Prepend(CTransform{}), std::forward<InitFunc>(init), policy);
+			}
+		}
+
 		[[nodiscard]] ECS::ECSWorld& GetECSWorld() noexcept { return m_ECSWorld; }
 		[[nodiscard]] ECS::ECSWorld const& GetECSWorld() const noexcept { return m_ECSWorld; }
+
+		// Memory of all component pools of the scene, per pool stats are on the ECS world
+		[[nodiscard]] MauCor::ArenaStats GetComponentMemoryStats() const noexcept { return m_ComponentArena.GetStats(); }
 #pragma endregion
 
+		// Entities with a transform & static mesh, brought up to date right before the scene is rendered
+		[[nodiscard]] SpatialIndex const& GetSpatialIndex() const noexcept { return m_SpatialIndex; }
+
 		[[nodiscard]] CameraManager const& GetCameraManager() const noexcept { return m_CameraManager; }
 		[[nodiscard]] CameraManager& GetCameraManager() noexcept { return m_CameraManager; }
 
@@ -54,7 +104,11 @@ namespace MauEng
 		CameraManager m_CameraManager{ };
 
 	private:
-		mutable ECS::ECSWorld m_ECSWorld{ };
+		// Backs the component pools, declared first so it outlives the world, its pages are counted under MemoryTag::ECS
+		MauCor::PageArena m_ComponentArena{ MauCor::PageArena::DEFAULT_PAGE_SIZE, true, MauCor::MemoryTag::ECS };
+		mutable ECS::ECSWorld m_ECSWorld{ &m_ComponentArena };
+		mutable SpatialIndex m_SpatialIndex{ };
+		mutable std::vector<ECS::EntityID> m_VisibleEntities{ };
 
 	};
 }
@@ -20,6 +20,7 @@ namespace MauEng
 		void Tick();
 
 		void UpdateCamerasAspectRatio(float aspectRatio) noexcept;
+		[[nodiscard]] Camera& GetActiveCamera() noexcept;
 
 		SceneManager(SceneManager const&) = delete;
 		SceneManager(SceneManager&&) = delete;
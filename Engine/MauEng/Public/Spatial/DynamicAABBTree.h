@@ -0,0 +1,116 @@
+#ifndef MAUENG_DYNAMICAABBTREE_H
+#define MAUENG_DYNAMICAABBTREE_H
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Math/BoundingVolumes.h"
+
+namespace MauEng
+{
+	uint32_t constexpr INVALID_PROXY_ID{ UINT32_MAX };
+
+	struct RayHit final
+	{
+		uint32_t userData{};
+		float distance{};
+	};
+
+	struct ProxyInput final
+	{
+		MauCor::AABB bounds{};
+		uint32_t userData{};
+	};
+
+	/*
+	 * Bounding volume hierarchy of (fattened) AABBs that can be updated incrementally.
+	 * Leaves are stored with a margin, small movements only need a containment check & no tree update.
+	 * Moving a proxy out of its fat bounds reinserts the leaf, the path to the root is refitted & rebalanced.
+	 * Queries report the user data of every leaf whose fat bounds pass the test, results are appended.
+	 */
+	class DynamicAABBTree final
+	{
+	public:
+		explicit DynamicAABBTree(float margin = .1f) noexcept
+			: m_Margin{ margin } {}
+		~DynamicAABBTree() = default;
+
+		[[nodiscard]] uint32_t CreateProxy(MauCor::AABB const& bounds, uint32_t userData);
+		void DestroyProxy(uint32_t proxyID) noexcept;
+
+		// Returns true when the proxy left its fat bounds & had to be reinserted
+		bool MoveProxy(uint32_t proxyID, MauCor::AABB const& bounds) noexcept;
+
+		// Replace the tree with a balanced tree over all proxies (built in parallel), proxyIDs[i] receives the id of proxies[i]
+		void Build(std::span<ProxyInput const> proxies, std::span<uint32_t> proxyIDs);
+		void Clear() noexcept;
+
+		void QueryAABB(MauCor::AABB const& bounds, std::vector<uint32_t>& results) const;
+		void QuerySphere(MauCor::Sphere const& sphere, std::vector<uint32_t>& results) const;
+		void QueryFrustum(MauCor::Frustum const& frustum, std::vector<uint32_t>& results) const;
+
+		// Closest leaf hit by the ray
+		[[nodiscard]] std::optional<RayHit> RayCast(MauCor::Ray const& ray, float maxDistance) const;
+		// All leaves hit by the ray, unsorted
+		void RayCastAll(MauCor::Ray const& ray, float maxDistance, std::vector<RayHit>& hits) const;
+
+		[[nodiscard]] uint32_t GetUserData(uint32_t proxyID) const noexcept { return m_Nodes[proxyID].userData; }
+		[[nodiscard]] MauCor::AABB const& GetFatBounds(uint32_t proxyID) const noexcept { return m_Nodes[proxyID].bounds; }
+
+		[[nodiscard]] uint32_t ProxyCount() const noexcept { return m_ProxyCount; }
+		[[nodiscard]] int32_t GetHeight() const noexcept { return NULL_NODE == m_Root ? 0 : m_Nodes[m_Root].height; }
+
+		// Checks the links, heights & bounds of every node, for tests & debugging
+		[[nodiscard]] bool Validate() const noexcept;
+
+		DynamicAABBTree(DynamicAABBTree const&) = delete;
+		DynamicAABBTree(DynamicAABBTree&&) = default;
+		DynamicAABBTree& operator=(DynamicAABBTree const&) = delete;
+		DynamicAABBTree& operator=(DynamicAABBTree&&) = default;
+
+	private:
+		static uint32_t constexpr NULL_NODE{ UINT32_MAX };
+
+		struct Node final
+		{
+			MauCor::AABB bounds{};
+
+			// Next free node while the node is in the free list
+			uint32_t parent{ NULL_NODE };
+			uint32_t child1{ NULL_NODE };
+			uint32_t child2{ NULL_NODE };
+			uint32_t userData{};
+
+			// Leaf = 0, free node = -1
+			int32_t height{ -1 };
+
+			[[nodiscard]] bool IsLeaf() const noexcept { return NULL_NODE == child1; }
+		};
+
+		std::vector<Node> m_Nodes{};
+		uint32_t m_Root{ NULL_NODE };
+		uint32_t m_FreeList{ NULL_NODE };
+		uint32_t m_ProxyCount{ 0 };
+
+		float m_Margin;
+
+		[[nodiscard]] uint32_t AllocateNode();
+		void FreeNode(uint32_t nodeID) noexcept;
+
+		void InsertLeaf(uint32_t leaf);
+		void RemoveLeaf(uint32_t leaf) noexcept;
+
+		// Walks up from the node, rebalancing & refitting every ancestor
+		void Refit(uint32_t nodeID) noexcept;
+		[[nodiscard]] uint32_t Balance(uint32_t nodeID) noexcept;
+
+		[[nodiscard]] uint32_t BuildRange(std::span<ProxyInput const> proxies, std::span<glm::vec3 const> centroids, std::span<uint32_t> order,
+			uint32_t begin, uint32_t end, uint32_t parallelDepth);
+
+		void AddLeaves(uint32_t nodeID, std::vector<uint32_t>& results, std::vector<uint32_t>& stack) const;
+	};
+}
+
+#endif
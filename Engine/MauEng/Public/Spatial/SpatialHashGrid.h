@@ -0,0 +1,199 @@
+#ifndef MAUENG_SPATIALHASHGRID_H
+#define MAUENG_SPATIALHASHGRID_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math/BoundingVolumes.h"
+
+#include "../../ECS/Public/EntityID.h"
+
+namespace MauEng
+{
+	namespace ECS
+	{
+		class ECSWorld;
+	}
+
+	/*
+	 * Uniform grid of points, hashed so the world size is unbounded.
+	 * Meant for very large amounts of small moving entities: there is no incremental update,
+	 * the grid is rebuilt every frame with a parallel counting sort of the points on their cell.
+	 * After a rebuild all points of a bucket are packed together, queries only visit the buckets of the overlapped cells.
+	 */
+	class SpatialHashGrid final
+	{
+	public:
+		explicit SpatialHashGrid(float cellSize = 4.f) noexcept
+			: m_CellSize{ cellSize }, m_InvCellSize{ 1.f / cellSize } {}
+		~SpatialHashGrid() = default;
+
+		// Rebuild from the translation of every entity with a CTransform
+		void Rebuild(ECS::ECSWorld& world);
+		// Rebuild from a custom set of points, entities[i] is located at positions[i]
+		void Rebuild(std::span<glm::vec3 const> positions, std::span<ECS::EntityID const> entities);
+
+		void Clear() noexcept;
+
+		/**
+		 * @brief Invoke func(entity, position) for every point inside the range.
+		 * @param range bounds to search in.
+		 * @param func function to call for every point.
+		 */
+		template<typename Func>
+		void ForEachInRange(MauCor::AABB const& range, Func&& func) const
+		{
+			if (m_Entities.empty())
+			{
+				return;
+			}
+
+			ForEachCandidateBucket(range, [&](uint32_t bucket)
+				{
+					for (uint32_t idx{ m_BucketStart[bucket] }; idx < m_BucketStart[bucket + 1]; ++idx)
+					{
+						glm::vec3 const& position{ m_Positions[idx] };
+						if (glm::all(glm::lessThanEqual(range.min, position)) && glm::all(glm::lessThanEqual(position, range.max)))
+						{
+							func(m_Entities[idx], position);
+						}
+					}
+				});
+		}
+
+		/**
+		 * @brief Invoke func(entity, position) for every point within the radius.
+		 * @param center center of the search sphere.
+		 * @param radius radius of the search sphere.
+		 * @param func function to call for every point.
+		 */
+		template<typename Func>
+		void ForEachInRadius(glm::vec3 const& center, float radius, Func&& func) const
+		{
+			float const radiusSq{ radius * radius };
+			ForEachInRange({ center - glm::vec3{ radius }, center + glm::vec3{ radius } }, [&](ECS::EntityID entity, glm::vec3 const& position)
+				{
+					glm::vec3 const delta{ position - center };
+					if (glm::dot(delta, delta) <= radiusSq)
+					{
+						func(entity, position);
+					}
+				});
+		}
+
+		void QueryRange(MauCor::AABB const& range, std::vector<ECS::EntityID>& results) const;
+		void QueryRadius(glm::vec3 const& center, float radius, std::vector<ECS::EntityID>& results) const;
+		// Entities in the cell of the position & the 26 cells around it
+		void QueryNeighbors(glm::vec3 const& position, std::vector<ECS::EntityID>& results) const;
+		// Culls the points as spheres of the given radius, the points are tested in parallel
+		void QueryFrustum(MauCor::Frustum const& frustum, float pointRadius, std::vector<ECS::EntityID>& results) const;
+
+		[[nodiscard]] float GetCellSize() const noexcept { return m_CellSize; }
+		[[nodiscard]] uint32_t BucketCount() const noexcept { return static_cast<uint32_t>(m_BucketStart.empty() ? 0 : m_BucketStart.size() - 1); }
+		[[nodiscard]] uint32_t EntityCount() const noexcept { return static_cast<uint32_t>(m_Entities.size()); }
+
+		SpatialHashGrid(SpatialHashGrid const&) = delete;
+		SpatialHashGrid(SpatialHashGrid&&) = default;
+		SpatialHashGrid& operator=(SpatialHashGrid const&) = delete;
+		SpatialHashGrid& operator=(SpatialHashGrid&&) = default;
+
+	private:
+		static uint32_t constexpr MIN_BUCKET_COUNT{ 1'024 };
+
+		// Rebuild first partitions the points on the high bits of their bucket, then sorts every partition on its own
+		static uint32_t constexpr PARTITION_BITS{ 8 };
+		static uint32_t constexpr PARTITION_COUNT{ 1 << PARTITION_BITS };
+		static uint32_t constexpr CHUNK_SIZE{ 16'384 };
+
+		struct Chunk final
+		{
+			uint32_t begin{};
+			uint32_t end{};
+			// Partition sizes of the chunk, then the write offset of the chunk in every partition
+			std::array<uint32_t, PARTITION_COUNT> offsets{};
+		};
+
+		// Carries the point itself, sorting a partition then never touches the input again
+		struct PartitionedPoint final
+		{
+			glm::vec3 position{};
+			ECS::EntityID entity{};
+			uint32_t bucket{};
+		};
+
+		float m_CellSize;
+		float m_InvCellSize;
+
+		// Bucket b holds the points [m_BucketStart[b], m_BucketStart[b + 1]), power of 2 buckets
+		std::vector<uint32_t> m_BucketStart{};
+		std::vector<glm::vec3> m_Positions{};
+		std::vector<ECS::EntityID> m_Entities{};
+
+		// Rebuild scratch buffers, kept to avoid allocating every frame
+		std::vector<uint32_t> m_PointBuckets{};
+		std::vector<PartitionedPoint> m_Partitioned{};
+		std::vector<Chunk> m_Chunks{};
+		std::vector<uint32_t> m_PartitionStart{};
+		std::vector<glm::vec3> m_GatheredPositions{};
+		std::vector<ECS::EntityID> m_GatheredEntities{};
+
+		[[nodiscard]] glm::ivec3 CellOf(glm::vec3 const& position) const noexcept
+		{
+			return glm::ivec3{ glm::floor(position * m_InvCellSize) };
+		}
+
+		[[nodiscard]] uint32_t HashCell(glm::ivec3 const& cell) const noexcept
+		{
+			uint32_t const hash{ (static_cast<uint32_t>(cell.x) * 73'856'093u) ^ (static_cast<uint32_t>(cell.y) * 19'349'663u) ^ (static_cast<uint32_t>(cell.z) * 83'492'791u) };
+			return hash & (BucketCount() - 1);
+		}
+
+		// Visits every bucket that can hold points of the range once, several cells can map to the same bucket
+		template<typename Func>
+		void ForEachCandidateBucket(MauCor::AABB const& range, Func&& func) const
+		{
+			glm::ivec3 const minCell{ CellOf(range.min) };
+			glm::ivec3 const maxCell{ CellOf(range.max) };
+
+			glm::i64vec3 const cellCounts{ glm::i64vec3{ maxCell - minCell } + glm::i64vec3{ 1 } };
+			int64_t const cellCount{ cellCounts.x * cellCounts.y * cellCounts.z };
+
+			// Range covers more cells than there are buckets, visiting every bucket is cheaper
+			if (cellCount >= BucketCount())
+			{
+				for (uint32_t bucket{ 0 }; bucket < BucketCount(); ++bucket)
+				{
+					func(bucket);
+				}
+				return;
+			}
+
+			std::vector<uint32_t> buckets{};
+			buckets.reserve(static_cast<std::size_t>(cellCount));
+
+			for (int32_t z{ minCell.z }; z <= maxCell.z; ++z)
+			{
+				for (int32_t y{ minCell.y }; y <= maxCell.y; ++y)
+				{
+					for (int32_t x{ minCell.x }; x <= maxCell.x; ++x)
+					{
+						buckets.emplace_back(HashCell({ x, y, z }));
+					}
+				}
+			}
+
+			std::ranges::sort(buckets);
+			auto const duplicates{ std::ranges::unique(buckets) };
+
+			for (auto it{ buckets.begin() }; it != duplicates.begin(); ++it)
+			{
+				func(*it);
+			}
+		}
+	};
+}
+
+#endif
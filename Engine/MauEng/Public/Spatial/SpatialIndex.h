@@ -0,0 +1,83 @@
+#ifndef MAUENG_SPATIALINDEX_H
+#define MAUENG_SPATIALINDEX_H
+
+#include "DynamicAABBTree.h"
+
+#include "../../ECS/Public/EntityID.h"
+
+namespace MauEng
+{
+	namespace ECS
+	{
+		class ECSWorld;
+	}
+
+	struct CTransform;
+	struct CStaticMesh;
+
+	/*
+	 * Spatial index over every entity with a CTransform & CStaticMesh, used for culling, picking & proximity queries.
+	 * Update only touches entities that are new or have a dirty transform, destroyed entities are detected from the entity count.
+	 * Queries return entity ids, the world bounds of the mesh are tested (with a small margin).
+	 */
+	class SpatialIndex final
+	{
+	public:
+		explicit SpatialIndex(float margin = .5f) noexcept
+			: m_Tree{ margin } {}
+		~SpatialIndex() = default;
+
+		// Sync with the world, updates the matrices of the moved transforms
+		void Update(ECS::ECSWorld& world);
+		void Clear() noexcept;
+
+		void QueryAABB(MauCor::AABB const& bounds, std::vector<ECS::EntityID>& results) const { m_Tree.QueryAABB(bounds, results); }
+		void QuerySphere(MauCor::Sphere const& sphere, std::vector<ECS::EntityID>& results) const { m_Tree.QuerySphere(sphere, results); }
+		void QueryFrustum(MauCor::Frustum const& frustum, std::vector<ECS::EntityID>& results) const { m_Tree.QueryFrustum(frustum, results); }
+
+		// Closest entity hit by the ray, RayHit::userData is the entity id
+		[[nodiscard]] std::optional<RayHit> RayCast(MauCor::Ray const& ray, float maxDistance) const { return m_Tree.RayCast(ray, maxDistance); }
+
+		[[nodiscard]] uint32_t EntityCount() const noexcept { return m_Tree.ProxyCount(); }
+		[[nodiscard]] DynamicAABBTree const& GetTree() const noexcept { return m_Tree; }
+
+		SpatialIndex(SpatialIndex const&) = delete;
+		SpatialIndex(SpatialIndex&&) = delete;
+		SpatialIndex& operator=(SpatialIndex const&) = delete;
+		SpatialIndex& operator=(SpatialIndex&&) = delete;
+
+	private:
+		// Worlds with this many new entities at once on an empty index are bulk built
+		static uint32_t constexpr BULK_BUILD_THRESHOLD{ 1'024 };
+
+		struct TrackedEntity final
+		{
+			ECS::EntityID id{ ECS::NULL_ENTITY_ID };
+			uint32_t proxyID{ INVALID_PROXY_ID };
+			uint32_t lastSeenUpdate{ 0 };
+		};
+
+		struct PendingEntity final
+		{
+			ECS::EntityID id{};
+			CTransform* pTransform{ nullptr };
+			CStaticMesh const* pMesh{ nullptr };
+			MauCor::AABB bounds{};
+			bool isNew{ false };
+		};
+
+		DynamicAABBTree m_Tree;
+
+		// Indexed by the entity index
+		std::vector<TrackedEntity> m_Tracked{};
+		std::vector<PendingEntity> m_Pending{};
+
+		uint32_t m_TrackedCount{ 0 };
+		uint32_t m_UpdateCount{ 0 };
+
+		void ApplyPending();
+		void RemoveUnseen() noexcept;
+	};
+}
+
+#endif
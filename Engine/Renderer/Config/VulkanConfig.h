@@ -34,6 +34,9 @@ namespace MauRen
 	uint32_t constexpr MAX_FRAMES_IN_FLIGHT{ 3 };
 	static_assert(MAX_FRAMES_IN_FLIGHT > 0);
 
+	// GPU profile scopes per frame (USE_GPU_PROFILER), each takes 2 timestamp queries
+	uint32_t constexpr MAX_GPU_PROFILE_SCOPES{ 64 };
+
 	// The descriptor pool creation will throw if this number is too large
 	uint32_t constexpr MAX_TEXTURES{ 4'048 };			// For texture array
 
@@ -49,6 +52,10 @@ namespace MauRen
 	uint32_t constexpr MAX_INDICES{ 20'000'000 };       // Maximum number of indices (for all meshes)
 
 	bool constexpr DEBUG_OUT_MAT{ true };
+
+	// Compares the matrices built by the transform compute shader with the CPU path once the frame is done, logs mismatches
+	// Slow, meant to be run on a software device (e.g. lavapipe) to check the shader
+	bool constexpr VALIDATE_GPU_TRANSFORMS{ false };
 }
 
 #endif // MAUREN_VULKANCONFIG_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define MAUREN_BINDLESS_DATA_H
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include "RendererIdentifiers.h"
 
@@ -33,6 +34,8 @@ namespace MauRen
     struct alignas(16) MeshInstanceData final
     {
         glm::mat4 modelMatrix;
+        // transpose(inverse(mat3(modelMatrix))), a GLSL mat3 in a buffer pads every column to a vec4
+        glm::mat3x4 normalMatrix;
         uint32_t subMeshID;     // Index into SubMeshData[]
         uint32_t materialID;  // Material for this submesh
 
@@ -40,6 +43,29 @@ namespace MauRen
         uint32_t flags;         // Flags for deletion or active status (E.g 0 = active, 1 = marked for deletion)
         uint32_t objectID;      // Optional: ID for selection/debug
     };
+    static_assert(sizeof(MeshInstanceData) == 128);
+
+    // (CPU only)
+    // Compact transform of a queued instance, used instead of the model matrix when USE_GPU_TRANSFORMS is on
+    struct InstanceTransform final
+    {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+    };
+
+    // (GPU-side resource - CPU copy)
+    // Input of the transform compute shader, it writes the MeshInstanceData with the same index
+    struct alignas(16) InstanceTransformData final
+    {
+        glm::vec4 rotation;     // Quaternion, xyzw (independent of the glm::quat layout)
+        glm::vec3 translation;
+        uint32_t subMeshID;
+        glm::vec3 scale;
+        uint32_t materialID;
+        // flags & objectID are not used yet, the shader writes 0
+    };
+    static_assert(sizeof(InstanceTransformData) == 48);
 
     // Per mesh data - on CPU only currently
     struct MeshData final
@@ -3,9 +3,12 @@
 
 #include "RendererIdentifiers.h"
 
+#include "../../MauEng/Public/Components/CInstanceBatch.h"
+
 namespace MauEng
 {
 	struct CStaticMesh;
+	struct CTransform;
 }
 
 namespace MauRen
@@ -22,16 +25,29 @@ namespace MauRen
 		virtual void Init() override {}
 		virtual void Destroy() override {}
 
-		virtual void Render(glm::mat4 const&, glm::mat4 const&) override {}
+		// Only counts the queued instances
+		virtual void Render(glm::mat4 const&, glm::mat4 const&) override
+		{
+			m_InstanceCount = m_QueuedCount;
+			m_QueuedCount = 0;
+		}
 		virtual void ResizeWindow() override {}
 
-		virtual void QueueDraw(glm::mat4 const&, MauEng::CStaticMesh const&) override {}
+		virtual void QueueDraw(MauEng::CTransform const&, MauEng::CStaticMesh const&) override { ++m_QueuedCount; }
+		virtual void QueueDraw(MauEng::CInstanceBatch const& batch) override { m_QueuedCount += batch.Count(); }
 		virtual uint32_t LoadOrGetMeshID(char const*) override { return INVALID_MESH_ID; }
+		virtual MauCor::AABB GetMeshBounds(uint32_t) override { return {}; }
+		virtual uint64_t GetGPUWaitTicks() const noexcept override { return 0; }
+		virtual uint32_t GetInstanceCount() const noexcept override { return m_InstanceCount; }
 
 		NullRenderer(NullRenderer const&) = delete;
 		NullRenderer(NullRenderer&&) = delete;
 		NullRenderer& operator=(NullRenderer const&) = delete;
 		NullRenderer& operator=(NullRenderer&&) = delete;
+
+	private:
+		uint32_t m_QueuedCount{ 0 };
+		uint32_t m_InstanceCount{ 0 };
 	};
 }
 
@@ -0,0 +1,86 @@
+#include "RendererPCH.h"
+
+#include "RenderSnapshot.h"
+
+namespace MauRen
+{
+	void RenderSnapshotBuffer::Publish()
+	{
+		ME_PROFILE_FUNCTION()
+
+		{
+			std::unique_lock lock{ m_Mutex };
+
+			// Bounded latency, wait until the reader picked up the previous snapshot
+			m_CV.wait(lock, [this] { return !m_HasReady || m_IsStopped; });
+
+			std::swap(m_WriteIndex, m_ReadyIndex);
+			m_HasReady = true;
+		}
+
+		m_CV.notify_all();
+
+		// The new write slot was released by the reader, reuse its capacity
+		m_Snapshots[m_WriteIndex].Clear();
+	}
+
+	RenderSnapshot const* RenderSnapshotBuffer::AcquireRead(std::stop_token const& stopToken)
+	{
+		ME_PROFILE_FUNCTION()
+
+		std::unique_lock lock{ m_Mutex };
+		ME_RENDERER_ASSERT(!m_IsReading);
+
+		if (!m_CV.wait(lock, stopToken, [this] { return m_HasReady; }))
+		{
+			return nullptr;
+		}
+
+		std::swap(m_ReadyIndex, m_ReadIndex);
+		m_HasReady = false;
+		m_IsReading = true;
+
+		lock.unlock();
+		m_CV.notify_all();
+
+		return &m_Snapshots[m_ReadIndex];
+	}
+
+	RenderSnapshot const* RenderSnapshotBuffer::TryAcquireRead()
+	{
+		std::unique_lock lock{ m_Mutex };
+		ME_RENDERER_ASSERT(!m_IsReading);
+
+		if (!m_HasReady)
+		{
+			return nullptr;
+		}
+
+		std::swap(m_ReadyIndex, m_ReadIndex);
+		m_HasReady = false;
+		m_IsReading = true;
+
+		lock.unlock();
+		m_CV.notify_all();
+
+		return &m_Snapshots[m_ReadIndex];
+	}
+
+	void RenderSnapshotBuffer::ReleaseRead()
+	{
+		std::scoped_lock lock{ m_Mutex };
+		ME_RENDERER_ASSERT(m_IsReading);
+
+		m_IsReading = false;
+	}
+
+	void RenderSnapshotBuffer::Stop()
+	{
+		{
+			std::scoped_lock lock{ m_Mutex };
+			m_IsStopped = true;
+		}
+
+		m_CV.notify_all();
+	}
+}
@@ -0,0 +1,115 @@
+#ifndef MAUREN_RENDERSNAPSHOT_H
+#define MAUREN_RENDERSNAPSHOT_H
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+
+#include "DebugRenderer/DebugVertex.h"
+#include "Assets/BindlessData.h"
+
+namespace MauRen
+{
+	// A single queued draw, recorded on the game thread
+	struct RenderInstance final
+	{
+		glm::mat4 transform;
+		uint32_t meshID;
+	};
+
+	// RenderInstance with the compact transform, used instead when USE_GPU_TRANSFORMS is on
+	struct RenderTransformInstance final
+	{
+		InstanceTransform transform;
+		uint32_t meshID;
+	};
+
+	// Instances of one mesh queued as a block, the transforms are in RenderSnapshot::batchTransforms (or batchInstanceTransforms)
+	struct RenderInstanceBatch final
+	{
+		uint32_t meshID;
+		uint32_t firstTransform;
+		uint32_t count;
+	};
+
+	// Everything the render thread needs to record a frame, it is never modified while the render thread reads it
+	struct RenderSnapshot final
+	{
+		glm::mat4 view{ 1.f };
+		glm::mat4 proj{ 1.f };
+
+		std::vector<RenderInstance> instances;
+		std::vector<RenderTransformInstance> transformInstances;
+
+		std::vector<RenderInstanceBatch> batches;
+		std::vector<glm::mat4> batchTransforms;
+		std::vector<InstanceTransform> batchInstanceTransforms;
+
+		std::vector<DebugVertex> debugVertices;
+		std::vector<uint32_t> debugIndices;
+
+		// Clears all data but keeps the capacity so the next frame does not have to reallocate
+		void Clear() noexcept
+		{
+			instances.clear();
+			transformInstances.clear();
+			batches.clear();
+			batchTransforms.clear();
+			batchInstanceTransforms.clear();
+			debugVertices.clear();
+			debugIndices.clear();
+		}
+	};
+
+	/*
+	 * Triple buffered snapshot storage shared by the game thread (writer) and the render thread (reader).
+	 * One slot is written, one is ready to be picked up and one is being rendered.
+	 * Publishing blocks while the previously published snapshot was not picked up yet.
+	 * While the reader renders frame N, frame N + 1 can be waiting & the game thread records N + 2, so it runs at most two frames ahead.
+	 */
+	class RenderSnapshotBuffer final
+	{
+	public:
+		RenderSnapshotBuffer() = default;
+		~RenderSnapshotBuffer() = default;
+
+		// Snapshot the game thread is currently recording into
+		[[nodiscard]] RenderSnapshot& GetWriteSnapshot() noexcept { return m_Snapshots[m_WriteIndex]; }
+
+		// Hand the write snapshot over to the reader & start a new (cleared) write snapshot
+		void Publish();
+
+		// Blocks until a snapshot is published, returns nullptr when a stop was requested
+		[[nodiscard]] RenderSnapshot const* AcquireRead(std::stop_token const& stopToken);
+		// Non blocking version, returns nullptr if nothing was published
+		[[nodiscard]] RenderSnapshot const* TryAcquireRead();
+		// Must be called once the reader is done with the acquired snapshot
+		void ReleaseRead();
+
+		// Wake up any waiting writer, used when shutting down the reader
+		void Stop();
+
+		RenderSnapshotBuffer(RenderSnapshotBuffer const&) = delete;
+		RenderSnapshotBuffer(RenderSnapshotBuffer&&) = delete;
+		RenderSnapshotBuffer& operator=(RenderSnapshotBuffer const&) = delete;
+		RenderSnapshotBuffer& operator=(RenderSnapshotBuffer&&) = delete;
+
+	private:
+		std::array<RenderSnapshot, 3> m_Snapshots{};
+
+		uint32_t m_WriteIndex{ 0 };
+		uint32_t m_ReadyIndex{ 1 };
+		uint32_t m_ReadIndex{ 2 };
+
+		bool m_HasReady{ false };
+		bool m_IsReading{ false };
+		bool m_IsStopped{ false };
+
+		std::mutex m_Mutex{};
+		std::condition_variable_any m_CV{};
+	};
+}
+
+#endif
@@ -2,6 +2,8 @@
 
 #include "../VulkanCommandPoolManager.h"
 
+#include "Memory/MemoryTracker.h"
+
 namespace MauRen
 {
 	void VulkanImage::Destroy()
@@ -11,7 +13,10 @@ namespace MauRen
 		DestroyAllImageViews();
 
 		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), image, nullptr);
-		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), imageMemory, nullptr);
+		if (VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), imageMemory, nullptr))
+		{
+			MauCor::TrackGPUFree(memoryTypeIndex, allocationSize);
+		}
 	}
 
 	void VulkanImage::TransitionImageLayout(VulkanCommandPoolManager const& CmdPoolManager, VkImageLayout newLayout)
@@ -327,6 +332,10 @@ namespace MauRen
 			throw std::runtime_error("Failed to allocate image memory!");
 		}
 
+		allocationSize = allocInfo.allocationSize;
+		memoryTypeIndex = allocInfo.memoryTypeIndex;
+		MauCor::TrackGPUAllocation(memoryTypeIndex, allocationSize);
+
 		vkBindImageMemory(deviceContext->GetLogicalDevice(), image, imageMemory, 0);
 	}
 }
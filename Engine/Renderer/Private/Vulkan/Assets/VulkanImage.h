@@ -12,6 +12,9 @@ namespace MauRen
 	{
 		VkImage image{ VK_NULL_HANDLE };
 		VkDeviceMemory imageMemory{ VK_NULL_HANDLE };
+		// Of imageMemory, counted by the memory tracker
+		VkDeviceSize allocationSize{ 0 };
+		uint32_t memoryTypeIndex{ 0 };
 		VkFormat format{ VK_FORMAT_UNDEFINED };
 		VkImageLayout layout{ VK_IMAGE_LAYOUT_UNDEFINED };
 
@@ -1,11 +1,15 @@
 #include "VulkanMeshManager.h"
 
+#include <algorithm>
+#include <execution>
+
 #include "MeshInstance.h"
 #include "RendererIdentifiers.h"
 #include "../VulkanDeviceContextManager.h"
 #include "VulkanMaterialManager.h"
 
 #include "Assets/ModelLoader.h"
+#include "Math/NormalMatrix.h"
 
 namespace MauRen
 {
@@ -13,12 +17,19 @@ namespace MauRen
 	{
 		m_CmdPoolManager = CmdPoolManager;
 
-		m_MeshData.reserve(MAX_MESHES);
+		m_Meshes.Reserve(MAX_MESHES);
+		m_MeshBounds.reserve(MAX_MESHES);
 		m_SubMeshes.reserve(MAX_MESHES);
 
 		m_MeshInstanceDataBuffers.reserve(MAX_MESH_INSTANCES);
 		InitializeMeshInstanceDataBuffers();
 
+		if constexpr (MauEng::USE_GPU_TRANSFORMS)
+		{
+			InitializeInstanceTransformBuffers();
+			m_ValidationTransforms.resize(MAX_FRAMES_IN_FLIGHT);
+		}
+
 		m_DrawCommands.reserve(MAX_DRAW_COMMANDS);
 		InitializeDrawCommandBuffers();
 
@@ -45,6 +56,11 @@ namespace MauRen
 			m.buffer.Destroy();
 		}
 
+		for (auto& t : m_InstanceTransformBuffers)
+		{
+			t.buffer.Destroy();
+		}
+
 		return true;
 	}
 
@@ -53,10 +69,9 @@ namespace MauRen
 	{
 		ME_PROFILE_FUNCTION()
 
-		if (auto it{ m_LoadedMeshes_Path.find(path) }; it != m_LoadedMeshes_Path.end())
+		if (auto const it{ m_MeshIDsByPath.find(path) }; it != m_MeshIDsByPath.end())
 		{
-			const auto& data{ m_MeshData[it->second] };
-			return data.meshID;
+			return it->second;
 		}
 
 		LoadedModel const loadedModel{ ModelLoader::LoadModel({ path }, cmdPoolManager, descriptorContext) };
@@ -64,7 +79,6 @@ namespace MauRen
 		ME_RENDERER_ASSERT(m_CurrentIndexOffset + loadedModel.indices.size() <= MAX_INDICES);
 
 		MeshData meshData;
-		meshData.meshID = m_NextID;
 		meshData.firstSubMesh = m_SubMeshes.size();
 		meshData.subMeshCount = loadedModel.subMeshes.size();
 
@@ -97,30 +111,113 @@ namespace MauRen
 		m_CurrentVertexOffset += static_cast<uint32_t>(loadedModel.vertices.size());
 		m_CurrentIndexOffset += static_cast<uint32_t>(loadedModel.indices.size());
 
-		m_LoadedMeshes[m_NextID] = static_cast<uint32_t>(m_MeshData.size());
-		m_LoadedMeshes_Path[path] = static_cast<uint32_t>(m_MeshData.size());
+		MauCor::AABB bounds{ MauCor::AABB::Empty() };
+		for (auto const& vertex : loadedModel.vertices)
+		{
+			bounds.Merge(vertex.position);
+		}
+
+		uint32_t const meshID{ m_Meshes.Emplace(std::move(meshData)) };
+		m_Meshes.Get(meshID).meshID = meshID;
+
+		uint32_t const slot{ decltype(m_Meshes)::Handle::Index(meshID) };
+		if (slot >= m_MeshBounds.size())
+		{
+			m_MeshBounds.resize(slot + 1);
+		}
+		m_MeshBounds[slot] = loadedModel.vertices.empty() ? MauCor::AABB{} : bounds;
 
-		m_MeshData.emplace_back(std::move(meshData));
+		m_MeshIDsByPath.emplace(path, meshID);
 
-		return m_NextID++;
+		return meshID;
 	}
 
 	MeshData const& VulkanMeshManager::GetMeshData(uint32_t meshID) const
 	{
-		auto const it{ m_LoadedMeshes.find(meshID) };
+		ME_RENDERER_ASSERT(m_Meshes.IsValid(meshID), "Mesh not found in VulkanMeshManager");
 
-		ME_RENDERER_ASSERT(it != end(m_LoadedMeshes), "Mesh not found in VulkanMeshManager");
+		if (auto const* pMeshData{ m_Meshes.TryGet(meshID) })
+		{
+			return *pMeshData;
+		}
 
-		if (it != m_LoadedMeshes.end())
+		throw std::runtime_error("Mesh not found! ");
+	}
+
+	MauCor::AABB const& VulkanMeshManager::GetMeshBounds(uint32_t meshID) const
+	{
+		ME_RENDERER_ASSERT(m_Meshes.IsValid(meshID), "Mesh not found in VulkanMeshManager");
+
+		if (m_Meshes.IsValid(meshID))
 		{
-			return m_MeshData[it->second];
+			return m_MeshBounds[decltype(m_Meshes)::Handle::Index(meshID)];
 		}
 
 		throw std::runtime_error("Mesh not found! ");
 	}
 
+	void VulkanMeshManager::QueueDrawBatch(uint32_t meshID, std::span<glm::mat4 const> transforms) noexcept
+	{
+		QueueBatch(m_MeshInstanceData, meshID, transforms,
+			[](glm::mat4 const& transform, uint32_t sub, SubMeshData const& subMesh, MeshData const& meshData)
+			{
+				return MeshInstanceData{ transform, ToNormalMatrix(transform), sub, subMesh.materialID, meshData.flags };
+			});
+	}
+
+	void VulkanMeshManager::QueueDrawBatch(uint32_t meshID, std::span<InstanceTransform const> transforms) noexcept
+	{
+		QueueBatch(m_InstanceTransforms, meshID, transforms,
+			[](InstanceTransform const& transform, uint32_t sub, SubMeshData const& subMesh, MeshData const&)
+			{
+				return ToTransformData(transform, sub, subMesh.materialID);
+			});
+	}
+
+	template<typename InstanceType, typename TransformType, typename MakeInstanceFunc>
+	void VulkanMeshManager::QueueBatch(std::vector<InstanceType>& instances, uint32_t meshID, std::span<TransformType const> transforms, MakeInstanceFunc const& makeInstance) noexcept
+	{
+		ME_PROFILE_FUNCTION()
+
+		auto const& meshData{ m_Meshes.Get(meshID) };
+		auto const count{ static_cast<uint32_t>(transforms.size()) };
+
+		for (uint32_t sub{ meshData.firstSubMesh }; sub < meshData.firstSubMesh + meshData.subMeshCount; ++sub)
+		{
+			auto const& subMesh{ m_SubMeshes[sub] };
+
+			auto const instanceOffset{ static_cast<uint32_t>(instances.size()) };
+			ME_RENDERER_ASSERT(instanceOffset + count <= MAX_MESH_INSTANCES);
+
+			instances.resize(instanceOffset + count);
+			std::transform(std::execution::par_unseq, transforms.begin(), transforms.end(), instances.begin() + instanceOffset,
+				[&](TransformType const& transform)
+				{
+					return makeInstance(transform, sub, subMesh, meshData);
+				});
+
+			// Not merged with the batched draw command of the submesh, the instances of a draw command have to be contiguous
+			ME_RENDERER_ASSERT(m_DrawCommands.size() < MAX_DRAW_COMMANDS);
+			m_DrawCommands.emplace_back(subMesh.indexCount, count, subMesh.firstIndex, subMesh.vertexOffset, instanceOffset);
+		}
+	}
+
 	void VulkanMeshManager::PreDraw(VkCommandBuffer commandBuffer, VkPipelineLayout layout, uint32_t setCount, VkDescriptorSet const* pDescriptorSets, uint32_t frame)
 	{
+		if constexpr (MauEng::USE_GPU_TRANSFORMS)
+		{
+			ME_PROFILE_SCOPE("Instance transform update - buffer")
+
+			if constexpr (VALIDATE_GPU_TRANSFORMS)
+			{
+				// The fence of this frame was waited on, the output of the last time it was rendered can be read
+				ValidateTransforms(frame);
+				m_ValidationTransforms[frame] = m_InstanceTransforms;
+			}
+
+			memcpy(m_InstanceTransformBuffers[frame].mapped, m_InstanceTransforms.data(), m_InstanceTransforms.size() * sizeof(InstanceTransformData));
+		}
+		else
 		{
 			ME_PROFILE_SCOPE("Mesh instance data update - buffer")
 
@@ -140,7 +237,7 @@ namespace MauRen
 			VkDescriptorBufferInfo bufferInfo = {};
 			bufferInfo.buffer = m_MeshInstanceDataBuffers[frame].buffer.buffer;
 			bufferInfo.offset = 0;
-			bufferInfo.range = m_MeshInstanceData.size() * sizeof(MeshInstanceData);
+			bufferInfo.range = InstanceCount() * sizeof(MeshInstanceData);
 
 			VkWriteDescriptorSet descriptorWrite = {};
 			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -152,6 +249,137 @@ namespace MauRen
 			descriptorWrite.pBufferInfo = &bufferInfo;
 
 			vkUpdateDescriptorSets(deviceContext->GetLogicalDevice(), 1, &descriptorWrite, 0, nullptr);
+
+			if constexpr (MauEng::USE_GPU_TRANSFORMS)
+			{
+				VkDescriptorBufferInfo transformBufferInfo{};
+				transformBufferInfo.buffer = m_InstanceTransformBuffers[frame].buffer.buffer;
+				transformBufferInfo.offset = 0;
+				transformBufferInfo.range = VK_WHOLE_SIZE;
+
+				descriptorWrite.dstBinding = 6;
+				descriptorWrite.pBufferInfo = &transformBufferInfo;
+
+				vkUpdateDescriptorSets(deviceContext->GetLogicalDevice(), 1, &descriptorWrite, 0, nullptr);
+			}
+		}
+	}
+
+	void VulkanMeshManager::BuildTransforms(VkCommandBuffer commandBuffer, VkPipeline pipeline, VkPipelineLayout layout, uint32_t setCount, VkDescriptorSet const* pDescriptorSets, uint32_t frame)
+	{
+		ME_PROFILE_FUNCTION()
+
+		uint32_t const instanceCount{ InstanceCount() };
+		if (0 == instanceCount)
+		{
+			return;
+		}
+
+		uint32_t constexpr GROUP_SIZE{ 64 }; // Matches local_size_x in transforms.comp
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, layout, 0, setCount, pDescriptorSets, 0, nullptr);
+		vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t), &instanceCount);
+		vkCmdDispatch(commandBuffer, (instanceCount + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+
+		// The vertex shaders of both passes read what the compute shader wrote
+		VkBufferMemoryBarrier2 barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+		barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+		barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+		barrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+		barrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+		if constexpr (VALIDATE_GPU_TRANSFORMS)
+		{
+			barrier.dstStageMask |= VK_PIPELINE_STAGE_2_HOST_BIT;
+			barrier.dstAccessMask |= VK_ACCESS_2_HOST_READ_BIT;
+		}
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer = m_MeshInstanceDataBuffers[frame].buffer.buffer;
+		barrier.offset = 0;
+		barrier.size = instanceCount * sizeof(MeshInstanceData);
+
+		VkDependencyInfo dependencyInfo{};
+		dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+		dependencyInfo.bufferMemoryBarrierCount = 1;
+		dependencyInfo.pBufferMemoryBarriers = &barrier;
+
+		vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+	}
+
+	glm::mat4 VulkanMeshManager::ToModelMatrix(InstanceTransform const& transform) noexcept
+	{
+		// translate * rotate * scale, like CTransform
+		glm::mat3 const rotation{ glm::mat3_cast(transform.rotation) };
+
+		glm::mat4 model{ 1.f };
+		model[0] = glm::vec4{ rotation[0] * transform.scale.x, 0.f };
+		model[1] = glm::vec4{ rotation[1] * transform.scale.y, 0.f };
+		model[2] = glm::vec4{ rotation[2] * transform.scale.z, 0.f };
+		model[3] = glm::vec4{ transform.translation, 1.f };
+
+		return model;
+	}
+
+	glm::mat3x4 VulkanMeshManager::ToNormalMatrix(glm::mat4 const& modelMatrix) noexcept
+	{
+		// Columns padded to vec4 for the std430 layout
+		glm::mat3 const normal{ MauCor::NormalMatrix(modelMatrix) };
+		return glm::mat3x4{ glm::vec4{ normal[0], 0.f }, glm::vec4{ normal[1], 0.f }, glm::vec4{ normal[2], 0.f } };
+	}
+
+	void VulkanMeshManager::ValidateTransforms(uint32_t frame) const noexcept
+	{
+		ME_PROFILE_FUNCTION()
+
+		auto const& transforms{ m_ValidationTransforms[frame] };
+		auto const* pInstances{ static_cast<MeshInstanceData const*>(m_MeshInstanceDataBuffers[frame].mapped) };
+
+		float constexpr EPSILON{ 1e-4f };
+		auto const nearlyEqual{ [](auto const& lhs, auto const& rhs, float scale)
+			{
+				for (glm::length_t col{ 0 }; col < lhs.length(); ++col)
+				{
+					auto const difference{ glm::abs(lhs[col] - rhs[col]) };
+					for (glm::length_t row{ 0 }; row < difference.length(); ++row)
+					{
+						if (difference[row] > EPSILON * scale)
+						{
+							return false;
+						}
+					}
+				}
+				return true;
+			} };
+
+		uint32_t mismatches{ 0 };
+		for (uint32_t i{ 0 }; i < transforms.size(); ++i)
+		{
+			glm::vec4 const& rotation{ transforms[i].rotation };
+			InstanceTransform const transform{ transforms[i].translation, glm::quat{ rotation.w, rotation.x, rotation.y, rotation.z }, transforms[i].scale };
+			glm::mat4 const model{ ToModelMatrix(transform) };
+
+			// Tolerance relative to the size of the values, positions far from the origin lose absolute precision
+			float const scale{ std::max({ 1.f, glm::length(transform.translation), glm::length(transform.scale) }) };
+
+			auto const& gpu{ pInstances[i] };
+			if (!nearlyEqual(gpu.modelMatrix, model, scale)
+				|| !nearlyEqual(gpu.normalMatrix, ToNormalMatrix(model), scale)
+				|| gpu.subMeshID != transforms[i].subMeshID
+				|| gpu.materialID != transforms[i].materialID)
+			{
+				if (0 == mismatches)
+				{
+					LOGGER.Log(MauCor::LogPriority::Error, MauCor::LogCategory::Renderer, "GPU transform {} does not match the CPU path", i);
+				}
+				++mismatches;
+			}
+		}
+
+		if (mismatches > 0)
+		{
+			LOGGER.Log(MauCor::LogPriority::Error, MauCor::LogCategory::Renderer, "{} of {} GPU transforms do not match the CPU path", mismatches, transforms.size());
 		}
 	}
 
@@ -181,6 +409,7 @@ namespace MauRen
 			// not optimal, useful for testing - just rebuild all draw commands every frame and queue them
 			m_DrawCommands.resize(0);
 			m_MeshInstanceData.resize(0);
+			m_InstanceTransforms.resize(0);
 
 			m_BatchedDrawCommands.assign(MAX_MESHES + 1, INVALID_MESH_ID);
 		}
@@ -192,16 +421,42 @@ namespace MauRen
 
 		VkDeviceSize constexpr BUFFER_SIZE{ sizeof(MeshInstanceData) * MAX_MESH_INSTANCES };
 
+		// With GPU transforms only the compute shader writes it, it is only read back to validate
+		bool constexpr IS_MAPPED{ !MauEng::USE_GPU_TRANSFORMS || VALIDATE_GPU_TRANSFORMS };
+		VkMemoryPropertyFlags constexpr MEMORY_PROPERTIES{ IS_MAPPED ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
+
 		for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; ++i)
 		{
 			m_MeshInstanceDataBuffers.emplace_back(VulkanMappedBuffer{
+												VulkanBuffer{BUFFER_SIZE,
+																	VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+																	MEMORY_PROPERTIES },
+												nullptr });
+
+			if constexpr (IS_MAPPED)
+			{
+				// Persistent mapping
+				vkMapMemory(deviceContext->GetLogicalDevice(), m_MeshInstanceDataBuffers[i].buffer.bufferMemory, 0, BUFFER_SIZE, 0, &m_MeshInstanceDataBuffers[i].mapped);
+			}
+		}
+	}
+
+	void VulkanMeshManager::InitializeInstanceTransformBuffers() noexcept
+	{
+		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
+
+		VkDeviceSize constexpr BUFFER_SIZE{ sizeof(InstanceTransformData) * MAX_MESH_INSTANCES };
+
+		for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; ++i)
+		{
+			m_InstanceTransformBuffers.emplace_back(VulkanMappedBuffer{
 												VulkanBuffer{BUFFER_SIZE,
 																	VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 																	VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT },
 												nullptr });
 
 			// Persistent mapping
-			vkMapMemory(deviceContext->GetLogicalDevice(), m_MeshInstanceDataBuffers[i].buffer.bufferMemory, 0, BUFFER_SIZE, 0, &m_MeshInstanceDataBuffers[i].mapped);
+			vkMapMemory(deviceContext->GetLogicalDevice(), m_InstanceTransformBuffers[i].buffer.bufferMemory, 0, BUFFER_SIZE, 0, &m_InstanceTransformBuffers[i].mapped);
 		}
 	}
 
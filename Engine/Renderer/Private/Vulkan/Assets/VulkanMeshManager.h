@@ -5,6 +5,7 @@
 #include "RendererPCH.h"
 #include "../VulkanBuffer.h"
 #include "Assets//BindlessData.h"
+#include "Containers/SlotMap.h"
 
 namespace MauRen
 {
@@ -20,40 +21,51 @@ namespace MauRen
 		[[nodiscard]] uint32_t LoadMesh(char const* path, VulkanCommandPoolManager& cmdPoolManager, VulkanDescriptorContext& descriptorContext) noexcept;
 
 		[[nodiscard]] MeshData const& GetMeshData(uint32_t meshID) const;
+		[[nodiscard]] MauCor::AABB const& GetMeshBounds(uint32_t meshID) const;
+		// False for ids that were never handed out or whose mesh is gone
+		[[nodiscard]] bool IsValidMesh(uint32_t meshID) const noexcept { return m_Meshes.IsValid(meshID); }
 
+		// CPU transforms, the instance data is uploaded as is
 		void QueueDraw(glm::mat4 const& transformMat, uint32_t meshID) noexcept
 		{
-			auto const it{ m_LoadedMeshes.find(meshID) };
-			ME_ASSERT(it != end(m_LoadedMeshes));
+			glm::mat3x4 const normalMatrix{ ToNormalMatrix(transformMat) };
 
-			auto const& meshData{ m_MeshData[it->second] };
-
-			for (uint32_t sub{ meshData.firstSubMesh }; sub < meshData.firstSubMesh + meshData.subMeshCount; ++ sub)
-			{
-				auto const& subMesh{ m_SubMeshes[sub] };
-
-				m_MeshInstanceData.emplace_back(transformMat, sub, subMesh.materialID, meshData.flags);
-
-				if (m_BatchedDrawCommands[sub] != INVALID_DRAW_COMMAND)
+			QueueInstance(meshID, [&](uint32_t sub, SubMeshData const& subMesh, MeshData const& meshData)
 				{
-					// Already added this mesh this frame; just increment instance count
-					m_DrawCommands[m_BatchedDrawCommands[sub]].instanceCount++;
-				}
-				else
-				{
-					// First time seeing this mesh this frame; create a new draw command
-					uint32_t const instanceOffset{ static_cast<uint32_t>(m_MeshInstanceData.size() - 1) };
+					m_MeshInstanceData.emplace_back(transformMat, normalMatrix, sub, subMesh.materialID, meshData.flags);
+				});
+		}
 
-					m_BatchedDrawCommands[sub] = static_cast<uint32_t>(m_DrawCommands.size());
-					m_DrawCommands.emplace_back(subMesh.indexCount, 1, subMesh.firstIndex, subMesh.vertexOffset, instanceOffset);
-				}
-			}
+		// GPU transforms (USE_GPU_TRANSFORMS), the matrices are built by the transform compute shader
+		void QueueDraw(InstanceTransform const& transform, uint32_t meshID) noexcept
+		{
+			QueueInstance(meshID, [&](uint32_t sub, SubMeshData const& subMesh, MeshData const&)
+				{
+					m_InstanceTransforms.emplace_back(ToTransformData(transform, sub, subMesh.materialID));
+				});
 		}
 
+		// Every submesh gets one draw command for all the instances, their data is written as one block
+		void QueueDrawBatch(uint32_t meshID, std::span<glm::mat4 const> transforms) noexcept;
+		void QueueDrawBatch(uint32_t meshID, std::span<InstanceTransform const> transforms) noexcept;
+
 		void PreDraw(VkCommandBuffer commandBuffer, VkPipelineLayout layout, uint32_t setCount, VkDescriptorSet const* pDescriptorSets, uint32_t frame);
 		void Draw(VkCommandBuffer commandBuffer, VkPipelineLayout layout, uint32_t setCount, VkDescriptorSet const* pDescriptorSets, uint32_t frame);
 		void PostDraw(VkCommandBuffer commandBuffer, VkPipelineLayout layout, uint32_t setCount, VkDescriptorSet const* pDescriptorSets, uint32_t frame);
 
+		// Records the transform compute shader for the queued instances, has to be recorded after PreDraw & before Draw
+		void BuildTransforms(VkCommandBuffer commandBuffer, VkPipeline pipeline, VkPipelineLayout layout, uint32_t setCount, VkDescriptorSet const* pDescriptorSets, uint32_t frame);
+
+		// Model matrix of the transform, the same the transform compute shader builds
+		[[nodiscard]] static glm::mat4 ToModelMatrix(InstanceTransform const& transform) noexcept;
+		// MauCor::NormalMatrix, padded for the instance buffer
+		[[nodiscard]] static glm::mat3x4 ToNormalMatrix(glm::mat4 const& modelMatrix) noexcept;
+		[[nodiscard]] static InstanceTransformData ToTransformData(InstanceTransform const& transform, uint32_t subMeshID, uint32_t materialID) noexcept
+		{
+			glm::quat const& rotation{ transform.rotation };
+			return { glm::vec4{ rotation.x, rotation.y, rotation.z, rotation.w }, transform.translation, subMeshID, transform.scale, materialID };
+		}
+
 		VulkanMeshManager(VulkanMeshManager const&) = delete;
 		VulkanMeshManager(VulkanMeshManager&&) = delete;
 		VulkanMeshManager& operator=(VulkanMeshManager const&) = delete;
@@ -61,17 +73,30 @@ namespace MauRen
 
 	private:
 		friend class MauCor::Singleton<VulkanMeshManager>;
+		// Enough slots for MAX_MESHES, the rest of the id is the generation
+		static uint32_t constexpr MESH_INDEX_BITS{ 16 };
+		static_assert(MAX_MESHES < (1u << MESH_INDEX_BITS));
+
 		VulkanMeshManager() = default;
 		virtual ~VulkanMeshManager() override = default;
 
 		VulkanCommandPoolManager const* m_CmdPoolManager;
 
-		// 1:1 copy w/ GPU buffers
+		// 1:1 copy w/ GPU buffers, only used for CPU transforms
 		std::vector<MeshInstanceData> m_MeshInstanceData;
+		// Written by the CPU or by the transform compute shader, only mapped when the CPU writes or reads it
 		std::vector<VulkanMappedBuffer> m_MeshInstanceDataBuffers;
 
-		// Data for each mesh
-		std::vector<MeshData> m_MeshData;
+		// 1:1 copy w/ GPU buffers, only used for GPU transforms
+		std::vector<InstanceTransformData> m_InstanceTransforms;
+		std::vector<VulkanMappedBuffer> m_InstanceTransformBuffers;
+		// What was uploaded per frame, checked against the shader output once the frame is done (VALIDATE_GPU_TRANSFORMS)
+		std::vector<std::vector<InstanceTransformData>> m_ValidationTransforms;
+
+		// Mesh IDs are handles into this, a lookup is an array index
+		MauCor::SlotMap<MeshData, MESH_INDEX_BITS> m_Meshes;
+		// Local space bounds, per slot of m_Meshes
+		std::vector<MauCor::AABB> m_MeshBounds;
 		std::vector<SubMeshData> m_SubMeshes;
 
 		// 1:1 copy w/ GPU buffers
@@ -87,16 +112,62 @@ namespace MauRen
 		// DrawCommands[SubMeshID] == uint max -> no batch yet; else it's the idx into the vec
 		std::vector<uint32_t> m_BatchedDrawCommands;
 
-		// maps mesh ID -> index into m_MeshData
-		std::unordered_map<uint32_t, uint32_t> m_LoadedMeshes;
-		// map model/mesh path into m_MeshData
-		std::unordered_map<char const*, uint32_t> m_LoadedMeshes_Path;
+		// Model path -> mesh ID, only used when loading
+		std::unordered_map<std::string, uint32_t> m_MeshIDsByPath;
 
 		uint32_t m_CurrentVertexOffset{ 0 }; // current vertex offset in the "global" vertex buffer
 		uint32_t m_CurrentIndexOffset{ 0 }; // current index offset in the "global" index buffer
-		uint32_t m_NextID{ 0 }; // next available mesh ID
+
+		// Amount of instance data entries queued this frame, there is one per submesh
+		[[nodiscard]] uint32_t InstanceCount() const noexcept
+		{
+			if constexpr (MauEng::USE_GPU_TRANSFORMS)
+			{
+				return static_cast<uint32_t>(m_InstanceTransforms.size());
+			}
+			else
+			{
+				return static_cast<uint32_t>(m_MeshInstanceData.size());
+			}
+		}
+
+		// addInstance(subMeshID, subMesh, meshData) appends the instance data of one submesh, it is added to the draw command of the submesh
+		template<typename AddInstanceFunc>
+		void QueueInstance(uint32_t meshID, AddInstanceFunc&& addInstance) noexcept
+		{
+			auto const& meshData{ m_Meshes.Get(meshID) };
+
+			for (uint32_t sub{ meshData.firstSubMesh }; sub < meshData.firstSubMesh + meshData.subMeshCount; ++ sub)
+			{
+				auto const& subMesh{ m_SubMeshes[sub] };
+
+				addInstance(sub, subMesh, meshData);
+
+				if (m_BatchedDrawCommands[sub] != INVALID_DRAW_COMMAND)
+				{
+					// Already added this mesh this frame; just increment instance count
+					m_DrawCommands[m_BatchedDrawCommands[sub]].instanceCount++;
+				}
+				else
+				{
+					// First time seeing this mesh this frame; create a new draw command
+					uint32_t const instanceOffset{ InstanceCount() - 1 };
+
+					m_BatchedDrawCommands[sub] = static_cast<uint32_t>(m_DrawCommands.size());
+					m_DrawCommands.emplace_back(subMesh.indexCount, 1, subMesh.firstIndex, subMesh.vertexOffset, instanceOffset);
+				}
+			}
+		}
+
+		// makeInstance(transform, subMeshID, subMesh, meshData) returns the instance data, it is called in parallel
+		template<typename InstanceType, typename TransformType, typename MakeInstanceFunc>
+		void QueueBatch(std::vector<InstanceType>& instances, uint32_t meshID, std::span<TransformType const> transforms, MakeInstanceFunc const& makeInstance) noexcept;
+
+		// Compares the shader output of the last time this frame was rendered with the CPU path
+		void ValidateTransforms(uint32_t frame) const noexcept;
 
 		void InitializeMeshInstanceDataBuffers() noexcept;
+		void InitializeInstanceTransformBuffers() noexcept;
 		void InitializeDrawCommandBuffers() noexcept;
 
 		void CreateVertexAndIndexBuffers() noexcept;
@@ -2,6 +2,8 @@
 
 #include "VulkanCommandPoolManager.h"
 
+#include "Memory/MemoryTracker.h"
+
 namespace MauRen
 {
 	void VulkanBuffer::Destroy()
@@ -9,7 +11,10 @@ namespace MauRen
 		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
 		
 		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), buffer, nullptr);
-		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), bufferMemory, nullptr);
+		if (VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), bufferMemory, nullptr))
+		{
+			MauCor::TrackGPUFree(memoryTypeIndex, allocationSize);
+		}
 	}
 
 	VulkanBuffer::VulkanBuffer(VkDeviceSize deviceSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
@@ -57,6 +62,10 @@ namespace MauRen
 			throw std::runtime_error("Failed to allocate buffer memory!");
 		}
 
+		allocationSize = allocInfo.allocationSize;
+		memoryTypeIndex = allocInfo.memoryTypeIndex;
+		MauCor::TrackGPUAllocation(memoryTypeIndex, allocationSize);
+
 		vkBindBufferMemory(deviceContext->GetLogicalDevice(), buffer, bufferMemory, 0);
 	}
 
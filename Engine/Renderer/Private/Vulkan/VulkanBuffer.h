@@ -13,6 +13,9 @@ namespace MauRen
 		VkBuffer buffer{ VK_NULL_HANDLE };
 		VkDeviceMemory bufferMemory{ VK_NULL_HANDLE };
 		VkDeviceSize size{ 0 };
+		// Of bufferMemory, counted by the memory tracker
+		VkDeviceSize allocationSize{ 0 };
+		uint32_t memoryTypeIndex{ 0 };
 
 		void Destroy();
 		static void CopyBuffer(VulkanCommandPoolManager const& CmPoolManager, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
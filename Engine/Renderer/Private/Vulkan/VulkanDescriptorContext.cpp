@@ -96,16 +96,25 @@ namespace MauRen
 		meshInstanceDataBinding.binding = MESH_INSTANCE_DATA_BINDING_SLOT;
 		meshInstanceDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 		meshInstanceDataBinding.descriptorCount = 1;
-		meshInstanceDataBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		// Written by the transform compute shader when USE_GPU_TRANSFORMS is on
+		meshInstanceDataBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
 		meshInstanceDataBinding.pImmutableSamplers = nullptr;
 
-		std::array<VkDescriptorSetLayoutBinding, 6> const bindings {
+		VkDescriptorSetLayoutBinding instanceTransformBinding{};
+		instanceTransformBinding.binding = INSTANCE_TRANSFORM_BINDING_SLOT;
+		instanceTransformBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		instanceTransformBinding.descriptorCount = 1;
+		instanceTransformBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		instanceTransformBinding.pImmutableSamplers = nullptr;
+
+		std::array<VkDescriptorSetLayoutBinding, 7> const bindings {
 			uboLayoutBinding,
 			samplerBinding,
 			bindlessTextureBinding,
 			materialDataBinding,
 			meshDataBinding,
-			meshInstanceDataBinding
+			meshInstanceDataBinding,
+			instanceTransformBinding
 		};
 
 		// Variable coutn adds more complexity and we do not need it currentl
@@ -118,6 +127,7 @@ namespace MauRen
 			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT, // Flags for bindless textures
 			0,
 			0,
+			0,
 			0
 		};
 		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo{};
@@ -146,7 +156,7 @@ namespace MauRen
 	{
 		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
 
-		std::array<VkDescriptorPoolSize, 6> poolSizes{};
+		std::array<VkDescriptorPoolSize, 7> poolSizes{};
 		poolSizes[UBO_BINDING_SLOT].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 		poolSizes[UBO_BINDING_SLOT].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
@@ -165,6 +175,9 @@ namespace MauRen
 		poolSizes[MESH_INSTANCE_DATA_BINDING_SLOT].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 		poolSizes[MESH_INSTANCE_DATA_BINDING_SLOT].descriptorCount = static_cast<uint32_t>(1 * MAX_FRAMES_IN_FLIGHT);
 
+		poolSizes[INSTANCE_TRANSFORM_BINDING_SLOT].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		poolSizes[INSTANCE_TRANSFORM_BINDING_SLOT].descriptorCount = static_cast<uint32_t>(1 * MAX_FRAMES_IN_FLIGHT);
+
 		if (MAX_TEXTURES > deviceContext->GetMaxSampledImages())
 		{
 			throw std::runtime_error("Max textures is bigger than device limitations");
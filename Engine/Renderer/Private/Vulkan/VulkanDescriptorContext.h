@@ -50,6 +50,7 @@ namespace MauRen
 
 		const uint32_t MESH_DATA_BINDING_SLOT{ 4 };
 		const uint32_t MESH_INSTANCE_DATA_BINDING_SLOT{ 5 };
+		const uint32_t INSTANCE_TRANSFORM_BINDING_SLOT{ 6 };
 
 	};
 }
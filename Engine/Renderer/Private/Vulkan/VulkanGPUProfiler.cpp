@@ -0,0 +1,247 @@
+#include "VulkanGPUProfiler.h"
+
+#include "VulkanCommandPoolManager.h"
+
+#include "Profiling/TraceClock.h"
+
+namespace MauRen
+{
+	void VulkanGPUProfiler::Initialize(VulkanCommandPoolManager const& cmdPoolManager)
+	{
+		if constexpr (!MauEng::USE_GPU_PROFILER)
+		{
+			return;
+		}
+
+		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
+
+		VkPhysicalDeviceProperties properties{};
+		vkGetPhysicalDeviceProperties(deviceContext->GetPhysicalDevice(), &properties);
+
+		uint32_t queueFamilyCount{ 0 };
+		vkGetPhysicalDeviceQueueFamilyProperties(deviceContext->GetPhysicalDevice(), &queueFamilyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(deviceContext->GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+		uint32_t const validBits{ queueFamilies[deviceContext->FindQueueFamilies().graphicsFamily.value()].timestampValidBits };
+		if (0 == validBits or properties.limits.timestampPeriod <= 0.f)
+		{
+			ME_LOG_WARN(MauCor::LogCategory::Renderer, "The graphics queue doesn't support timestamps, GPU profiling is off");
+			return;
+		}
+
+		m_TimestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t{ 1 } << validBits) - 1;
+		m_NanosecondsPerTimestamp = static_cast<double>(properties.limits.timestampPeriod);
+		m_pCmdPoolManager = &cmdPoolManager;
+
+		VkQueryPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		poolInfo.queryCount = QUERY_COUNT;
+
+		for (auto& frame : m_Frames)
+		{
+			if (VK_SUCCESS != vkCreateQueryPool(deviceContext->GetLogicalDevice(), &poolInfo, nullptr, &frame.queryPool))
+			{
+				throw std::runtime_error("Failed to create timestamp query pool!");
+			}
+		}
+
+		poolInfo.queryCount = 1;
+		if (VK_SUCCESS != vkCreateQueryPool(deviceContext->GetLogicalDevice(), &poolInfo, nullptr, &m_CalibrationPool))
+		{
+			throw std::runtime_error("Failed to create timestamp query pool!");
+		}
+
+		m_SessionCount = PROFILER.GetSessionCount();
+		Calibrate();
+	}
+
+	void VulkanGPUProfiler::Destroy()
+	{
+		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
+
+		for (auto& frame : m_Frames)
+		{
+			VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), frame.queryPool, nullptr);
+			frame.scopeCount = 0;
+		}
+		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), m_CalibrationPool, nullptr);
+
+		m_IsEnabled = false;
+	}
+
+	void VulkanGPUProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frame)
+	{
+		if (not m_IsEnabled)
+		{
+			return;
+		}
+
+		// A new session gets a fresh offset, the GPU & CPU clocks drift apart over time
+		if (uint32_t const sessionCount{ PROFILER.GetSessionCount() }; sessionCount != m_SessionCount)
+		{
+			m_SessionCount = sessionCount;
+			Calibrate();
+
+			if (not m_IsEnabled)
+			{
+				return;
+			}
+		}
+
+		auto& queries{ m_Frames[frame] };
+
+		// The frame's fence was waited for, so were its queries
+		ReadBack(queries);
+
+		queries.scopeCount = 0;
+		vkCmdResetQueryPool(commandBuffer, queries.queryPool, 0, QUERY_COUNT);
+
+		m_CurrentFrame = frame;
+		m_Depth = 0;
+	}
+
+	uint32_t VulkanGPUProfiler::BeginScope(VkCommandBuffer commandBuffer, char const* name)
+	{
+		if (not m_IsEnabled)
+		{
+			return UINT32_MAX;
+		}
+
+		auto& queries{ m_Frames[m_CurrentFrame] };
+		if (queries.scopeCount == MAX_GPU_PROFILE_SCOPES)
+		{
+			return UINT32_MAX;
+		}
+
+		uint32_t const scope{ queries.scopeCount++ };
+		queries.scopes[scope] = { name, m_Depth++ };
+
+		vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, queries.queryPool, scope * 2);
+
+		return scope;
+	}
+
+	void VulkanGPUProfiler::EndScope(VkCommandBuffer commandBuffer, uint32_t scope)
+	{
+		if (UINT32_MAX == scope)
+		{
+			return;
+		}
+
+		--m_Depth;
+		vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, m_Frames[m_CurrentFrame].queryPool, scope * 2 + 1);
+	}
+
+	void VulkanGPUProfiler::Calibrate()
+	{
+		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
+
+		uint32_t constexpr ATTEMPTS{ 5 };
+
+		VkQueryPool const queryPool{ m_CalibrationPool };
+		uint64_t shortestWait{ UINT64_MAX };
+
+		for (uint32_t attempt{ 0 }; attempt < ATTEMPTS; ++attempt)
+		{
+			VkCommandBuffer const commandBuffer{ m_pCmdPoolManager->BeginSingleTimeCommands() };
+			vkCmdResetQueryPool(commandBuffer, queryPool, 0, 1);
+			vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, queryPool, 0);
+
+			// The timestamp is written somewhere between the submit & the end of the wait
+			uint64_t const before{ MauCor::ReadTraceClock() };
+			m_pCmdPoolManager->EndSingleTimeCommands(commandBuffer);
+			uint64_t const after{ MauCor::ReadTraceClock() };
+
+			uint64_t timestamp{ 0 };
+			if (VK_SUCCESS != vkGetQueryPoolResults(deviceContext->GetLogicalDevice(), queryPool, 0, 1, sizeof(timestamp), &timestamp, sizeof(timestamp), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT))
+			{
+				continue;
+			}
+
+			if (after - before < shortestWait)
+			{
+				shortestWait = after - before;
+				m_CalibrationTimestamp = timestamp & m_TimestampMask;
+				m_CalibrationTicks = before + (after - before) / 2;
+			}
+		}
+
+		m_IsEnabled = shortestWait != UINT64_MAX;
+		if (not m_IsEnabled)
+		{
+			ME_LOG_WARN(MauCor::LogCategory::Renderer, "Failed to read a GPU timestamp, GPU profiling is off");
+			return;
+		}
+
+		m_RateStartTime = std::chrono::steady_clock::now();
+		m_RateStartTicks = MauCor::ReadTraceClock();
+	}
+
+	double VulkanGPUProfiler::MeasureTicksPerNanosecond() const noexcept
+	{
+		uint64_t const ticks{ MauCor::ReadTraceClock() };
+		auto const elapsed{ std::chrono::steady_clock::now() - m_RateStartTime };
+
+		if (elapsed < MIN_RATE_DURATION)
+		{
+			return MauCor::TraceClockFrequency() / 1'000'000'000.0;
+		}
+
+		return static_cast<double>(ticks - m_RateStartTicks) / static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+
+	uint64_t VulkanGPUProfiler::ToTraceTicks(uint64_t timestamp, double ticksPerNanosecond) const noexcept
+	{
+		// Wraps around with the timestamp's valid bits, scopes of a frame recorded before the calibration are behind it
+		uint64_t const ahead{ (timestamp - m_CalibrationTimestamp) & m_TimestampMask };
+		double const elapsed{ ahead <= m_TimestampMask / 2 ? static_cast<double>(ahead) : -static_cast<double>((m_CalibrationTimestamp - timestamp) & m_TimestampMask) };
+
+		return m_CalibrationTicks + static_cast<uint64_t>(static_cast<int64_t>(elapsed * m_NanosecondsPerTimestamp * ticksPerNanosecond));
+	}
+
+	void VulkanGPUProfiler::ReadBack(FrameQueries const& frame) const
+	{
+		if (0 == frame.scopeCount)
+		{
+			return;
+		}
+
+		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
+
+		// Timestamp & availability per query, VK_NOT_READY only means some of them aren't available
+		std::array<uint64_t, QUERY_COUNT * 2> results{};
+		uint32_t const queryCount{ frame.scopeCount * 2 };
+
+		VkResult const result{ vkGetQueryPoolResults(deviceContext->GetLogicalDevice(), frame.queryPool, 0, queryCount,
+			queryCount * 2 * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT) };
+
+		if (VK_SUCCESS != result and VK_NOT_READY != result)
+		{
+			return;
+		}
+
+		double const ticksPerNanosecond{ MeasureTicksPerNanosecond() };
+
+		for (uint32_t scope{ 0 }; scope < frame.scopeCount; ++scope)
+		{
+			uint64_t const* const pQueries{ results.data() + scope * 4 };
+			if (0 == pQueries[1] or 0 == pQueries[3])
+			{
+				continue;
+			}
+
+			MauCor::TraceScope const traceScope{ frame.scopes[scope].name, ToTraceTicks(pQueries[0], ticksPerNanosecond), ToTraceTicks(pQueries[2], ticksPerNanosecond), frame.scopes[scope].depth, false };
+
+			if constexpr (MauEng::USE_PROFILER_STATS)
+			{
+				PROFILER.AddToStats(traceScope);
+			}
+
+			PROFILER.WriteGPUScope(traceScope);
+		}
+	}
+}
@@ -0,0 +1,127 @@
+#ifndef MAUREN_VULKANGPUPROFILER_H
+#define MAUREN_VULKANGPUPROFILER_H
+
+#include "RendererPCH.h"
+
+#include <array>
+#include <chrono>
+
+namespace MauRen
+{
+	class VulkanCommandPoolManager;
+
+	/*
+	 * Times command buffer regions on the GPU (USE_GPU_PROFILER).
+	 * Every frame in flight has its own timestamp query pool, a scope writes a timestamp at its start & end.
+	 * The results are read back when the frame's command buffer is recorded again, its fence was waited for by then,
+	 * so the CPU never waits on a query.
+	 * GPU timestamps are converted to trace clock ticks with an offset measured in Initialize & again whenever a profiling session begins.
+	 * The trace clock's rate is measured against steady_clock from that calibration on, like the trace profiler does over its session,
+	 * so the GPU track doesn't drift away from the CPU scopes. The scopes go to the profiler's GPU track (Profiler::WriteGPUScope) & to the scope stats.
+	 * Does nothing on devices without timestamp support on the graphics queue.
+	 */
+	class VulkanGPUProfiler final
+	{
+	public:
+		VulkanGPUProfiler() = default;
+		~VulkanGPUProfiler() = default;
+
+		void Initialize(VulkanCommandPoolManager const& cmdPoolManager);
+		void Destroy();
+
+		// First thing recorded in the frame's command buffer, reports the scopes of the last time this frame was rendered
+		void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frame);
+
+		// Returns the scope's index, UINT32_MAX when the frame is out of scopes or profiling is off
+		// The name has to outlive the profiling session (literals)
+		[[nodiscard]] uint32_t BeginScope(VkCommandBuffer commandBuffer, char const* name);
+		void EndScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+		[[nodiscard]] bool IsEnabled() const noexcept { return m_IsEnabled; }
+
+		VulkanGPUProfiler(VulkanGPUProfiler const&) = delete;
+		VulkanGPUProfiler(VulkanGPUProfiler&&) = delete;
+		VulkanGPUProfiler& operator=(VulkanGPUProfiler const&) = delete;
+		VulkanGPUProfiler& operator=(VulkanGPUProfiler&&) = delete;
+
+	private:
+		static uint32_t constexpr QUERY_COUNT{ MAX_GPU_PROFILE_SCOPES * 2 };
+		// Until then the trace clock's rate is the estimate of TraceClockFrequency
+		static constexpr std::chrono::milliseconds MIN_RATE_DURATION{ 100 };
+
+		struct GPUScope final
+		{
+			char const* name;
+			uint32_t depth;
+		};
+
+		struct FrameQueries final
+		{
+			VkQueryPool queryPool{ VK_NULL_HANDLE };
+			std::array<GPUScope, MAX_GPU_PROFILE_SCOPES> scopes{};
+			// Scopes recorded the last time this frame was rendered
+			uint32_t scopeCount{ 0 };
+		};
+
+		std::array<FrameQueries, MAX_FRAMES_IN_FLIGHT> m_Frames{};
+		uint32_t m_CurrentFrame{ 0 };
+		uint32_t m_Depth{ 0 };
+
+		VulkanCommandPoolManager const* m_pCmdPoolManager{ nullptr };
+		// Separate from the frames' pools, calibrating doesn't overwrite a query that wasn't read back yet
+		VkQueryPool m_CalibrationPool{ VK_NULL_HANDLE };
+
+		// GPU timestamps only have timestampValidBits bits
+		uint64_t m_TimestampMask{ 0 };
+		double m_NanosecondsPerTimestamp{ 0.0 };
+		// A GPU timestamp & the trace clock at the same moment, measured by Calibrate
+		uint64_t m_CalibrationTimestamp{ 0 };
+		uint64_t m_CalibrationTicks{ 0 };
+		// Both CPU clocks at the end of Calibrate, the trace clock's rate is measured from here
+		uint64_t m_RateStartTicks{ 0 };
+		std::chrono::steady_clock::time_point m_RateStartTime{};
+		// Profiler::GetSessionCount at the last calibration
+		uint32_t m_SessionCount{ 0 };
+
+		bool m_IsEnabled{ false };
+
+		// Writes a timestamp & measures the trace clock around the submit, the tightest of a few tries is kept
+		// Waits for the graphics queue to be idle
+		void Calibrate();
+		// Trace clock ticks per nanosecond since the calibration
+		[[nodiscard]] double MeasureTicksPerNanosecond() const noexcept;
+		[[nodiscard]] uint64_t ToTraceTicks(uint64_t timestamp, double ticksPerNanosecond) const noexcept;
+		void ReadBack(FrameQueries const& frame) const;
+	};
+
+	// Times the commands recorded while it lives on the GPU
+	class VulkanGPUTimer final
+	{
+	public:
+		explicit VulkanGPUTimer(VulkanGPUProfiler& profiler, VkCommandBuffer commandBuffer, char const* name) :
+			m_Profiler{ profiler },
+			m_CommandBuffer{ commandBuffer },
+			m_Scope{ profiler.BeginScope(commandBuffer, name) }
+		{
+		}
+		~VulkanGPUTimer()
+		{
+			m_Profiler.EndScope(m_CommandBuffer, m_Scope);
+		}
+
+		VulkanGPUTimer(VulkanGPUTimer const&) = delete;
+		VulkanGPUTimer(VulkanGPUTimer&&) = delete;
+		VulkanGPUTimer& operator=(VulkanGPUTimer const&) = delete;
+		VulkanGPUTimer& operator=(VulkanGPUTimer&&) = delete;
+
+	private:
+		VulkanGPUProfiler& m_Profiler;
+		VkCommandBuffer const m_CommandBuffer;
+		uint32_t const m_Scope;
+	};
+
+	// Like ME_PROFILE_SCOPE, but measures the commands recorded in the scope on the GPU
+	#define ME_PROFILE_GPU_SCOPE(gpuProfiler, commandBuffer, name) MauRen::VulkanGPUTimer C(gpuTimer, __LINE__) { gpuProfiler, commandBuffer, name };
+}
+
+#endif
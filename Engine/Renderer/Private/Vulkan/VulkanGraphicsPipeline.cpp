@@ -9,6 +9,11 @@ namespace MauRen
 		CreateGraphicsPipeline(pSwapChainContext, descriptorSetLayout, descriptorSetLayoutCount);
 		CreateDepthPrePassPipeline(pSwapChainContext, descriptorSetLayout, descriptorSetLayoutCount);
 		CreateDebugGraphicsPipeline(pSwapChainContext, descriptorSetLayout, descriptorSetLayoutCount);
+
+		if constexpr (MauEng::USE_GPU_TRANSFORMS)
+		{
+			CreateTransformPipeline(descriptorSetLayout, descriptorSetLayoutCount);
+		}
 	}
 
 	void VulkanGraphicsPipeline::Destroy()
@@ -23,6 +28,9 @@ namespace MauRen
 
 		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), m_DepthPrePassPipeline, nullptr);
 		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), m_DepthPrePassPipelineLayout, nullptr);
+
+		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), m_TransformPipeline, nullptr);
+		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), m_TransformPipelineLayout, nullptr);
 	}
 
 	void VulkanGraphicsPipeline::CreateGraphicsPipeline(VulkanSwapchainContext* pSwapChainContext, VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorSetLayoutCount)
@@ -540,6 +548,54 @@ namespace MauRen
 		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), debugVertShaderModule, nullptr);
 	}
 
+	void VulkanGraphicsPipeline::CreateTransformPipeline(VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorSetLayoutCount)
+	{
+		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
+
+		auto const compShaderCode{ ReadFile("Resources/Shaders/transforms.comp.spv") };
+
+		// Shader modules are linked internally, the VkShaderModule is just a wrapper so we do not need to store it.
+		VkShaderModule compShaderModule{ CreateShaderModule(compShaderCode) };
+
+		VkPipelineShaderStageCreateInfo compShaderStageInfo{};
+		compShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		compShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		compShaderStageInfo.module = compShaderModule;
+		compShaderStageInfo.pName = "main";
+
+		// Amount of instances
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(uint32_t);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = descriptorSetLayoutCount;
+		pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(deviceContext->GetLogicalDevice(), &pipelineLayoutInfo, nullptr, &m_TransformPipelineLayout) != VK_SUCCESS)
+		{
+			throw std::runtime_error("Failed to create transform pipeline layout!");
+		}
+
+		VkComputePipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage = compShaderStageInfo;
+		pipelineInfo.layout = m_TransformPipelineLayout;
+		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+		pipelineInfo.basePipelineIndex = -1;
+
+		if (VK_SUCCESS != vkCreateComputePipelines(deviceContext->GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_TransformPipeline))
+		{
+			throw std::runtime_error("Failed to create transform pipeline!");
+		}
+
+		VulkanUtils::SafeDestroy(deviceContext->GetLogicalDevice(), compShaderModule, nullptr);
+	}
+
 	std::vector<char> VulkanGraphicsPipeline::ReadFile(std::filesystem::path const& filepath)
 	{
 		ME_RENDERER_ASSERT(std::filesystem::exists(filepath));
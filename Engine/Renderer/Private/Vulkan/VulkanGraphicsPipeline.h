@@ -27,6 +27,10 @@ namespace MauRen
 		[[nodiscard]] VkPipeline GetDebugPipeline() const noexcept { return m_DebugPipeline; }
 		[[nodiscard]] VkPipelineLayout GetDebugPipelineLayout() const noexcept { return m_DebugPipelineLayout; }
 
+		// Compute pipeline that builds the instance matrices, only created when USE_GPU_TRANSFORMS is on
+		[[nodiscard]] VkPipeline GetTransformPipeline() const noexcept { return m_TransformPipeline; }
+		[[nodiscard]] VkPipelineLayout GetTransformPipelineLayout() const noexcept { return m_TransformPipelineLayout; }
+
 		VulkanGraphicsPipeline(VulkanGraphicsPipeline const&) = delete;
 		VulkanGraphicsPipeline(VulkanGraphicsPipeline&&) = delete;
 		VulkanGraphicsPipeline& operator=(VulkanGraphicsPipeline const&) = delete;
@@ -42,9 +46,13 @@ namespace MauRen
 		VkPipelineLayout m_DebugPipelineLayout{ VK_NULL_HANDLE };
 		VkPipeline m_DebugPipeline{ VK_NULL_HANDLE };
 
+		VkPipelineLayout m_TransformPipelineLayout{ VK_NULL_HANDLE };
+		VkPipeline m_TransformPipeline{ VK_NULL_HANDLE };
+
 		void CreateGraphicsPipeline(VulkanSwapchainContext* pSwapChainContext, VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorSetLayoutCount);
 		void CreateDepthPrePassPipeline(VulkanSwapchainContext* pSwapChainContext, VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorSetLayoutCount);
 		void CreateDebugGraphicsPipeline(VulkanSwapchainContext* pSwapChainContext, VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorSetLayoutCount);
+		void CreateTransformPipeline(VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorSetLayoutCount);
 
 		static std::vector<char> ReadFile(std::filesystem::path const& filepath);
 		[[nodiscard]] VkShaderModule CreateShaderModule(std::vector<char> const& code) const;
@@ -1,11 +1,20 @@
 #include "VulkanRenderer.h"
 
+#include <algorithm>
+#include <execution>
+#include <ranges>
+
 #include "Assets/VulkanMeshManager.h"
 #include "Assets/VulkanMaterialManager.h"
 #include "DebugRenderer/InternalDebugRenderer.h"
 #include "DebugRenderer/NullDebugRenderer.h"
 
+#include "Profiling/TraceClock.h"
+#include "Memory/MemoryTracker.h"
+
 #include "../../MauEng/Public/Components/CStaticMesh.h"
+#include "../../MauEng/Public/Components/CTransform.h"
+#include "../../MauEng/Public/Components/CInstanceBatch.h"
 
 namespace MauRen
 {
@@ -29,6 +38,7 @@ namespace MauRen
 	void VulkanRenderer::Init()
 	{
 		ME_PROFILE_FUNCTION()
+		MauCor::MemoryTagScope const memoryTag{ MauCor::MemoryTag::RendererCPU };
 
 		m_InstanceContext.Initialize();
 		m_SurfaceContext.Initialize(&m_InstanceContext, m_pWindow);
@@ -63,6 +73,7 @@ namespace MauRen
 
 		m_CommandPoolManager.CreateCommandBuffers();
 		CreateSyncObjects();
+		m_GPUProfiler.Initialize(m_CommandPoolManager);
 
 		VulkanMaterialManager::GetInstance().InitializeTextureManager(m_CommandPoolManager, m_DescriptorContext);
 		VulkanMeshManager::GetInstance().Initialize(&m_CommandPoolManager);
@@ -79,10 +90,22 @@ namespace MauRen
 									  VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 									  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
 		}
+
+		if constexpr (MauEng::USE_RENDER_THREAD)
+		{
+			m_RenderThread = std::jthread{ [this](std::stop_token const& stopToken) { RenderThreadLoop(stopToken); } };
+		}
 	}
 
 	void VulkanRenderer::Destroy()
 	{
+		if (m_RenderThread.joinable())
+		{
+			m_RenderThread.request_stop();
+			m_Snapshots.Stop();
+			m_RenderThread.join();
+		}
+
 		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
 
 		// Wait for GPU to finish everything
@@ -104,6 +127,7 @@ namespace MauRen
 			m_DebugIndexBuffer.Destroy();
 		}
 
+		m_GPUProfiler.Destroy();
 		m_CommandPoolManager.Destroy();
 
 		m_SwapChainContext.Destroy();
@@ -129,13 +153,35 @@ namespace MauRen
 
 	void VulkanRenderer::Render(glm::mat4 const& view, glm::mat4 const& proj)
 	{
-		DrawFrame(view, proj);
+		ME_PROFILE_FUNCTION()
+		MauCor::MemoryTagScope const memoryTag{ MauCor::MemoryTag::RendererCPU };
+
+		RenderSnapshot& snapshot{ m_Snapshots.GetWriteSnapshot() };
+		snapshot.view = view;
+		snapshot.proj = proj;
 
 		if (m_DebugRenderer)
 		{
+			// Swap instead of copy, the debug renderer gets the (cleared) storage of an older snapshot
+			std::swap(snapshot.debugVertices, m_DebugRenderer->m_ActivePoints);
+			std::swap(snapshot.debugIndices, m_DebugRenderer->m_IndexBuffer);
+
 			m_DebugRenderer->m_ActivePoints.clear();
 			m_DebugRenderer->m_IndexBuffer.clear();
 		}
+
+		m_InstanceCount = static_cast<uint32_t>(snapshot.instances.size() + snapshot.transformInstances.size() + snapshot.batchTransforms.size() + snapshot.batchInstanceTransforms.size());
+
+		m_Snapshots.Publish();
+
+		if constexpr (!MauEng::USE_RENDER_THREAD)
+		{
+			if (RenderSnapshot const* pSnapshot{ m_Snapshots.TryAcquireRead() })
+			{
+				ConsumeSnapshot(*pSnapshot);
+				m_Snapshots.ReleaseRead();
+			}
+		}
 	}
 
 	void VulkanRenderer::ResizeWindow()
@@ -143,16 +189,124 @@ namespace MauRen
 		m_FramebufferResized = true;
 	}
 
-	void VulkanRenderer::QueueDraw(glm::mat4 const& transformMat, MauEng::CStaticMesh const& mesh)
+	void VulkanRenderer::QueueDraw(MauEng::CTransform const& transform, MauEng::CStaticMesh const& mesh)
 	{
-		VulkanMeshManager::GetInstance().QueueDraw(transformMat, mesh.meshID);
+		MauCor::MemoryTagScope const memoryTag{ MauCor::MemoryTag::RendererCPU };
+
+		if constexpr (MauEng::USE_GPU_TRANSFORMS)
+		{
+			m_Snapshots.GetWriteSnapshot().transformInstances.emplace_back(InstanceTransform{ transform.translation, transform.rotation.rotation, transform.scale }, mesh.meshID);
+		}
+		else
+		{
+			m_Snapshots.GetWriteSnapshot().instances.emplace_back(transform.mat, mesh.meshID);
+		}
+	}
+
+	void VulkanRenderer::QueueDraw(MauEng::CInstanceBatch const& batch)
+	{
+		if (0 == batch.Count())
+		{
+			return;
+		}
+
+		MauCor::MemoryTagScope const memoryTag{ MauCor::MemoryTag::RendererCPU };
+		auto& snapshot{ m_Snapshots.GetWriteSnapshot() };
+
+		if constexpr (MauEng::USE_GPU_TRANSFORMS)
+		{
+			auto const first{ static_cast<uint32_t>(snapshot.batchInstanceTransforms.size()) };
+			snapshot.batchInstanceTransforms.resize(first + batch.Count());
+
+			auto const instances{ std::views::iota(0u, batch.Count()) };
+			std::for_each(std::execution::par_unseq, instances.begin(), instances.end(), [&](uint32_t idx)
+				{
+					snapshot.batchInstanceTransforms[first + idx] = { batch.positions[idx], batch.rotations[idx], glm::vec3{ batch.scales[idx] } };
+				});
+
+			snapshot.batches.emplace_back(batch.meshID, first, batch.Count());
+		}
+		else
+		{
+			// The matrices are built straight into the snapshot
+			auto const first{ static_cast<uint32_t>(snapshot.batchTransforms.size()) };
+			snapshot.batchTransforms.resize(first + batch.Count());
+			batch.BuildMatrices({ snapshot.batchTransforms.data() + first, batch.Count() });
+
+			snapshot.batches.emplace_back(batch.meshID, first, batch.Count());
+		}
 	}
 
 	uint32_t VulkanRenderer::LoadOrGetMeshID(char const* path)
 	{
+		// The model, its materials & textures
+		MauCor::MemoryTagScope const memoryTag{ MauCor::MemoryTag::Assets };
+		std::scoped_lock lock{ m_AssetMutex };
 		return VulkanMeshManager::GetInstance().LoadMesh(path, m_CommandPoolManager, m_DescriptorContext);
 	}
 
+	MauCor::AABB VulkanRenderer::GetMeshBounds(uint32_t meshID)
+	{
+		std::scoped_lock lock{ m_AssetMutex };
+		return VulkanMeshManager::GetInstance().GetMeshBounds(meshID);
+	}
+
+	void VulkanRenderer::RenderThreadLoop(std::stop_token const& stopToken)
+	{
+		ME_PROFILE_THREAD("RenderThread")
+		MauCor::MemoryTagScope const memoryTag{ MauCor::MemoryTag::RendererCPU };
+
+		while (!stopToken.stop_requested())
+		{
+			RenderSnapshot const* pSnapshot{ m_Snapshots.AcquireRead(stopToken) };
+			if (!pSnapshot)
+			{
+				break;
+			}
+
+			ConsumeSnapshot(*pSnapshot);
+			m_Snapshots.ReleaseRead();
+		}
+	}
+
+	void VulkanRenderer::ConsumeSnapshot(RenderSnapshot const& snapshot)
+	{
+		ME_PROFILE_FUNCTION()
+
+		{
+			ME_PROFILE_SCOPE("Queue snapshot draws")
+			std::scoped_lock lock{ m_AssetMutex };
+
+			auto& meshManager{ VulkanMeshManager::GetInstance() };
+			if constexpr (MauEng::USE_GPU_TRANSFORMS)
+			{
+				for (auto const& instance : snapshot.transformInstances)
+				{
+					meshManager.QueueDraw(instance.transform, instance.meshID);
+				}
+
+				for (auto const& batch : snapshot.batches)
+				{
+					meshManager.QueueDrawBatch(batch.meshID, std::span<InstanceTransform const>{ snapshot.batchInstanceTransforms.data() + batch.firstTransform, batch.count });
+				}
+			}
+			else
+			{
+				for (auto const& instance : snapshot.instances)
+				{
+					meshManager.QueueDraw(instance.transform, instance.meshID);
+				}
+
+				for (auto const& batch : snapshot.batches)
+				{
+					meshManager.QueueDrawBatch(batch.meshID, std::span<glm::mat4 const>{ snapshot.batchTransforms.data() + batch.firstTransform, batch.count });
+				}
+			}
+		}
+
+		DrawFrame(snapshot);
+	}
+
 	void VulkanRenderer::CreateUniformBuffers()
 	{
 		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
@@ -172,7 +326,7 @@ namespace MauRen
 		}
 	}
 
-	void VulkanRenderer::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+	void VulkanRenderer::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, RenderSnapshot const& snapshot)
 	{
 		ME_PROFILE_FUNCTION()
 #pragma region PRE_DRAW
@@ -187,7 +341,8 @@ namespace MauRen
 			throw std::runtime_error("Failed to begin recording command buffer!");
 		}
 
-		
+		m_GPUProfiler.BeginFrame(commandBuffer, m_CurrentFrame);
+
 		// Image memory barriers
 		auto& depth{ m_SwapChainContext.GetDepthImage() };
 		auto& colour{ m_SwapChainContext.GetColorImage() };
@@ -205,10 +360,18 @@ namespace MauRen
 		scissor.extent = m_SwapChainContext.GetExtent();
 
 		VulkanMeshManager::GetInstance().PreDraw(commandBuffer, m_GraphicsPipeline->GetPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
+
+		if constexpr (MauEng::USE_GPU_TRANSFORMS)
+		{
+			ME_PROFILE_SCOPE("Build transforms")
+			ME_PROFILE_GPU_SCOPE(m_GPUProfiler, commandBuffer, "GPU Build transforms")
+			VulkanMeshManager::GetInstance().BuildTransforms(commandBuffer, m_GraphicsPipeline->GetTransformPipeline(), m_GraphicsPipeline->GetTransformPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
+		}
 #pragma endregion
 #pragma region DEPTH_PREPASS
 		{
 			ME_PROFILE_SCOPE("Depth Prepass")
+			ME_PROFILE_GPU_SCOPE(m_GPUProfiler, commandBuffer, "GPU Depth Prepass")
 			// Depth
 			depth.TransitionImageLayout(commandBuffer,
 				VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
@@ -236,8 +399,11 @@ namespace MauRen
 			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline->GetDepthPrePassPipeline());
-				VulkanMeshManager::GetInstance().Draw(commandBuffer, m_GraphicsPipeline->GetDepthPrePassPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
-				RenderDebug(commandBuffer);
+				{
+					ME_PROFILE_GPU_SCOPE(m_GPUProfiler, commandBuffer, "GPU Depth Prepass draws")
+					VulkanMeshManager::GetInstance().Draw(commandBuffer, m_GraphicsPipeline->GetDepthPrePassPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
+				}
+				RenderDebug(commandBuffer, snapshot);
 			vkCmdEndRendering(commandBuffer);
 		}
 #pragma endregion
@@ -245,6 +411,7 @@ namespace MauRen
 #pragma region MAIN_PASS
 		{
 			ME_PROFILE_SCOPE("Main pass")
+			ME_PROFILE_GPU_SCOPE(m_GPUProfiler, commandBuffer, "GPU Main pass")
 
 			// Colour
 			if (VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL != colour.layout)
@@ -294,8 +461,11 @@ namespace MauRen
 				vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
 				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline->GetPipeline());
-				VulkanMeshManager::GetInstance().Draw(commandBuffer, m_GraphicsPipeline->GetPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
-				RenderDebug(commandBuffer);
+				{
+					ME_PROFILE_GPU_SCOPE(m_GPUProfiler, commandBuffer, "GPU Main pass draws")
+					VulkanMeshManager::GetInstance().Draw(commandBuffer, m_GraphicsPipeline->GetPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
+				}
+				RenderDebug(commandBuffer, snapshot);
 			vkCmdEndRendering(commandBuffer);
 		}
 #pragma endregion
@@ -303,6 +473,8 @@ namespace MauRen
 #pragma region POST_DRAW
 		{
 			ME_PROFILE_SCOPE("Post draw")
+			// Not a GPU timer, it has to end before the command buffer does
+			uint32_t const gpuPostDraw{ m_GPUProfiler.BeginScope(commandBuffer, "GPU Post draw") };
 
 			VulkanMeshManager::GetInstance().PostDraw(commandBuffer, m_GraphicsPipeline->GetPipelineLayout(), 1, &m_DescriptorContext.GetDescriptorSets()[m_CurrentFrame], m_CurrentFrame);
 
@@ -346,6 +518,8 @@ namespace MauRen
 				VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT,
 				VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_MEMORY_READ_BIT);
 
+			m_GPUProfiler.EndScope(commandBuffer, gpuPostDraw);
+
 			if (VK_SUCCESS != vkEndCommandBuffer(commandBuffer))
 			{
 				throw std::runtime_error("Failed to record command buffer!");
@@ -381,14 +555,16 @@ namespace MauRen
 		}
 	}
 
-	void VulkanRenderer::DrawFrame(glm::mat4 const& view, glm::mat4 const& proj)
+	void VulkanRenderer::DrawFrame(RenderSnapshot const& snapshot)
 	{
 		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
 
 		{
 			ME_PROFILE_SCOPE("Wait for GPU")
 			// At the start of the frame, we want to wait until the previous frame has finished, so that the command buffer and semaphores are available to use.
+			uint64_t const waitStart{ MauCor::ReadTraceClock() };
 			vkWaitForFences(deviceContext->GetLogicalDevice(), 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+			m_GPUWaitTicks.store(MauCor::ReadTraceClock() - waitStart, std::memory_order_relaxed);
 		}
 
 		uint32_t imageIndex;
@@ -399,6 +575,8 @@ namespace MauRen
 
 			if (VK_ERROR_OUT_OF_DATE_KHR == acquireNextImageResult)
 			{
+				// Waits for the device & recreates resources, a mesh load could be submitting at the same time
+				std::scoped_lock assetLock{ m_AssetMutex };
 				RecreateSwapchain();
 				return;
 			}
@@ -416,14 +594,20 @@ namespace MauRen
 			vkResetFences(deviceContext->GetLogicalDevice(), 1, &m_InFlightFences[m_CurrentFrame]);
 		}
 
-		UpdateUniformBuffer(m_CurrentFrame, view, proj);
-		UpdateDebugVertexBuffer();
+		UpdateUniformBuffer(m_CurrentFrame, snapshot.view, snapshot.proj);
+
+		// Loading a mesh uses the mesh manager, the command pool & the graphics queue from the game thread, so does the debug vertex upload.
+		// Taken after the fence wait & image acquire, those can take a whole GPU frame
+		std::scoped_lock assetLock{ m_AssetMutex };
+
+		UpdateDebugVertexBuffer(snapshot);
+
 		{
 			ME_PROFILE_SCOPE("Reset command buffer")
 			vkResetCommandBuffer(m_CommandPoolManager.GetCommandBuffer(m_CurrentFrame), 0);
 		}
 
-		RecordCommandBuffer(m_CommandPoolManager.GetCommandBuffer(m_CurrentFrame), imageIndex);
+		RecordCommandBuffer(m_CommandPoolManager.GetCommandBuffer(m_CurrentFrame), imageIndex, snapshot);
 
 		VkSubmitInfo submitInfo{};
 		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -502,7 +686,8 @@ namespace MauRen
 		// It is possible to create a new swap chain while drawing commands on an image from the old swap chain are still in - flight.
 		// You need to pass the previous swap chain to the oldSwapChain field in the VkSwapchainCreateInfoKHR struct and destroy the old swap chain as soon as you've finished using it.
 
-		if (SDL_GetWindowFlags(m_pWindow) & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN))
+		// SDL events may only be pumped on the main thread, the game loop already skips rendering while minimized
+		if (!MauEng::USE_RENDER_THREAD && (SDL_GetWindowFlags(m_pWindow) & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN)))
 		{
 			SDL_Event event;
 			while (SDL_PollEvent(&event))
@@ -527,7 +712,7 @@ namespace MauRen
 		return true;
 	}
 
-	void VulkanRenderer::UpdateDebugVertexBuffer()
+	void VulkanRenderer::UpdateDebugVertexBuffer(RenderSnapshot const& snapshot)
 	{
 		//TODO use VulkanMappedBuffer
 
@@ -540,14 +725,14 @@ namespace MauRen
 
 		auto const deviceContext{ VulkanDeviceContextManager::GetInstance().GetDeviceContext() };
 
-		if (m_DebugRenderer->m_ActivePoints.empty())
+		if (snapshot.debugVertices.empty())
 		{
 			return;
 		}
 
 		// Map the vertex buffer memory
 		{
-			size_t const bufferSize{ sizeof(m_DebugRenderer->m_ActivePoints[0]) * m_DebugRenderer->m_ActivePoints.size() };
+			size_t const bufferSize{ sizeof(snapshot.debugVertices[0]) * snapshot.debugVertices.size() };
 
 			VulkanBuffer stagingBuffer
 			{
@@ -560,7 +745,7 @@ namespace MauRen
 			vkMapMemory(deviceContext->GetLogicalDevice(), stagingBuffer.bufferMemory, 0, bufferSize, 0, &mappedMemory);
 
 			// Copy the data to the buffer
-			memcpy(mappedMemory, m_DebugRenderer->m_ActivePoints.data(), bufferSize);
+			memcpy(mappedMemory, snapshot.debugVertices.data(), bufferSize);
 
 			// Unmap the memory
 			vkUnmapMemory(deviceContext->GetLogicalDevice(), stagingBuffer.bufferMemory);
@@ -570,7 +755,7 @@ namespace MauRen
 		}
 
 		{
-			size_t const bufferSize{ sizeof(m_DebugRenderer->m_IndexBuffer[0]) * m_DebugRenderer->m_IndexBuffer.size() };
+			size_t const bufferSize{ sizeof(snapshot.debugIndices[0]) * snapshot.debugIndices.size() };
 
 			VulkanBuffer stagingBuffer
 			{
@@ -583,7 +768,7 @@ namespace MauRen
 			vkMapMemory(deviceContext->GetLogicalDevice(), stagingBuffer.bufferMemory, 0, bufferSize, 0, &mappedMemory);
 
 			// Copy the data to the buffer
-			memcpy(mappedMemory, m_DebugRenderer->m_IndexBuffer.data(), bufferSize);
+			memcpy(mappedMemory, snapshot.debugIndices.data(), bufferSize);
 
 			// Unmap the memory
 			vkUnmapMemory(deviceContext->GetLogicalDevice(), stagingBuffer.bufferMemory);
@@ -594,7 +779,7 @@ namespace MauRen
 
 	}
 
-	void VulkanRenderer::RenderDebug(VkCommandBuffer commandBuffer)
+	void VulkanRenderer::RenderDebug(VkCommandBuffer commandBuffer, RenderSnapshot const& snapshot)
 	{
 		ME_PROFILE_FUNCTION()
 
@@ -608,7 +793,7 @@ namespace MauRen
 		VkDeviceSize constexpr offset{ 0 };
 		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_DebugVertexBuffer.buffer, &offset);
 		vkCmdBindIndexBuffer(commandBuffer, m_DebugIndexBuffer.buffer, offset, VK_INDEX_TYPE_UINT32);
-		vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(m_DebugRenderer->m_IndexBuffer.size()), 1, 0, 0, 0);
+		vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(snapshot.debugIndices.size()), 1, 0, 0, 0);
 
 	}
 }
@@ -3,6 +3,9 @@
 
 #include "RendererPCH.h"
 
+#include <thread>
+#include <atomic>
+
 #include "Renderer.h"
 
 #include "VulkanInstanceContext.h"
@@ -13,12 +16,14 @@
 #include "VulkanSwapchainContext.h"
 #include "VulkanGraphicsPipeline.h"
 #include "VulkanCommandPoolManager.h"
+#include "VulkanGPUProfiler.h"
 
 #include "VulkanBuffer.h"
 
 #include "Assets/VulkanImage.h"
 
 #include "DebugRenderer/DebugVertex.h"
+#include "RenderSnapshot.h"
 
 // Sources
 // https://github.com/KhronosGroup/Vulkan-Docs/wiki/Synchronization-Examples#swapchain-image-acquire-and-present
@@ -28,6 +33,8 @@
 namespace MauEng
 {
 	struct CStaticMesh;
+	struct CTransform;
+	struct CInstanceBatch;
 }
 
 namespace MauRen
@@ -44,8 +51,12 @@ namespace MauRen
 		virtual void Render(glm::mat4 const& view, glm::mat4 const& proj) override;
 		virtual void ResizeWindow() override;
 
-		virtual void QueueDraw(glm::mat4 const& transformMat, MauEng::CStaticMesh const& mesh) override;
+		virtual void QueueDraw(MauEng::CTransform const& transform, MauEng::CStaticMesh const& mesh) override;
+		virtual void QueueDraw(MauEng::CInstanceBatch const& batch) override;
 		virtual [[nodiscard]] uint32_t LoadOrGetMeshID(char const* path) override;
+		virtual [[nodiscard]] MauCor::AABB GetMeshBounds(uint32_t meshID) override;
+		virtual [[nodiscard]] uint64_t GetGPUWaitTicks() const noexcept override { return m_GPUWaitTicks.load(std::memory_order_relaxed); }
+		virtual [[nodiscard]] uint32_t GetInstanceCount() const noexcept override { return m_InstanceCount; }
 
 		VulkanRenderer(VulkanRenderer const&) = delete;
 		VulkanRenderer(VulkanRenderer&&) = delete;
@@ -67,6 +78,8 @@ namespace MauRen
 		VulkanGraphicsPipeline* m_GraphicsPipeline{};
 
 		VulkanCommandPoolManager m_CommandPoolManager{};
+		// Times the passes on the GPU (USE_GPU_PROFILER)
+		VulkanGPUProfiler m_GPUProfiler{};
 
 		// Signal that an image has been acquired from the swapchain and is ready for rendering
 		std::vector<VkSemaphore> m_ImageAvailableSemaphores{};
@@ -79,7 +92,17 @@ namespace MauRen
 
 		uint32_t m_CurrentFrame{ 0 };
 
-		bool m_FramebufferResized{ false };
+		std::atomic<bool> m_FramebufferResized{ false };
+		// Written by the thread that draws, read by the game loop's frame timer
+		std::atomic<uint64_t> m_GPUWaitTicks{ 0 };
+		// Game thread only
+		uint32_t m_InstanceCount{ 0 };
+
+		// Game thread records into the write snapshot, the render thread consumes the published ones
+		RenderSnapshotBuffer m_Snapshots{};
+		std::jthread m_RenderThread{};
+		// Guards the asset managers, meshes can be loaded on the game thread while the render thread is drawing
+		std::mutex m_AssetMutex{};
 
 		struct alignas(16) UniformBufferObject final
 		{
@@ -104,17 +127,21 @@ namespace MauRen
 
 		void CreateSyncObjects();
 
-		void DrawFrame(glm::mat4 const& view, glm::mat4 const& proj);
-		void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+		void RenderThreadLoop(std::stop_token const& stopToken);
+		// Queue all instances of the snapshot & draw it, called on the render thread (or inline when not threaded)
+		void ConsumeSnapshot(RenderSnapshot const& snapshot);
+
+		void DrawFrame(RenderSnapshot const& snapshot);
+		void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, RenderSnapshot const& snapshot);
 		void UpdateUniformBuffer(uint32_t currentImage, glm::mat4 const& view, glm::mat4 const& proj);
 
 		// Recreate the swapchain on e.g a window resize
 		bool RecreateSwapchain();
 
 		// Update the buffer for debug drawing
-		void UpdateDebugVertexBuffer();
+		void UpdateDebugVertexBuffer(RenderSnapshot const& snapshot);
 
-		void RenderDebug(VkCommandBuffer commandBuffer);
+		void RenderDebug(VkCommandBuffer commandBuffer, RenderSnapshot const& snapshot);
 	};
 }
 
@@ -165,6 +165,17 @@ namespace MauRen
 			sampler = VK_NULL_HANDLE;
 			return true;
 		}
+		inline bool SafeDestroy(VkDevice device, VkQueryPool& queryPool, VkAllocationCallbacks const* pAllocator)
+		{
+			if (queryPool == VK_NULL_HANDLE)
+			{
+				return false;
+			}
+
+			vkDestroyQueryPool(device, queryPool, pAllocator);
+			queryPool = VK_NULL_HANDLE;
+			return true;
+		}
 #pragma endregion
 
 		inline [[nodiscard]] uint32_t FindMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties)
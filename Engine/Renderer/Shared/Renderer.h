@@ -2,10 +2,13 @@
 #define MAUREN_RENDERER_H
 
 #include "MeshInstance.h"
+#include "Math/BoundingVolumes.h"
 
 namespace MauEng
 {
 	struct CStaticMesh;
+	struct CTransform;
+	struct CInstanceBatch;
 }
 
 struct SDL_Window;
@@ -24,8 +27,18 @@ namespace MauRen
 
 		virtual void ResizeWindow() = 0;
 
-		virtual void QueueDraw(glm::mat4 const& transformMat, MauEng::CStaticMesh const& mesh) = 0;
+		// Uses the matrix of the transform, or its translation, rotation & scale with USE_GPU_TRANSFORMS
+		virtual void QueueDraw(MauEng::CTransform const& transform, MauEng::CStaticMesh const& mesh) = 0;
+		// Queues all instances of the batch as one block
+		virtual void QueueDraw(MauEng::CInstanceBatch const& batch) = 0;
 		virtual [[nodiscard]] uint32_t LoadOrGetMeshID(char const* path) = 0;
+		// Local space bounds of all vertices of the mesh
+		virtual [[nodiscard]] MauCor::AABB GetMeshBounds(uint32_t meshID) = 0;
+
+		// How long the last drawn frame waited for the GPU to finish the frame before it, in trace clock ticks
+		virtual [[nodiscard]] uint64_t GetGPUWaitTicks() const noexcept = 0;
+		// Instances (single meshes & every instance of a batch) queued for the last frame handed to Render
+		virtual [[nodiscard]] uint32_t GetInstanceCount() const noexcept = 0;
 
 		Renderer(Renderer const&) = delete;
 		Renderer(Renderer&&) = delete;
@@ -5,6 +5,18 @@
 
 namespace MauGam
 {
+	namespace
+	{
+		// splitmix64, neighbouring indices get unrelated generator states
+		[[nodiscard]] uint64_t MixSeed(uint64_t value) noexcept
+		{
+			value += 0x9E3779B97F4A7C15ull;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+			return value ^ (value >> 31);
+		}
+	}
+
 	ECSTestScene::ECSTestScene()
 	{
 		ME_PROFILE_FUNCTION()
@@ -59,19 +71,25 @@ namespace MauGam
 		uint32_t constexpr NUM_INSTANCES{ 100'000 };
 		if constexpr (ENABLE_HIGH_INSTANCE_TEST)
 		{
-			std::random_device rd;  // Random device for seed 
-			std::mt19937 gen(rd()); // Mersenne Twister generator
-			std::uniform_real_distribution<float> dis(-300.0f, 300); // Random translation range
+			// Note: spider has no normal map (scaling is a little off)
+			CTransform spiderTransform{};
+			spiderTransform.Scale({ .05f, .05f, .05f });
 
-			for (size_t i { 0 }; i < NUM_INSTANCES; i++)
-			{
-				// Note: spider has no normal map (scaling is a little off)
-				Entity entSpider{ CreateEntity() }; 
-				auto& transform{ entSpider.GetComponent<CTransform>() };
-				transform.Translate({ dis(gen), dis(gen), dis(gen) });
-				transform.Scale({ .05f, .05f, .05f });
-				entSpider.AddComponent<CStaticMesh>("Resources/Models/Spider/spider.obj");
-			}
+			// The mesh is only looked up once, every spider gets a copy of the prototype
+			ECS::Prototype const spider{ spiderTransform, CStaticMesh{ "Resources/Models/Spider/spider.obj" } };
+
+			// Fixed, every run (and benchmark) gets the same spiders
+			uint64_t constexpr SPAWN_SEED{ 1'337 };
+
+			CreateEntities(NUM_INSTANCES, spider, [](uint32_t idx, CTransform& transform, CStaticMesh const&)
+				{
+					// Generator per entity, init runs in parallel so a shared generator can not be used.
+					// Consecutive minstd seeds give outputs linear in the index (the spiders end up on a lattice), mix it first
+					std::minstd_rand gen(static_cast<uint32_t>(MixSeed(SPAWN_SEED ^ idx)));
+					std::uniform_real_distribution<float> dis(-300.0f, 300); // Random translation range
+
+					transform.Translate({ dis(gen), dis(gen), dis(gen) });
+				}, std::execution::par_unseq);
 		}
 
 
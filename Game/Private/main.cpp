@@ -1,4 +1,10 @@
+#include <cmath>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glm/gtc/constants.hpp>
 
 #include "Engine.h"
 
@@ -8,16 +14,65 @@
 #include "ECSTestScene.h"
 
 void InitDemoScene();
+MauEng::CameraPath CreateFlythroughPath();
 
 // SDL needs to be able to overwrite main depending on the platform here
 #include "SDL3/SDL.h"
 #include "SDL3/SDL_main.h"
-int main(int, char* [])
+int main(int argc, char* argv[])
 {
 	using namespace MauEng;
-	Engine engine{};
 
-	engine.Run(InitDemoScene);
+	// --benchmark [--windowed] [--trace] [--frames N] [--output path]
+	bool isBenchmark{ false };
+	bool isWindowed{ false };
+	BenchmarkSettings settings{};
+
+	for (int arg{ 1 }; arg < argc; ++arg)
+	{
+		std::string_view const option{ argv[arg] };
+		bool const hasValue{ arg + 1 < argc };
+
+		if (option == "--benchmark")
+		{
+			isBenchmark = true;
+		}
+		else if (option == "--windowed")
+		{
+			isWindowed = true;
+		}
+		else if (option == "--trace")
+		{
+			settings.captureTrace = true;
+		}
+		else if (option == "--frames" and hasValue)
+		{
+			settings.frameCount = static_cast<uint32_t>(std::stoul(argv[++arg]));
+		}
+		else if (option == "--output" and hasValue)
+		{
+			settings.outputPath = argv[++arg];
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << option << '\n';
+			return 1;
+		}
+	}
+
+	if (not isBenchmark)
+	{
+		Engine engine{};
+		engine.Run(InitDemoScene);
+
+		return 0;
+	}
+
+	settings.cameraPath = CreateFlythroughPath();
+
+	// Headless unless asked otherwise, only the windowed run has GPU pass timings
+	Engine engine{ isWindowed ? EngineMode::Windowed : EngineMode::Headless };
+	engine.RunBenchmark(InitDemoScene, settings);
 
 	return 0;
 }
@@ -28,4 +83,26 @@ void InitDemoScene()
 
 	MauEng::SceneManager::GetInstance().LoadScene(std::make_unique<ECSTestScene>());
 	//MauEng::SceneManager::GetInstance().LoadScene(std::make_unique<DebugDrawingScene>());
-}
\ No newline at end of file
+}
+
+// Circles the spider cube of the ECS test scene looking at its center, one lap every 16 seconds
+MauEng::CameraPath CreateFlythroughPath()
+{
+	float constexpr RADIUS{ 500.f };
+	float constexpr HEIGHT{ 120.f };
+	float constexpr SECONDS_PER_KEY{ 2.f };
+	uint32_t constexpr KEY_COUNT{ 8 };
+
+	std::vector<MauEng::CameraPathKey> keys{};
+	for (uint32_t key{ 0 }; key <= KEY_COUNT; ++key)
+	{
+		float const angle{ glm::two_pi<float>() * static_cast<float>(key) / static_cast<float>(KEY_COUNT) };
+		keys.push_back({
+			.timeSec = static_cast<float>(key) * SECONDS_PER_KEY,
+			.position = { std::cos(angle) * RADIUS, HEIGHT, std::sin(angle) * RADIUS },
+			.target = { 0.f, 0.f, 0.f }
+		});
+	}
+
+	return MauEng::CameraPath{ std::move(keys) };
+}
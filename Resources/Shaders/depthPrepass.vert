@@ -9,6 +9,7 @@ layout(set = 0, binding = 0) uniform UniformBufferObject
 struct MeshInstanceData
 {
     mat4 modelMatrix;
+    mat3 normalMatrix;  // transpose(inverse(mat3(modelMatrix))), built once per instance
     uint meshIndex;     // Index into MeshData[]
     uint materialIndex; // Index into MaterialData[]
 
@@ -12,10 +12,10 @@ layout(set = 0, binding = 0) uniform UniformBufferObject
 //      glm::vec4 tangent; // .xyz = tangent vector, .w = handedness
 //      glm::vec2 texCoord;
 
-// glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMatrix)));
 struct MeshInstanceData
 {
     mat4 modelMatrix;
+    mat3 normalMatrix;  // transpose(inverse(mat3(modelMatrix))), built once per instance
     uint meshIndex;     // Index into MeshData[]
     uint materialIndex; // Index into MaterialData[]
 
@@ -46,7 +46,7 @@ void main()
 
     gl_Position = ubo.viewProj * model * vec4(inPosition, 1.0);
 
-    mat3 normalMatrix = transpose(inverse(mat3(model)));
+    mat3 normalMatrix = instance.normalMatrix;
 
     outTangent = vec4(normalMatrix * inTangent.xyz, inTangent.w);
     outNormal = normalize(normalMatrix * inNormal);
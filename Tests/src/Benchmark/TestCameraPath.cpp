@@ -0,0 +1,46 @@
+#include <doctest/doctest.h>
+
+#include "Benchmark.h"
+
+using namespace MauEng;
+
+TEST_CASE("Camera path interpolates between its keys")
+{
+	// Out of order on purpose, the path sorts them
+	CameraPath const path{ {
+		{ .timeSec = 2.f, .position = { 10.f, 0.f, 0.f }, .target = { 0.f, 0.f, 10.f } },
+		{ .timeSec = 0.f, .position = { 0.f, 0.f, 0.f }, .target = { 0.f, 0.f, 0.f } },
+		{ .timeSec = 4.f, .position = { 10.f, 20.f, 0.f }, .target = { 0.f, 0.f, 10.f } }
+	} };
+
+	REQUIRE(not path.IsEmpty());
+	CHECK(path.GetDuration() == doctest::Approx(4.f));
+
+	auto const halfway{ path.Sample(1.f) };
+	CHECK(halfway.position.x == doctest::Approx(5.f));
+	CHECK(halfway.target.z == doctest::Approx(5.f));
+
+	auto const onKey{ path.Sample(2.f) };
+	CHECK(onKey.position.x == doctest::Approx(10.f));
+	CHECK(onKey.position.y == doctest::Approx(0.f));
+
+	auto const secondSegment{ path.Sample(3.f) };
+	CHECK(secondSegment.position.x == doctest::Approx(10.f));
+	CHECK(secondSegment.position.y == doctest::Approx(10.f));
+}
+
+TEST_CASE("Camera path clamps to its first & last key")
+{
+	CameraPath const path{ {
+		{ .timeSec = 1.f, .position = { 1.f, 2.f, 3.f }, .target = {} },
+		{ .timeSec = 2.f, .position = { 4.f, 5.f, 6.f }, .target = {} }
+	} };
+
+	CHECK(path.Sample(-5.f).position.x == doctest::Approx(1.f));
+	CHECK(path.Sample(0.f).position.z == doctest::Approx(3.f));
+	CHECK(path.Sample(100.f).position.y == doctest::Approx(5.f));
+
+	CameraPath const empty{};
+	CHECK(empty.IsEmpty());
+	CHECK(empty.GetDuration() == doctest::Approx(0.f));
+}
@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "Components/CInstanceBatch.h"
+#include "Components/CTransform.h"
+
+namespace
+{
+	// No renderer in the tests, the bounds are passed in
+	MauCor::AABB const UNIT_BOX{ glm::vec3{ -1.f }, glm::vec3{ 1.f } };
+}
+
+TEST_CASE("CInstanceBatch add & remove keep the arrays in step")
+{
+	MauEng::CInstanceBatch batch{ 0, UNIT_BOX };
+
+	for (uint32_t i{ 0 }; i < 4; ++i)
+	{
+		CHECK(batch.AddInstance(glm::vec3{ static_cast<float>(i) }) == i);
+	}
+
+	batch.RemoveInstance(1);
+
+	REQUIRE(batch.Count() == 3);
+	CHECK(batch.rotations.size() == 3);
+	CHECK(batch.scales.size() == 3);
+	// The last instance took the freed slot
+	CHECK(batch.positions[1] == glm::vec3{ 3.f });
+
+	batch.Clear();
+	CHECK(batch.Count() == 0);
+}
+
+TEST_CASE("CInstanceBatch matrices match CTransform")
+{
+	MauEng::CInstanceBatch batch{ 0, UNIT_BOX };
+
+	glm::vec3 constexpr position{ 10.f, -2.f, 4.f };
+	// 90-degree rotation around Y-axis
+	glm::quat constexpr rotation{ 0.707f, 0.f, 0.707f, 0.f };
+	float constexpr scale{ 2.f };
+
+	batch.AddInstance(glm::vec3{ 0.f });
+	batch.AddInstance(position, rotation, scale);
+
+	std::vector<glm::mat4> matrices(batch.Count());
+	batch.BuildMatrices(matrices);
+
+	MauEng::CTransform transform{ position, rotation, glm::vec3{ scale } };
+	glm::mat4 const expected{ transform.GetMatrix() };
+
+	CHECK(matrices[0] == glm::mat4{ 1.f });
+	for (glm::length_t col{ 0 }; col < 4; ++col)
+	{
+		for (glm::length_t row{ 0 }; row < 4; ++row)
+		{
+			CHECK(matrices[1][col][row] == doctest::Approx(expected[col][row]));
+		}
+	}
+}
+
+TEST_CASE("CInstanceBatch bounds contain every rotated & scaled instance")
+{
+	MauEng::CInstanceBatch batch{ 0, UNIT_BOX };
+
+	batch.AddInstance(glm::vec3{ -50.f, 0.f, 0.f }, glm::quat{ 0.924f, 0.383f, 0.f, 0.f });
+	batch.AddInstance(glm::vec3{ 50.f, 10.f, 0.f }, glm::quat{ 1.f, 0.f, 0.f, 0.f }, 3.f);
+
+	auto const bounds{ batch.ComputeBounds() };
+
+	std::vector<glm::mat4> matrices(batch.Count());
+	batch.BuildMatrices(matrices);
+
+	for (auto const& matrix : matrices)
+	{
+		for (int corner{ 0 }; corner < 8; ++corner)
+		{
+			glm::vec3 const local{ (corner & 1) ? 1.f : -1.f, (corner & 2) ? 1.f : -1.f, (corner & 4) ? 1.f : -1.f };
+			glm::vec3 const world{ matrix * glm::vec4{ local, 1.f } };
+
+			CHECK(bounds.Contains(MauCor::AABB{ world, world }));
+		}
+	}
+}
+
+TEST_CASE("CInstanceBatch caches its bounds until the instances change")
+{
+	MauEng::CInstanceBatch batch{ 0, UNIT_BOX };
+	batch.AddInstance(glm::vec3{ 0.f });
+
+	auto const first{ batch.GetBounds() };
+	CHECK_FALSE(batch.isDirty);
+
+	// Not tracked, the cached bounds stay until marked dirty
+	batch.positions[0] = glm::vec3{ 100.f };
+	CHECK(batch.GetBounds().max == first.max);
+
+	batch.isDirty = true;
+	CHECK(batch.GetBounds().Contains(MauCor::AABB{ glm::vec3{ 100.f }, glm::vec3{ 100.f } }));
+
+	batch.SetInstance(0, glm::vec3{ -100.f }, glm::quat{ 1.f, 0.f, 0.f, 0.f }, 1.f);
+	CHECK(batch.isDirty);
+	CHECK(batch.GetBounds().Contains(MauCor::AABB{ glm::vec3{ -100.f }, glm::vec3{ -100.f } }));
+
+	batch.AddInstance(glm::vec3{ 200.f });
+	CHECK(batch.GetBounds().Contains(MauCor::AABB{ glm::vec3{ 200.f }, glm::vec3{ 200.f } }));
+
+	batch.RemoveInstance(1);
+	CHECK(batch.GetBounds().max.x < 200.f);
+}
+
+TEST_CASE("CInstanceBatch stores an instance in 32 bytes")
+{
+	MauEng::CInstanceBatch batch{ 0, UNIT_BOX };
+	batch.Reserve(1'000);
+
+	CHECK(batch.MemoryBytes() == 1'000 * (sizeof(glm::vec3) + sizeof(glm::quat) + sizeof(float)));
+	CHECK(batch.MemoryBytes() == 32'000);
+}
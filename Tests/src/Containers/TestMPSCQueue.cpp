@@ -0,0 +1,98 @@
+#include <doctest/doctest.h>
+
+#include <thread>
+#include <vector>
+
+#include "Containers/MPSCQueue.h"
+
+using namespace MauCor;
+
+TEST_CASE("MPSC queue is FIFO & bounded")
+{
+	MPSCQueue<int> queue{ 3 };
+
+	// Rounded up to a power of two
+	CHECK(queue.Capacity() == 4);
+	CHECK(queue.Empty());
+
+	for (int i{ 0 }; i < 4; ++i)
+	{
+		CHECK(queue.TryPush(i));
+	}
+	CHECK_FALSE(queue.TryPush(4));
+	CHECK(queue.Size() == 4);
+
+	int value{ -1 };
+	CHECK(queue.TryPop([&](int v) { value = v; }));
+	CHECK(value == 0);
+
+	// The freed slot is reused
+	CHECK(queue.TryPush(4));
+
+	for (int expected{ 1 }; expected <= 4; ++expected)
+	{
+		CHECK(queue.TryPop([&](int v) { value = v; }));
+		CHECK(value == expected);
+	}
+
+	CHECK_FALSE(queue.TryPop([&](int v) { value = v; }));
+	CHECK(queue.Empty());
+	CHECK(queue.PushCount() == 5);
+	CHECK(queue.PopCount() == 5);
+}
+
+TEST_CASE("MPSC queue keeps every value of concurrent producers")
+{
+	struct Value final
+	{
+		uint32_t producer{};
+		uint32_t sequence{};
+	};
+
+	uint32_t constexpr PRODUCER_COUNT{ 4 };
+	uint32_t constexpr VALUES_PER_PRODUCER{ 20'000 };
+
+	// Small on purpose, producers keep running into a full queue
+	MPSCQueue<Value> queue{ 64 };
+
+	std::vector<std::jthread> producers{};
+	for (uint32_t producer{ 0 }; producer < PRODUCER_COUNT; ++producer)
+	{
+		producers.emplace_back([&queue, producer]
+			{
+				for (uint32_t sequence{ 0 }; sequence < VALUES_PER_PRODUCER; ++sequence)
+				{
+					while (!queue.TryPush(Value{ producer, sequence }))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+
+	// Values of one producer come out in the order it pushed them
+	std::vector<uint32_t> nextSequence(PRODUCER_COUNT, 0);
+	bool inOrder{ true };
+	uint32_t popped{ 0 };
+
+	while (popped < PRODUCER_COUNT * VALUES_PER_PRODUCER)
+	{
+		bool const hasValue{ queue.TryPop([&](Value const& value)
+			{
+				inOrder &= value.sequence == nextSequence[value.producer];
+				nextSequence[value.producer] = value.sequence + 1;
+			}) };
+
+		if (hasValue)
+		{
+			++popped;
+		}
+	}
+
+	CHECK(inOrder);
+	CHECK(queue.Empty());
+	for (auto const sequence : nextSequence)
+	{
+		CHECK(sequence == VALUES_PER_PRODUCER);
+	}
+}
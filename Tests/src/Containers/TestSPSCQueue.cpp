@@ -0,0 +1,66 @@
+#include <doctest/doctest.h>
+
+#include <thread>
+#include <vector>
+
+#include "Containers/SPSCQueue.h"
+
+using namespace MauCor;
+
+TEST_CASE("SPSC queue is FIFO & bounded")
+{
+	SPSCQueue<int> queue{ 3 };
+
+	// Rounded up to a power of two
+	CHECK(queue.Capacity() == 4);
+	CHECK(queue.Empty());
+
+	for (int i{ 0 }; i < 4; ++i)
+	{
+		CHECK(queue.TryPush(i));
+	}
+	CHECK_FALSE(queue.TryPush(4));
+	CHECK(queue.Size() == 4);
+
+	std::vector<int> values{};
+	CHECK(queue.PopAll([&](int v) { values.emplace_back(v); }) == 4);
+	CHECK(values == std::vector{ 0, 1, 2, 3 });
+	CHECK(queue.Empty());
+
+	// Wraps around
+	CHECK(queue.TryPush(4));
+	CHECK(queue.TryPush(5));
+	values.clear();
+	CHECK(queue.PopAll([&](int v) { values.emplace_back(v); }) == 2);
+	CHECK(values == std::vector{ 4, 5 });
+	CHECK(queue.PopAll([&](int v) { values.emplace_back(v); }) == 0);
+}
+
+TEST_CASE("SPSC queue keeps every value of a concurrent producer")
+{
+	uint32_t constexpr VALUE_COUNT{ 100'000 };
+
+	// Small on purpose, the producer keeps running into a full queue
+	SPSCQueue<uint32_t> queue{ 64 };
+
+	std::jthread producer{ [&queue]
+		{
+			for (uint32_t i{ 0 }; i < VALUE_COUNT; ++i)
+			{
+				while (!queue.TryPush(i))
+				{
+					std::this_thread::yield();
+				}
+			}
+		} };
+
+	uint32_t expected{ 0 };
+	bool isInOrder{ true };
+	while (expected < VALUE_COUNT)
+	{
+		queue.PopAll([&](uint32_t value) { isInOrder = isInOrder && value == expected++; });
+	}
+
+	CHECK(isInOrder);
+	CHECK(queue.Empty());
+}
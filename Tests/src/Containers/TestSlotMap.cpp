@@ -0,0 +1,65 @@
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "Containers/SlotMap.h"
+
+using namespace MauCor;
+
+TEST_CASE("Slot map hands out dense handles")
+{
+	SlotMap<std::string> slotMap{};
+
+	auto const first{ slotMap.Emplace("first") };
+	auto const second{ slotMap.Emplace("second") };
+
+	// Generation 0, the handle is the slot index
+	CHECK(first == 0);
+	CHECK(second == 1);
+	CHECK(slotMap.Size() == 2);
+
+	CHECK(slotMap.Get(first) == "first");
+	CHECK(slotMap.Get(second) == "second");
+	CHECK_FALSE(slotMap.IsValid(UINT32_MAX));
+	CHECK(slotMap.TryGet(2) == nullptr);
+}
+
+TEST_CASE("Slot map detects stale handles")
+{
+	SlotMap<int> slotMap{};
+
+	auto const first{ slotMap.Emplace(1) };
+	auto const second{ slotMap.Emplace(2) };
+
+	slotMap.Erase(first);
+	CHECK_FALSE(slotMap.IsValid(first));
+	CHECK(slotMap.TryGet(first) == nullptr);
+	CHECK(slotMap.Size() == 1);
+
+	// Reuses the slot with a new generation
+	auto const reused{ slotMap.Emplace(3) };
+	CHECK(SlotMap<int>::Handle::Index(reused) == SlotMap<int>::Handle::Index(first));
+	CHECK(reused != first);
+	CHECK_FALSE(slotMap.IsValid(first));
+	CHECK(slotMap.Get(reused) == 3);
+	CHECK(slotMap.Get(second) == 2);
+	CHECK(slotMap.SlotCount() == 2);
+}
+
+TEST_CASE("Slot map generations wrap without making the invalid handle")
+{
+	SlotMap<int, 4> slotMap{};
+
+	auto handle{ slotMap.Emplace(0) };
+	for (int i{ 1 }; i < 100'000; ++i)
+	{
+		slotMap.Erase(handle);
+
+		auto const next{ slotMap.Emplace(i) };
+		CHECK_FALSE(slotMap.IsValid(handle));
+		REQUIRE(next != SlotMap<int, 4>::Handle::INVALID);
+		handle = next;
+	}
+
+	CHECK(slotMap.Get(handle) == 99'999);
+}
@@ -0,0 +1,121 @@
+#include <doctest/doctest.h>
+#include <execution>
+#include <numeric>
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+namespace
+{
+	struct CHealth final { int value{}; };
+	struct CDead final {};
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("Command buffer creates entities with components on playback")
+{
+	ECSWorld world{};
+	auto& commands{ world.GetCommandBuffer() };
+
+	auto const pending{ commands.CreateEntity() };
+	commands.AddComponent(pending, CHealth{ 10 });
+
+	CHECK(world.ComponentCount<CHealth>() == 0);
+
+	world.FlushCommands();
+
+	CHECK(world.ComponentCount<CHealth>() == 1);
+	world.View<CHealth>().Each([](CHealth const& h) { CHECK(h.value == 10); });
+	CHECK(commands.IsEmpty());
+}
+
+TEST_CASE("Command buffer records from parallel code")
+{
+	ECSWorld world{};
+	auto& commands{ world.GetCommandBuffer() };
+
+	std::vector<int> values(10'000);
+	std::iota(values.begin(), values.end(), 0);
+
+	std::for_each(std::execution::par, values.begin(), values.end(), [&commands](int value)
+		{
+			auto const pending{ commands.CreateEntity() };
+			commands.AddComponent(pending, CHealth{ value });
+
+			if (value % 2)
+			{
+				commands.AddComponent<CDead>(pending);
+			}
+		});
+
+	world.FlushCommands();
+
+	CHECK(world.ComponentCount<CHealth>() == values.size());
+	CHECK(world.ComponentCount<CDead>() == values.size() / 2);
+
+	long long sum{ 0 };
+	world.View<CHealth>().Each([&sum](CHealth const& h) { sum += h.value; });
+	CHECK(sum == std::accumulate(values.begin(), values.end(), 0ll));
+}
+
+TEST_CASE("Command buffer removes components & destroys entities")
+{
+	ECSWorld world{};
+
+	std::vector<EntityID> ids{};
+	for (int i{ 0 }; i < 10; ++i)
+	{
+		auto const entity{ world.CreateEntity() };
+		world.AddComponent<CHealth>(entity.ID(), i);
+		ids.emplace_back(entity.ID());
+	}
+
+	auto& commands{ world.GetCommandBuffer() };
+	commands.RemoveComponent<CHealth>(ids[0]);
+	commands.DestroyEntity(ids[1]);
+	// Destroying twice is fine
+	commands.DestroyEntity(ids[1]);
+	// Adding an existing component replaces it
+	commands.AddComponent(ids[2], CHealth{ 100 });
+
+	world.FlushCommands();
+
+	CHECK(world.IsValid(ids[0]));
+	CHECK_FALSE(world.HasComponent<CHealth>(ids[0]));
+	CHECK_FALSE(world.IsValid(ids[1]));
+	CHECK(world.GetComponent<CHealth>(ids[2]).value == 100);
+	CHECK(world.ComponentCount<CHealth>() == 8);
+}
+
+TEST_CASE("Command buffer plays adds & removes of one component back in record order")
+{
+	ECSWorld world{};
+
+	auto const added{ world.CreateEntity() };
+	auto const swapped{ world.CreateEntity() };
+	world.AddComponent<CHealth>(swapped.ID(), 1);
+
+	auto& commands{ world.GetCommandBuffer() };
+
+	// Add then remove, the component is gone
+	commands.AddComponent(added.ID(), CHealth{ 10 });
+	commands.RemoveComponent<CHealth>(added.ID());
+	auto const pending{ commands.CreateEntity() };
+	commands.AddComponent<CDead>(pending);
+	commands.RemoveComponent<CDead>(pending);
+
+	// Remove then add, the entity has the added component
+	commands.RemoveComponent<CHealth>(swapped.ID());
+	commands.AddComponent(swapped.ID(), CHealth{ 20 });
+	commands.RemoveComponent<CDead>(added.ID());
+	commands.AddComponent<CDead>(added.ID());
+
+	world.FlushCommands();
+
+	CHECK_FALSE(world.HasComponent<CHealth>(added.ID()));
+	CHECK(world.HasComponent<CDead>(added.ID()));
+	CHECK(world.GetComponent<CHealth>(swapped.ID()).value == 20);
+	CHECK(world.ComponentCount<CHealth>() == 1);
+	CHECK(world.ComponentCount<CDead>() == 1);
+}
@@ -0,0 +1,75 @@
+#include <doctest/doctest.h>
+
+#include "Memory/PageArena.h"
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+namespace
+{
+	struct CPosition final { float x{}, y{}, z{}; };
+	struct CMesh final { uint32_t meshID{}; };
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("Component pools allocate from the memory resource of the world")
+{
+	MauCor::PageArena arena{};
+
+	{
+		ECSWorld world{ &arena };
+		Prototype const prototype{ CPosition{}, CMesh{ 3 } };
+
+		auto const ids{ world.CreateEntities(10'000, prototype) };
+		CHECK(world.GetComponent<CMesh>(ids.back()).meshID == 3);
+
+		CHECK(arena.GetStats().usedBytes >= 10'000 * (sizeof(CPosition) + sizeof(CMesh)));
+	}
+
+	CHECK(arena.GetStats().allocationCount == 0);
+}
+
+TEST_CASE("Reserved pools do not grow while they fill up")
+{
+	ECSWorld world{};
+
+	CHECK(world.GetPoolStats<CPosition>().capacity == 0);
+
+	world.Reserve<CPosition>(5'000);
+	world.Reserve<CMesh>(5'000);
+	world.ReserveEntities(5'000);
+
+	auto const reserved{ world.GetPoolStats<CPosition>() };
+	CHECK(reserved.size == 0);
+	CHECK(reserved.capacity >= 5'000);
+	CHECK(reserved.componentBytes >= 5'000 * sizeof(CPosition));
+
+	static_cast<void>(world.CreateEntities(5'000, Prototype{ CPosition{}, CMesh{} }));
+
+	auto const filled{ world.GetPoolStats<CPosition>() };
+	CHECK(filled.size == 5'000);
+	CHECK(filled.capacity == reserved.capacity);
+	CHECK(filled.componentBytes == reserved.componentBytes);
+}
+
+TEST_CASE("Pool stats are reported for every pool")
+{
+	ECSWorld world{};
+
+	auto entity{ world.CreateEntity() };
+	entity.AddComponent<CPosition>();
+	entity.AddComponent<CMesh>();
+
+	auto const stats{ world.GetAllPoolStats() };
+
+	std::size_t components{ 0 };
+	for (auto const& pool : stats)
+	{
+		CHECK_FALSE(pool.name.empty());
+		CHECK(pool.capacity >= pool.size);
+		components += pool.size;
+	}
+
+	CHECK(components >= 2);
+}
@@ -0,0 +1,52 @@
+#include <doctest/doctest.h>
+#include <execution>
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+namespace
+{
+	struct CPosition final { float x{}; };
+	struct CMesh final { uint32_t meshID{}; };
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("CreateEntities fills the range with valid entities")
+{
+	ECSWorld world{};
+
+	std::vector<EntityID> ids(1'000, NULL_ENTITY_ID);
+	world.CreateEntities(ids.begin(), ids.end());
+
+	CHECK(std::ranges::all_of(ids, [&world](EntityID id) { return world.IsValid(id); }));
+}
+
+TEST_CASE("CreateEntities copies the prototype into every entity")
+{
+	ECSWorld world{};
+	Prototype const prototype{ CPosition{ 5.f }, CMesh{ 3 } };
+
+	auto const ids{ world.CreateEntities(500, prototype) };
+
+	REQUIRE(ids.size() == 500);
+	CHECK(world.ComponentCount<CPosition>() == 500);
+	CHECK(world.ComponentCount<CMesh>() == 500);
+	CHECK(world.GetComponent<CMesh>(ids.back()).meshID == 3);
+}
+
+TEST_CASE("CreateEntities runs the init function for every entity")
+{
+	ECSWorld world{};
+	Prototype const prototype{ CPosition{}, CMesh{ 3 } };
+
+	auto const ids{ world.CreateEntities(10'000, prototype, [](uint32_t idx, CPosition& p, CMesh&)
+		{
+			p.x = static_cast<float>(idx);
+		}, std::execution::par_unseq) };
+
+	for (uint32_t idx{ 0 }; idx < ids.size(); ++idx)
+	{
+		CHECK(world.GetComponent<CPosition>(ids[idx]).x == doctest::Approx(static_cast<float>(idx)));
+	}
+}
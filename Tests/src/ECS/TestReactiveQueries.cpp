@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+namespace
+{
+	struct CMesh final { uint32_t meshID{}; };
+	struct CHealth final { int value{}; };
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("Reactive queries collect added components until cleared")
+{
+	ECSWorld world{};
+	auto query{ world.Observe<CMesh>() };
+
+	auto const ids{ world.CreateEntities(100, Prototype{ CMesh{ 1 } }) };
+	auto const other{ world.CreateEntity().ID() };
+	world.AddComponent<CHealth>(other);
+
+	CHECK(query.Size() == 100);
+	CHECK(query.Contains(ids.front()));
+	CHECK_FALSE(query.Contains(other));
+
+	std::vector<EntityID> seen{};
+	query.Consume([&seen](EntityID id) { seen.emplace_back(id); });
+
+	CHECK(seen == ids);
+	CHECK(query.Empty());
+
+	// Only what changed after the clear
+	world.AddComponent<CMesh>(other, 2u);
+	query.Each([other](EntityID id) { CHECK(id == other); });
+	CHECK(query.Size() == 1);
+}
+
+TEST_CASE("Reactive queries collect removals & notified updates once per entity")
+{
+	ECSWorld world{};
+	auto const ids{ world.CreateEntities(10, Prototype{ CHealth{ 100 } }) };
+
+	auto query{ world.Observe<CHealth>(ComponentEvent::Removed | ComponentEvent::Updated) };
+
+	// Writing through a reference is not noticed
+	world.GetComponent<CHealth>(ids[0]).value = 50;
+	CHECK(query.Empty());
+
+	world.ReplaceComponent<CHealth>(ids[1], 10);
+	world.Patch<CHealth>(ids[2], [](CHealth& health) { health.value -= 5; });
+	world.Patch<CHealth>(ids[2], [](CHealth& health) { health.value -= 5; });
+	world.RemoveComponent<CHealth>(ids[3]);
+	world.DestroyEntity(ids[4]);
+
+	CHECK(world.GetComponent<CHealth>(ids[2]).value == 90);
+
+	CHECK(query.Size() == 4);
+	CHECK(query.Contains(ids[1]));
+	CHECK(query.Contains(ids[2]));
+	CHECK(query.Contains(ids[3]));
+	CHECK(query.Contains(ids[4]));
+	CHECK_FALSE(world.IsValid(ids[4]));
+}
+
+TEST_CASE("Reactive queries see changes from the command buffer & stop when destroyed")
+{
+	ECSWorld world{};
+
+	auto query{ world.Observe<CMesh>(ComponentEvent::Added | ComponentEvent::Removed) };
+	auto moved{ std::move(query) };
+
+	auto& commands{ world.GetCommandBuffer() };
+	auto const pending{ commands.CreateEntity() };
+	commands.AddComponent(pending, CMesh{ 3 });
+	world.FlushCommands();
+
+	CHECK(moved.Size() == 1);
+	CHECK_FALSE(query);
+	CHECK(query.Empty());
+
+	// Destroys the listening state, its connections go with it
+	moved = ReactiveQuery{};
+	CHECK_FALSE(moved);
+
+	auto listening{ world.Observe<CMesh>(ComponentEvent::Added | ComponentEvent::Removed) };
+
+	auto const entity{ world.CreateEntity().ID() };
+	world.AddComponent<CMesh>(entity);
+	world.RemoveComponent<CMesh>(entity);
+	CHECK(world.ComponentCount<CMesh>() == 1);
+
+	// Only the live query saw the change, the destroyed one is not called anymore
+	CHECK(moved.Empty());
+	CHECK_FALSE(moved.Contains(entity));
+	CHECK(query.Empty());
+	CHECK(listening.Size() == 1);
+	CHECK(listening.Contains(entity));
+}
+
+TEST_CASE("Reactive queries keep a recycled entity apart from the destroyed one")
+{
+	ECSWorld world{};
+	auto query{ world.Observe<CMesh>(ComponentEvent::Added | ComponentEvent::Removed) };
+
+	auto const first{ world.CreateEntity().ID() };
+	world.AddComponent<CMesh>(first);
+	world.DestroyEntity(first);
+
+	auto const second{ world.CreateEntity().ID() };
+	world.AddComponent<CMesh>(second);
+
+	REQUIRE(ECSWorld::GetEntityIndex(first) == ECSWorld::GetEntityIndex(second));
+	CHECK(query.Size() == 2);
+	CHECK(query.Contains(first));
+	CHECK(query.Contains(second));
+
+	query.Clear();
+	CHECK_FALSE(query.Contains(first));
+	CHECK_FALSE(query.Contains(second));
+
+	// Only the new version changed, the old one shares its index but is not in the query
+	world.RemoveComponent<CMesh>(second);
+	CHECK(query.Size() == 1);
+	CHECK(query.Contains(second));
+	CHECK_FALSE(query.Contains(first));
+}
@@ -0,0 +1,131 @@
+#include <doctest/doctest.h>
+
+#include <limits>
+#include <random>
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+namespace
+{
+	struct CMesh final { uint32_t meshID{}; };
+	struct CDepth final { float depth{}; };
+	struct CPosition final { float x{}, y{}, z{}; };
+
+	// Creates entities with shuffled keys, the owner id is stored to check the components stayed with their entity
+	struct CKeyed final
+	{
+		uint64_t key{};
+		uint32_t owner{};
+	};
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("Float keys keep their order")
+{
+	CHECK(OrderedKey(-100.f) < OrderedKey(-1.f));
+	CHECK(OrderedKey(-1.f) < OrderedKey(-0.5f));
+	CHECK(OrderedKey(-0.5f) < OrderedKey(0.f));
+	CHECK(OrderedKey(0.f) < OrderedKey(0.25f));
+	CHECK(OrderedKey(0.25f) < OrderedKey(1'000.f));
+	CHECK(~OrderedKey(1'000.f) < ~OrderedKey(0.25f));
+}
+
+TEST_CASE("Pools sorted by key iterate in key order")
+{
+	ECSWorld world{};
+	std::mt19937 rng{ 42 };
+
+	uint32_t constexpr COUNT{ 200'000 };
+	static_cast<void>(world.CreateEntities(COUNT, Prototype{ CMesh{}, CDepth{} }, [&rng](uint32_t, CMesh& mesh, CDepth& depth)
+		{
+			mesh.meshID = rng() % 64;
+			depth.depth = std::uniform_real_distribution<float>{ -50.f, 50.f }(rng);
+		}));
+
+	SUBCASE("Radix sort on mesh id")
+	{
+		world.SortByKey<CMesh>([](CMesh const& mesh) { return mesh.meshID; });
+
+		uint32_t previous{ 0 };
+		world.View<CMesh>().Each([&previous](CMesh const& mesh)
+			{
+				CHECK_LE(previous, mesh.meshID);
+				previous = mesh.meshID;
+			});
+	}
+
+	SUBCASE("Radix sort back to front")
+	{
+		world.SortByKey<CDepth>([](CDepth const& depth) { return ~OrderedKey(depth.depth); });
+
+		float previous{ std::numeric_limits<float>::max() };
+		world.View<CDepth>().Each([&previous](CDepth const& depth)
+			{
+				CHECK_GE(previous, depth.depth);
+				previous = depth.depth;
+			});
+	}
+
+	SUBCASE("Parallel compare sort")
+	{
+		world.Sort<CDepth>([](CDepth const& lhs, CDepth const& rhs) { return lhs.depth < rhs.depth; }, ParallelSort{});
+
+		float previous{ std::numeric_limits<float>::lowest() };
+		world.View<CDepth>().Each([&previous](CDepth const& depth)
+			{
+				CHECK_LE(previous, depth.depth);
+				previous = depth.depth;
+			});
+	}
+}
+
+TEST_CASE("Radix sort keeps components with their entity")
+{
+	ECSWorld world{};
+	std::mt19937_64 rng{ 7 };
+
+	std::vector<EntityID> const ids{ world.CreateEntities(50'000, Prototype{ CKeyed{} }) };
+	for (auto const id : ids)
+	{
+		world.GetComponent<CKeyed>(id) = CKeyed{ .key = rng(), .owner = id };
+	}
+
+	world.SortByKey<CKeyed>([](CKeyed const& keyed) { return keyed.key; });
+
+	uint64_t previous{ 0 };
+	world.View<CKeyed>().Each([&previous](EntityID id, CKeyed const& keyed)
+		{
+			CHECK_LE(previous, keyed.key);
+			CHECK_EQ(id, keyed.owner);
+			previous = keyed.key;
+		});
+}
+
+TEST_CASE("Groups sorted by key iterate in key order")
+{
+	ECSWorld world{};
+
+	uint32_t constexpr COUNT{ 10'000 };
+	static_cast<void>(world.CreateEntities(COUNT, Prototype{ CMesh{}, CPosition{} }, [](uint32_t idx, CMesh& mesh, CPosition& position)
+		{
+			mesh.meshID = (idx * 7'919) % 97;
+			position.x = static_cast<float>(mesh.meshID);
+		}));
+
+	auto group{ world.Group<CMesh, CPosition>() };
+	group.SortByKey<CMesh>([](CMesh const& mesh) { return mesh.meshID; });
+
+	uint32_t previous{ 0 };
+	uint32_t visited{ 0 };
+	group.Each([&](CMesh const& mesh, CPosition const& position)
+		{
+			CHECK_LE(previous, mesh.meshID);
+			CHECK_EQ(position.x, static_cast<float>(mesh.meshID));
+			previous = mesh.meshID;
+			++visited;
+		});
+
+	CHECK_EQ(visited, COUNT);
+}
@@ -0,0 +1,88 @@
+#include <doctest/doctest.h>
+#include <atomic>
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+namespace
+{
+	struct CPosition final { float x{}; };
+	struct CVelocity final { float x{}; };
+	struct CHealth final { int value{}; };
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("System access is split in reads & writes")
+{
+	using Access = SystemAccess<Read<CPosition, CVelocity>, Write<CHealth>>;
+
+	CHECK(Access::Reads().size() == 2);
+	REQUIRE(Access::Writes().size() == 1);
+	CHECK(Access::Writes().front() == GetComponentTypeID<CHealth>());
+	CHECK(std::is_same_v<Access::Components, TypeList<CPosition, CVelocity, CHealth>>);
+	// A per entity system can't write what it declared read only
+	CHECK(std::is_same_v<Access::Parameters, TypeList<CPosition const, CVelocity const, CHealth>>);
+}
+
+TEST_CASE("Systems only conflict when one of them writes")
+{
+	SystemEntry const readPos{ .name = "A", .reads = { GetComponentTypeID<CPosition>() } };
+	SystemEntry const readPos2{ .name = "B", .reads = { GetComponentTypeID<CPosition>() } };
+	SystemEntry const writePos{ .name = "C", .writes = { GetComponentTypeID<CPosition>() } };
+	SystemEntry const writeHealth{ .name = "D", .writes = { GetComponentTypeID<CHealth>() } };
+
+	CHECK_FALSE(SystemScheduler::IsConflicting(readPos, readPos2));
+	CHECK(SystemScheduler::IsConflicting(readPos, writePos));
+	CHECK(SystemScheduler::IsConflicting(writePos, readPos));
+	CHECK_FALSE(SystemScheduler::IsConflicting(writePos, writeHealth));
+}
+
+TEST_CASE("Conflicting systems keep registration order, others share a stage")
+{
+	SystemScheduler scheduler{};
+	scheduler.AddSystem({ .name = "ReadPos", .reads = { GetComponentTypeID<CPosition>() } });
+	scheduler.AddSystem({ .name = "WritePos", .writes = { GetComponentTypeID<CPosition>() } });
+	scheduler.AddSystem({ .name = "WriteHealth", .writes = { GetComponentTypeID<CHealth>() } });
+	scheduler.AddSystem({ .name = "Both", .reads = { GetComponentTypeID<CPosition>() }, .writes = { GetComponentTypeID<CHealth>() } });
+
+	auto const& stages{ scheduler.GetStages() };
+	REQUIRE(stages.size() == 3);
+	CHECK(stages[0] == std::vector<uint32_t>{ 0, 2 });
+	CHECK(stages[1] == std::vector<uint32_t>{ 1 });
+	CHECK(stages[2] == std::vector<uint32_t>{ 3 });
+}
+
+TEST_CASE("Per entity systems iterate the accessed components")
+{
+	ECSWorld world{};
+
+	for (int i{ 0 }; i < 100; ++i)
+	{
+		auto const entity{ world.CreateEntity() };
+		world.AddComponent<CPosition>(entity.ID());
+		world.AddComponent<CVelocity>(entity.ID(), 2.f);
+	}
+
+	std::atomic<int> healthSystemRuns{ 0 };
+
+	world.AddSystem<Read<CVelocity>, Write<CPosition>>("Move", [](CVelocity const& v, CPosition& p)
+		{
+			p.x += v.x;
+		});
+	world.AddSystem<Write<CHealth>>("Health", [&healthSystemRuns](ECSWorld&)
+		{
+			++healthSystemRuns;
+		});
+
+	CHECK(world.SystemCount() == 2);
+
+	world.RunSystems();
+	world.RunSystems();
+
+	world.View<CPosition>().Each([](CPosition const& p)
+		{
+			CHECK(p.x == doctest::Approx(4.f));
+		});
+	CHECK(healthSystemRuns == 2);
+}
@@ -0,0 +1,314 @@
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "ECSWorld.h"
+#include "Entity.h"
+#include "WorldSerializer.h"
+
+namespace
+{
+	struct CPosition final
+	{
+		float x{}; float y{}; float z{};
+		bool operator==(CPosition const&) const = default;
+	};
+	struct CHealth final
+	{
+		int value{};
+		bool operator==(CHealth const&) const = default;
+	};
+	// 3 bytes of padding after the flag
+	struct CPadded final
+	{
+		uint8_t flag{};
+		uint32_t value{};
+		bool operator==(CPadded const&) const = default;
+	};
+
+	void RegisterTestComponents(MauEng::ECS::WorldSerializer& serializer)
+	{
+		serializer.RegisterComponent<CPosition>("CPosition");
+		serializer.RegisterComponent<CHealth>("CHealth");
+		serializer.RegisterComponent<CPadded>("CPadded");
+	}
+}
+
+using namespace MauEng::ECS;
+
+TEST_CASE("World snapshot round trip keeps entity ids & components")
+{
+	auto const path{ std::filesystem::temp_directory_path() / "MauEngTestSnapshot.snap" };
+
+	WorldSerializer serializer{};
+	RegisterTestComponents(serializer);
+
+	std::vector<EntityID> ids{};
+	{
+		ECSWorld world{};
+		for (int i{ 0 }; i < 1'000; ++i)
+		{
+			auto const entity{ world.CreateEntity() };
+			world.AddComponent<CPosition>(entity.ID(), static_cast<float>(i), 1.f, 2.f);
+			if (i % 3 == 0)
+			{
+				world.AddComponent<CHealth>(entity.ID(), i);
+			}
+			ids.emplace_back(entity.ID());
+		}
+
+		REQUIRE(serializer.Save(world, path));
+	}
+
+	ECSWorld loaded{};
+	REQUIRE(serializer.Load(loaded, path));
+
+	CHECK(loaded.ComponentCount<CPosition>() == 1'000);
+	CHECK(loaded.ComponentCount<CHealth>() == 334);
+
+	for (int i{ 0 }; i < 1'000; ++i)
+	{
+		REQUIRE(loaded.IsValid(ids[i]));
+		CHECK(loaded.GetComponent<CPosition>(ids[i]) == CPosition{ static_cast<float>(i), 1.f, 2.f });
+
+		REQUIRE(loaded.HasComponent<CHealth>(ids[i]) == (i % 3 == 0));
+		if (i % 3 == 0)
+		{
+			CHECK(loaded.GetComponent<CHealth>(ids[i]) == CHealth{ i });
+		}
+	}
+
+	// Loading requires the ids to be free, a failed load leaves the world alone
+	CHECK_FALSE(serializer.Load(loaded, path));
+	CHECK(loaded.ComponentCount<CPosition>() == 1'000);
+	CHECK(loaded.ComponentCount<CHealth>() == 334);
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("A failed load does not create any entity")
+{
+	auto const path{ std::filesystem::temp_directory_path() / "MauEngTestPartialSnapshot.snap" };
+
+	WorldSerializer serializer{};
+	RegisterTestComponents(serializer);
+
+	{
+		ECSWorld world{};
+		for (int i{ 0 }; i < 10; ++i)
+		{
+			world.AddComponent<CHealth>(world.CreateEntity().ID(), i);
+		}
+
+		REQUIRE(serializer.Save(world, path));
+	}
+
+	// Only the index of the last saved entity is in use, the ones before it are free
+	ECSWorld world{};
+	std::vector<EntityID> ids{};
+	for (int i{ 0 }; i < 10; ++i)
+	{
+		ids.emplace_back(world.CreateEntity().ID());
+	}
+	for (int i{ 0 }; i < 9; ++i)
+	{
+		world.DestroyEntity(ids[i]);
+	}
+	world.AddComponent<CPosition>(ids[9], 1.f, 2.f, 3.f);
+
+	CHECK_FALSE(serializer.Load(world, path));
+	CHECK(world.ComponentCount<CHealth>() == 0);
+	for (int i{ 0 }; i < 9; ++i)
+	{
+		CHECK_FALSE(world.IsValid(ids[i]));
+	}
+	REQUIRE(world.IsValid(ids[9]));
+	CHECK(world.GetComponent<CPosition>(ids[9]) == CPosition{ 1.f, 2.f, 3.f });
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Delta snapshot compares components, not their padding")
+{
+	auto const basePath{ std::filesystem::temp_directory_path() / "MauEngTestPaddedBase.snap" };
+	auto const unchangedPath{ std::filesystem::temp_directory_path() / "MauEngTestPaddedUnchanged.snap" };
+	auto const deltaPath{ std::filesystem::temp_directory_path() / "MauEngTestPaddedDelta.snap" };
+
+	WorldSerializer serializer{};
+	RegisterTestComponents(serializer);
+
+	ECSWorld world{};
+	std::vector<EntityID> ids{};
+	for (int i{ 0 }; i < 16; ++i)
+	{
+		auto const entity{ world.CreateEntity() };
+		world.AddComponent<CPadded>(entity.ID(), uint8_t{ 1 }, static_cast<uint32_t>(i));
+		ids.emplace_back(entity.ID());
+	}
+
+	REQUIRE(serializer.Save(world, basePath));
+	REQUIRE(serializer.SaveDelta(world, basePath, unchangedPath));
+
+	// Same values, different padding bytes
+	for (int i{ 0 }; i < 16; ++i)
+	{
+		auto& component{ world.GetComponent<CPadded>(ids[i]) };
+		CPadded const copy{ component };
+		std::memset(&component, 0xAB, sizeof(CPadded));
+		component.flag = copy.flag;
+		component.value = copy.value;
+	}
+
+	REQUIRE(serializer.SaveDelta(world, basePath, deltaPath));
+	CHECK(std::filesystem::file_size(deltaPath) == std::filesystem::file_size(unchangedPath));
+
+	std::filesystem::remove(basePath);
+	std::filesystem::remove(unchangedPath);
+	std::filesystem::remove(deltaPath);
+}
+
+TEST_CASE("Delta snapshot only applies the changes since the base snapshot")
+{
+	auto const basePath{ std::filesystem::temp_directory_path() / "MauEngTestBase.snap" };
+	auto const deltaPath{ std::filesystem::temp_directory_path() / "MauEngTestDelta.snap" };
+
+	WorldSerializer serializer{};
+	RegisterTestComponents(serializer);
+
+	ECSWorld world{};
+	std::vector<EntityID> ids{};
+	for (int i{ 0 }; i < 10; ++i)
+	{
+		auto const entity{ world.CreateEntity() };
+		world.AddComponent<CPosition>(entity.ID(), static_cast<float>(i), 0.f, 0.f);
+		world.AddComponent<CHealth>(entity.ID(), 100);
+		ids.emplace_back(entity.ID());
+	}
+
+	REQUIRE(serializer.Save(world, basePath));
+
+	world.GetComponent<CPosition>(ids[0]).x = 42.f;
+	world.RemoveComponent<CHealth>(ids[1]);
+	world.DestroyEntity(ids[2]);
+	auto const spawned{ world.CreateEntity() };
+	world.AddComponent<CHealth>(spawned.ID(), 7);
+
+	REQUIRE(serializer.SaveDelta(world, basePath, deltaPath));
+
+	// The delta only holds the changes, not the whole world
+	CHECK(std::filesystem::file_size(deltaPath) < std::filesystem::file_size(basePath));
+
+	ECSWorld loaded{};
+	REQUIRE(serializer.Load(loaded, basePath));
+	REQUIRE(serializer.LoadDelta(loaded, deltaPath));
+
+	CHECK(loaded.GetComponent<CPosition>(ids[0]).x == 42.f);
+	CHECK_FALSE(loaded.HasComponent<CHealth>(ids[1]));
+	CHECK_FALSE(loaded.IsValid(ids[2]));
+	REQUIRE(loaded.IsValid(spawned.ID()));
+	CHECK(loaded.GetComponent<CHealth>(spawned.ID()).value == 7);
+	CHECK(loaded.ComponentCount<CPosition>() == 9);
+	CHECK(loaded.ComponentCount<CHealth>() == 9);
+
+	std::filesystem::remove(basePath);
+	std::filesystem::remove(deltaPath);
+}
+
+TEST_CASE("Delta snapshot changes are seen by queries observing updates")
+{
+	auto const basePath{ std::filesystem::temp_directory_path() / "MauEngTestObservedBase.snap" };
+	auto const deltaPath{ std::filesystem::temp_directory_path() / "MauEngTestObservedDelta.snap" };
+
+	WorldSerializer serializer{};
+	RegisterTestComponents(serializer);
+
+	ECSWorld world{};
+	std::vector<EntityID> ids{};
+	for (int i{ 0 }; i < 4; ++i)
+	{
+		auto const entity{ world.CreateEntity() };
+		world.AddComponent<CHealth>(entity.ID(), 100);
+		ids.emplace_back(entity.ID());
+	}
+
+	REQUIRE(serializer.Save(world, basePath));
+	world.GetComponent<CHealth>(ids[1]).value = 50;
+	REQUIRE(serializer.SaveDelta(world, basePath, deltaPath));
+
+	ECSWorld loaded{};
+	REQUIRE(serializer.Load(loaded, basePath));
+
+	auto updated{ loaded.Observe<CHealth>(ComponentEvent::Updated) };
+	REQUIRE(serializer.LoadDelta(loaded, deltaPath));
+
+	CHECK(loaded.GetComponent<CHealth>(ids[1]).value == 50);
+	CHECK(updated.Size() == 1);
+	CHECK(updated.Contains(ids[1]));
+
+	std::filesystem::remove(basePath);
+	std::filesystem::remove(deltaPath);
+}
+
+TEST_CASE("A snapshot that lists an entity twice in a block is rejected")
+{
+	auto const path{ std::filesystem::temp_directory_path() / "MauEngTestDuplicateSnapshot.snap" };
+
+	WorldSerializer serializer{};
+	RegisterTestComponents(serializer);
+
+	EntityID first{};
+	EntityID second{};
+	{
+		ECSWorld world{};
+		// Not saved, gives the saved ids bytes that don't show up anywhere else in the file
+		for (int i{ 0 }; i < 300; ++i)
+		{
+			[[maybe_unused]] auto const unsaved{ world.CreateEntity() };
+		}
+
+		first = world.CreateEntity().ID();
+		second = world.CreateEntity().ID();
+		world.AddComponent<CHealth>(first, 12'345);
+		world.AddComponent<CHealth>(second, 67'890);
+
+		REQUIRE(serializer.Save(world, path));
+	}
+
+	std::string contents{};
+	{
+		std::ifstream file{ path, std::ios::binary };
+		contents.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+	}
+
+	auto const toBytes{ [](EntityID lhs, EntityID rhs)
+		{
+			std::string bytes(2 * sizeof(EntityID), '\0');
+			std::memcpy(bytes.data(), &lhs, sizeof(EntityID));
+			std::memcpy(bytes.data() + sizeof(EntityID), &rhs, sizeof(EntityID));
+			return bytes;
+		} };
+
+	// After the snapshot's entity list, the CHealth block is the next place both ids follow each other (in storage order)
+	std::size_t const listOffset{ contents.find(toBytes(first, second)) };
+	REQUIRE(listOffset != std::string::npos);
+
+	std::size_t const searchFrom{ listOffset + 2 * sizeof(EntityID) };
+	std::size_t const blockOffset{ std::min(contents.find(toBytes(first, second), searchFrom), contents.find(toBytes(second, first), searchFrom)) };
+	REQUIRE(blockOffset != std::string::npos);
+
+	// The block now holds its first entity twice
+	std::memcpy(contents.data() + blockOffset + sizeof(EntityID), contents.data() + blockOffset, sizeof(EntityID));
+
+	std::ofstream{ path, std::ios::binary | std::ios::trunc } << contents;
+
+	ECSWorld world{};
+	CHECK_FALSE(serializer.Load(world, path));
+	CHECK_FALSE(world.IsValid(first));
+	CHECK(world.ComponentCount<CHealth>() == 0);
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,81 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+using namespace MauCor;
+
+namespace
+{
+	// Keeps the messages it gets outside of itself, the async logger owns it & calls it from its writer thread only
+	class CaptureLogger final : public Logger
+	{
+	public:
+		explicit CaptureLogger(std::vector<std::string>& messages) :
+			m_Messages{ messages }
+		{
+		}
+		virtual ~CaptureLogger() override = default;
+
+		CaptureLogger(CaptureLogger const&) = delete;
+		CaptureLogger(CaptureLogger&&) = delete;
+		CaptureLogger& operator=(CaptureLogger const&) = delete;
+		CaptureLogger& operator=(CaptureLogger&&) = delete;
+
+	private:
+		std::vector<std::string>& m_Messages;
+
+		virtual void LogInternal(LogPriority, LogCategory, std::chrono::system_clock::time_point, std::string_view message) override
+		{
+			m_Messages.emplace_back(message);
+		}
+	};
+}
+
+TEST_CASE("Async logger writes messages in order")
+{
+	std::vector<std::string> messages{};
+	auto const pLogger{ CreateAsyncLogger(std::make_unique<CaptureLogger>(messages), { 1'024, LogOverflowPolicy::Block }) };
+	pLogger->SetPriorityLevel(LogPriority::Info);
+
+	pLogger->Log(LogPriority::Trace, LogCategory::Core, "skipped");
+	for (int i{ 0 }; i < 100; ++i)
+	{
+		pLogger->Log(LogPriority::Info, LogCategory::Game, "message {}", i);
+	}
+
+	pLogger->Flush();
+
+	REQUIRE(messages.size() == 100);
+	CHECK(messages.front() == "message 0");
+	CHECK(messages.back() == "message 99");
+}
+
+TEST_CASE("Async logger cuts off long messages")
+{
+	std::vector<std::string> messages{};
+	auto const pLogger{ CreateAsyncLogger(std::make_unique<CaptureLogger>(messages)) };
+
+	std::string const longMessage(2'000, 'a');
+	pLogger->Log(LogPriority::Info, LogCategory::Game, "{}", longMessage);
+	pLogger->Flush();
+
+	REQUIRE(messages.size() == 1);
+	CHECK(messages.front().size() < longMessage.size());
+	CHECK(messages.front().ends_with("..."));
+}
+
+TEST_CASE("Async logger writes the queue when it is destroyed")
+{
+	std::vector<std::string> messages{};
+	{
+		auto const pLogger{ CreateAsyncLogger(std::make_unique<CaptureLogger>(messages)) };
+		pLogger->Log(LogPriority::Info, LogCategory::Game, "first");
+		pLogger->Log(LogPriority::Info, LogCategory::Game, "second");
+	}
+
+	REQUIRE(messages.size() == 2);
+	CHECK(messages[1] == "second");
+}
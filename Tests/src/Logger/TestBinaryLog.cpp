@@ -0,0 +1,141 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+using namespace MauCor;
+
+namespace
+{
+	template<typename... Args>
+	[[nodiscard]] std::string RoundTrip(std::string_view format, Args const&... args)
+	{
+		std::array<std::byte, MAX_BINARY_ARGS_SIZE> bytes{};
+		uint32_t const size{ EncodeBinaryArgs(std::span{ bytes }, args...) };
+
+		return FormatBinaryLog(format, BINARY_ARG_TYPES<Args...>, std::span{ bytes }.first(size));
+	}
+
+	[[nodiscard]] std::vector<DecodedLogRecord> ReadLog(std::filesystem::path const& path)
+	{
+		std::ifstream file{ path, std::ios::in | std::ios::binary };
+		BinaryLogReader reader{ file };
+		REQUIRE(reader.IsValid());
+
+		std::vector<DecodedLogRecord> records{};
+		DecodedLogRecord record{};
+		while (reader.Next(record))
+		{
+			records.emplace_back(record);
+		}
+
+		return records;
+	}
+}
+
+TEST_CASE("Binary log arguments round trip")
+{
+	int8_t const smallInt{ -8 };
+	uint16_t const smallUInt{ 16 };
+	int64_t const bigInt{ -9'000'000'000 };
+	uint64_t const bigUInt{ 18'000'000'000'000'000'000u };
+	int const value{ 42 };
+	void const* pointer{ &value };
+	std::string const string{ "string" };
+	std::string_view const view{ "view" };
+	char const* nullString{ nullptr };
+
+	CHECK(RoundTrip("{} {}", true, false) == "true false");
+	CHECK(RoundTrip("{}", 'c') == "c");
+	CHECK(RoundTrip("{} {} {}", smallInt, -32, smallUInt) == "-8 -32 16");
+	CHECK(RoundTrip("{} {}", 4'000'000'000u, bigUInt) == "4000000000 18000000000000000000");
+	CHECK(RoundTrip("{}", bigInt) == "-9000000000");
+	CHECK(RoundTrip("{:.2f} {}", 1.5f, 0.25) == "1.50 0.25");
+	CHECK(RoundTrip("{} {} {} {}", "literal", string, view, nullString) == "literal string view ");
+	CHECK(RoundTrip("{}", pointer) == fmt::format("{}", pointer));
+	CHECK(RoundTrip("no arguments") == "no arguments");
+}
+
+TEST_CASE("Binary log cuts off strings that don't fit")
+{
+	std::string const longString(1'000, 'a');
+
+	std::string const message{ RoundTrip("{} {}", longString, 7) };
+
+	// The argument after the string still fits
+	CHECK(message.ends_with(" 7"));
+	CHECK(message.size() < MAX_BINARY_ARGS_SIZE);
+}
+
+TEST_CASE("Binary logger file decodes back to the messages")
+{
+	auto const path{ std::filesystem::temp_directory_path() / "MauEngTestLog.bin" };
+	uint32_t line{};
+
+	{
+		auto const pLogger{ CreateBinaryLogger(std::filesystem::path{ path }) };
+
+		for (int i{ 0 }; i < 3; ++i)
+		{
+			line = __LINE__ + 1;
+			ME_LOG_BINARY_TO(*pLogger, LogPriority::Warn, LogCategory::Game, "Frame {} took {:.1f} ms on {}", i, 16.5f, "main");
+		}
+		pLogger->Log(LogPriority::Error, LogCategory::Renderer, "text {}", 1);
+
+		// Other threads get their own buffer
+		std::jthread{ [&pLogger] { ME_LOG_BINARY_TO(*pLogger, LogPriority::Info, LogCategory::Core, "from a thread {}", 2u); } }.join();
+
+		pLogger->Flush();
+	}
+
+	auto const records{ ReadLog(path) };
+	std::filesystem::remove(path);
+
+	REQUIRE(records.size() == 5);
+
+	CHECK(records[0].message == "Frame 0 took 16.5 ms on main");
+	CHECK(records[2].message == "Frame 2 took 16.5 ms on main");
+	CHECK(records[2].priority == LogPriority::Warn);
+	CHECK(records[2].category == LogCategory::Game);
+	CHECK(records[2].line == line);
+	CHECK(records[2].file.ends_with("TestBinaryLog.cpp"));
+
+	CHECK(records[3].message == "text 1");
+	CHECK(records[3].priority == LogPriority::Error);
+	CHECK(records[3].file.empty());
+
+	CHECK(records[4].message == "from a thread 2");
+}
+
+TEST_CASE("Binary logs are formatted by loggers without a binary format")
+{
+	class CaptureLogger final : public Logger
+	{
+	public:
+		CaptureLogger() = default;
+		virtual ~CaptureLogger() override = default;
+
+		CaptureLogger(CaptureLogger const&) = delete;
+		CaptureLogger(CaptureLogger&&) = delete;
+		CaptureLogger& operator=(CaptureLogger const&) = delete;
+		CaptureLogger& operator=(CaptureLogger&&) = delete;
+
+		std::string message{};
+
+	private:
+		virtual void LogInternal(LogPriority, LogCategory, std::chrono::system_clock::time_point, std::string_view logged) override
+		{
+			message = logged;
+		}
+	};
+
+	CaptureLogger logger{};
+	ME_LOG_BINARY_TO(logger, LogPriority::Info, LogCategory::Game, "{} & {}", "text", 3.5);
+
+	CHECK(logger.message == "text & 3.5");
+}
@@ -0,0 +1,128 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "Logger/Logger.h"
+
+using namespace MauCor;
+
+namespace
+{
+	// Fresh directory per test, removed again at the end
+	class TempDirectory final
+	{
+	public:
+		explicit TempDirectory(char const* name) :
+			m_Path{ std::filesystem::temp_directory_path() / name }
+		{
+			std::filesystem::remove_all(m_Path);
+			std::filesystem::create_directories(m_Path);
+		}
+		~TempDirectory()
+		{
+			std::error_code error{};
+			std::filesystem::remove_all(m_Path, error);
+		}
+
+		[[nodiscard]] std::filesystem::path const& GetPath() const noexcept { return m_Path; }
+
+		TempDirectory(TempDirectory const&) = delete;
+		TempDirectory(TempDirectory&&) = delete;
+		TempDirectory& operator=(TempDirectory const&) = delete;
+		TempDirectory& operator=(TempDirectory&&) = delete;
+
+	private:
+		std::filesystem::path const m_Path;
+	};
+
+	[[nodiscard]] std::string ReadFile(std::filesystem::path const& path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	}
+}
+
+TEST_CASE("File logger rotates through a fixed amount of generations")
+{
+	TempDirectory const directory{ "MauEngTestFileLogger" };
+
+	std::atomic<uint32_t> compressedCount{ 0 };
+
+	FileLoggerSettings settings{};
+	settings.segmentSize = 1'024;
+	settings.generationCount = 3;
+	settings.compressSegment = [&compressedCount](std::filesystem::path const& path)
+		{
+			// Stands in for zstd, a full segment is trimmed to what was written
+			std::string const contents{ ReadFile(path) };
+			CHECK(contents.find('\0') == std::string::npos);
+
+			std::ofstream{ path.string() + ".packed", std::ios::binary } << contents;
+			compressedCount.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		};
+
+	{
+		auto const pLogger{ CreateFileLogger(directory.GetPath() / "Log.txt", settings) };
+
+		// Rotation only happens once the rotation thread has the next segment ready
+		auto const deadline{ std::chrono::steady_clock::now() + std::chrono::seconds{ 5 } };
+		for (uint32_t i{ 0 }; compressedCount.load(std::memory_order_relaxed) < 6 && std::chrono::steady_clock::now() < deadline; ++i)
+		{
+			pLogger->Log(LogPriority::Info, LogCategory::Core, "message {}", i);
+			std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+		}
+	}
+
+	REQUIRE(compressedCount.load() >= 6);
+
+	uint32_t packedCount{ 0 };
+	uint32_t textCount{ 0 };
+	for (auto const& entry : std::filesystem::directory_iterator{ directory.GetPath() })
+	{
+		std::string const fileName{ entry.path().filename().string() };
+		CHECK(fileName.starts_with("Log."));
+
+		if (fileName.ends_with(".packed"))
+		{
+			++packedCount;
+		}
+		else
+		{
+			// The segment that was being written, trimmed when the logger closed it
+			++textCount;
+			CHECK(ReadFile(entry.path()).find("message") != std::string::npos);
+			CHECK(ReadFile(entry.path()).find('\0') == std::string::npos);
+		}
+	}
+
+	// Well over generationCount rotations, the segment being written counts as a generation
+	CHECK(packedCount == settings.generationCount - 1);
+	CHECK(textCount == 1);
+	CHECK(packedCount + textCount == settings.generationCount);
+}
+
+TEST_CASE("File logger continues after the segments of an earlier run")
+{
+	TempDirectory const directory{ "MauEngTestFileLoggerRuns" };
+
+	FileLoggerSettings settings{};
+	settings.generationCount = 2;
+
+	for (uint32_t run{ 0 }; run < 3; ++run)
+	{
+		auto const pLogger{ CreateFileLogger(directory.GetPath() / "Log.txt", settings) };
+		pLogger->Log(LogPriority::Warn, LogCategory::Game, "run {}", run);
+	}
+
+	// The newest run & the one before it
+	CHECK_FALSE(std::filesystem::exists(directory.GetPath() / "Log.0.txt"));
+	CHECK(ReadFile(directory.GetPath() / "Log.1.txt").find("run 1") != std::string::npos);
+	CHECK(ReadFile(directory.GetPath() / "Log.2.txt").find("run 2") != std::string::npos);
+	CHECK(ReadFile(directory.GetPath() / "Log.2.txt").size() < settings.segmentSize);
+}
@@ -0,0 +1,99 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+using namespace MauCor;
+
+namespace
+{
+	inline constexpr LogCategory LOG_TEST_AUDIO{ MakeLogCategory(0) };
+	inline constexpr LogCategory LOG_TEST_UNNAMED{ MakeLogCategory(MAX_LOG_CATEGORIES - BUILT_IN_LOG_CATEGORY_COUNT - 1) };
+
+	// Stores "category: message"
+	class CaptureLogger final : public Logger
+	{
+	public:
+		CaptureLogger() = default;
+		virtual ~CaptureLogger() override = default;
+
+		std::vector<std::string> messages{};
+
+		CaptureLogger(CaptureLogger const&) = delete;
+		CaptureLogger(CaptureLogger&&) = delete;
+		CaptureLogger& operator=(CaptureLogger const&) = delete;
+		CaptureLogger& operator=(CaptureLogger&&) = delete;
+
+	private:
+		virtual void LogInternal(LogPriority, LogCategory category, std::chrono::system_clock::time_point, std::string_view message) override
+		{
+			messages.emplace_back(std::string{ CategoryToString(category) } + ": " + std::string{ message });
+		}
+	};
+
+	[[nodiscard]] int CountCall(int& calls) noexcept
+	{
+		return ++calls;
+	}
+}
+
+TEST_CASE("Compile time log filter follows the configured minimum")
+{
+	static_assert(IsLogCompiledIn(LogPriority::Fatal, LogCategory::Core));
+	static_assert(IsLogCompiledIn(MauEng::MIN_LOG_PRIORITY) && IsLogCompiledIn(MauEng::MIN_LOG_PRIORITY, LOG_TEST_AUDIO));
+	static_assert(MauEng::MIN_LOG_PRIORITY == LogPriority::Trace || !IsLogCompiledIn(LogPriority::Trace, LogCategory::Game));
+
+	CHECK(static_cast<uint8_t>(LOG_TEST_AUDIO) == BUILT_IN_LOG_CATEGORY_COUNT);
+}
+
+TEST_CASE("Filtered logs don't evaluate their arguments")
+{
+	CaptureLogger logger{};
+	int calls{ 0 };
+
+	// Error & Fatal only, so the test also holds when MAUENG_MIN_LOG_PRIORITY compiles out the lower priorities
+	logger.SetPriorityLevel(LogPriority::Fatal);
+	ME_LOG_TO(logger, LogPriority::Error, LogCategory::Game, "{}", CountCall(calls));
+	CHECK(calls == 0);
+	CHECK(logger.messages.empty());
+
+	ME_LOG_TO(logger, LogPriority::Fatal, LogCategory::Game, "{}", CountCall(calls));
+	CHECK(calls == 1);
+
+	logger.SetPriorityLevel(LogPriority::Trace);
+	logger.SetCategoryPriorityLevel(LogCategory::Renderer, LogPriority::Fatal);
+
+	ME_LOG_TO(logger, LogPriority::Error, LogCategory::Renderer, "{}", CountCall(calls));
+	ME_LOG_BINARY_TO(logger, LogPriority::Error, LogCategory::Renderer, "{}", CountCall(calls));
+	CHECK(calls == 1);
+
+	// Other categories keep the global level
+	ME_LOG_TO(logger, LogPriority::Error, LogCategory::Engine, "{}", CountCall(calls));
+	ME_LOG_BINARY_TO(logger, LogPriority::Error, LogCategory::Engine, "{}", CountCall(calls));
+	CHECK(calls == 3);
+
+	REQUIRE(logger.messages.size() == 3);
+	CHECK(logger.messages[0] == "Game: 1");
+	CHECK(logger.messages[1] == "Engine: 2");
+	CHECK(logger.messages[2] == "Engine: 3");
+}
+
+TEST_CASE("User log categories print their registered name")
+{
+	CHECK(std::string{ LogCategoryName(LogCategory::Renderer) } == "Renderer");
+	CHECK(std::string{ LogCategoryName(LOG_TEST_UNNAMED) } == "Unknown");
+
+	RegisterLogCategory(LOG_TEST_AUDIO, "Audio");
+	CHECK(std::string{ LogCategoryName(LOG_TEST_AUDIO) } == "Audio");
+
+	CaptureLogger logger{};
+	logger.SetCategoryPriorityLevel(LOG_TEST_AUDIO, LogPriority::Fatal);
+
+	ME_LOG_TO(logger, LogPriority::Error, LOG_TEST_AUDIO, "voice {}", 1);
+	ME_LOG_TO(logger, LogPriority::Fatal, LOG_TEST_AUDIO, "voice {}", 2);
+
+	REQUIRE(logger.messages.size() == 1);
+	CHECK(logger.messages[0] == "Audio: voice 2");
+}
@@ -0,0 +1,49 @@
+#include "doctest/doctest.h"
+#include "Math/NormalMatrix.h"
+#include "Math/Rotator.h"
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+namespace
+{
+	void CheckAgainstInverseTranspose(glm::mat4 const& model)
+	{
+		glm::mat3 const expected{ glm::transpose(glm::inverse(glm::mat3{ model })) };
+		glm::mat3 const normal{ MauCor::NormalMatrix(model) };
+
+		for (glm::length_t col{ 0 }; col < 3; ++col)
+		{
+			for (glm::length_t row{ 0 }; row < 3; ++row)
+			{
+				CHECK(normal[col][row] == doctest::Approx(expected[col][row]).epsilon(1e-4));
+			}
+		}
+	}
+}
+
+TEST_CASE("Normal matrix matches the inverse transpose for non uniform scale")
+{
+	glm::vec3 constexpr translation{ 5.f, -3.f, 12.f };
+	glm::vec3 constexpr scales[]{ glm::vec3{ 1.f }, glm::vec3{ 2.f, 0.5f, 7.f }, glm::vec3{ 0.01f, 30.f, 1.f }, glm::vec3{ -1.f, 2.f, 3.f } };
+	MauCor::Rotator const rotations[]{ MauCor::Rotator{}, MauCor::Rotator{ 45.f, 30.f, 60.f }, MauCor::Rotator{ -90.f, 10.f, 0.f } };
+
+	// Built the same way as CTransform: translate * rotate * scale
+	for (auto const& rotation : rotations)
+	{
+		for (auto const& scale : scales)
+		{
+			glm::mat4 const model{ glm::translate(glm::mat4{ 1.f }, translation) * glm::toMat4(rotation.rotation) * glm::scale(glm::mat4{ 1.f }, scale) };
+			CheckAgainstInverseTranspose(model);
+		}
+	}
+}
+
+TEST_CASE("Normal matrix ignores translation")
+{
+	glm::mat4 const model{ glm::translate(glm::mat4{ 1.f }, glm::vec3{ 100.f, 0.f, -4.f }) * glm::scale(glm::mat4{ 1.f }, glm::vec3{ 3.f, 1.f, 0.5f }) };
+	glm::mat3 const normal{ MauCor::NormalMatrix(model) };
+
+	CHECK(normal[0][0] == doctest::Approx(1.f / 3.f));
+	CHECK(normal[1][1] == doctest::Approx(1.f));
+	CHECK(normal[2][2] == doctest::Approx(2.f));
+}
@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+#include <vector>
+
+#include "Memory/MemoryTracker.h"
+
+using namespace MauCor;
+
+TEST_CASE("Memory tracker counts live bytes, allocations & peaks per tag")
+{
+	auto const before{ GetMemoryStats(MemoryTag::Assets) };
+
+	TrackAllocation(MemoryTag::Assets, 100);
+	TrackAllocation(MemoryTag::Assets, 50);
+
+	auto const allocated{ GetMemoryStats(MemoryTag::Assets) };
+	CHECK(allocated.liveBytes == before.liveBytes + 150);
+	CHECK(allocated.liveAllocations == before.liveAllocations + 2);
+	CHECK(allocated.totalAllocations == before.totalAllocations + 2);
+	CHECK(allocated.peakBytes >= before.liveBytes + 150);
+
+	TrackFree(MemoryTag::Assets, 100);
+	TrackFree(MemoryTag::Assets, 50);
+
+	// The peak stays, the total only counts allocations
+	auto const freed{ GetMemoryStats(MemoryTag::Assets) };
+	CHECK(freed.liveBytes == before.liveBytes);
+	CHECK(freed.liveAllocations == before.liveAllocations);
+	CHECK(freed.peakBytes == allocated.peakBytes);
+	CHECK(freed.totalAllocations == allocated.totalAllocations);
+}
+
+TEST_CASE("Memory tracker counts GPU memory per type & under the GPU tag")
+{
+	uint32_t const type{ MAX_GPU_MEMORY_TYPES - 1 };
+	auto const typeBefore{ GetGPUMemoryStats(type) };
+	auto const tagBefore{ GetMemoryStats(MemoryTag::RendererGPU) };
+
+	TrackGPUAllocation(type, 4'096);
+	CHECK(GetGPUMemoryStats(type).liveBytes == typeBefore.liveBytes + 4'096);
+	CHECK(GetMemoryStats(MemoryTag::RendererGPU).liveBytes == tagBefore.liveBytes + 4'096);
+
+	TrackGPUFree(type, 4'096);
+	CHECK(GetGPUMemoryStats(type).liveBytes == typeBefore.liveBytes);
+	CHECK(GetMemoryStats(MemoryTag::RendererGPU).liveBytes == tagBefore.liveBytes);
+	CHECK(GetGPUMemoryStats(type).peakBytes >= 4'096);
+}
+
+TEST_CASE("Tracked memory resource counts its allocations under its tag")
+{
+	CHECK(GetThreadMemoryTag() == MemoryTag::Untagged);
+	{
+		MemoryTagScope const outer{ MemoryTag::Logger };
+		{
+			MemoryTagScope const inner{ MemoryTag::ECS };
+			CHECK(GetThreadMemoryTag() == MemoryTag::ECS);
+		}
+		CHECK(GetThreadMemoryTag() == MemoryTag::Logger);
+	}
+	CHECK(GetThreadMemoryTag() == MemoryTag::Untagged);
+
+	TrackedMemoryResource resource{ MemoryTag::ECS, std::pmr::new_delete_resource() };
+	auto const before{ GetMemoryStats(MemoryTag::ECS) };
+	{
+		std::pmr::vector<uint32_t> values{ &resource };
+		values.reserve(256);
+
+		CHECK(GetMemoryStats(MemoryTag::ECS).liveBytes == before.liveBytes + 256 * sizeof(uint32_t));
+		CHECK(GetMemoryStats(MemoryTag::ECS).liveAllocations == before.liveAllocations + 1);
+	}
+	CHECK(GetMemoryStats(MemoryTag::ECS).liveBytes == before.liveBytes);
+}
@@ -0,0 +1,78 @@
+#include <doctest/doctest.h>
+#include <map>
+#include <vector>
+
+#include "Memory/PageArena.h"
+
+TEST_CASE("Page arena reuses freed blocks & tracks its memory")
+{
+	MauCor::PageArena arena{ 64 * 1024 };
+
+	void* const pFirst{ arena.allocate(100, 8) };
+	CHECK(arena.GetStats().usedBytes == 128);
+	CHECK(arena.GetStats().pageCount == 1);
+
+	arena.deallocate(pFirst, 100, 8);
+	CHECK(arena.GetStats().usedBytes == 0);
+
+	// Same size class, the freed block comes back
+	void* const pSecond{ arena.allocate(120, 16) };
+	CHECK(pSecond == pFirst);
+
+	void* const pAligned{ arena.allocate(256, 256) };
+	CHECK(reinterpret_cast<std::uintptr_t>(pAligned) % 256 == 0);
+
+	arena.deallocate(pSecond, 120, 16);
+	arena.deallocate(pAligned, 256, 256);
+
+	auto const stats{ arena.GetStats() };
+	CHECK(stats.allocationCount == 0);
+	CHECK(stats.peakUsedBytes == 128 + 256);
+}
+
+TEST_CASE("Page arena gives blocks larger than a page their own allocation")
+{
+	MauCor::PageArena arena{ 64 * 1024 };
+
+	{
+		std::pmr::vector<uint32_t> values{ &arena };
+		values.resize(1'000'000, 7);
+
+		auto const stats{ arena.GetStats() };
+		CHECK(stats.largeAllocationCount == 1);
+		CHECK(stats.reservedBytes >= values.size() * sizeof(uint32_t));
+
+		std::pmr::map<uint32_t, uint32_t> lookup{ &arena };
+		for (uint32_t idx{ 0 }; idx < 1'000; ++idx)
+		{
+			lookup.emplace(idx, values[idx]);
+		}
+		CHECK(lookup.at(999) == 7);
+	}
+
+	auto const stats{ arena.GetStats() };
+	CHECK(stats.largeAllocationCount == 0);
+	CHECK(stats.usedBytes == 0);
+	// Pages stay reserved for reuse
+	CHECK(stats.reservedBytes == stats.pageCount * arena.GetPageSize());
+}
+
+TEST_CASE("Page arena counts the memory it takes from the OS under its tag")
+{
+	using namespace MauCor;
+
+	auto const before{ GetMemoryStats(MemoryTag::Assets) };
+	{
+		PageArena arena{ 64 * 1024, false, MemoryTag::Assets };
+
+		std::pmr::vector<uint32_t> values{ &arena };
+		values.reserve(256);
+
+		// The page is counted, not the blocks carved from it
+		CHECK(GetMemoryStats(MemoryTag::Assets).liveBytes - before.liveBytes >= arena.GetStats().reservedBytes);
+
+		values.resize(1'000'000, 7);
+		CHECK(GetMemoryStats(MemoryTag::Assets).liveBytes - before.liveBytes >= arena.GetStats().reservedBytes);
+	}
+	CHECK(GetMemoryStats(MemoryTag::Assets).liveBytes == before.liveBytes);
+}
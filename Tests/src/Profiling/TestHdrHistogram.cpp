@@ -0,0 +1,77 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+
+#include "Profiling/HdrHistogram.h"
+
+using namespace MauCor;
+
+TEST_CASE("HdrHistogram keeps small values exact")
+{
+	HdrHistogram histogram{ 1'000 };
+
+	for (uint64_t value{ 1 }; value <= 100; ++value)
+	{
+		histogram.Record(value);
+	}
+
+	CHECK(histogram.Count() == 100);
+	CHECK(histogram.Min() == 1);
+	CHECK(histogram.Max() == 100);
+	CHECK(histogram.Mean() == doctest::Approx(50.5));
+	CHECK(histogram.ValueAtPercentile(0.5) == 50);
+	CHECK(histogram.ValueAtPercentile(0.99) == 99);
+	CHECK(histogram.ValueAtPercentile(1.0) == 100);
+}
+
+TEST_CASE("HdrHistogram percentiles stay within the bucket precision")
+{
+	// Frame times in nanoseconds, 1 ms up to 100 ms
+	HdrHistogram histogram{ 60'000'000'000 };
+
+	for (uint64_t ms{ 1 }; ms <= 100; ++ms)
+	{
+		histogram.Record(ms * 1'000'000);
+	}
+
+	auto const isClose{ [](uint64_t value, uint64_t expected)
+		{
+			// Never below the value, at most a bucket (1 / 128th) above it
+			return value >= expected && value <= expected + expected / 128;
+		} };
+
+	CHECK(isClose(histogram.ValueAtPercentile(0.5), 50'000'000));
+	CHECK(isClose(histogram.ValueAtPercentile(0.95), 95'000'000));
+	CHECK(isClose(histogram.ValueAtPercentile(0.99), 99'000'000));
+	CHECK(histogram.ValueAtPercentile(1.0) == 100'000'000);
+	CHECK(histogram.Min() == 1'000'000);
+}
+
+TEST_CASE("HdrHistogram clamps, visits & resets its buckets")
+{
+	HdrHistogram histogram{ 10'000 };
+
+	histogram.Record(5);
+	histogram.Record(5);
+	histogram.Record(1'000'000);
+
+	CHECK(histogram.Max() == 10'000);
+
+	uint64_t total{ 0 };
+	uint64_t lastLowest{ 0 };
+	bool isOrdered{ true };
+	histogram.ForEachBucket([&](uint64_t lowest, uint64_t highest, uint64_t count)
+		{
+			isOrdered = isOrdered && lowest >= lastLowest && highest >= lowest;
+			lastLowest = lowest;
+			total += count;
+		});
+
+	CHECK(isOrdered);
+	CHECK(total == 3);
+
+	histogram.Reset();
+	CHECK(histogram.Count() == 0);
+	CHECK(histogram.Min() == 0);
+	CHECK(histogram.ValueAtPercentile(0.99) == 0);
+}
@@ -0,0 +1,180 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config/EngineConfig.h"
+#include "Profiling/Profiler.h"
+#include "Profiling/TraceClock.h"
+
+using namespace MauCor;
+
+namespace
+{
+	// Only keeps the stats, scopes aren't written anywhere
+	class StatsProfiler final : public Profiler
+	{
+	public:
+		StatsProfiler() = default;
+		virtual ~StatsProfiler() override = default;
+
+		virtual void WriteProfile(ProfileResult const&, bool) override {}
+		virtual void WriteProfile(std::string const&) override {}
+		virtual void WriteScope(TraceScope const&) override {}
+		virtual void EndSession() override {}
+
+		StatsProfiler(StatsProfiler const&) = delete;
+		StatsProfiler(StatsProfiler&&) = delete;
+		StatsProfiler& operator=(StatsProfiler const&) = delete;
+		StatsProfiler& operator=(StatsProfiler&&) = delete;
+
+	private:
+		virtual void BeginSessionInternal(std::string const&, size_t) override {}
+	};
+
+	[[nodiscard]] uint64_t ToTicks(double milliseconds)
+	{
+		return static_cast<uint64_t>(milliseconds * TraceClockFrequency() / 1'000.0);
+	}
+}
+
+TEST_CASE("Scope stats are summed per frame")
+{
+	StatsProfiler profiler{};
+
+	char const* const SCOPE{ "QUEUE DRAWS" };
+
+	// 2 calls of 1 ms in frame 0, 1 call of 4 ms in frame 1
+	profiler.AddToStats({ SCOPE, 0, ToTicks(1.0), 0, false });
+	profiler.AddToStats({ SCOPE, 0, ToTicks(1.0), 0, false });
+	profiler.EndStatsFrame();
+	profiler.AddToStats({ SCOPE, 0, ToTicks(4.0), 0, false });
+	profiler.EndStatsFrame();
+
+	auto const stats{ profiler.GetStats("QUEUE DRAWS") };
+	REQUIRE(stats.has_value());
+
+	CHECK(stats->frameCount == 2);
+	CHECK(stats->min == doctest::Approx(2.0).epsilon(0.01));
+	CHECK(stats->max == doctest::Approx(4.0).epsilon(0.01));
+	CHECK(stats->average == doctest::Approx(3.0).epsilon(0.01));
+	CHECK(stats->callsPerFrame == doctest::Approx(1.5));
+
+	CHECK_FALSE(profiler.GetStats("NOT PROFILED").has_value());
+}
+
+TEST_CASE("Scope stats percentiles use the nearest rank")
+{
+	StatsProfiler profiler{};
+
+	// 1 ms up to 100 ms, one frame each
+	for (uint32_t frame{ 1 }; frame <= 100; ++frame)
+	{
+		profiler.AddToStats({ "Scope", 0, ToTicks(static_cast<double>(frame)), 0, true });
+		profiler.EndStatsFrame();
+	}
+
+	auto const stats{ profiler.GetStats("Scope") };
+	REQUIRE(stats.has_value());
+
+	CHECK(stats->frameCount == 100);
+	CHECK(stats->p95 == doctest::Approx(95.0).epsilon(0.01));
+	CHECK(stats->p99 == doctest::Approx(99.0).epsilon(0.01));
+	CHECK(stats->max == doctest::Approx(100.0).epsilon(0.01));
+}
+
+TEST_CASE("Scope stats combine threads & keep names with the same text together")
+{
+	StatsProfiler profiler{};
+
+	// Same text, different pointers, e.g a dynamic name
+	std::string const dynamicName{ "Physics" };
+
+	{
+		std::vector<std::jthread> threads{};
+		for (uint32_t t{ 0 }; t < 4; ++t)
+		{
+			threads.emplace_back([&profiler]
+				{
+					for (uint32_t i{ 0 }; i < 1'000; ++i)
+					{
+						profiler.AddToStats({ "Physics", 0, 10, 1, false });
+					}
+				});
+		}
+	}
+
+	profiler.AddToStats({ profiler.InternScopeName(dynamicName), 0, 10, 1, false });
+	profiler.EndStatsFrame();
+
+	auto const stats{ profiler.GetStats("Physics") };
+	REQUIRE(stats.has_value());
+
+	CHECK(stats->frameCount == 1);
+	CHECK(stats->callsPerFrame == doctest::Approx(4'001.0));
+}
+
+TEST_CASE("Interned scope names outlive their string & share a pointer per text")
+{
+	StatsProfiler profiler{};
+
+	char const* pName{ nullptr };
+	{
+		std::string const systemName{ "MovementSystem" };
+		pName = profiler.InternScopeName(systemName);
+		CHECK(pName != systemName.c_str());
+	}
+
+	std::string const sameText{ "MovementSystem" };
+	CHECK(profiler.InternScopeName(sameText) == pName);
+	CHECK(std::string_view{ pName } == "MovementSystem");
+	CHECK(profiler.InternScopeName("RenderSystem") != pName);
+}
+
+TEST_CASE("Scope stats drop scopes that didn't run for a whole window")
+{
+	StatsProfiler profiler{};
+
+	profiler.AddToStats({ profiler.InternScopeName(std::string{ "RemovedSystem" }), 0, 10, 0, false });
+	profiler.EndStatsFrame();
+
+	for (uint32_t frame{ 1 }; frame < MauEng::PROFILER_STATS_FRAME_COUNT; ++frame)
+	{
+		profiler.AddToStats({ "Frame", 0, 10, 0, false });
+		profiler.EndStatsFrame();
+	}
+
+	// Still in the window
+	CHECK(profiler.GetStats("RemovedSystem").has_value());
+
+	profiler.EndStatsFrame();
+	CHECK_FALSE(profiler.GetStats("RemovedSystem").has_value());
+	CHECK(profiler.GetStats("Frame").has_value());
+	CHECK(profiler.GetAllStats().size() == 1);
+}
+
+TEST_CASE("Scope stats start over with the window they were reset to")
+{
+	StatsProfiler profiler{};
+
+	profiler.AddToStats({ "Warmup", 0, 10, 0, false });
+	profiler.EndStatsFrame();
+	// Ended after the last frame, not part of the new window
+	profiler.AddToStats({ "Measured", 0, 1'000, 0, false });
+
+	profiler.ResetStats(3);
+	CHECK(profiler.GetAllStats().empty());
+
+	for (uint32_t frame{ 0 }; frame < 5; ++frame)
+	{
+		profiler.AddToStats({ "Measured", 0, 10, 0, false });
+		profiler.EndStatsFrame();
+	}
+
+	auto const stats{ profiler.GetStats("Measured") };
+	REQUIRE(stats.has_value());
+	CHECK(stats->frameCount == 3);
+	CHECK(stats->max == doctest::Approx(stats->min));
+	CHECK_FALSE(profiler.GetStats("Warmup").has_value());
+}
@@ -0,0 +1,133 @@
+#include <doctest/doctest.h>
+#include <random>
+#include <set>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Spatial/SpatialHashGrid.h"
+#include "Components/CTransform.h"
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+using namespace MauEng;
+
+namespace
+{
+	struct PointSet final
+	{
+		std::vector<glm::vec3> positions{};
+		std::vector<ECS::EntityID> entities{};
+	};
+
+	PointSet RandomPoints(uint32_t count, std::mt19937& gen)
+	{
+		std::uniform_real_distribution<float> position{ -100.f, 100.f };
+
+		PointSet points{};
+		for (uint32_t idx{ 0 }; idx < count; ++idx)
+		{
+			points.positions.emplace_back(position(gen), position(gen), position(gen));
+			points.entities.emplace_back(idx);
+		}
+		return points;
+	}
+
+	// Brute force reference for the grid queries
+	template<typename Predicate>
+	std::multiset<ECS::EntityID> BruteForce(PointSet const& points, Predicate&& predicate)
+	{
+		std::multiset<ECS::EntityID> result{};
+		for (uint32_t idx{ 0 }; idx < points.positions.size(); ++idx)
+		{
+			if (predicate(points.positions[idx]))
+			{
+				result.insert(points.entities[idx]);
+			}
+		}
+		return result;
+	}
+}
+
+TEST_CASE("Spatial hash grid queries match brute force")
+{
+	std::mt19937 gen{ 42 };
+	std::uniform_real_distribution<float> position{ -100.f, 100.f };
+
+	auto const points{ RandomPoints(20'000, gen) };
+
+	SpatialHashGrid grid{ 2.f };
+	grid.Rebuild(points.positions, points.entities);
+	REQUIRE(grid.EntityCount() == 20'000);
+
+	for (int query{ 0 }; query < 50; ++query)
+	{
+		glm::vec3 const center{ position(gen), position(gen), position(gen) };
+		std::vector<ECS::EntityID> results{};
+
+		// Every 10th query covers more cells than there are buckets
+		float const radius{ query % 10 == 0 ? 80.f : 6.f };
+		grid.QueryRadius(center, radius, results);
+		CHECK(std::multiset<ECS::EntityID>{ results.begin(), results.end() } == BruteForce(points, [&](glm::vec3 const& p) { return glm::dot(p - center, p - center) <= radius * radius; }));
+
+		results.clear();
+		MauCor::AABB const range{ center - glm::vec3{ 5.f, 10.f, 3.f }, center + glm::vec3{ 5.f, 1.f, 3.f } };
+		grid.QueryRange(range, results);
+		CHECK(std::multiset<ECS::EntityID>{ results.begin(), results.end() } == BruteForce(points, [&](glm::vec3 const& p) { return range.Contains({ p, p }); }));
+
+		results.clear();
+		grid.QueryNeighbors(center, results);
+		glm::ivec3 const cell{ glm::floor(center / 2.f) };
+		CHECK(std::multiset<ECS::EntityID>{ results.begin(), results.end() } == BruteForce(points, [&](glm::vec3 const& p)
+			{
+				return glm::all(glm::lessThanEqual(glm::abs(glm::ivec3{ glm::floor(p / 2.f) } - cell), glm::ivec3{ 1 }));
+			}));
+
+		results.clear();
+		glm::mat4 const viewProj{ glm::perspective(glm::radians(60.f), 16.f / 9.f, .1f, 80.f) * glm::lookAt(center, glm::vec3{ 0.f }, glm::vec3{ 0.f, 1.f, 0.f }) };
+		auto const frustum{ MauCor::Frustum::FromMatrix(viewProj) };
+		grid.QueryFrustum(frustum, .5f, results);
+		CHECK(std::multiset<ECS::EntityID>{ results.begin(), results.end() } == BruteForce(points, [&](glm::vec3 const& p) { return frustum.Overlaps(MauCor::Sphere{ p, .5f }); }));
+	}
+}
+
+TEST_CASE("Spatial hash grid rebuilds from the world")
+{
+	ECS::ECSWorld world{};
+	SpatialHashGrid grid{ 1.f };
+
+	std::vector<ECS::EntityID> ids{};
+	for (int idx{ 0 }; idx < 10; ++idx)
+	{
+		auto entity{ world.CreateEntity() };
+		entity.AddComponent<CTransform>().Translate({ static_cast<float>(idx) * 10.f, 0.f, 0.f });
+		ids.emplace_back(entity.ID());
+	}
+
+	grid.Rebuild(world);
+	CHECK(grid.EntityCount() == 10);
+
+	std::vector<ECS::EntityID> results{};
+	grid.QueryRadius({ 20.f, 0.f, 0.f }, 1.f, results);
+	REQUIRE(results.size() == 1);
+	CHECK(results.front() == ids[2]);
+
+	world.GetComponent<CTransform>(ids[2]).Translate({ 0.f, 500.f, 0.f });
+	world.DestroyEntity(ids[3]);
+	grid.Rebuild(world);
+
+	CHECK(grid.EntityCount() == 9);
+
+	results.clear();
+	grid.QueryRadius({ 20.f, 0.f, 0.f }, 1.f, results);
+	CHECK(results.empty());
+
+	results.clear();
+	grid.QueryNeighbors({ 20.5f, 500.5f, .5f }, results);
+	REQUIRE(results.size() == 1);
+	CHECK(results.front() == ids[2]);
+
+	grid.Clear();
+	results.clear();
+	grid.QueryRadius({ 20.f, 500.f, 0.f }, 1.f, results);
+	CHECK(results.empty());
+}
@@ -0,0 +1,232 @@
+#include <doctest/doctest.h>
+#include <random>
+#include <set>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Spatial/DynamicAABBTree.h"
+#include "Spatial/SpatialIndex.h"
+#include "Components/CStaticMesh.h"
+#include "Components/CTransform.h"
+
+#include "ECSWorld.h"
+#include "Entity.h"
+
+using namespace MauEng;
+
+namespace
+{
+	MauCor::AABB RandomBox(std::mt19937& gen)
+	{
+		std::uniform_real_distribution<float> position{ -100.f, 100.f };
+		std::uniform_real_distribution<float> size{ .1f, 3.f };
+
+		glm::vec3 const center{ position(gen), position(gen), position(gen) };
+		return { center - glm::vec3{ size(gen) }, center + glm::vec3{ size(gen) } };
+	}
+
+	// Brute force reference for the tree queries
+	template<typename Predicate>
+	std::set<uint32_t> BruteForce(std::vector<MauCor::AABB> const& boxes, std::vector<bool> const& isAlive, Predicate&& predicate)
+	{
+		std::set<uint32_t> result{};
+		for (uint32_t idx{ 0 }; idx < boxes.size(); ++idx)
+		{
+			if (isAlive[idx] && predicate(boxes[idx]))
+			{
+				result.insert(idx);
+			}
+		}
+		return result;
+	}
+
+	void CheckQueries(DynamicAABBTree const& tree, std::vector<MauCor::AABB> const& boxes, std::vector<bool> const& isAlive, std::mt19937& gen)
+	{
+		std::uniform_real_distribution<float> position{ -100.f, 100.f };
+
+		for (int query{ 0 }; query < 50; ++query)
+		{
+			std::vector<uint32_t> results{};
+
+			MauCor::AABB const box{ RandomBox(gen).Expanded(20.f) };
+			tree.QueryAABB(box, results);
+			CHECK(std::set<uint32_t>{ results.begin(), results.end() } == BruteForce(boxes, isAlive, [&](auto const& b) { return b.Overlaps(box); }));
+
+			results.clear();
+			MauCor::Sphere const sphere{ { position(gen), position(gen), position(gen) }, 30.f };
+			tree.QuerySphere(sphere, results);
+			CHECK(std::set<uint32_t>{ results.begin(), results.end() } == BruteForce(boxes, isAlive, [&](auto const& b) { return sphere.Overlaps(b); }));
+
+			results.clear();
+			glm::vec3 const eye{ position(gen), position(gen), position(gen) };
+			glm::mat4 const viewProj{ glm::perspective(glm::radians(60.f), 16.f / 9.f, .1f, 80.f) * glm::lookAt(eye, glm::vec3{ 0.f }, glm::vec3{ 0.f, 1.f, 0.f }) };
+			auto const frustum{ MauCor::Frustum::FromMatrix(viewProj) };
+			tree.QueryFrustum(frustum, results);
+			CHECK(std::set<uint32_t>{ results.begin(), results.end() } == BruteForce(boxes, isAlive, [&](auto const& b) { return frustum.Overlaps(b); }));
+
+			MauCor::Ray const ray{ eye, glm::normalize(glm::vec3{ position(gen), position(gen), position(gen) } - eye) };
+			auto const hit{ tree.RayCast(ray, 150.f) };
+
+			float closest{ -1.f };
+			for (uint32_t idx{ 0 }; idx < boxes.size(); ++idx)
+			{
+				float const distance{ isAlive[idx] ? ray.Intersect(boxes[idx], 150.f) : -1.f };
+				if (distance >= 0.f && (closest < 0.f || distance < closest))
+				{
+					closest = distance;
+				}
+			}
+
+			REQUIRE(hit.has_value() == (closest >= 0.f));
+			if (hit)
+			{
+				CHECK(hit->distance == doctest::Approx(closest));
+			}
+		}
+	}
+}
+
+TEST_CASE("Frustum planes are extracted from the view projection matrix")
+{
+	glm::mat4 const viewProj{ glm::perspective(glm::radians(90.f), 1.f, 1.f, 100.f) * glm::lookAt(glm::vec3{ 0.f }, glm::vec3{ 0.f, 0.f, -1.f }, glm::vec3{ 0.f, 1.f, 0.f }) };
+	auto const frustum{ MauCor::Frustum::FromMatrix(viewProj) };
+
+	CHECK(frustum.Overlaps({ glm::vec3{ -1.f, -1.f, -11.f }, glm::vec3{ 1.f, 1.f, -9.f } }));
+	// Behind the camera
+	CHECK_FALSE(frustum.Overlaps({ glm::vec3{ -1.f, -1.f, 9.f }, glm::vec3{ 1.f, 1.f, 11.f } }));
+	// Past the far plane
+	CHECK_FALSE(frustum.Overlaps({ glm::vec3{ -1.f, -1.f, -111.f }, glm::vec3{ 1.f, 1.f, -109.f } }));
+	// Outside the 90 degree fov
+	CHECK_FALSE(frustum.Overlaps({ glm::vec3{ 20.f, -1.f, -11.f }, glm::vec3{ 22.f, 1.f, -9.f } }));
+}
+
+TEST_CASE("Dynamic AABB tree queries match brute force after inserts, moves & removes")
+{
+	std::mt19937 gen{ 42 };
+
+	DynamicAABBTree tree{ 0.f };
+	std::vector<MauCor::AABB> boxes{};
+	std::vector<uint32_t> proxyIDs{};
+	std::vector<bool> isAlive{};
+
+	for (uint32_t idx{ 0 }; idx < 2'000; ++idx)
+	{
+		boxes.emplace_back(RandomBox(gen));
+		proxyIDs.emplace_back(tree.CreateProxy(boxes.back(), idx));
+		isAlive.emplace_back(true);
+	}
+
+	for (int step{ 0 }; step < 3'000; ++step)
+	{
+		uint32_t const idx{ gen() % 2'000 };
+		if (!isAlive[idx])
+		{
+			continue;
+		}
+
+		if (step % 5 == 0)
+		{
+			tree.DestroyProxy(proxyIDs[idx]);
+			isAlive[idx] = false;
+		}
+		else
+		{
+			boxes[idx] = RandomBox(gen);
+			tree.MoveProxy(proxyIDs[idx], boxes[idx]);
+		}
+	}
+
+	REQUIRE(tree.Validate());
+	CHECK(tree.ProxyCount() == static_cast<uint32_t>(std::ranges::count(isAlive, true)));
+
+	CheckQueries(tree, boxes, isAlive, gen);
+}
+
+TEST_CASE("Dynamic AABB tree balances the new parent of an inserted leaf")
+{
+	DynamicAABBTree tree{ 0.f };
+
+	// Every box holds all the previous ones, so each insert pairs the new leaf with the root.
+	// Without balancing the new parent the tree turns into a list of 31 levels
+	for (uint32_t idx{ 0 }; idx < 32; ++idx)
+	{
+		float const halfSize{ static_cast<float>(1u << idx) };
+		tree.CreateProxy(MauCor::AABB{ glm::vec3{ -halfSize }, glm::vec3{ halfSize } }, idx);
+	}
+
+	REQUIRE(tree.Validate());
+	CHECK(tree.GetHeight() <= 16);
+}
+
+TEST_CASE("Dynamic AABB tree bulk build")
+{
+	std::mt19937 gen{ 7 };
+
+	std::vector<MauCor::AABB> boxes{};
+	std::vector<ProxyInput> proxies{};
+	for (uint32_t idx{ 0 }; idx < 50'000; ++idx)
+	{
+		boxes.emplace_back(RandomBox(gen));
+		proxies.emplace_back(ProxyInput{ boxes.back(), idx });
+	}
+
+	DynamicAABBTree tree{ 0.f };
+	std::vector<uint32_t> proxyIDs(proxies.size());
+	tree.Build(proxies, proxyIDs);
+
+	REQUIRE(tree.Validate());
+	for (uint32_t idx{ 0 }; idx < proxies.size(); ++idx)
+	{
+		REQUIRE(tree.GetUserData(proxyIDs[idx]) == idx);
+	}
+
+	// The median split keeps the tree close to log2(n)
+	CHECK(tree.GetHeight() <= 20);
+
+	std::vector<bool> const isAlive(boxes.size(), true);
+	CheckQueries(tree, boxes, isAlive, gen);
+}
+
+TEST_CASE("Spatial index follows transforms & destroyed entities")
+{
+	ECS::ECSWorld world{};
+	SpatialIndex index{};
+
+	MauCor::AABB const unitBox{ glm::vec3{ -.5f }, glm::vec3{ .5f } };
+
+	std::vector<ECS::EntityID> ids{};
+	for (int idx{ 0 }; idx < 10; ++idx)
+	{
+		auto entity{ world.CreateEntity() };
+		entity.AddComponent<CTransform>().Translate({ static_cast<float>(idx) * 10.f, 0.f, 0.f });
+		entity.AddComponent<CStaticMesh>(0u, unitBox);
+		ids.emplace_back(entity.ID());
+	}
+
+	index.Update(world);
+	CHECK(index.EntityCount() == 10);
+
+	std::vector<ECS::EntityID> results{};
+	index.QuerySphere({ glm::vec3{ 20.f, 0.f, 0.f }, 1.f }, results);
+	REQUIRE(results.size() == 1);
+	CHECK(results.front() == ids[2]);
+
+	// Move entity 2 far away & destroy entity 3
+	world.GetComponent<CTransform>(ids[2]).Translate({ 0.f, 500.f, 0.f });
+	world.DestroyEntity(ids[3]);
+	index.Update(world);
+
+	CHECK(index.EntityCount() == 9);
+
+	results.clear();
+	index.QuerySphere({ glm::vec3{ 20.f, 0.f, 0.f }, 1.f }, results);
+	CHECK(results.empty());
+
+	results.clear();
+	index.QueryAABB({ glm::vec3{ 15.f, 490.f, -5.f }, glm::vec3{ 25.f, 510.f, 5.f } }, results);
+	REQUIRE(results.size() == 1);
+	CHECK(results.front() == ids[2]);
+
+	auto const hit{ index.RayCast({ glm::vec3{ -10.f, 0.f, 0.f }, glm::vec3{ 1.f, 0.f, 0.f } }, 100.f) };
+	REQUIRE(hit.has_value());
+	CHECK(hit->userData == ids[0]);
+}
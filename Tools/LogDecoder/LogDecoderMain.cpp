@@ -0,0 +1,60 @@
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+#include "Logger/Logger.h"
+
+// Turns a binary log (USE_BINARY_FILE_LOGGING) into the text the file logger would have written
+// Usage: MauEngLogDecoder <Log.bin> [output.txt]
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: MauEngLogDecoder <binary log> [output file]\n";
+		return 1;
+	}
+
+	std::ifstream input{ argv[1], std::ios::in | std::ios::binary };
+	if (!input.is_open())
+	{
+		std::cerr << "Error opening binary log: " << argv[1] << '\n';
+		return 1;
+	}
+
+	MauCor::BinaryLogReader reader{ input };
+	if (!reader.IsValid())
+	{
+		std::cerr << argv[1] << " is not a binary log of this version\n";
+		return 1;
+	}
+
+	std::ofstream outputFile{};
+	if (argc > 2)
+	{
+		outputFile.open(argv[2], std::ios::out | std::ios::trunc);
+		if (!outputFile.is_open())
+		{
+			std::cerr << "Error opening output file: " << argv[2] << '\n';
+			return 1;
+		}
+	}
+	std::ostream& output{ outputFile.is_open() ? outputFile : std::cout };
+
+	auto const* pTimeZone{ std::chrono::current_zone() };
+
+	MauCor::DecodedLogRecord record{};
+	while (reader.Next(record))
+	{
+		std::string const timestamp{ std::format("{:%Y-%m-%d %H:%M:%S}", std::chrono::zoned_time{ pTimeZone, record.time }) };
+
+		output << fmt::format("[{}] [{}] [{}] {}", timestamp, MauCor::Logger::PriorityToString(record.priority), MauCor::Logger::CategoryToString(record.category), record.message);
+		if (!record.file.empty())
+		{
+			output << fmt::format(" ({}:{})", record.file, record.line);
+		}
+		output << '\n';
+	}
+
+	return 0;
+}